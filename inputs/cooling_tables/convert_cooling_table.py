@@ -0,0 +1,59 @@
+import argparse
+import numpy as np
+
+"""
+Converts an ASCII cooling table (as read with `cooling/table_format = ascii`) into the
+binary format that can be used with `cooling/table_format = binary`.
+
+Usage: python convert_cooling_table.py schure.cooling schure.bin
+    Afterwards set `table_filename = schure.bin` and `table_format = binary` in the
+    `<cooling>` block of the parameter file (`lambda_units_cgs` is still required).
+
+Notes:
+    - Layout (native endianness): 8 byte magic "APKCOOL1", int64 number of entries,
+        float64 log10 of the first temperature, float64 log10 temperature spacing,
+        followed by the float64 log10 cooling rates.
+    - The binary format requires an evenly spaced (in log10 temperature) table.
+"""
+
+magic = b"APKCOOL1"
+
+parser = argparse.ArgumentParser(description="Convert ASCII cooling table to binary")
+parser.add_argument("input", help="ASCII cooling table")
+parser.add_argument("output", help="Binary cooling table")
+parser.add_argument("--log_temp_col", type=int, default=0)
+parser.add_argument("--log_lambda_col", type=int, default=1)
+parser.add_argument(
+    "--d_log_temp_tol",
+    type=float,
+    default=1e-8,
+    help="Tolerance for the relative difference in temperature spacing",
+)
+args = parser.parse_args()
+
+data = np.loadtxt(args.input, comments="#", ndmin=2)
+log_temps = data[:, args.log_temp_col]
+log_lambdas = data[:, args.log_lambda_col]
+
+if len(log_temps) < 2:
+    raise ValueError("Not enough data to interpolate cooling")
+
+d_log_temp = log_temps[1] - log_temps[0]
+if d_log_temp <= 0:
+    raise ValueError("Temperatures in table need to be increasing")
+
+rel_diff = np.abs(np.diff(log_temps) - d_log_temp) / d_log_temp
+if np.any(rel_diff > args.d_log_temp_tol):
+    i = np.argmax(rel_diff) + 1
+    raise ValueError(
+        f"Uneven temperature spacing at i={i} log_temp={log_temps[i]} "
+        f"rel_diff={rel_diff[i - 1]} (tol={args.d_log_temp_tol})"
+    )
+
+with open(args.output, "wb") as f:
+    f.write(magic)
+    f.write(np.array([len(log_lambdas)], dtype=np.int64).tobytes())
+    f.write(np.array([log_temps[0], d_log_temp], dtype=np.float64).tobytes())
+    f.write(np.ascontiguousarray(log_lambdas, dtype=np.float64).tobytes())
+
+print(f"Wrote {len(log_lambdas)} entries to {args.output}")
@@ -0,0 +1,104 @@
+import glob
+import numpy as np
+
+"""
+Reads the snapshots written by the asynchronous output (see `<async_output>` in
+docs/input.md), i.e., the raw binary files `<basename>.<file_number>.rank<rank>.bin`.
+
+Usage:
+    import async_snapshot
+    snap = async_snapshot.read_snapshot("snapshot", 0)
+    rho = snap["fields"]["prim"][:, 0]  # [block][k][j][i]
+
+Notes:
+    - `read_snapshot` combines the files of all ranks and sorts the blocks by their
+        global id, i.e., in the same order as the blocks of the (HDF5) outputs of
+        Parthenon.
+    - Fields are returned with shape [block][component][k][j][i] in the precision they
+        were written with (float32 for the `float_variables`).
+"""
+
+
+def read_snapshot_file(filename):
+    """Returns the header and fields (in file order) of a single rank's file"""
+    header = {"variables": [], "float_variables": [], "blocks": []}
+    with open(filename, "rb") as f:
+        while True:
+            line = f.readline()
+            if not line:
+                raise ValueError(f"{filename}: header not terminated by a data line")
+            tokens = line.decode().split()
+            if not tokens or tokens[0] == "#":
+                continue
+            key, values = tokens[0], tokens[1:]
+            if key == "data":
+                break
+            if key == "time":
+                header["time"] = float(values[0])
+            elif key in ("cycle", "real_bytes", "num_blocks"):
+                header[key] = int(values[0])
+            elif key == "rank":
+                header["rank"], header["nranks"] = int(values[0]), int(values[1])
+            elif key in ("variables", "float_variables"):
+                header[key] = [
+                    (name, int(ncomp))
+                    for name, ncomp in (value.rsplit(":", 1) for value in values)
+                ]
+            elif key == "nx":
+                header["nx"] = tuple(int(value) for value in values)
+            elif key == "block":
+                header["blocks"].append(
+                    {
+                        "gid": int(values[0]),
+                        "level": int(values[1]),
+                        "bounds": np.array([float(value) for value in values[2:]]),
+                    }
+                )
+        data = f.read()
+
+    num_blocks = header["num_blocks"]
+    assert len(header["blocks"]) == num_blocks, f"{filename}: corrupt header"
+    nx1, nx2, nx3 = header["nx"]
+    real = np.dtype(np.float64 if header["real_bytes"] == 8 else np.float32)
+    fields = {}
+    offset = 0
+    for key, dtype in (("variables", real), ("float_variables", np.dtype(np.float32))):
+        if not header[key]:
+            continue
+        ncomp_total = sum(ncomp for _, ncomp in header[key])
+        count = num_blocks * ncomp_total * nx3 * nx2 * nx1
+        values = np.frombuffer(data, dtype=dtype, count=count, offset=offset)
+        values = values.reshape((num_blocks, ncomp_total, nx3, nx2, nx1))
+        offset += count * dtype.itemsize
+        # The components of all fields of a block are contiguous
+        comp = 0
+        for name, ncomp in header[key]:
+            fields[name] = values[:, comp : comp + ncomp]
+            comp += ncomp
+    assert offset == len(data), f"{filename}: unexpected size of the data"
+    return header, fields
+
+
+def read_snapshot(basename, file_number):
+    """Returns the snapshot combining the files of all ranks (sorted by block gid)"""
+    filenames = sorted(glob.glob(f"{basename}.{file_number:05d}.rank*.bin"))
+    if not filenames:
+        raise FileNotFoundError(f"No snapshot {basename}.{file_number:05d}.rank*.bin")
+    headers, fields = zip(*(read_snapshot_file(filename) for filename in filenames))
+    nranks = headers[0]["nranks"]
+    assert len(filenames) == nranks, f"Expected {nranks} files, found {len(filenames)}"
+
+    blocks = [block for header in headers for block in header["blocks"]]
+    order = np.argsort([block["gid"] for block in blocks])
+    return {
+        "time": headers[0]["time"],
+        "cycle": headers[0]["cycle"],
+        "gid": np.array([blocks[b]["gid"] for b in order]),
+        "level": np.array([blocks[b]["level"] for b in order]),
+        # x1min, x1max, x2min, x2max, x3min, x3max
+        "bounds": np.array([blocks[b]["bounds"] for b in order]),
+        "fields": {
+            name: np.concatenate([rank_fields[name] for rank_fields in fields])[order]
+            for name in fields[0]
+        },
+    }
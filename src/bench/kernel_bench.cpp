@@ -0,0 +1,372 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file kernel_bench.cpp
+//  \brief Standalone microbenchmark of the pointwise kernels (reconstruction, Riemann
+//  solvers, conserved to primitive conversion, and cooling table interpolation)
+//
+// The kernels are called on synthetic (smooth) data of a single block without setting
+// up a Mesh so that changes to the inner kernels can be evaluated in isolation, e.g.,
+//   athenaPK_kernel_bench bench/nx=128 bench/nrep=50
+// For each kernel the time per call, the cell (or interface) updates per second, and the
+// effective bandwidth (assuming each array element is read or written exactly once) are
+// reported.
+
+// C++ headers
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+// Kokkos/Parthenon headers
+#include <Kokkos_Core.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../eos/adiabatic_glmmhd.hpp"
+#include "../eos/adiabatic_hydro.hpp"
+#include "../hydro/hydro.hpp"
+#include "../hydro/rsolvers/rsolvers.hpp"
+#include "../hydro/srcterms/tabular_cooling.hpp"
+#include "../main.hpp"
+#include "../recon/limo3_simple.hpp"
+#include "../recon/plm_simple.hpp"
+#include "../recon/ppm_simple.hpp"
+#include "../recon/weno3_simple.hpp"
+#include "../recon/wenoz_simple.hpp"
+#include "../units.hpp"
+
+namespace kernel_bench {
+using parthenon::DevExecSpace;
+using parthenon::ParArray1D;
+using parthenon::ParArray3D;
+using parthenon::ParArray4D;
+using parthenon::Real;
+
+constexpr int nghost = 3;
+constexpr int nvar_mhd = 9; // with (cell centered) magnetic fields and psi
+
+struct Settings {
+  int nx;    // interior cells per direction of the (single) block
+  int nrep;  // timed repetitions of each kernel
+  int nwarm; // untimed repetitions before timing
+  Real gamma;
+};
+
+// L/R states on a pencil as expected by the pointwise Riemann solvers, i.e., wl(n, i)
+struct PencilState {
+  ParArray4D<Real> w;
+  int k, j;
+  KOKKOS_INLINE_FUNCTION Real operator()(const int n, const int i) const {
+    return w(n, k, j, i);
+  }
+};
+
+// Same interface as the fluxes of a VariableFluxPack (only a single direction is
+// stored as all kernels are called in X1DIR)
+struct BenchFluxes {
+  ParArray4D<Real> f;
+  KOKKOS_INLINE_FUNCTION Real &flux(const int /*dir*/, const int n, const int k,
+                                    const int j, const int i) const {
+    return f(n, k, j, i);
+  }
+};
+
+// Times `nrep` calls of `kernel` (after `nwarm` untimed calls) and prints a summary line
+template <typename F>
+void Time(const std::string &name, const Settings &s, const Real nupdates,
+          const Real bytes, F &&kernel) {
+  for (int r = 0; r < s.nwarm; r++) {
+    kernel();
+  }
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  for (int r = 0; r < s.nrep; r++) {
+    kernel();
+  }
+  Kokkos::fence();
+  const Real time = timer.seconds() / static_cast<Real>(s.nrep);
+  std::printf("  %-36s %12.4e %14.4e %10.2f\n", name.c_str(), time, nupdates / time,
+              bytes / time * 1e-9);
+}
+
+// Smooth synthetic primitive state (with magnetic fields and psi if nvar > NHYDRO)
+KOKKOS_INLINE_FUNCTION void SyntheticPrim(const int k, const int j, const int i,
+                                          const int nx, Real *w) {
+  const Real x = 2.0 * M_PI * i / nx;
+  const Real y = 2.0 * M_PI * j / nx;
+  const Real z = 2.0 * M_PI * k / nx;
+  w[IDN] = 1.0 + 0.5 * std::sin(x) * std::cos(y);
+  w[IV1] = 0.3 * std::sin(y + z);
+  w[IV2] = 0.2 * std::cos(x + z);
+  w[IV3] = 0.1 * std::sin(x - y);
+  w[IPR] = 1.0 + 0.3 * std::cos(x) * std::sin(z);
+  w[IB1] = 0.5 + 0.1 * std::cos(z);
+  w[IB2] = 0.2 * std::sin(x);
+  w[IB3] = 0.1 * std::cos(y);
+  w[IPS] = 0.0;
+}
+
+void FillPrim(const Settings &s, const int nvar, ParArray4D<Real> w) {
+  const int n = s.nx + 2 * nghost;
+  const int nx = s.nx;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "kernel_bench::FillPrim", DevExecSpace(), 0, n - 1, 0, n - 1,
+      0, n - 1, KOKKOS_LAMBDA(const int k, const int j, const int i) {
+        Real wi[nvar_mhd];
+        SyntheticPrim(k, j, i, nx, wi);
+        for (int v = 0; v < nvar; v++) {
+          w(v, k, j, i) = wi[v];
+        }
+      });
+}
+
+// Pointwise reconstruction in cell i returning ql_ip1 and qr_i (as in the scratch pad
+// based flux kernel)
+template <Reconstruction recon>
+KOKKOS_INLINE_FUNCTION void ReconstructCell(const ParArray4D<Real> &q, const int n,
+                                            const int k, const int j, const int i,
+                                            const Real dx, Real &ql_ip1, Real &qr_i) {
+  if constexpr (recon == Reconstruction::plm) {
+    PLM(q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1), ql_ip1, qr_i);
+  } else if constexpr (recon == Reconstruction::ppm) {
+    PPM(q(n, k, j, i - 2), q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1),
+        q(n, k, j, i + 2), ql_ip1, qr_i);
+  } else if constexpr (recon == Reconstruction::wenoz) {
+    WENOZ(q(n, k, j, i - 2), q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1),
+          q(n, k, j, i + 2), ql_ip1, qr_i);
+  } else if constexpr (recon == Reconstruction::weno3) {
+    WENO3(q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1), ql_ip1, qr_i, dx * dx);
+  } else if constexpr (recon == Reconstruction::limo3) {
+    LimO3(q(n, k, j, i - 1), q(n, k, j, i), q(n, k, j, i + 1), ql_ip1, qr_i, dx,
+          n == IDN || n == IPR);
+  }
+}
+
+template <Reconstruction recon>
+void LaunchReconstruction(const int nx, const int nvar, const ParArray4D<Real> &w,
+                          const ParArray4D<Real> &wl, const ParArray4D<Real> &wr) {
+  const Real dx = 1.0 / nx;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "kernel_bench::Reconstruct", DevExecSpace(), 0, nvar - 1,
+      nghost, nghost + nx - 1, nghost, nghost + nx - 1, nghost - 1, nghost + nx,
+      KOKKOS_LAMBDA(const int n, const int k, const int j, const int i) {
+        ReconstructCell<recon>(w, n, k, j, i, dx, wl(n, k, j, i + 1), wr(n, k, j, i));
+      });
+}
+
+template <Reconstruction recon>
+void BenchReconstruction(const std::string &name, const Settings &s, const int nvar,
+                         const ParArray4D<Real> &w, const ParArray4D<Real> &wl,
+                         const ParArray4D<Real> &wr) {
+  // including one cell on each side so that the states on all faces are set
+  const Real ncells = static_cast<Real>(s.nx) * s.nx * (s.nx + 2);
+  // read w, write wl and wr
+  const Real bytes = 3.0 * nvar * ncells * sizeof(Real);
+  Time(name, s, ncells, bytes,
+       [&]() { LaunchReconstruction<recon>(s.nx, nvar, w, wl, wr); });
+}
+
+template <Fluid fluid, RiemannSolver rsolver, typename EOS>
+void LaunchRiemann(const int nx, const EOS &eos, const ParArray4D<Real> &wl,
+                   const ParArray4D<Real> &wr, const BenchFluxes &fluxes) {
+  const Real c_h = 1.0;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "kernel_bench::RiemannSolve", DevExecSpace(), nghost,
+      nghost + nx - 1, nghost, nghost + nx - 1, nghost, nghost + nx,
+      KOKKOS_LAMBDA(const int k, const int j, const int i) {
+        const PencilState pl{wl, k, j};
+        const PencilState pr{wr, k, j};
+        auto f = fluxes;
+        Riemann<fluid, rsolver>::Solve(k, j, i, IV1, pl, pr, f, eos, c_h);
+      });
+}
+
+template <Fluid fluid, RiemannSolver rsolver, typename EOS>
+void BenchRiemann(const std::string &name, const Settings &s, const int nvar,
+                  const EOS &eos, const ParArray4D<Real> &wl, const ParArray4D<Real> &wr,
+                  const BenchFluxes &fluxes) {
+  const Real nfaces = static_cast<Real>(s.nx) * s.nx * (s.nx + 1);
+  // read wl and wr, write the fluxes
+  const Real bytes = 3.0 * nvar * nfaces * sizeof(Real);
+  Time(name, s, nfaces, bytes,
+       [&]() { LaunchRiemann<fluid, rsolver>(s.nx, eos, wl, wr, fluxes); });
+}
+
+// Conserved variables from the synthetic primitive state
+void FillCons(const Settings &s, const int nvar, const ParArray4D<Real> &u) {
+  const int n = s.nx + 2 * nghost;
+  const int nx = s.nx;
+  const Real gm1 = s.gamma - 1.0;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "kernel_bench::FillCons", DevExecSpace(), 0, n - 1, 0, n - 1,
+      0, n - 1, KOKKOS_LAMBDA(const int k, const int j, const int i) {
+        Real wi[nvar_mhd];
+        SyntheticPrim(k, j, i, nx, wi);
+        u(IDN, k, j, i) = wi[IDN];
+        u(IM1, k, j, i) = wi[IDN] * wi[IV1];
+        u(IM2, k, j, i) = wi[IDN] * wi[IV2];
+        u(IM3, k, j, i) = wi[IDN] * wi[IV3];
+        u(IEN, k, j, i) =
+            wi[IPR] / gm1 + 0.5 * wi[IDN] * (SQR(wi[IV1]) + SQR(wi[IV2]) + SQR(wi[IV3]));
+        if (nvar > NHYDRO) {
+          for (int v = IB1; v <= IPS; v++) {
+            u(v, k, j, i) = wi[v];
+          }
+          u(IEN, k, j, i) += 0.5 * (SQR(wi[IB1]) + SQR(wi[IB2]) + SQR(wi[IB3]));
+        }
+      });
+}
+
+template <typename EOS>
+void LaunchConsToPrim(const int n, const int nvar, const EOS &eos,
+                      const ParArray4D<Real> &u, const ParArray4D<Real> &w) {
+  const int nscalars = 0;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "kernel_bench::ConsToPrim", DevExecSpace(), 0, n - 1, 0,
+      n - 1, 0, n - 1, KOKKOS_LAMBDA(const int k, const int j, const int i) {
+        eos.ConsToPrim(u, w, nvar, nscalars, k, j, i);
+      });
+}
+
+template <typename EOS>
+void BenchConsToPrim(const std::string &name, const Settings &s, const int nvar,
+                     const EOS &eos, const ParArray4D<Real> &u,
+                     const ParArray4D<Real> &w) {
+  // The synthetic data does not hit any floor so that u is not modified by the calls
+  FillCons(s, nvar, u);
+  const int n = s.nx + 2 * nghost;
+  const Real ncells = static_cast<Real>(n) * n * n;
+  // read u, write w
+  const Real bytes = 2.0 * nvar * ncells * sizeof(Real);
+  Time(name, s, ncells, bytes, [&]() { LaunchConsToPrim(n, nvar, eos, u, w); });
+}
+
+void LaunchCoolingDeDt(const int nx, const CoolingTableObj &table,
+                       const ParArray3D<Real> &e, const ParArray3D<Real> &rho,
+                       const ParArray3D<Real> &de_dt) {
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "kernel_bench::CoolingDeDt", DevExecSpace(), 0, nx - 1, 0,
+      nx - 1, 0, nx - 1, KOKKOS_LAMBDA(const int k, const int j, const int i) {
+        de_dt(k, j, i) = table.DeDt(e(k, j, i), rho(k, j, i));
+      });
+}
+
+void BenchCooling(const Settings &s, parthenon::ParameterInput *pin) {
+  // Synthetic cooling table (evenly spaced in log T as required by CoolingTableObj)
+  // with a smooth cooling curve peaking around 10^5.5 K
+  const Real log_temp_start = 4.0;
+  const Real log_temp_final = 9.0;
+  const unsigned int n_temp = 101;
+  const Real d_log_temp = (log_temp_final - log_temp_start) / (n_temp - 1);
+  ParArray1D<Real> log_lambdas("log_lambdas", n_temp);
+  auto log_lambdas_h = Kokkos::create_mirror_view(log_lambdas);
+  for (unsigned int i = 0; i < n_temp; i++) {
+    const Real log_temp = log_temp_start + i * d_log_temp;
+    log_lambdas_h(i) = -22.0 - 0.5 * SQR(log_temp - 5.5) / (1.0 + 0.5 * log_temp);
+  }
+  Kokkos::deep_copy(log_lambdas, log_lambdas_h);
+
+  const Units units(pin);
+  const Real mu = 0.6;
+  const Real mbar_over_kb = mu * units.atomic_mass_unit() / units.k_boltzmann();
+  const Real x_H = 0.75;
+
+  const int nx = s.nx;
+  ParArray3D<Real> e("e", nx, nx, nx), rho("rho", nx, nx, nx), de_dt("de_dt", nx, nx, nx);
+  const Real gm1 = s.gamma - 1.0;
+  const Real rho0 = 1e-26 * units.g() / (units.cm() * units.cm() * units.cm());
+  // Temperatures covering the entire table
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "kernel_bench::FillCooling", DevExecSpace(), 0, nx - 1, 0,
+      nx - 1, 0, nx - 1, KOKKOS_LAMBDA(const int k, const int j, const int i) {
+        const Real log_temp =
+            log_temp_start + (log_temp_final - log_temp_start) * (i + 0.5) / nx;
+        e(k, j, i) = std::pow(10.0, log_temp) / (mbar_over_kb * gm1);
+        rho(k, j, i) = rho0 * (1.0 + 0.5 * std::sin(2.0 * M_PI * (j + k) / nx));
+      });
+
+  const Real ncells = static_cast<Real>(nx) * nx * nx;
+  // read e and rho, write de_dt (ignoring the table that is expected to be cached)
+  const Real bytes = 3.0 * ncells * sizeof(Real);
+  for (const bool fast_table : {false, true}) {
+    const CoolingTableObj table(log_lambdas, log_temp_start, log_temp_final, d_log_temp,
+                                n_temp, mbar_over_kb, s.gamma, x_H, units, fast_table);
+    Time(fast_table ? "cooling DeDt (fast table)" : "cooling DeDt", s, ncells, bytes,
+         [&]() { LaunchCoolingDeDt(nx, table, e, rho, de_dt); });
+  }
+}
+
+void Run(parthenon::ParameterInput *pin) {
+  Settings s;
+  s.nx = pin->GetOrAddInteger("bench", "nx", 64);
+  s.nrep = pin->GetOrAddInteger("bench", "nrep", 20);
+  s.nwarm = pin->GetOrAddInteger("bench", "nwarm", 2);
+  s.gamma = pin->GetOrAddReal("bench", "gamma", 5.0 / 3.0);
+  PARTHENON_REQUIRE_THROWS(s.nx > 0 && s.nrep > 0 && s.nwarm >= 0,
+                           "kernel_bench: nx and nrep must be positive");
+
+  const int n = s.nx + 2 * nghost;
+  ParArray4D<Real> w("w", nvar_mhd, n, n, n), u("u", nvar_mhd, n, n, n);
+  ParArray4D<Real> wl("wl", nvar_mhd, n, n, n), wr("wr", nvar_mhd, n, n, n);
+  BenchFluxes fluxes{ParArray4D<Real>("flux", nvar_mhd, n, n, n)};
+
+  // Limiters are enabled (but not hit by the synthetic data) as in a production run
+  const Real dfloor = 1e-8, pfloor = 1e-10, efloor = 0.0;
+  const Real vceil = std::numeric_limits<Real>::infinity();
+  const Real eceil = std::numeric_limits<Real>::infinity();
+  const AdiabaticHydroEOS hydro_eos(pfloor, dfloor, efloor, vceil, eceil, s.gamma);
+  const AdiabaticGLMMHDEOS glmmhd_eos(pfloor, dfloor, efloor, vceil, eceil, s.gamma);
+
+  std::printf("AthenaPK kernel microbenchmark with %d^3 cells per call (%d repetitions, "
+              "concurrency %d)\n",
+              s.nx, s.nrep, static_cast<int>(DevExecSpace().concurrency()));
+  std::printf("  %-36s %12s %14s %10s\n", "kernel", "time/call[s]", "updates/s", "GB/s");
+
+  FillPrim(s, nvar_mhd, w);
+  for (const int nvar : {static_cast<int>(NHYDRO), nvar_mhd}) {
+    const std::string suffix = nvar == NHYDRO ? " (euler)" : " (glmmhd)";
+    BenchReconstruction<Reconstruction::plm>("recon plm" + suffix, s, nvar, w, wl, wr);
+    BenchReconstruction<Reconstruction::ppm>("recon ppm" + suffix, s, nvar, w, wl, wr);
+    BenchReconstruction<Reconstruction::wenoz>("recon wenoz" + suffix, s, nvar, w, wl,
+                                               wr);
+    BenchReconstruction<Reconstruction::weno3>("recon weno3" + suffix, s, nvar, w, wl,
+                                               wr);
+    BenchReconstruction<Reconstruction::limo3>("recon limo3" + suffix, s, nvar, w, wl,
+                                               wr);
+  }
+
+  // Riemann solvers on the (smooth) L/R states of the PLM reconstruction
+  BenchReconstruction<Reconstruction::plm>("recon plm (glmmhd)", s, nvar_mhd, w, wl, wr);
+  BenchRiemann<Fluid::euler, RiemannSolver::hlle>("riemann hlle (euler)", s, NHYDRO,
+                                                  hydro_eos, wl, wr, fluxes);
+  BenchRiemann<Fluid::euler, RiemannSolver::hllc>("riemann hllc (euler)", s, NHYDRO,
+                                                  hydro_eos, wl, wr, fluxes);
+  BenchRiemann<Fluid::glmmhd, RiemannSolver::hlle>("riemann hlle (glmmhd)", s,
+                                                   nvar_mhd, glmmhd_eos, wl, wr, fluxes);
+  BenchRiemann<Fluid::glmmhd, RiemannSolver::hlld>("riemann hlld (glmmhd)", s,
+                                                   nvar_mhd, glmmhd_eos, wl, wr, fluxes);
+  BenchRiemann<Fluid::glmmhd, RiemannSolver::hlld_branchless>(
+      "riemann hlld_branchless (glmmhd)", s, nvar_mhd, glmmhd_eos, wl, wr, fluxes);
+
+  BenchConsToPrim("cons_to_prim (euler)", s, NHYDRO, hydro_eos, u, w);
+  BenchConsToPrim("cons_to_prim (glmmhd)", s, nvar_mhd, glmmhd_eos, u, w);
+
+  BenchCooling(s, pin);
+}
+
+} // namespace kernel_bench
+
+int main(int argc, char *argv[]) {
+  Kokkos::ScopeGuard guard(argc, argv);
+  {
+    // Options are passed as `block/par=value` on the command line
+    parthenon::ParameterInput pin;
+    pin.ModifyFromCmdline(argc, argv);
+    kernel_bench::Run(&pin);
+  }
+  return 0;
+}
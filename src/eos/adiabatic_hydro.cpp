@@ -15,6 +15,7 @@
 
 // Parthenon headers
 #include "../eos/adiabatic_hydro.hpp"
+#include "../hydro/hydro_params.hpp"
 #include "../main.hpp"
 #include "config.hpp"
 #include "interface/variable.hpp"
@@ -22,26 +23,23 @@
 #include "mesh/domain.hpp"
 #include "parthenon_arrays.hpp"
 using parthenon::IndexDomain;
+using parthenon::IndexRange;
 using parthenon::MeshBlockVarPack;
 using parthenon::ParArray4D;
 
-//----------------------------------------------------------------------------------------
-// \!fn void EquationOfState::ConservedToPrimitive(
-//           Container<Real> &rc,
-//           int il, int iu, int jl, int ju, int kl, int ku)
-// \brief Converts conserved into primitive variables in adiabatic hydro.
-void AdiabaticHydroEOS::ConservedToPrimitive(MeshData<Real> *md) const {
+// Conversion for the interior and the ghost zones (all or the number set by
+// `hydro/cons_to_prim_nghost`) of a partition
+template <bool with_limiters>
+void AdiabaticHydroConsToPrim(const AdiabaticHydroEOS &eos, MeshData<Real> *md) {
   auto const cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
   auto prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
-  auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
-  auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+  const auto &params = Hydro::GetHydroParams(md);
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+  IndexRange ib, jb, kb;
+  GetConsToPrimBounds(md, params.cons_to_prim_nghost, ib, jb, kb);
 
-  auto pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  const auto nhydro = pkg->Param<int>("nhydro");
-  const auto nscalars = pkg->Param<int>("nscalars");
-
-  auto this_on_device = (*this);
+  auto this_on_device = eos;
 
   parthenon::par_for(
       DEFAULT_LOOP_PATTERN, "ConservedToPrimitive", parthenon::DevExecSpace(), 0,
@@ -50,6 +48,21 @@ void AdiabaticHydroEOS::ConservedToPrimitive(MeshData<Real> *md) const {
         const auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
 
-        return this_on_device.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+        return this_on_device.template ConsToPrim<with_limiters>(cons, prim, nhydro,
+                                                                 nscalars, k, j, i);
       });
 }
+
+//----------------------------------------------------------------------------------------
+// \!fn void EquationOfState::ConservedToPrimitive(
+//           Container<Real> &rc,
+//           int il, int iu, int jl, int ju, int kl, int ku)
+// \brief Converts conserved into primitive variables in adiabatic hydro.
+void AdiabaticHydroEOS::ConservedToPrimitive(MeshData<Real> *md) const {
+  // Skip all floor and ceiling branches if none is enabled (identical results)
+  if (LimitersDisabled()) {
+    AdiabaticHydroConsToPrim<false>(*this, md);
+  } else {
+    AdiabaticHydroConsToPrim<true>(*this, md);
+  }
+}
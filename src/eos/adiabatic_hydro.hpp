@@ -47,8 +47,9 @@ class AdiabaticHydroEOS : public EquationOfState {
   //----------------------------------------------------------------------------------------
   // \!fn Real EquationOfState::ConsToPrim(View4D cons, View4D prim, const int& k, const
   // int& j, const int& i) \brief Fills an array of primitives given an array of
-  // conserveds, potentially updating the conserved with floors
-  template <typename View4D>
+  // conserveds, potentially updating the conserved with floors.
+  // `with_limiters = false` skips all floors and ceilings (see LimitersDisabled()).
+  template <bool with_limiters = true, typename View4D>
   KOKKOS_INLINE_FUNCTION void ConsToPrim(View4D cons, View4D prim, const int &nhydro,
                                          const int &nscalars, const int &k, const int &j,
                                          const int &i) const {
@@ -77,8 +78,13 @@ class AdiabaticHydroEOS : public EquationOfState {
     PARTHENON_REQUIRE(u_d > 0.0 || density_floor_ > 0.0,
                       "Got negative density. Consider enabling first-order flux "
                       "correction or setting a reasonble density floor.");
-    // apply density floor, without changing momentum or energy
-    u_d = (u_d > density_floor_) ? u_d : density_floor_;
+    if constexpr (with_limiters) {
+      if (u_d < density_floor_) {
+        CountLimiter(Limiter::density_floor);
+      }
+      // apply density floor, without changing momentum or energy
+      u_d = (u_d > density_floor_) ? u_d : density_floor_;
+    }
     w_d = u_d;
 
     Real di = 1.0 / u_d;
@@ -91,7 +97,8 @@ class AdiabaticHydroEOS : public EquationOfState {
 
     // apply velocity ceiling. By default ceiling is std::numeric_limits<Real>::infinity()
     const Real w_v2 = SQR(w_vx) + SQR(w_vy) + SQR(w_vz);
-    if (w_v2 > SQR(velocity_ceiling_)) {
+    if (with_limiters && w_v2 > SQR(velocity_ceiling_)) {
+      CountLimiter(Limiter::velocity_ceiling);
       const Real w_v = sqrt(w_v2);
       w_vx *= velocity_ceiling_ / w_v;
       w_vy *= velocity_ceiling_ / w_v;
@@ -112,27 +119,32 @@ class AdiabaticHydroEOS : public EquationOfState {
                       "Got negative pressure. Consider enabling first-order flux "
                       "correction or setting a reasonble pressure or temperature floor.");
 
-    // Pressure floor (if present) takes precedence over temperature floor
-    if ((pressure_floor_ > 0.0) && (w_p < pressure_floor_)) {
-      // apply pressure floor, correct total energy
-      u_e = (pressure_floor_ / gm1) + e_k;
-      w_p = pressure_floor_;
-    }
-
-    // temperature (internal energy) based pressure floor
-    const Real eff_pressure_floor = gm1 * u_d * e_floor_;
-    if (w_p < eff_pressure_floor) {
-      // apply temperature floor, correct total energy
-      u_e = (u_d * e_floor_) + e_k;
-      w_p = eff_pressure_floor;
-    }
-
-    // temperature (internal energy) based pressure ceiling
-    const Real eff_pressure_ceiling = gm1 * u_d * e_ceiling_;
-    if (w_p > eff_pressure_ceiling) {
-      // apply temperature ceiling, correct total energy
-      u_e = (u_d * e_ceiling_) + e_k;
-      w_p = eff_pressure_ceiling;
+    if constexpr (with_limiters) {
+      // Pressure floor (if present) takes precedence over temperature floor
+      if ((pressure_floor_ > 0.0) && (w_p < pressure_floor_)) {
+        CountLimiter(Limiter::pressure_floor);
+        // apply pressure floor, correct total energy
+        u_e = (pressure_floor_ / gm1) + e_k;
+        w_p = pressure_floor_;
+      }
+
+      // temperature (internal energy) based pressure floor
+      const Real eff_pressure_floor = gm1 * u_d * e_floor_;
+      if (w_p < eff_pressure_floor) {
+        CountLimiter(Limiter::temperature_floor);
+        // apply temperature floor, correct total energy
+        u_e = (u_d * e_floor_) + e_k;
+        w_p = eff_pressure_floor;
+      }
+
+      // temperature (internal energy) based pressure ceiling
+      const Real eff_pressure_ceiling = gm1 * u_d * e_ceiling_;
+      if (w_p > eff_pressure_ceiling) {
+        CountLimiter(Limiter::temperature_ceiling);
+        // apply temperature ceiling, correct total energy
+        u_e = (u_d * e_ceiling_) + e_k;
+        w_p = eff_pressure_ceiling;
+      }
     }
 
     // Convert passive scalars
@@ -12,11 +12,14 @@
 // C headers
 
 // C++ headers
+#include <algorithm>
+#include <cstdint>
 #include <limits> // std::numeric_limits<float>
 
 // Parthenon headers
 #include "mesh/mesh.hpp"
 
+using parthenon::IndexRange;
 using parthenon::MeshBlock;
 using parthenon::MeshBlockData;
 using parthenon::MeshBlockVarPack;
@@ -27,6 +30,39 @@ using parthenon::Real;
 
 // enum class EOS { isothermal, adiabatic, general, undefined };
 
+// Floors and ceilings applied in ConsToPrim (order is used as index of the counters)
+enum class Limiter {
+  density_floor,
+  velocity_ceiling,
+  pressure_floor,
+  temperature_floor,
+  temperature_ceiling
+};
+constexpr int num_limiters = 5;
+using LimiterCounts = Kokkos::View<std::int64_t *, parthenon::DevMemSpace>;
+
+// Index ranges of the conversion from conserved to primitive variables, i.e., the
+// interior plus `nghost` ghost zones in each active dimension (or the entire block for a
+// negative `nghost`).
+inline void GetConsToPrimBounds(MeshData<Real> *md, const int nghost, IndexRange &ib,
+                                IndexRange &jb, IndexRange &kb) {
+  using parthenon::IndexDomain;
+  const auto &pmbd = md->GetBlockData(0);
+  ib = pmbd->GetBoundsI(IndexDomain::entire);
+  jb = pmbd->GetBoundsJ(IndexDomain::entire);
+  kb = pmbd->GetBoundsK(IndexDomain::entire);
+  if (nghost < 0) {
+    return;
+  }
+  const auto ib_int = pmbd->GetBoundsI(IndexDomain::interior);
+  const auto jb_int = pmbd->GetBoundsJ(IndexDomain::interior);
+  const auto kb_int = pmbd->GetBoundsK(IndexDomain::interior);
+  // Inactive dimensions have no ghost zones, i.e., entire and interior coincide
+  ib = IndexRange{std::max(ib.s, ib_int.s - nghost), std::min(ib.e, ib_int.e + nghost)};
+  jb = IndexRange{std::max(jb.s, jb_int.s - nghost), std::min(jb.e, jb_int.e + nghost)};
+  kb = IndexRange{std::max(kb.s, kb_int.s - nghost), std::min(kb.e, kb_int.e + nghost)};
+}
+
 //! \class EquationOfState
 //  \brief abstract base class for equation of state object
 
@@ -55,9 +91,35 @@ class EquationOfState {
   KOKKOS_INLINE_FUNCTION
   Real GetInternalECeiling() const { return internal_e_ceiling_; }
 
+  // Enables counting (on the device) the number of conversions in which each limiter is
+  // applied. The counters are shared by all copies of the object.
+  void EnableLimiterCounts() {
+    limiter_counts_ = LimiterCounts("limiter counts", num_limiters);
+    count_limiters_ = true;
+  }
+  LimiterCounts GetLimiterCounts() const { return limiter_counts_; }
+
+  // If all floors and ceilings are disabled (and not counted) ConsToPrim<false>, which
+  // skips all limiters, results in identical primitive variables.
+  bool LimitersDisabled() const {
+    return density_floor_ <= 0.0 && pressure_floor_ <= 0.0 && internal_e_floor_ <= 0.0 &&
+           velocity_ceiling_ == std::numeric_limits<Real>::infinity() &&
+           internal_e_ceiling_ == std::numeric_limits<Real>::infinity() &&
+           !count_limiters_;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void CountLimiter(const Limiter limiter) const {
+    if (count_limiters_) {
+      Kokkos::atomic_increment(&limiter_counts_(static_cast<int>(limiter)));
+    }
+  }
+
  private:
   Real pressure_floor_, density_floor_, internal_e_floor_;
   Real velocity_ceiling_, internal_e_ceiling_;
+  bool count_limiters_ = false;
+  LimiterCounts limiter_counts_;
 };
 
 #endif // EOS_EOS_HPP_
@@ -0,0 +1,202 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file autotune.cpp
+//  \brief Runtime autotuner for the launch configuration of the flux calculation
+
+// C++ headers
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "autotune.hpp"
+#include "hydro_params.hpp"
+
+namespace Hydro {
+
+namespace {
+std::string FluxKernelName(const FluxKernel kernel) {
+  switch (kernel) {
+  case FluxKernel::scratch:
+    return "scratch";
+  case FluxKernel::fused:
+    return "fused";
+  case FluxKernel::tight:
+    return "tight";
+  default:
+    return "undefined";
+  }
+}
+} // namespace
+
+FluxAutotuner::FluxAutotuner(const std::string &cache_filename,
+                             const int cycles_per_candidate,
+                             const std::vector<FluxLaunchConfig> &candidates,
+                             const std::string &method_key)
+    : cache_filename_(cache_filename), cycles_per_candidate_(cycles_per_candidate),
+      candidates_(candidates), times_(candidates.size(), 0.0), key_(method_key) {
+  PARTHENON_REQUIRE_THROWS(!candidates_.empty(), "No candidates for flux autotuning.");
+  PARTHENON_REQUIRE_THROWS(cycles_per_candidate_ >= 2,
+                           "Flux autotuning requires at least two cycles per candidate "
+                           "(the first is used as warmup).");
+}
+
+bool FluxAutotuner::NextCycle(const std::string &block_key) {
+  if (finished_) {
+    return false;
+  }
+  if (!started_) {
+    started_ = true;
+    key_ += "_" + block_key;
+    if (ReadCache()) {
+      finished_ = true;
+    }
+    return true;
+  }
+
+  // The first cycle of each candidate is considered warmup
+  if (cycle_ > 0) {
+    times_[current_] += time_current_cycle_;
+  }
+  time_current_cycle_ = 0.0;
+
+  if (++cycle_ < cycles_per_candidate_) {
+    return false;
+  }
+  cycle_ = 0;
+  if (++current_ < static_cast<int>(candidates_.size())) {
+    return true;
+  }
+
+  SelectFastest();
+  WriteCache();
+  finished_ = true;
+  return true;
+}
+
+void FluxAutotuner::SelectFastest() {
+  // The slowest rank determines the time to solution
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, times_.data(),
+                                    static_cast<int>(times_.size()), MPI_PARTHENON_REAL,
+                                    MPI_MAX, MPI_COMM_WORLD));
+#endif
+  selected_ = 0;
+  for (int n = 1; n < static_cast<int>(times_.size()); n++) {
+    if (times_[n] < times_[selected_]) {
+      selected_ = n;
+    }
+  }
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "Flux autotuning for '" << key_ << "':" << std::endl;
+    for (int n = 0; n < static_cast<int>(times_.size()); n++) {
+      std::cout << "  flux_kernel = " << FluxKernelName(candidates_[n].kernel)
+                << ", scratch_level = " << candidates_[n].scratch_level << ": "
+                << times_[n] << " s" << (n == selected_ ? " (selected)" : "")
+                << std::endl;
+    }
+  }
+}
+
+// Cache file contains one line per key, i.e., "key flux_kernel scratch_level time".
+// If a key is contained multiple times, the last entry is used.
+bool FluxAutotuner::ReadCache() {
+  std::ifstream file(cache_filename_);
+  if (!file.is_open()) {
+    return false;
+  }
+  bool found = false;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream iss(line);
+    std::string key, kernel;
+    int scratch_level;
+    if (!(iss >> key >> kernel >> scratch_level) || key != key_) {
+      continue;
+    }
+    for (int n = 0; n < static_cast<int>(candidates_.size()); n++) {
+      if (FluxKernelName(candidates_[n].kernel) == kernel &&
+          candidates_[n].scratch_level == scratch_level) {
+        selected_ = n;
+        found = true;
+      }
+    }
+  }
+  if (found && parthenon::Globals::my_rank == 0) {
+    std::cout << "Using cached flux autotuning result for '" << key_
+              << "': flux_kernel = " << FluxKernelName(candidates_[selected_].kernel)
+              << ", scratch_level = " << candidates_[selected_].scratch_level
+              << std::endl;
+  }
+  return found;
+}
+
+void FluxAutotuner::WriteCache() const {
+  if (parthenon::Globals::my_rank != 0) {
+    return;
+  }
+  std::ofstream file(cache_filename_, std::ios::app);
+  if (!file.is_open()) {
+    std::cout << "### WARNING Could not open flux autotuning cache file '"
+              << cache_filename_ << "'." << std::endl;
+    return;
+  }
+  file << key_ << " " << FluxKernelName(candidates_[selected_].kernel) << " "
+       << candidates_[selected_].scratch_level << " " << times_[selected_] << std::endl;
+}
+
+void InitFluxAutotuner(ParameterInput *pin, StateDescriptor *pkg,
+                       const std::vector<FluxLaunchConfig> &candidates,
+                       const std::string &method_key) {
+  const auto cycles = pin->GetOrAddInteger("hydro", "autotune_cycles", 3);
+  const auto filename =
+      pin->GetOrAddString("hydro", "autotune_file", "athenapk_autotune.dat");
+  pkg->AddParam<>("flux_autotuner",
+                  FluxAutotuner(filename, cycles, candidates, method_key), true);
+}
+
+void AdvanceFluxAutotuner(StateDescriptor *hydro_pkg, MeshBlock *pmb) {
+  auto tuner = hydro_pkg->Param<FluxAutotuner>("flux_autotuner");
+  if (tuner.IsFinished()) {
+    return;
+  }
+  std::stringstream block_key;
+  block_key << pmb->block_size.nx1 << "x" << pmb->block_size.nx2 << "x"
+            << pmb->block_size.nx3 << "_" << DevExecSpace().name();
+  if (tuner.NextCycle(block_key.str())) {
+    const auto &config = tuner.GetConfig();
+    hydro_pkg->UpdateParam("flux_kernel", config.kernel);
+    hydro_pkg->UpdateParam("scratch_level", config.scratch_level);
+    hydro_pkg->UpdateParam("flux_first_stage", config.flux_first_stage);
+    hydro_pkg->UpdateParam("flux_other_stage", config.flux_other_stage);
+    RefreshHydroParams(hydro_pkg);
+  }
+  hydro_pkg->UpdateParam("flux_autotuner", tuner);
+}
+
+TaskStatus CalculateFluxesTimed(std::shared_ptr<MeshData<Real>> &md,
+                                FluxFun_t *calc_flux_fun) {
+  // Make sure that only the flux calculation is timed
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  const auto status = calc_flux_fun(md);
+  Kokkos::fence();
+  const auto elapsed = timer.seconds();
+
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  auto tuner = hydro_pkg->Param<FluxAutotuner>("flux_autotuner");
+  tuner.AddTime(elapsed);
+  hydro_pkg->UpdateParam("flux_autotuner", tuner);
+  return status;
+}
+
+} // namespace Hydro
@@ -0,0 +1,90 @@
+#ifndef HYDRO_AUTOTUNE_HPP_
+#define HYDRO_AUTOTUNE_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file autotune.hpp
+//  \brief Runtime autotuner for the launch configuration of the flux calculation
+
+// C++ headers
+#include <memory>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "hydro.hpp"
+
+namespace Hydro {
+
+// Launch configuration of the flux calculation that is subject to tuning.
+// All configurations result in identical fluxes.
+struct FluxLaunchConfig {
+  FluxKernel kernel;
+  int scratch_level;
+  FluxFun_t *flux_first_stage;
+  FluxFun_t *flux_other_stage;
+};
+
+// Each candidate configuration is used for a fixed number of cycles (the first of which
+// is considered warmup and ignored) while the time spent in the flux calculation is
+// recorded. Afterwards, the configuration that is fastest on the slowest rank is used
+// for the remainder of the simulation and stored in a cache file so that subsequent
+// runs with the same key (method, block shape, and device) skip the tuning.
+class FluxAutotuner {
+ public:
+  FluxAutotuner() = default;
+  FluxAutotuner(const std::string &cache_filename, const int cycles_per_candidate,
+                const std::vector<FluxLaunchConfig> &candidates,
+                const std::string &method_key);
+
+  // Advance to the next cycle. Needs to be called once per cycle (before the first
+  // stage) and returns true if the launch configuration changed.
+  bool NextCycle(const std::string &block_key);
+  void AddTime(const Real seconds) { time_current_cycle_ += seconds; }
+  bool IsTuning() const { return started_ && !finished_; }
+  bool IsFinished() const { return finished_; }
+  const FluxLaunchConfig &GetConfig() const {
+    return candidates_[finished_ ? selected_ : current_];
+  }
+
+ private:
+  bool ReadCache();
+  void WriteCache() const;
+  void SelectFastest();
+
+  std::string cache_filename_;
+  int cycles_per_candidate_ = 0;
+  std::vector<FluxLaunchConfig> candidates_;
+  std::vector<Real> times_;
+  std::string key_;
+  int current_ = 0;
+  int cycle_ = 0;
+  int selected_ = 0;
+  Real time_current_cycle_ = 0.0;
+  bool started_ = false;
+  bool finished_ = false;
+};
+
+// Setup autotuner for flux calculation (only called if enabled via hydro/autotune)
+void InitFluxAutotuner(ParameterInput *pin, StateDescriptor *pkg,
+                       const std::vector<FluxLaunchConfig> &candidates,
+                       const std::string &method_key);
+
+// Select the launch configuration for the next cycle and update the package params
+// accordingly. Called on the host before the task collection of the first stage is
+// created.
+void AdvanceFluxAutotuner(StateDescriptor *hydro_pkg, MeshBlock *pmb);
+
+// Task wrapper measuring the time of the flux calculation while tuning
+TaskStatus CalculateFluxesTimed(std::shared_ptr<MeshData<Real>> &md,
+                                FluxFun_t *calc_flux_fun);
+
+} // namespace Hydro
+
+#endif // HYDRO_AUTOTUNE_HPP_
@@ -0,0 +1,72 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file block_costs.cpp
+//  \brief Estimates of the computational cost of each block used for load balancing
+
+// C++ headers
+#include <string>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "block_costs.hpp"
+#include "hydro.hpp"
+#include "utils/error_checking.hpp"
+
+namespace Hydro {
+
+void InitBlockCosts(ParameterInput *pin, StateDescriptor *pkg) {
+  const auto block_costs = pin->GetOrAddBoolean("hydro", "block_costs", false);
+  pkg->AddParam<>("block_costs", block_costs);
+  if (!block_costs) {
+    return;
+  }
+  // Parthenon only uses the block costs set by the application with the manual balancer
+  PARTHENON_REQUIRE_THROWS(
+      pin->GetOrAddString("parthenon/loadbalancing", "balancer", "default") == "manual",
+      "AthenaPK hydro: block_costs requires parthenon/loadbalancing/balancer = manual");
+  pkg->AddParam<>("block_cost_cooling_subcycle",
+                  pin->GetOrAddReal("hydro", "block_cost_cooling_subcycle", 0.1));
+  pkg->AddParam<>("block_cost_fofc", pin->GetOrAddReal("hydro", "block_cost_fofc", 1.0));
+}
+
+void ResetBlockCosts(BlockList_t &blocks, StateDescriptor *pkg) {
+  if (!pkg->Param<bool>("block_costs")) {
+    return;
+  }
+  for (auto &pmb : blocks) {
+    Real cost = 1.0;
+    if (ProblemBlockCost != nullptr) {
+      cost += ProblemBlockCost(pmb.get());
+    }
+    pmb->SetCostForLoadBalancing(cost);
+  }
+}
+
+BlockWorkCounter::BlockWorkCounter(MeshData<Real> *md, const std::string &weight_key) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  enabled_ = hydro_pkg->Param<bool>("block_costs");
+  if (enabled_) {
+    weight_ = hydro_pkg->Param<Real>(weight_key);
+    work_ = parthenon::ParArray1D<Real>("block work", md->NumBlocks());
+  }
+}
+
+void BlockWorkCounter::AddToBlockCosts(MeshData<Real> *md) const {
+  if (!enabled_) {
+    return;
+  }
+  auto work_h = Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), work_);
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    auto pmb = md->GetBlockData(b)->GetBlockPointer();
+    const auto ncells = static_cast<Real>(pmb->block_size.nx1 * pmb->block_size.nx2 *
+                                          pmb->block_size.nx3);
+    pmb->SetCostForLoadBalancing(pmb->cost_ + weight_ * work_h(b) / ncells);
+  }
+}
+
+} // namespace Hydro
@@ -0,0 +1,56 @@
+#ifndef HYDRO_BLOCK_COSTS_HPP_
+#define HYDRO_BLOCK_COSTS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file block_costs.hpp
+//  \brief Estimates of the computational cost of each block used for load balancing
+
+// C++ headers
+#include <string>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+// Setup block cost estimates (only used if enabled via hydro/block_costs)
+void InitBlockCosts(ParameterInput *pin, StateDescriptor *pkg);
+
+// The cost of a block is measured relative to the hydro update of the block. At the
+// beginning of each cycle, all costs are reset to this base cost (plus potentially
+// problem specific costs, see ProblemBlockCost). Additional work during the cycle (e.g.,
+// cooling subcycles) is added to the cost so that the load balancing (at the end of the
+// cycle) uses the cost of the last cycle.
+void ResetBlockCosts(BlockList_t &blocks, StateDescriptor *pkg);
+
+// Counts additional work per block of a MeshData container (a noop if block costs are
+// disabled).
+class BlockWorkCounter {
+ public:
+  // The param `weight_key` contains the cost of one unit of work (e.g., one cooling
+  // subcycle of a cell) relative to the hydro update of a cell.
+  BlockWorkCounter(MeshData<Real> *md, const std::string &weight_key);
+
+  KOKKOS_INLINE_FUNCTION void Add(const int b, const Real work) const {
+    if (enabled_) {
+      Kokkos::atomic_add(&work_(b), work);
+    }
+  }
+
+  // Add the counted work to the cost of the blocks (blocking).
+  void AddToBlockCosts(MeshData<Real> *md) const;
+
+ private:
+  bool enabled_ = false;
+  Real weight_ = 0.0;
+  parthenon::ParArray1D<Real> work_;
+};
+
+} // namespace Hydro
+
+#endif // HYDRO_BLOCK_COSTS_HPP_
@@ -21,12 +21,13 @@
 using namespace parthenon::package::prelude;
 
 KOKKOS_INLINE_FUNCTION
-Real ThermalDiffusivity::Get(const Real pres, const Real rho, const Real gradTmag) const {
+Real ThermalDiffusivity::Get(const Real p_over_rho, const Real rho,
+                             const Real gradTmag) const {
   if (conduction_ == Conduction::thermal_diff) {
     return coeff_;
   } else if (conduction_ == Conduction::spitzer) {
-    const Real T = mbar_over_kb_ * pres / rho;
-    const Real kappa = coeff_ * std::pow(T, 5. / 2.); // Full spitzer
+    const Real T = mbar_over_kb_ * p_over_rho;
+    const Real kappa = coeff_ * SQR(T) * std::sqrt(T); // Full spitzer
     const Real chi_spitzer = kappa * mbar_over_kb_ / rho;
 
     // Saturated total flux: fac * \rho * c_{s,isoth}^3
@@ -35,7 +36,7 @@ Real ThermalDiffusivity::Get(const Real pres, const Real rho, const Real gradTma
     // Thus, everything is in code units and no conversion is required.
     // The \rho above is cancelled as we convert the condution above to a diffusvity here.
     const Real chi_sat =
-        0.34 * std::pow(pres / rho, 3.0 / 2.0) / (gradTmag + TINY_NUMBER);
+        0.34 * p_over_rho * std::sqrt(p_over_rho) / (gradTmag + TINY_NUMBER);
     return std::min(chi_spitzer, chi_sat);
 
   } else {
@@ -43,10 +44,32 @@ Real ThermalDiffusivity::Get(const Real pres, const Real rho, const Real gradTma
   }
 }
 
+namespace {
+// Fill p/rho (the temperature up to a constant factor) including ghost zones, which is
+// subsequently used in the stencils of the conduction kernels.
+void FillConductionTemperature(MeshData<Real> *md) {
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  auto T_pack = md->PackVariables(std::vector<std::string>{"p_over_rho"});
+
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "FillConductionTemperature", parthenon::DevExecSpace(), 0,
+      prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        T_pack(b, 0, k, j, i) = prim_pack(b, IPR, k, j, i) / prim_pack(b, IDN, k, j, i);
+      });
+}
+} // namespace
+
 Real EstimateConductionTimestep(MeshData<Real> *md) {
   // get to package via first block in Meshdata (which exists by construction)
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  FillConductionTemperature(md);
+  const auto &T_pack = md->PackVariables(std::vector<std::string>{"p_over_rho"});
 
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
@@ -74,8 +97,8 @@ Real EstimateConductionTimestep(MeshData<Real> *md) {
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt) {
         const auto &coords = prim_pack.GetCoords(b);
         const auto &prim = prim_pack(b);
+        const auto &T = T_pack(b);
         const auto &rho = prim(IDN, k, j, i);
-        const auto &p = prim(IPR, k, j, i);
         // TODO(pgrete) when we introduce isotropic thermal conduction a lot of the
         // following machinery should be hidden behind conditionals
         const auto &Bx = prim(IB1, k, j, i);
@@ -83,24 +106,17 @@ Real EstimateConductionTimestep(MeshData<Real> *md) {
         const auto &Bz = prim(IB3, k, j, i);
         const auto Bmag = sqrt(SQR(Bx) + SQR(By) + SQR(Bz));
 
-        const auto dTdx = 0.5 *
-                          (prim(IPR, k, j, i + 1) / prim(IDN, k, j, i + 1) -
-                           prim(IPR, k, j, i - 1) / prim(IDN, k, j, i - 1)) /
-                          coords.Dxc<1>(i);
-
-        const auto dTdy = 0.5 *
-                          (prim(IPR, k, j + 1, i) / prim(IDN, k, j + 1, i) -
-                           prim(IPR, k, j - 1, i) / prim(IDN, k, j - 1, i)) /
-                          coords.Dxc<2>(j);
-
-        const auto dTdz = ndim >= 3
-                              ? 0.5 *
-                                    (prim(IPR, k + 1, j, i) / prim(IDN, k + 1, j, i) -
-                                     prim(IPR, k - 1, j, i) / prim(IDN, k - 1, j, i)) /
-                                    coords.Dxc<3>(k)
-                              : 0.0;
+        const auto dTdx =
+            0.5 * (T(0, k, j, i + 1) - T(0, k, j, i - 1)) / coords.Dxc<1>(i);
+
+        const auto dTdy =
+            0.5 * (T(0, k, j + 1, i) - T(0, k, j - 1, i)) / coords.Dxc<2>(j);
+
+        const auto dTdz =
+            ndim >= 3 ? 0.5 * (T(0, k + 1, j, i) - T(0, k - 1, j, i)) / coords.Dxc<3>(k)
+                      : 0.0;
         const auto gradTmag = sqrt(SQR(dTdx) + SQR(dTdy) + SQR(dTdz));
-        auto thermal_diff_coeff = thermal_diff.Get(p, rho, gradTmag);
+        auto thermal_diff_coeff = thermal_diff.Get(T(0, k, j, i), rho, gradTmag);
 
         const auto denom = Bmag * gradTmag;
         // if either Bmag or gradTmag are 0, no anisotropic thermal conduction
@@ -142,6 +158,9 @@ void ThermalFluxAniso(MeshData<Real> *md) {
   auto hydro_pkg = pmb->packages.Get("Hydro");
 
   auto const &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  // p/rho is calculated once (instead of at every stencil point in all directions)
+  FillConductionTemperature(md);
+  auto const &T_pack = md->PackVariables(std::vector<std::string>{"p_over_rho"});
 
   const int ndim = pmb->pmy_mesh->ndim;
 
@@ -154,6 +173,7 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         const auto &coords = prim_pack.GetCoords(b);
         auto &cons = cons_pack(b);
         const auto &prim = prim_pack(b);
+        const auto &T = T_pack(b);
 
         // Variables only required in 3D case
         Real dTdz = 0.0;
@@ -162,33 +182,25 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         // clang-format off
         /* Monotonized temperature difference dT/dy */
         const auto dTdy =
-            limiters::lim4(prim(IPR, k, j + 1, i    ) / prim(IDN, k, j + 1, i    ) -
-                           prim(IPR, k, j    , i    ) / prim(IDN, k, j    , i    ),
-                           prim(IPR, k, j    , i    ) / prim(IDN, k, j    , i    ) -
-                           prim(IPR, k, j - 1, i    ) / prim(IDN, k, j - 1, i    ),
-                           prim(IPR, k, j + 1, i - 1) / prim(IDN, k, j + 1, i - 1) -
-                           prim(IPR, k, j    , i - 1) / prim(IDN, k, j    , i - 1),
-                           prim(IPR, k, j    , i - 1) / prim(IDN, k, j    , i - 1) -
-                           prim(IPR, k, j - 1, i - 1) / prim(IDN, k, j - 1, i - 1)) /
+            limiters::lim4(T(0, k, j + 1, i    ) - T(0, k, j    , i    ),
+                           T(0, k, j    , i    ) - T(0, k, j - 1, i    ),
+                           T(0, k, j + 1, i - 1) - T(0, k, j    , i - 1),
+                           T(0, k, j    , i - 1) - T(0, k, j - 1, i - 1)) /
             coords.Dxc<2>(k, j, i);
 
         if (ndim >= 3) {
           /* Monotonized temperature difference dT/dz, 3D problem ONLY */
-          dTdz = limiters::lim4(prim(IPR, k + 1, j, i    ) / prim(IDN, k + 1, j, i    ) -
-                                prim(IPR, k    , j, i    ) / prim(IDN, k    , j, i    ),
-                                prim(IPR, k    , j, i    ) / prim(IDN, k    , j, i    ) -
-                                prim(IPR, k - 1, j, i    ) / prim(IDN, k - 1, j, i    ),
-                                prim(IPR, k + 1, j, i - 1) / prim(IDN, k + 1, j, i - 1) -
-                                prim(IPR, k    , j, i - 1) / prim(IDN, k    , j, i - 1),
-                                prim(IPR, k    , j, i - 1) / prim(IDN, k    , j, i - 1) -
-                                prim(IPR, k - 1, j, i - 1) / prim(IDN, k - 1, j, i - 1)) /
+          dTdz = limiters::lim4(T(0, k + 1, j, i    ) - T(0, k    , j, i    ),
+                                T(0, k    , j, i    ) - T(0, k - 1, j, i    ),
+                                T(0, k + 1, j, i - 1) - T(0, k    , j, i - 1),
+                                T(0, k    , j, i - 1) - T(0, k - 1, j, i - 1)) /
                  coords.Dxc<3>(k, j, i);
           Bz = 0.5 * (prim(IB3, k, j, i - 1) + prim(IB3, k, j, i));
         }
         // clang-format on
 
-        const auto T_i = prim(IPR, k, j, i) / prim(IDN, k, j, i);
-        const auto T_im1 = prim(IPR, k, j, i - 1) / prim(IDN, k, j, i - 1);
+        const auto T_i = T(0, k, j, i);
+        const auto T_im1 = T(0, k, j, i - 1);
         const auto dTdx = (T_i - T_im1) / coords.Dxc<1>(k, j, i);
 
         // Calc interface values
@@ -202,8 +214,8 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         const auto gradTmag = sqrt(SQR(dTdx) + SQR(dTdy) + SQR(dTdz));
         const auto thermal_diff_f =
             0.5 *
-            (thermal_diff.Get(prim(IPR, k, j, i), prim(IDN, k, j, i), gradTmag) +
-             thermal_diff.Get(prim(IPR, k, j, i - 1), prim(IDN, k, j, i - 1), gradTmag));
+            (thermal_diff.Get(T(0, k, j, i), prim(IDN, k, j, i), gradTmag) +
+             thermal_diff.Get(T(0, k, j, i - 1), prim(IDN, k, j, i - 1), gradTmag));
         cons.flux(X1DIR, IEN, k, j, i) -= thermal_diff_f * denf * (Bx * bDotGradT) / B02;
       });
 
@@ -215,6 +227,7 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         const auto &coords = prim_pack.GetCoords(b);
         auto &cons = cons_pack(b);
         const auto &prim = prim_pack(b);
+        const auto &T = T_pack(b);
 
         // Variables only required in 3D case
         Real dTdz = 0.0;
@@ -223,34 +236,26 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         // clang-format off
         /* Monotonized temperature difference dT/dx */
         const auto dTdx =
-            limiters::lim4(prim(IPR, k, j    , i + 1) / prim(IDN, k, j    , i + 1) -
-                           prim(IPR, k, j    , i    ) / prim(IDN, k, j    , i    ),
-                           prim(IPR, k, j    , i    ) / prim(IDN, k, j    , i    ) -
-                           prim(IPR, k, j    , i - 1) / prim(IDN, k, j    , i - 1),
-                           prim(IPR, k, j - 1, i + 1) / prim(IDN, k, j - 1, i + 1) -
-                           prim(IPR, k, j - 1, i    ) / prim(IDN, k, j - 1, i    ),
-                           prim(IPR, k, j - 1, i    ) / prim(IDN, k, j - 1, i    ) -
-                           prim(IPR, k, j - 1, i - 1) / prim(IDN, k, j - 1, i - 1)) /
+            limiters::lim4(T(0, k, j    , i + 1) - T(0, k, j    , i    ),
+                           T(0, k, j    , i    ) - T(0, k, j    , i - 1),
+                           T(0, k, j - 1, i + 1) - T(0, k, j - 1, i    ),
+                           T(0, k, j - 1, i    ) - T(0, k, j - 1, i - 1)) /
             coords.Dxc<1>(k, j, i);
 
         if (ndim >= 3) {
           /* Monotonized temperature difference dT/dz, 3D problem ONLY */
-          dTdz = limiters::lim4(prim(IPR, k + 1, j    , i) / prim(IDN, k + 1, j    , i) -
-                                prim(IPR, k    , j    , i) / prim(IDN, k    , j    , i),
-                                prim(IPR, k    , j    , i) / prim(IDN, k    , j    , i) -
-                                prim(IPR, k - 1, j    , i) / prim(IDN, k - 1, j    , i),
-                                prim(IPR, k + 1, j - 1, i) / prim(IDN, k + 1, j - 1, i) -
-                                prim(IPR, k    , j - 1, i) / prim(IDN, k    , j - 1, i),
-                                prim(IPR, k    , j - 1, i) / prim(IDN, k    , j - 1, i) -
-                                prim(IPR, k - 1, j - 1, i) / prim(IDN, k - 1, j - 1, i)) /
+          dTdz = limiters::lim4(T(0, k + 1, j    , i) - T(0, k    , j    , i),
+                                T(0, k    , j    , i) - T(0, k - 1, j    , i),
+                                T(0, k + 1, j - 1, i) - T(0, k    , j - 1, i),
+                                T(0, k    , j - 1, i) - T(0, k - 1, j - 1, i)) /
                  coords.Dxc<3>(k, j, i);
 
           Bz = 0.5 * (prim(IB3, k, j - 1, i) + prim(IB3, k, j, i));
         }
         // clang-format on
 
-        const auto T_j = prim(IPR, k, j, i) / prim(IDN, k, j, i);
-        const auto T_jm1 = prim(IPR, k, j - 1, i) / prim(IDN, k, j - 1, i);
+        const auto T_j = T(0, k, j, i);
+        const auto T_jm1 = T(0, k, j - 1, i);
         const auto dTdy = (T_j - T_jm1) / coords.Dxc<2>(k, j, i);
 
         // Calc interface values
@@ -264,8 +269,8 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         const auto gradTmag = sqrt(SQR(dTdx) + SQR(dTdy) + SQR(dTdz));
         const auto thermal_diff_f =
             0.5 *
-            (thermal_diff.Get(prim(IPR, k, j, i), prim(IDN, k, j, i), gradTmag) +
-             thermal_diff.Get(prim(IPR, k, j - 1, i), prim(IDN, k, j - 1, i), gradTmag));
+            (thermal_diff.Get(T(0, k, j, i), prim(IDN, k, j, i), gradTmag) +
+             thermal_diff.Get(T(0, k, j - 1, i), prim(IDN, k, j - 1, i), gradTmag));
         cons.flux(X2DIR, IEN, k, j, i) -= thermal_diff_f * denf * (By * bDotGradT) / B02;
       });
   /* Compute heat fluxes in 3-direction, 3D problem ONLY  ---------------------*/
@@ -280,35 +285,28 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         const auto &coords = prim_pack.GetCoords(b);
         auto &cons = cons_pack(b);
         const auto &prim = prim_pack(b);
+        const auto &T = T_pack(b);
 
         // clang-format off
         /* Monotonized temperature difference dT/dx */
         const auto dTdx =
-            limiters::lim4(prim(IPR, k    , j, i + 1) / prim(IDN, k    , j, i + 1) -
-                           prim(IPR, k    , j, i    ) / prim(IDN, k    , j, i    ),
-                           prim(IPR, k    , j, i    ) / prim(IDN, k    , j, i    ) -
-                           prim(IPR, k    , j, i - 1) / prim(IDN, k    , j, i - 1),
-                           prim(IPR, k - 1, j, i + 1) / prim(IDN, k - 1, j, i + 1) -
-                           prim(IPR, k - 1, j, i    ) / prim(IDN, k - 1, j, i    ),
-                           prim(IPR, k - 1, j, i    ) / prim(IDN, k - 1, j, i    ) -
-                           prim(IPR, k - 1, j, i - 1) / prim(IDN, k - 1, j, i - 1)) /
+            limiters::lim4(T(0, k    , j, i + 1) - T(0, k    , j, i    ),
+                           T(0, k    , j, i    ) - T(0, k    , j, i - 1),
+                           T(0, k - 1, j, i + 1) - T(0, k - 1, j, i    ),
+                           T(0, k - 1, j, i    ) - T(0, k - 1, j, i - 1)) /
             coords.Dxc<1>(k, j, i);
 
         /* Monotonized temperature difference dT/dy */
         const auto dTdy =
-            limiters::lim4(prim(IPR, k    , j + 1, i) / prim(IDN, k    , j + 1, i) -
-                           prim(IPR, k    , j    , i) / prim(IDN, k    , j    , i),
-                           prim(IPR, k    , j    , i) / prim(IDN, k    , j    , i) -
-                           prim(IPR, k    , j - 1, i) / prim(IDN, k    , j - 1, i),
-                           prim(IPR, k - 1, j + 1, i) / prim(IDN, k - 1, j + 1, i) -
-                           prim(IPR, k - 1, j    , i) / prim(IDN, k - 1, j    , i),
-                           prim(IPR, k - 1, j    , i) / prim(IDN, k - 1, j    , i) -
-                           prim(IPR, k - 1, j - 1, i) / prim(IDN, k - 1, j - 1, i)) /
+            limiters::lim4(T(0, k    , j + 1, i) - T(0, k    , j    , i),
+                           T(0, k    , j    , i) - T(0, k    , j - 1, i),
+                           T(0, k - 1, j + 1, i) - T(0, k - 1, j    , i),
+                           T(0, k - 1, j    , i) - T(0, k - 1, j - 1, i)) /
             coords.Dxc<2>(k, j, i);
         // clang-format on
 
-        const auto T_k = prim(IPR, k, j, i) / prim(IDN, k, j, i);
-        const auto T_km1 = prim(IPR, k - 1, j, i) / prim(IDN, k - 1, j, i);
+        const auto T_k = T(0, k, j, i);
+        const auto T_km1 = T(0, k - 1, j, i);
         const auto dTdz = (T_k - T_km1) / coords.Dxc<3>(k, j, i);
 
         const auto Bx = 0.5 * (prim(IB1, k - 1, j, i) + prim(IB1, k, j, i));
@@ -322,8 +320,8 @@ void ThermalFluxAniso(MeshData<Real> *md) {
         const auto gradTmag = sqrt(SQR(dTdx) + SQR(dTdy) + SQR(dTdz));
         const auto thermal_diff_f =
             0.5 *
-            (thermal_diff.Get(prim(IPR, k, j, i), prim(IDN, k, j, i), gradTmag) +
-             thermal_diff.Get(prim(IPR, k - 1, j, i), prim(IDN, k - 1, j, i), gradTmag));
+            (thermal_diff.Get(T(0, k, j, i), prim(IDN, k, j, i), gradTmag) +
+             thermal_diff.Get(T(0, k - 1, j, i), prim(IDN, k - 1, j, i), gradTmag));
 
         cons.flux(X3DIR, IEN, k, j, i) -= thermal_diff_f * denf * (Bz * bDotGradT) / B02;
       });
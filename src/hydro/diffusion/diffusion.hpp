@@ -80,7 +80,7 @@ struct ThermalDiffusivity {
       : coeff_(coeff), conduction_(conduction), mbar_over_kb_(mbar_over_kb) {}
 
   KOKKOS_INLINE_FUNCTION
-  Real Get(const Real pres, const Real rho, const Real gradTmag) const;
+  Real Get(const Real p_over_rho, const Real rho, const Real gradTmag) const;
 };
 
 Real EstimateConductionTimestep(MeshData<Real> *md);
@@ -88,4 +88,15 @@ Real EstimateConductionTimestep(MeshData<Real> *md);
 //! Calculate anisotropic thermal conduction
 void ThermalFluxAniso(MeshData<Real> *md);
 
+//! Number of RKL2 stages required to stably advance the diffusive terms by tau given
+//! the explicit diffusive timestep dt_diff
+int RKL2NumStages(const Real tau, const Real dt_diff);
+
+//! Calculate (only) the diffusive energy fluxes for the operator split integration
+TaskStatus CalcDiffFluxes(MeshData<Real> *md);
+
+//! Update of the total energy in stage `stage` of `s` of the RKL2 integrator
+TaskStatus RKL2StageUpdate(MeshData<Real> *md, const int stage, const int s,
+                           const Real tau);
+
 #endif //  HYDRO_DIFFUSION_DIFFUSION_HPP_
@@ -0,0 +1,119 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file sts.cpp
+//! \brief Operator split super-time-stepping (RKL2) of the diffusive fluxes following
+//! Meyer, Balsara & Aslam (2014) MNRAS 000, 1–16
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../../main.hpp"
+#include "diffusion.hpp"
+
+using namespace parthenon::package::prelude;
+
+namespace {
+// Coefficient b_j of the RKL2 scheme
+Real RKL2b(const int j) {
+  return j < 3 ? 1.0 / 3.0 : (SQR(j) + j - 2.0) / (2.0 * j * (j + 1.0));
+}
+} // namespace
+
+int RKL2NumStages(const Real tau, const Real dt_diff) {
+  // Stable for tau <= dt_diff * (s^2 + s - 2) / 4
+  const auto s =
+      static_cast<int>(std::ceil(0.5 * (std::sqrt(9.0 + 16.0 * tau / dt_diff) - 1.0)));
+  return std::max(s, 2);
+}
+
+TaskStatus CalcDiffFluxes(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto cons_pack = md->PackVariablesAndFluxes(flags_ind);
+  const int ndim = md->GetMeshPointer()->ndim;
+
+  // The diffusive fluxes are added to existing fluxes so only reset the energy fluxes
+  // (all other fluxes are not used in the update and remain untouched).
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  const int ju = ndim >= 2 ? jb.e + 1 : jb.e;
+  const int ku = ndim >= 3 ? kb.e + 1 : kb.e;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Reset diffusive fluxes", parthenon::DevExecSpace(), 0,
+      cons_pack.GetDim(5) - 1, kb.s, ku, jb.s, ju, ib.s, ib.e + 1,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &cons = cons_pack(b);
+        cons.flux(X1DIR, IEN, k, j, i) = 0.0;
+        if (ndim >= 2) {
+          cons.flux(X2DIR, IEN, k, j, i) = 0.0;
+        }
+        if (ndim >= 3) {
+          cons.flux(X3DIR, IEN, k, j, i) = 0.0;
+        }
+      });
+
+  if (hydro_pkg->Param<Conduction>("conduction") != Conduction::none) {
+    ThermalFluxAniso(md);
+  }
+  return TaskStatus::complete;
+}
+
+// Stage j (of s) of the RKL2 integrator with step size tau. The current stage Y_{j-1}
+// is stored in the total energy, and Y_0, Y_{j-2}, and M(Y_0) in separate fields.
+TaskStatus RKL2StageUpdate(MeshData<Real> *md, const int stage, const int s,
+                           const Real tau) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto cons_pack = md->PackVariablesAndFluxes(flags_ind);
+  auto reg_pack =
+      md->PackVariables(std::vector<std::string>{"rkl2_Y0", "rkl2_Yjm2", "rkl2_MY0"});
+  const int ndim = pmb->pmy_mesh->ndim;
+
+  const Real w1 = 4.0 / (SQR(s) + s - 2.0);
+  // Coefficients of the current stage (all but mu_tilde unused in the first stage)
+  const int n = stage;
+  const Real mu = n > 1 ? (2.0 * n - 1.0) / n * RKL2b(n) / RKL2b(n - 1) : 0.0;
+  const Real nu = n > 1 ? -(n - 1.0) / n * RKL2b(n) / RKL2b(n - 2) : 0.0;
+  const Real mu_tilde = n > 1 ? mu * w1 : RKL2b(1) * w1;
+  const Real gamma_tilde = n > 1 ? -(1.0 - RKL2b(n - 1)) * mu_tilde : 0.0;
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "RKL2StageUpdate", parthenon::DevExecSpace(), 0,
+      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &coords = cons_pack.GetCoords(b);
+        auto &cons = cons_pack(b);
+        auto &reg = reg_pack(b);
+        const Real Y_jm1 = cons(IEN, k, j, i);
+        const Real MY_jm1 =
+            parthenon::Update::FluxDivHelper(IEN, k, j, i, ndim, coords, cons);
+        if (n == 1) {
+          reg(0, k, j, i) = Y_jm1;
+          reg(1, k, j, i) = Y_jm1;
+          reg(2, k, j, i) = MY_jm1;
+          cons(IEN, k, j, i) = Y_jm1 + mu_tilde * tau * MY_jm1;
+        } else {
+          const Real Y0 = reg(0, k, j, i);
+          cons(IEN, k, j, i) = mu * Y_jm1 + nu * reg(1, k, j, i) +
+                               (1.0 - mu - nu) * Y0 + mu_tilde * tau * MY_jm1 +
+                               gamma_tilde * tau * reg(2, k, j, i);
+          reg(1, k, j, i) = Y_jm1;
+        }
+      });
+  return TaskStatus::complete;
+}
@@ -4,16 +4,67 @@
 // reserved. Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+// C++ headers
+#include <cmath>
+#include <string>
+#include <vector>
+
 // Parthenon headers
 #include <parthenon/package.hpp>
 
 // AthenaPK headers
 #include "../../main.hpp"
+#include "glmmhd.hpp"
 
 using namespace parthenon::package::prelude;
 
 namespace Hydro::GLMMHD {
 
+namespace {
+// Source terms of a single cell (see DednerSource below)
+template <bool extended, typename Cons_t, typename Prim_t, typename Coords_t>
+KOKKOS_FORCEINLINE_FUNCTION void DednerCellSource(Cons_t &cons, const Prim_t &prim,
+                                                  const Coords_t &coords, const int k,
+                                                  const int j, const int i,
+                                                  const int k_offset, const Real beta_dt,
+                                                  const Real coeff) {
+  // Use extended source terms that is non-conservative but has better
+  // stability properties as reported by Dedner+ and M&T
+  // TODO(pgrete) Once nvcc is fixed this could be constexpr if again
+  if (extended) {
+    const Real divB =
+        0.5 * ((prim(IB1, k, j, i + 1) - prim(IB1, k, j, i - 1)) /
+                   coords.template Dxc<1>(k, j, i) +
+               (prim(IB2, k, j + 1, i) - prim(IB2, k, j - 1, i)) /
+                   coords.template Dxc<2>(k, j, i) +
+               (prim(IB3, k + k_offset, j, i) - prim(IB3, k - k_offset, j, i)) /
+                   coords.template Dxc<3>(k, j, i));
+    cons(IM1, k, j, i) -= beta_dt * divB * prim(IB1, k, j, i);
+    cons(IM2, k, j, i) -= beta_dt * divB * prim(IB2, k, j, i);
+    cons(IM3, k, j, i) -= beta_dt * divB * prim(IB3, k, j, i);
+    cons(IEN, k, j, i) -=
+        0.5 * beta_dt *
+        (prim(IB1, k, j, i) * (prim(IPS, k, j, i + 1) - prim(IPS, k, j, i - 1)) /
+             coords.template Dxc<1>(k, j, i) +
+         prim(IB2, k, j, i) * (prim(IPS, k, j + 1, i) - prim(IPS, k, j - 1, i)) /
+             coords.template Dxc<2>(k, j, i) +
+         prim(IB3, k, j, i) *
+             (prim(IPS, k + k_offset, j, i) - prim(IPS, k - k_offset, j, i)) /
+             coords.template Dxc<3>(k, j, i));
+  }
+  cons(IPS, k, j, i) *= coeff;
+}
+
+// Using an alpha based parameter here following Mignone & Tzeferacos 2010 (27)
+Real DednerDampingCoeff(MeshData<Real> *md, const Real beta_dt) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto c_h = hydro_pkg->Param<Real>("c_h");
+  const auto mindx = hydro_pkg->Param<Real>("mindx");
+  const auto alpha = hydro_pkg->Param<Real>("glmmhd_alpha");
+  return std::exp(-alpha * c_h * beta_dt / mindx);
+}
+} // namespace
+
 template <bool extended>
 void DednerSource(MeshData<Real> *md, const Real beta_dt) {
   auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
@@ -23,13 +74,7 @@ void DednerSource(MeshData<Real> *md, const Real beta_dt) {
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  const auto c_h = hydro_pkg->Param<Real>("c_h");
-  const auto mindx = hydro_pkg->Param<Real>("mindx");
-  const auto alpha = hydro_pkg->Param<Real>("glmmhd_alpha");
-
-  // Using an alpha based parameter here following Mignone & Tzeferacos 2010 (27)
-  const auto coeff = std::exp(-alpha * c_h * beta_dt / mindx);
+  const auto coeff = DednerDampingCoeff(md, beta_dt);
 
   int k_offset = 1;
   // In 2D, offset is 0 so that the second order x3-derivatives are zero
@@ -43,37 +88,72 @@ void DednerSource(MeshData<Real> *md, const Real beta_dt) {
       DEFAULT_LOOP_PATTERN, "DednerSource", parthenon::DevExecSpace(), 0,
       cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
-        // Use extended source terms that is non-conservative but has better
-        // stability properties as reported by Dedner+ and M&T
-        // TODO(pgrete) Once nvcc is fixed this could be constexpr if again
-        if (extended) {
-          auto &cons = cons_pack(b);
-          const auto &prim = prim_pack(b);
-          const auto &coords = prim_pack.GetCoords(b);
-          const Real divB =
-              0.5 * ((prim(IB1, k, j, i + 1) - prim(IB1, k, j, i - 1)) /
-                         coords.Dxc<1>(k, j, i) +
-                     (prim(IB2, k, j + 1, i) - prim(IB2, k, j - 1, i)) /
-                         coords.Dxc<2>(k, j, i) +
-                     (prim(IB3, k + k_offset, j, i) - prim(IB3, k - k_offset, j, i)) /
-                         coords.Dxc<3>(k, j, i));
-          cons(IM1, k, j, i) -= beta_dt * divB * prim(IB1, k, j, i);
-          cons(IM2, k, j, i) -= beta_dt * divB * prim(IB2, k, j, i);
-          cons(IM3, k, j, i) -= beta_dt * divB * prim(IB3, k, j, i);
-          cons(IEN, k, j, i) -=
-              0.5 * beta_dt *
-              (prim(IB1, k, j, i) * (prim(IPS, k, j, i + 1) - prim(IPS, k, j, i - 1)) /
-                   coords.Dxc<1>(k, j, i) +
-               prim(IB2, k, j, i) * (prim(IPS, k, j + 1, i) - prim(IPS, k, j - 1, i)) /
-                   coords.Dxc<2>(k, j, i) +
-               prim(IB3, k, j, i) *
-                   (prim(IPS, k + k_offset, j, i) - prim(IPS, k - k_offset, j, i)) /
-                   coords.Dxc<3>(k, j, i));
-        }
-        cons_pack(b, IPS, k, j, i) *= coeff;
+        auto &cons = cons_pack(b);
+        DednerCellSource<extended>(cons, prim_pack(b), prim_pack.GetCoords(b), k, j, i,
+                                   k_offset, beta_dt, coeff);
       });
 }
 template void DednerSource<true>(MeshData<Real> *md, const Real beta_dt);
 template void DednerSource<false>(MeshData<Real> *md, const Real beta_dt);
 
-} // namespace Hydro::GLMMHD
\ No newline at end of file
+template <bool extended>
+TaskStatus UpdateWithFluxDivergence(MeshData<Real> *u0_data, const bool u1_required,
+                                    const Real gam0, const Real gam1, const Real beta_dt,
+                                    const bool first_stage) {
+  IndexRange ib = u0_data->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = u0_data->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = u0_data->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto u0_pack = u0_data->PackVariablesAndFluxes(flags_ind);
+  // In the first stage, the initial state is only stored if required.
+  const bool store_initial = first_stage && u1_required;
+  // cons is used as (never written) placeholder if the initial state is not required
+  auto u1_pack = u0_data->PackVariables(
+      std::vector<std::string>{u1_required ? "u1_cons" : "cons"});
+  const auto &prim_pack = u0_data->PackVariables(std::vector<std::string>{"prim"});
+
+  const auto coeff = DednerDampingCoeff(u0_data, beta_dt);
+  const int ndim = u0_data->GetMeshPointer()->ndim;
+  const int k_offset = ndim < 3 ? 0 : 1;
+  const int nvar = u0_pack.GetDim(4);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "GLMMHD::UpdateWithFluxDivergence", DevExecSpace(), 0,
+      u0_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &coords = u0_pack.GetCoords(b);
+        auto &u0 = u0_pack(b);
+        // Identical to UpdateWithFluxDivergence(FirstStage)...
+        for (int v = 0; v < nvar; v++) {
+          const auto flux_div =
+              parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0);
+          if (first_stage) {
+            const Real u_initial = u0(v, k, j, i);
+            if (store_initial) {
+              u1_pack(b, v, k, j, i) = u_initial;
+            }
+            u0(v, k, j, i) = u_initial + beta_dt * flux_div;
+          } else {
+            u0(v, k, j, i) = gam0 * u0(v, k, j, i) + gam1 * u1_pack(b, v, k, j, i) +
+                             beta_dt * flux_div;
+          }
+        }
+        // ... followed by the source terms (that only depend on prim of this stage)
+        DednerCellSource<extended>(u0, prim_pack(b), coords, k, j, i, k_offset, beta_dt,
+                                   coeff);
+      });
+  return TaskStatus::complete;
+}
+template TaskStatus UpdateWithFluxDivergence<true>(MeshData<Real> *u0_data,
+                                                   const bool u1_required,
+                                                   const Real gam0, const Real gam1,
+                                                   const Real beta_dt,
+                                                   const bool first_stage);
+template TaskStatus UpdateWithFluxDivergence<false>(MeshData<Real> *u0_data,
+                                                    const bool u1_required,
+                                                    const Real gam0, const Real gam1,
+                                                    const Real beta_dt,
+                                                    const bool first_stage);
+
+} // namespace Hydro::GLMMHD
@@ -21,6 +21,15 @@ void DednerSource(MeshData<Real> *md, const Real beta_dt);
 
 using SourceFun_t = std::function<void(MeshData<Real> *md, const Real beta_dt)>;
 
+// Update with the flux divergence (identical to Hydro::UpdateWithFluxDivergence or, in
+// the first stage, to UpdateWithFluxDivergenceFirstStage) fused with the
+// DednerSource so that the state is only read and written once per stage.
+template <bool extended>
+TaskStatus UpdateWithFluxDivergence(MeshData<Real> *u0_data, const bool u1_required,
+                                    const Real gam0, const Real gam1, const Real beta_dt,
+                                    const bool first_stage);
+using UpdateFun_t = decltype(UpdateWithFluxDivergence<false>);
+
 } // namespace Hydro::GLMMHD
 
 #endif // HYDRO_GLMMHD_GLMMHD_HPP_
@@ -4,12 +4,16 @@
 // Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+#include <array>
+#include <cstdint>
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 // Parthenon headers
+#include <Kokkos_Graph.hpp>
 #include <parthenon/package.hpp>
 
 // AthenaPK headers
@@ -23,19 +27,102 @@
 #include "../recon/ppm_simple.hpp"
 #include "../recon/weno3_simple.hpp"
 #include "../recon/wenoz_simple.hpp"
+#include "../recon/recon_all_vars.hpp"
 #include "../refinement/refinement.hpp"
 #include "../units.hpp"
+#include "../utils/async_output.hpp"
+#include "../utils/global_reductions.hpp"
+#include "../utils/memory_report.hpp"
+#include "../utils/partition_data.hpp"
+#include "../utils/task_timers.hpp"
+#include "autotune.hpp"
+#include "block_costs.hpp"
 #include "defs.hpp"
 #include "diffusion/diffusion.hpp"
+#include "flux_functions.hpp"
 #include "glmmhd/glmmhd.hpp"
 #include "hydro.hpp"
+#include "hydro_params.hpp"
 #include "outputs/outputs.hpp"
+#include "pack_size.hpp"
 #include "rsolvers/rsolvers.hpp"
 #include "srcterms/tabular_cooling.hpp"
 #include "utils/error_checking.hpp"
 
 using namespace parthenon::package::prelude;
 
+namespace Hydro {
+// History columns of the limiter counts (in the order of the Limiter enum)
+const std::array<std::string, num_limiters> limiter_count_keys = {
+    "num_dfloor", "num_vceil", "num_pfloor", "num_Tfloor", "num_Tceil"};
+
+// Quantities of the fused history reduction (in the order of the history columns)
+constexpr int num_fused_hst = 8;
+struct FusedHstSums {
+  Real vals[num_fused_hst];
+  KOKKOS_INLINE_FUNCTION FusedHstSums() {
+    for (int n = 0; n < num_fused_hst; n++) {
+      vals[n] = 0.0;
+    }
+  }
+  KOKKOS_INLINE_FUNCTION FusedHstSums &operator+=(const FusedHstSums &rhs) {
+    for (int n = 0; n < num_fused_hst; n++) {
+      vals[n] += rhs.vals[n];
+    }
+    return *this;
+  }
+};
+
+// Fused history sums of the partitions evaluated in the history output of cycle
+// `ncycle`. All entries are discarded once the history of another cycle is evaluated so
+// that the cache only holds the partitions of a single history output.
+struct FusedHstCache {
+  int ncycle = -1;
+  std::map<const MeshData<Real> *, FusedHstSums> sums;
+};
+
+// Work lists (reused across calls, one per partition) of the first order flux correction
+// containing the flattened indices of the cells corrected in the last attempt and of the
+// cells to be checked in the next attempt (the corrected cells and their face neighbors).
+// The stamps mark the cells already added to the current list of cells to be checked.
+struct FOFCWorkLists {
+  parthenon::ParArray1D<int> corrected_cells;
+  parthenon::ParArray1D<int> check_cells;
+  parthenon::ParArray1D<int> stamps;
+  Kokkos::View<int, parthenon::DevMemSpace> num_corrected_cells;
+  Kokkos::View<int, parthenon::DevMemSpace> num_check_cells;
+  int stamp = 0;
+};
+
+// Kokkos graphs of the tight flux kernels (hydro/flux_graph) of a partition, one per
+// flux function (e.g., the first order and the high order fluxes of the stages of vl2),
+// together with the blocks they were created for so that they are only recreated if the
+// blocks change. The divergence cleaning speed (which changes every cycle for GLM MHD)
+// is read by the kernels from a device scalar rather than captured by value.
+struct FluxGraph {
+  Kokkos::View<Real, parthenon::DevMemSpace> c_h;
+  Real c_h_host = std::numeric_limits<Real>::quiet_NaN(); // last value copied to c_h
+  std::vector<std::weak_ptr<MeshBlockData<Real>>> blocks;
+  std::map<FluxFun_t *, Kokkos::Experimental::Graph<parthenon::DevExecSpace>> graphs;
+};
+
+// Divergence cleaning speed passed by value to the tight flux kernels if they are
+// launched directly (the graphs use a device scalar, see FluxGraph)
+struct ConstCleaningSpeed {
+  Real c_h;
+  KOKKOS_INLINE_FUNCTION Real operator()() const { return c_h; }
+};
+} // namespace Hydro
+
+namespace Kokkos {
+template <>
+struct reduction_identity<Hydro::FusedHstSums> {
+  KOKKOS_FORCEINLINE_FUNCTION static Hydro::FusedHstSums sum() {
+    return Hydro::FusedHstSums();
+  }
+};
+} // namespace Kokkos
+
 // *************************************************//
 // define the "physics" package Hydro, which  *//
 // includes defining various functions that control*//
@@ -119,6 +206,81 @@ Real HydroHst(MeshData<Real> *md) {
   return sum;
 }
 
+// Calculates all Hydro history quantities (mass, momenta, KE, tot-E and, for MHD, ME
+// and relDivB) in a single kernel. Whichever column is evaluated first for the given
+// MeshData in a history output triggers the reduction and all other columns use the
+// cached results (see FusedHstCache).
+template <int idx>
+Real FusedHydroHst(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  auto &cache = *hydro_pkg->MutableParam<FusedHstCache>("fused_hst_cache");
+  const int ncycle = md->GetMeshPointer()->ncycle;
+  if (cache.ncycle != ncycle) {
+    cache.sums.clear();
+    cache.ncycle = ncycle;
+  }
+
+  auto cached = cache.sums.find(md);
+  if (cached == cache.sums.end()) {
+    const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+    const bool three_d = cons_pack.GetNdim() == 3;
+    const bool mhd = hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
+
+    IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+    FusedHstSums sums;
+    Kokkos::parallel_reduce(
+        "FusedHydroHst",
+        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+            DevExecSpace(), {0, kb.s, jb.s, ib.s},
+            {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+            {1, 1, 1, ib.e + 1 - ib.s}),
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                      FusedHstSums &lsums) {
+          const auto &cons = cons_pack(b);
+          const auto &coords = cons_pack.GetCoords(b);
+          const auto vol = coords.CellVolume(k, j, i);
+
+          lsums.vals[0] += cons(IDN, k, j, i) * vol;
+          lsums.vals[1] += cons(IM1, k, j, i) * vol;
+          lsums.vals[2] += cons(IM2, k, j, i) * vol;
+          lsums.vals[3] += cons(IM3, k, j, i) * vol;
+          lsums.vals[4] += 0.5 / cons(IDN, k, j, i) *
+                           (SQR(cons(IM1, k, j, i)) + SQR(cons(IM2, k, j, i)) +
+                            SQR(cons(IM3, k, j, i))) *
+                           vol;
+          lsums.vals[5] += cons(IEN, k, j, i) * vol;
+          if (mhd) {
+            const Real b_sqr = SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
+                               SQR(cons(IB3, k, j, i));
+            lsums.vals[6] += 0.5 * b_sqr * vol;
+            // relative divergence of B error, see HydroHst
+            Real divb = (cons(IB1, k, j, i + 1) - cons(IB1, k, j, i - 1)) /
+                            coords.Dxc<1>(k, j, i) +
+                        (cons(IB2, k, j + 1, i) - cons(IB2, k, j - 1, i)) /
+                            coords.Dxc<2>(k, j, i);
+            if (three_d) {
+              divb += (cons(IB3, k + 1, j, i) - cons(IB3, k - 1, j, i)) /
+                      coords.Dxc<3>(k, j, i);
+            }
+            const Real abs_b = std::sqrt(b_sqr);
+            lsums.vals[7] += (abs_b != 0) ? 0.5 *
+                                                (std::sqrt(SQR(coords.Dxc<1>(k, j, i)) +
+                                                           SQR(coords.Dxc<2>(k, j, i)) +
+                                                           SQR(coords.Dxc<3>(k, j, i)))) *
+                                                std::abs(divb) / abs_b * vol
+                                          : 0;
+          }
+        },
+        Kokkos::Sum<FusedHstSums>(sums));
+    cached = cache.sums.emplace(md, sums).first;
+  }
+
+  return cached->second.vals[idx];
+}
+
 // TOOD(pgrete) check is we can enlist this with FillDerived directly
 // this is the package registered function to fill derived, here, convert the
 // conserved variables to primitives
@@ -138,8 +300,10 @@ void ConsToPrim(MeshData<Real> *md) {
 // as the "cons" variables have already been updated when this function is called.
 TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real beta_dt) {
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &params = hydro_pkg->Param<HydroParams>("hydro_params");
 
-  if (hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd) {
+  // Otherwise already applied as part of the flux divergence update
+  if (params.fluid == Fluid::glmmhd && !params.glmmhd_fused_update) {
     hydro_pkg->Param<GLMMHD::SourceFun_t>("glmmhd_source")(md, beta_dt);
   }
   if (ProblemSourceUnsplit != nullptr) {
@@ -152,7 +316,8 @@ TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real b
 TaskStatus AddSplitSourcesFirstOrder(MeshData<Real> *md, const SimTime &tm) {
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
-  const auto &enable_cooling = hydro_pkg->Param<Cooling>("enable_cooling");
+  const auto &enable_cooling =
+      hydro_pkg->Param<HydroParams>("hydro_params").enable_cooling;
 
   if (enable_cooling == Cooling::tabular) {
     const TabularCooling &tabular_cooling =
@@ -184,6 +349,32 @@ TaskStatus AddSplitSourcesStrang(MeshData<Real> *md, const SimTime &tm) {
   return TaskStatus::complete;
 }
 
+void PreparePartitionData(StateDescriptor *pkg, parthenon::Mesh *pmesh) {
+  if (pkg->AllParams().hasKey("fofc_work_lists")) {
+    pkg->MutableParam<utils::PartitionData<FOFCWorkLists>>("fofc_work_lists")
+        ->Prepare(pmesh);
+  }
+  if (pkg->AllParams().hasKey("flux_graphs")) {
+    pkg->MutableParam<utils::PartitionData<FluxGraph>>("flux_graphs")->Prepare(pmesh);
+  }
+  if (pkg->AllParams().hasKey("cooling_work_lists")) {
+    pkg->MutableParam<utils::PartitionData<cooling::CoolingWorkLists>>(
+           "cooling_work_lists")
+        ->Prepare(pmesh);
+  }
+  // Blocks the cached fields of the cluster problem generator were filled for
+  if (pkg->AllParams().hasKey("gravity_partition_signatures")) {
+    pkg->MutableParam<utils::PartitionData<std::vector<Real>>>(
+           "gravity_partition_signatures")
+        ->Prepare(pmesh);
+  }
+  if (pkg->AllParams().hasKey("snia_partition_signatures")) {
+    pkg->MutableParam<utils::PartitionData<std::vector<Real>>>(
+           "snia_partition_signatures")
+        ->Prepare(pmesh);
+  }
+}
+
 std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   auto pkg = std::make_shared<StateDescriptor>("Hydro");
 
@@ -193,6 +384,27 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   bool pack_in_one = pin->GetOrAddBoolean("parthenon/mesh", "pack_in_one", true);
   pkg->AddParam<>("pack_in_one", pack_in_one);
 
+  // Registry for scalar global reductions (e.g., for c_h or AGN triggering) that are
+  // reduced with a single MPI call in the first stage of each cycle.
+  pkg->AddParam<>("global_reductions", utils::GlobalReductions(), true);
+
+  // Rank local statistics (e.g., of the cooling subcycling) that are accumulated over the
+  // partitions during each cycle (like the global reductions, but not reduced over all
+  // ranks), reported in the history output, and reset at the beginning of each cycle.
+  pkg->AddParam<>("cycle_counters", utils::GlobalReductions(), true);
+
+  // Named profiling regions (and optional timers) of all tasks added by the driver
+  pkg->AddParam<>("task_timers", utils::TaskTimers(pin), true);
+
+  // Snapshots of selected fields written by a background thread (if enabled)
+  pkg->AddParam<>("async_output", std::make_shared<utils::AsyncOutput>(pin));
+
+  // Per block cost estimates for the load balancing
+  InitBlockCosts(pin, pkg.get());
+
+  // Number of blocks per partition (optionally chosen from the device concurrency)
+  InitPackSize(pin, pkg.get());
+
   const auto fluid_str = pin->GetOrAddString("hydro", "fluid", "euler");
   auto fluid = Fluid::undefined;
   bool calc_c_h = false; // calculate hyperbolic divergence cleaning speed
@@ -209,8 +421,12 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
         pin->GetOrAddString("hydro", "glmmhd_source", "dedner_plain");
     if (glmmhd_source_str == "dedner_plain") {
       pkg->AddParam<GLMMHD::SourceFun_t>("glmmhd_source", GLMMHD::DednerSource<false>);
+      pkg->AddParam<GLMMHD::UpdateFun_t *>("glmmhd_update_fun",
+                                           GLMMHD::UpdateWithFluxDivergence<false>);
     } else if (glmmhd_source_str == "dedner_extended") {
       pkg->AddParam<GLMMHD::SourceFun_t>("glmmhd_source", GLMMHD::DednerSource<true>);
+      pkg->AddParam<GLMMHD::UpdateFun_t *>("glmmhd_update_fun",
+                                           GLMMHD::UpdateWithFluxDivergence<true>);
     } else {
       PARTHENON_FAIL("AthenaPK hydro: Unknown glmmhd_source");
     }
@@ -221,14 +437,25 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     pkg->AddParam<Real>("c_h", 0.0, true); // hyperbolic divergence cleaning speed
     // global minimum dx (used to calc c_h)
     pkg->AddParam<Real>("mindx", std::numeric_limits<Real>::max(), true);
+    // finest mesh level for which mindx has been calculated (-1 if not calculated yet)
+    pkg->AddParam<int>("mindx_level", -1, true);
     // hyperbolic timestep constraint
     pkg->AddParam<Real>("dt_hyp", std::numeric_limits<Real>::max(), true);
+    auto *global_reductions =
+        pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+    global_reductions->Register("mindx", utils::ReductionOp::min);
+    global_reductions->Register("dt_hyp", utils::ReductionOp::min);
   } else {
     PARTHENON_FAIL("AthenaPK hydro: Unknown fluid method.");
   }
   pkg->AddParam<>("fluid", fluid);
   pkg->AddParam<>("nhydro", nhydro);
   pkg->AddParam<>("calc_c_h", calc_c_h);
+  // Fuse the Dedner source with the flux divergence update (identical results)
+  const auto glmmhd_fused_update =
+      fluid == Fluid::glmmhd &&
+      pin->GetOrAddBoolean("hydro", "glmmhd_fused_update", false);
+  pkg->AddParam<>("glmmhd_fused_update", glmmhd_fused_update);
 
   const auto recon_str = pin->GetString("hydro", "reconstruction");
   int recon_need_nghost = 3; // largest number for the choices below
@@ -251,11 +478,26 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   } else if (recon_str == "wenoz") {
     recon = Reconstruction::wenoz;
     recon_need_nghost = 3;
+  } else if (recon_str == "hybrid_ppm") {
+    recon = Reconstruction::hybrid_ppm;
+    recon_need_nghost = 3;
+  } else if (recon_str == "hybrid_wenoz") {
+    recon = Reconstruction::hybrid_wenoz;
+    recon_need_nghost = 3;
   } else {
     PARTHENON_FAIL("AthenaPK hydro: Unknown reconstruction method.");
   }
   // Adding recon independently of flux function pointer as it's used in 3D flux func.
   pkg->AddParam<>("reconstruction", recon);
+  // Indicator of the hybrid reconstructions, see recon/hybrid_simple.hpp
+  if (IsHybridReconstruction(recon)) {
+    pkg->AddParam<>("hybrid_recon_threshold",
+                    pin->GetOrAddReal("hydro", "hybrid_recon_threshold", 0.01));
+    // Count the cells using each method (in a separate kernel) for the history
+    const auto hybrid_recon_hst =
+        pin->GetOrAddBoolean("hydro", "hybrid_recon_hst", false);
+    pkg->AddParam<>("hybrid_recon_hst", hybrid_recon_hst);
+  }
 
   // Use hyperbolic timestep constraint by default
   bool calc_dt_hyp = true;
@@ -271,6 +513,16 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     riemann = RiemannSolver::hllc;
   } else if (riemann_str == "hlld") {
     riemann = RiemannSolver::hlld;
+  } else if (riemann_str == "hlld_branchless") {
+    riemann = RiemannSolver::hlld_branchless;
+  } else if (riemann_str == "hybrid_hllc") {
+    riemann = RiemannSolver::hybrid_hllc;
+    PARTHENON_REQUIRE(fluid == Fluid::euler,
+                      "hybrid_hllc Riemann solver only implemented for euler fluid.")
+  } else if (riemann_str == "hybrid_hlld") {
+    riemann = RiemannSolver::hybrid_hlld;
+    PARTHENON_REQUIRE(fluid == Fluid::glmmhd,
+                      "hybrid_hlld Riemann solver only implemented for glmmhd fluid.")
   } else if (riemann_str == "none") {
     riemann = RiemannSolver::none;
     // If hyperbolic fluxes are disabled, there's no restriction from those
@@ -284,6 +536,19 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   }
   pkg->AddParam<>("riemann", riemann);
 
+  // Indicator of the hybrid Riemann solvers, see rsolvers/hybrid.hpp
+  const bool hybrid_riemann =
+      riemann == RiemannSolver::hybrid_hllc || riemann == RiemannSolver::hybrid_hlld;
+  if (hybrid_riemann) {
+    pkg->AddParam<>("hybrid_pressure_jump",
+                    pin->GetOrAddReal("hydro", "hybrid_pressure_jump", 0.1));
+    pkg->AddParam<>("hybrid_mach", pin->GetOrAddReal("hydro", "hybrid_mach", 1.0));
+    pkg->AddParam<>("hybrid_beta", pin->GetOrAddReal("hydro", "hybrid_beta", 10.0));
+    // Count the interfaces using each solver (in a separate kernel) for the history
+    const auto hybrid_hst = pin->GetOrAddBoolean("hydro", "hybrid_hst", false);
+    pkg->AddParam<>("hybrid_hst", hybrid_hst);
+  }
+
   // Set calculation of hyperbolic timestep. Input file option takes precedence.
   if (pin->DoesParameterExist("hydro", "calc_dt_hyp")) {
     calc_dt_hyp = pin->GetBoolean("hydro", "calc_dt_hyp");
@@ -294,66 +559,170 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   const auto max_dt = pin->GetOrAddReal("hydro", "max_dt", -1.0);
   pkg->AddParam<>("max_dt", max_dt);
 
+  // Kernel used to calculate the hyperbolic fluxes
+  const auto flux_kernel_str = pin->GetOrAddString("hydro", "flux_kernel", "scratch");
+  auto flux_kernel = FluxKernel::undefined;
+  if (flux_kernel_str == "scratch") {
+    flux_kernel = FluxKernel::scratch;
+  } else if (flux_kernel_str == "fused") {
+    flux_kernel = FluxKernel::fused;
+  } else if (flux_kernel_str == "tight") {
+    flux_kernel = FluxKernel::tight;
+  } else {
+    PARTHENON_FAIL(
+        "AthenaPK hydro: Unknown flux_kernel. Options are: scratch, fused, tight");
+  }
+  // If enabled, the flux kernel, the scratch level (and thus the flux functions) are
+  // selected at runtime during the first cycles, see autotune.hpp.
+  const auto autotune = pin->GetOrAddBoolean("hydro", "autotune", false);
+  pkg->AddParam<>("autotune", autotune);
+  pkg->AddParam<>("flux_kernel", flux_kernel, autotune);
+
+  // Launch the kernels of the tight flux calculation as a single (cached) Kokkos graph
+  const auto flux_graph = pin->GetOrAddBoolean("hydro", "flux_graph", false);
+  pkg->AddParam<>("flux_graph", flux_graph);
+  if (flux_graph) {
+    pkg->AddParam<>("flux_graphs", utils::PartitionData<FluxGraph>(), true);
+  }
+
+  // Store reconstructed states in single precision (Riemann fluxes and update remain in
+  // full precision).
+  const auto mixed_precision = pin->GetOrAddBoolean("hydro", "mixed_precision", false);
+#ifndef ATHENAPK_ENABLE_MIXED_PRECISION
+  if (mixed_precision) {
+    PARTHENON_FAIL("AthenaPK hydro: mixed_precision requested but not compiled in. "
+                   "Reconfigure with -DAthenaPK_ENABLE_MIXED_PRECISION=ON.");
+  }
+#endif
+  if (mixed_precision && flux_kernel != FluxKernel::scratch) {
+    PARTHENON_FAIL("AthenaPK hydro: mixed_precision is only supported with "
+                   "flux_kernel=scratch.");
+  }
+  pkg->AddParam<>("mixed_precision", mixed_precision);
+
+  // Reconstruct all variables of a cell in a single inner loop (rather than one inner
+  // loop per variable) in the scratch and fused flux kernels. Identical results.
+  const auto reconstruct_all_vars =
+      pin->GetOrAddBoolean("hydro", "reconstruct_all_vars", false);
+  pkg->AddParam<>("reconstruct_all_vars", reconstruct_all_vars);
+
+  // Cache a rolling window of the input pencils in scratch memory in the x2 and x3
+  // sweeps of the scratch flux kernel so that each pencil is only loaded once per sweep.
+  const auto transverse_stencil_cache =
+      pin->GetOrAddBoolean("hydro", "transverse_stencil_cache", false);
+  pkg->AddParam<>("transverse_stencil_cache", transverse_stencil_cache);
+
   // Map contaning all compiled in flux functions
-  std::map<std::tuple<Fluid, Reconstruction, RiemannSolver>, FluxFun_t *>
-      flux_functions{};
-  // TODO(?) The following line could potentially be set by configure-time options
-  // so that the resulting binary can only contain a subset of included flux functions
-  // to reduce size.
-  add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::none>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::plm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::ppm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::weno3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::limo3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::wenoz, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::dc, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::plm, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::ppm, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::weno3, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::limo3, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::euler, Reconstruction::wenoz, RiemannSolver::hllc>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::dc, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::dc, RiemannSolver::none>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::plm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::ppm, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::weno3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::limo3, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::wenoz, RiemannSolver::hlle>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::dc, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::plm, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::ppm, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::weno3, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::limo3, RiemannSolver::hlld>(flux_functions);
-  add_flux_fun<Fluid::glmmhd, Reconstruction::wenoz, RiemannSolver::hlld>(flux_functions);
+  std::map<FluxFunKey_t, FluxFun_t *> flux_functions{};
+  std::map<CountFunKey_t, FluxFun_t *> count_functions{};
+  // Only the subset of flux functions selected at configure time (see
+  // AthenaPK_FLUX_VARIANTS CMake option) is compiled in to reduce binary size.
+  AddCompiledFluxFunctions(flux_functions, count_functions);
   // Add first order recon with LLF fluxes (implemented for testing as tight loop)
-  flux_functions[std::make_tuple(Fluid::euler, Reconstruction::dc, RiemannSolver::llf)] =
-      Hydro::CalculateFluxesTight<Fluid::euler>;
-  flux_functions[std::make_tuple(Fluid::glmmhd, Reconstruction::dc, RiemannSolver::llf)] =
-      Hydro::CalculateFluxesTight<Fluid::glmmhd>;
+  // which is used independent of the chosen flux kernel.
+  // The tight loop does not use scratch memory so mixed precision is a no-op.
+  for (const auto kernel : {FluxKernel::scratch, FluxKernel::fused, FluxKernel::tight}) {
+    for (const auto mixed : {false, true}) {
+      flux_functions[std::make_tuple(Fluid::euler, Reconstruction::dc, RiemannSolver::llf,
+                                     kernel, mixed)] =
+          Hydro::CalculateFluxesTight<Fluid::euler, Reconstruction::dc,
+                                      RiemannSolver::llf>;
+      flux_functions[std::make_tuple(Fluid::glmmhd, Reconstruction::dc,
+                                     RiemannSolver::llf, kernel, mixed)] =
+          Hydro::CalculateFluxesTight<Fluid::glmmhd, Reconstruction::dc,
+                                      RiemannSolver::llf>;
+    }
+  }
+#ifdef ATHENAPK_ENABLE_FLUX_KERNEL_TIGHT
+  flux_functions[std::make_tuple(Fluid::euler, Reconstruction::dc, RiemannSolver::llf,
+                                 FluxKernel::tight_boundary, false)] =
+      Hydro::CalculateFluxesTight<Fluid::euler, Reconstruction::dc, RiemannSolver::llf,
+                                  true>;
+  flux_functions[std::make_tuple(Fluid::glmmhd, Reconstruction::dc, RiemannSolver::llf,
+                                 FluxKernel::tight_boundary, false)] =
+      Hydro::CalculateFluxesTight<Fluid::glmmhd, Reconstruction::dc, RiemannSolver::llf,
+                                  true>;
+#endif
 
   // flux used in all stages expect the first. First stage is set below based on integr.
   FluxFun_t *flux_other_stage = nullptr;
-  flux_other_stage = flux_functions.at(std::make_tuple(fluid, recon, riemann));
+  const auto flux_key =
+      std::make_tuple(fluid, recon, riemann, flux_kernel, mixed_precision);
+  if (flux_functions.count(flux_key) == 0) {
+    PARTHENON_FAIL("AthenaPK hydro: Combination of fluid '" + fluid_str +
+                   "', reconstruction '" + recon_str + "', and Riemann solver '" +
+                   riemann_str + "' with flux kernel '" + flux_kernel_str +
+                   "' is not compiled in. Reconfigure with the combination "
+                   "added to the AthenaPK_FLUX_VARIANTS and the kernel added to the "
+                   "AthenaPK_FLUX_KERNELS CMake options.");
+  }
+  flux_other_stage = flux_functions.at(flux_key);
 
   parthenon::HstVar_list hst_vars = {};
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IDN>, "mass"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IM1>, "1-mom"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IM2>, "2-mom"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IM3>, "3-mom"));
-  hst_vars.emplace_back(
-      HistoryOutputVar(parthenon::UserHistoryOperation::sum, HydroHst<Hst::ekin>, "KE"));
-  hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                         HydroHst<Hst::idx, IEN>, "tot-E"));
-  if (fluid == Fluid::glmmhd) {
+  // Evaluate all default history quantities in a single kernel (identical results up to
+  // roundoff).
+  const auto fused_hst = pin->GetOrAddBoolean("hydro", "fused_hst", false);
+  if (fused_hst) {
+    pkg->AddParam<>("fused_hst_cache", FusedHstCache(), true);
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           FusedHydroHst<0>, "mass"));
     hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                           HydroHst<Hst::emag>, "ME"));
+                                           FusedHydroHst<1>, "1-mom"));
     hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
-                                           HydroHst<Hst::divb>, "relDivB"));
+                                           FusedHydroHst<2>, "2-mom"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           FusedHydroHst<3>, "3-mom"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           FusedHydroHst<4>, "KE"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           FusedHydroHst<5>, "tot-E"));
+    if (fluid == Fluid::glmmhd) {
+      hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                             FusedHydroHst<6>, "ME"));
+      hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                             FusedHydroHst<7>, "relDivB"));
+    }
+  } else {
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IDN>, "mass"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IM1>, "1-mom"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IM2>, "2-mom"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IM3>, "3-mom"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::ekin>, "KE"));
+    hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                           HydroHst<Hst::idx, IEN>, "tot-E"));
+    if (fluid == Fluid::glmmhd) {
+      hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                             HydroHst<Hst::emag>, "ME"));
+      hst_vars.emplace_back(HistoryOutputVar(parthenon::UserHistoryOperation::sum,
+                                             HydroHst<Hst::divb>, "relDivB"));
+    }
+  }
+  if (hybrid_riemann && pkg->Param<bool>("hybrid_hst")) {
+    // Number of interfaces using the HLLE and the accurate solver in the current cycle
+    // (see "cycle_counters").
+    auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+    for (const auto &key : {"riemann_hlle_interfaces", "riemann_accurate_interfaces"}) {
+      pkg->AddParam<Real>(key, 0.0, true);
+      cycle_counters->Register(key, utils::ReductionOp::sum, false);
+      hst_vars.emplace_back(utils::AccumulatedParamHstVar(
+          parthenon::UserHistoryOperation::sum, "Hydro", "cycle_counters", key));
+    }
+  }
+  if (IsHybridReconstruction(recon) && pkg->Param<bool>("hybrid_recon_hst")) {
+    // Number of cell reconstructions (all directions) using PLM and the high order
+    // method in the current cycle (see "cycle_counters").
+    auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+    for (const auto &key : {"recon_plm_cells", "recon_high_order_cells"}) {
+      pkg->AddParam<Real>(key, 0.0, true);
+      cycle_counters->Register(key, utils::ReductionOp::sum, false);
+      hst_vars.emplace_back(utils::AccumulatedParamHstVar(
+          parthenon::UserHistoryOperation::sum, "Hydro", "cycle_counters", key));
+    }
   }
   pkg->AddParam<>(parthenon::hist_param_key, hst_vars, true);
 
@@ -363,6 +732,18 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     PARTHENON_FAIL("AthenaPK hydro: Need more ghost zones for chosen reconstruction.");
   }
 
+  // Halo of the conversion to primitive variables. The reconstruction (and the
+  // refinement criteria and diffusive fluxes) only access the first ghost zones so that
+  // the outer ones may be skipped (negative value: convert all ghost zones).
+  const auto cons_to_prim_nghost =
+      pin->GetOrAddInteger("hydro", "cons_to_prim_nghost", -1);
+  PARTHENON_REQUIRE_THROWS(cons_to_prim_nghost < 0 ||
+                               (cons_to_prim_nghost >= recon_need_nghost &&
+                                cons_to_prim_nghost <= nghost),
+                           "AthenaPK hydro: cons_to_prim_nghost needs to be between the "
+                           "number of ghost zones of the reconstruction and nghost.");
+  pkg->AddParam<>("cons_to_prim_nghost", cons_to_prim_nghost);
+
   const auto integrator_str = pin->GetString("parthenon/time", "integrator");
   auto integrator = Integrator::undefined;
   FluxFun_t *flux_first_stage = flux_other_stage;
@@ -376,12 +757,104 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   } else if (integrator_str == "vl2") {
     integrator = Integrator::vl2;
     // override first stage (predictor) to first order
-    flux_first_stage =
-        flux_functions.at(std::make_tuple(fluid, Reconstruction::dc, riemann));
+    const auto flux_key_dc =
+        std::make_tuple(fluid, Reconstruction::dc, riemann, flux_kernel, mixed_precision);
+    if (flux_functions.count(flux_key_dc) == 0) {
+      PARTHENON_FAIL("AthenaPK hydro: vl2 integrator requires the combination of "
+                     "fluid '" +
+                     fluid_str + "', reconstruction 'dc', and Riemann solver '" +
+                     riemann_str +
+                     "' with flux kernel '" + flux_kernel_str +
+                     "', which is not compiled in. Reconfigure with the combination "
+                     "added to the AthenaPK_FLUX_VARIANTS and the kernel added to the "
+                     "AthenaPK_FLUX_KERNELS CMake options.");
+    }
+    flux_first_stage = flux_functions.at(flux_key_dc);
   }
   pkg->AddParam<>("integrator", integrator);
-  pkg->AddParam<FluxFun_t *>("flux_first_stage", flux_first_stage);
-  pkg->AddParam<FluxFun_t *>("flux_other_stage", flux_other_stage);
+  pkg->AddParam<FluxFun_t *>("flux_first_stage", flux_first_stage, autotune);
+  pkg->AddParam<FluxFun_t *>("flux_other_stage", flux_other_stage, autotune);
+  // The hybrid reconstructions are not used in the (first order) predictor step of vl2
+  if (IsHybridReconstruction(recon) && pkg->Param<bool>("hybrid_recon_hst")) {
+    pkg->AddParam<>("hybrid_recon_count_first_stage", integrator != Integrator::vl2);
+  }
+  if (hybrid_riemann && pkg->Param<bool>("hybrid_hst")) {
+    // Identical variants as the flux functions (which exist at this point)
+    const auto recon_first_stage =
+        integrator == Integrator::vl2 ? Reconstruction::dc : recon;
+    pkg->AddParam<FluxFun_t *>(
+        "hybrid_count_first_stage",
+        count_functions.at(std::make_tuple(fluid, recon_first_stage, riemann)));
+    pkg->AddParam<FluxFun_t *>(
+        "hybrid_count_other_stage",
+        count_functions.at(std::make_tuple(fluid, recon, riemann)));
+  }
+
+  // Calculate the fluxes on the block faces first so that the communication for the
+  // flux correction (with mesh refinement) overlaps with the calculation of all fluxes.
+  const auto overlap_flux_correction =
+      pin->GetOrAddBoolean("hydro", "overlap_flux_correction", false);
+  pkg->AddParam<>("overlap_flux_correction", overlap_flux_correction);
+  if (overlap_flux_correction) {
+    const auto recon_first_stage =
+        integrator == Integrator::vl2 ? Reconstruction::dc : recon;
+    const auto flux_key_bnd_first = std::make_tuple(
+        fluid, recon_first_stage, riemann, FluxKernel::tight_boundary, false);
+    const auto flux_key_bnd_other =
+        std::make_tuple(fluid, recon, riemann, FluxKernel::tight_boundary, false);
+    // Boundary flux functions are part of the tight flux kernel
+    PARTHENON_REQUIRE_THROWS(flux_functions.count(flux_key_bnd_first) > 0 &&
+                                 flux_functions.count(flux_key_bnd_other) > 0,
+                             "Missing boundary flux function for overlapping flux "
+                             "correction. Reconfigure with 'tight' added to the "
+                             "AthenaPK_FLUX_KERNELS CMake option.");
+    pkg->AddParam<FluxFun_t *>("flux_boundary_first_stage",
+                               flux_functions.at(flux_key_bnd_first));
+    pkg->AddParam<FluxFun_t *>("flux_boundary_other_stage",
+                               flux_functions.at(flux_key_bnd_other));
+  }
+
+  // Ghost zone exchange using Parthenon's default tasks (parthenon), with separate tasks
+  // for local (same rank) and nonlocal neighbors (split), or with a single set of tasks
+  // for all neighbors (combined).
+  const auto boundary_exchange_str =
+      pin->GetOrAddString("hydro", "boundary_exchange", "parthenon");
+  auto boundary_exchange = BoundaryExchange::undefined;
+  if (boundary_exchange_str == "parthenon") {
+    boundary_exchange = BoundaryExchange::parthenon;
+  } else if (boundary_exchange_str == "split") {
+    boundary_exchange = BoundaryExchange::split;
+  } else if (boundary_exchange_str == "combined") {
+    boundary_exchange = BoundaryExchange::combined;
+  } else {
+    PARTHENON_FAIL("AthenaPK hydro: Unknown boundary_exchange. Options are: parthenon, "
+                   "split, combined");
+  }
+  // The custom exchanges do not prolongate ghost zones from coarser neighbors
+  PARTHENON_REQUIRE_THROWS(
+      boundary_exchange == BoundaryExchange::parthenon ||
+          pin->GetOrAddString("parthenon/mesh", "refinement", "none") == "none",
+      "AthenaPK hydro: boundary_exchange = split and combined are only supported without "
+      "mesh refinement.");
+  pkg->AddParam<>("boundary_exchange", boundary_exchange);
+  // Measure the (exposed) time of the ghost zone exchange. For benchmarking only as this
+  // separates the exchange from the remaining tasks.
+  const auto time_boundary_exchange =
+      pin->GetOrAddBoolean("hydro", "time_boundary_exchange", false);
+  pkg->AddParam<>("time_boundary_exchange", time_boundary_exchange);
+  if (time_boundary_exchange) {
+    pkg->AddParam<Real>("boundary_exchange_start", 0.0, true);
+    pkg->AddParam<Real>("boundary_exchange_time", 0.0, true);
+  }
+
+  // Store the initial state in u1 as part of the first stage update (rather than copying
+  // the entire state before the first stage).
+  const auto fused_u1_init = pin->GetOrAddBoolean("hydro", "fused_u1_init", false);
+  pkg->AddParam<>("fused_u1_init", fused_u1_init);
+  // Single stage integrators only require u1 if it is not stored by the update
+  pkg->AddParam<>("u1_required", !fused_u1_init || integrator != Integrator::rk1);
+  // Memory used by u1 (see "u1_cons" below and HydroDriver)
+  pkg->AddParam<std::int64_t>("u1_bytes", -1, true);
 
   auto first_order_flux_correct =
       pin->GetOrAddBoolean("hydro", "first_order_flux_correct", false);
@@ -394,6 +867,42 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
       pkg->AddParam<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun",
                                                   FirstOrderFluxCorrect<Fluid::glmmhd>);
     }
+    // Correct fluxes in every stage or only in the final stage (based on the initial
+    // state, which requires storing the initial primitive variables in u1).
+    const auto fofc_stages_str =
+        pin->GetOrAddString("hydro", "first_order_flux_correct_stages", "all");
+    bool fofc_final_stage_only = false;
+    if (fofc_stages_str == "final") {
+      // Only for those integrators the final stage is an update of the initial state
+      // (gam0 = 0, gam1 = 1, beta = 1) so that the corrected update is first order.
+      if (integrator != Integrator::vl2 && integrator != Integrator::rk1) {
+        PARTHENON_FAIL("AthenaPK hydro: first_order_flux_correct_stages = final is only "
+                       "supported with the vl2 and rk1 integrators.");
+      }
+      fofc_final_stage_only = true;
+    } else if (fofc_stages_str != "all") {
+      PARTHENON_FAIL("AthenaPK hydro: Unknown first_order_flux_correct_stages. Options "
+                     "are: all, final");
+    }
+    pkg->AddParam<>("fofc_final_stage_only", fofc_final_stage_only);
+    // Recheck only the previously corrected cells and their neighbors in subsequent
+    // attempts (or all cells, which is only kept as a reference).
+    pkg->AddParam<>("fofc_use_work_list",
+                    pin->GetOrAddBoolean("hydro", "first_order_flux_correct_work_list",
+                                         true));
+    pkg->AddParam<>("fofc_work_lists", utils::PartitionData<FOFCWorkLists>(), true);
+
+    // Number of cells corrected (or relying on floors after correction) in the current
+    // cycle (see "cycle_counters").
+    auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+    auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+    for (const auto &key : {"fofc_num_corrected", "fofc_num_need_floor"}) {
+      pkg->AddParam<Real>(key, 0.0, true);
+      cycle_counters->Register(key, utils::ReductionOp::sum, false);
+      hst_vars.emplace_back(utils::AccumulatedParamHstVar(
+          parthenon::UserHistoryOperation::sum, "Hydro", "cycle_counters", key));
+    }
+    pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
   }
 
   if (pin->DoesBlockExist("units")) {
@@ -484,16 +993,78 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     }
     pkg->AddParam<>("conduction", conduction);
 
+    // Diffusive terms are either added to the hyperbolic fluxes (unsplit), or operator
+    // split and integrated with RKL2 super-time-stepping so that the global timestep is
+    // not restricted by the (parabolic) diffusive timestep.
+    auto diffint = DiffInt::none;
+    if (conduction != Conduction::none) {
+      const auto diffint_str = pin->GetOrAddString("diffusion", "integrator", "unsplit");
+      if (diffint_str == "unsplit") {
+        diffint = DiffInt::unsplit;
+      } else if (diffint_str == "rkl2") {
+        diffint = DiffInt::rkl2;
+        // Optionally restrict the ratio of global to diffusive timestep (and, thus, the
+        // number of RKL2 stages). Non-positive values disable the restriction.
+        const auto rkl2_max_dt_ratio =
+            pin->GetOrAddReal("diffusion", "rkl2_max_dt_ratio", -1.0);
+        pkg->AddParam<>("rkl2_max_dt_ratio", rkl2_max_dt_ratio);
+        // (explicit) diffusive timestep constraint, which is accumulated over the
+        // partitions like the global reductions but reduced separately (see driver)
+        pkg->AddParam<Real>("dt_diff", std::numeric_limits<Real>::max(), true);
+        pkg->MutableParam<utils::GlobalReductions>("global_reductions")
+            ->Register("dt_diff", utils::ReductionOp::min, false);
+      } else {
+        PARTHENON_FAIL("AthenaPK unknown integration method for diffusion processes. "
+                       "Options are: unsplit, rkl2");
+      }
+    }
+    pkg->AddParam<>("diffint", diffint);
+
+    // Fuse conversion to primitive variables and timestep estimate in final stage
+    const auto fused_dt_estimate =
+        pin->GetOrAddBoolean("hydro", "fused_dt_estimate", false);
+    pkg->AddParam<>("fused_dt_estimate", fused_dt_estimate);
+
+    // Count how often each floor and ceiling is applied (reported in the history file)
+    const auto count_limiters = pin->GetOrAddBoolean("hydro", "count_limiters", false);
+
     if (fluid == Fluid::euler) {
       AdiabaticHydroEOS eos(pfloor, dfloor, efloor, vceil, eceil, gamma);
+      if (count_limiters) {
+        eos.EnableLimiterCounts();
+      }
       pkg->AddParam<>("eos", eos);
       pkg->FillDerivedMesh = ConsToPrim<AdiabaticHydroEOS>;
       pkg->EstimateTimestepMesh = EstimateTimestep<Fluid::euler>;
+      pkg->AddParam<FillDerivedAndEstimateTimestepFun_t *>(
+          "fill_derived_and_estimate_timestep_fun",
+          FillDerivedAndEstimateTimestep<Fluid::euler>);
     } else if (fluid == Fluid::glmmhd) {
       AdiabaticGLMMHDEOS eos(pfloor, dfloor, efloor, vceil, eceil, gamma);
+      if (count_limiters) {
+        eos.EnableLimiterCounts();
+      }
       pkg->AddParam<>("eos", eos);
       pkg->FillDerivedMesh = ConsToPrim<AdiabaticGLMMHDEOS>;
       pkg->EstimateTimestepMesh = EstimateTimestep<Fluid::glmmhd>;
+      pkg->AddParam<FillDerivedAndEstimateTimestepFun_t *>(
+          "fill_derived_and_estimate_timestep_fun",
+          FillDerivedAndEstimateTimestep<Fluid::glmmhd>);
+    }
+
+    pkg->AddParam<>("count_limiters", count_limiters);
+    if (count_limiters) {
+      // Number of conversions in the current cycle in which each limiter is applied (see
+      // "cycle_counters" and ContributeLimiterCounts).
+      auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+      auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+      for (const auto &key : limiter_count_keys) {
+        pkg->AddParam<Real>(key, 0.0, true);
+        cycle_counters->Register(key, utils::ReductionOp::sum, false);
+        hst_vars.emplace_back(utils::AccumulatedParamHstVar(
+            parthenon::UserHistoryOperation::sum, "Hydro", "cycle_counters", key));
+      }
+      pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
     }
   } else {
     PARTHENON_FAIL("AthenaPK hydro: Unknown EOS");
@@ -521,7 +1092,34 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   }
 
   auto scratch_level = pin->GetOrAddInteger("hydro", "scratch_level", 0);
-  pkg->AddParam("scratch_level", scratch_level);
+  pkg->AddParam("scratch_level", scratch_level, autotune);
+
+  if (autotune) {
+    // All compiled in flux kernels are considered with the chosen or a higher (slower
+    // but larger) scratch level that result in identical fluxes.
+    std::vector<FluxLaunchConfig> candidates;
+    for (const auto kernel :
+         {FluxKernel::scratch, FluxKernel::fused, FluxKernel::tight}) {
+      const auto key = std::make_tuple(fluid, recon, riemann, kernel, mixed_precision);
+      const auto key_dc =
+          std::make_tuple(fluid, Reconstruction::dc, riemann, kernel, mixed_precision);
+      if (flux_functions.count(key) == 0 ||
+          (integrator == Integrator::vl2 && flux_functions.count(key_dc) == 0)) {
+        continue;
+      }
+      auto *flux_other = flux_functions.at(key);
+      auto *flux_first =
+          integrator == Integrator::vl2 ? flux_functions.at(key_dc) : flux_other;
+      // The tight kernel does not use scratch memory
+      const int max_level = kernel == FluxKernel::tight ? scratch_level : 1;
+      for (int level = scratch_level; level <= max_level; level++) {
+        candidates.push_back({kernel, level, flux_first, flux_other});
+      }
+    }
+    InitFluxAutotuner(pin, pkg.get(), candidates,
+                      fluid_str + "_" + recon_str + "_" + riemann_str + "_" +
+                          integrator_str);
+  }
 
   auto nscalars = pin->GetOrAddInteger("hydro", "nscalars", 0);
   pkg->AddParam("nscalars", nscalars);
@@ -566,22 +1164,64 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
                prim_labels);
   pkg->AddField("prim", m);
 
+  // Initial state (u1) of the integration. Single copy fields (rather than a separate
+  // register of the independent variables) so that neither fluxes nor coarse buffers
+  // are allocated, as u1 is set at the beginning of each cycle and only read in the
+  // updates. The primitive variables are only required by the first order flux
+  // correction in the final stage of multi-stage integrators.
+  m = Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy},
+               std::vector<int>({nhydro + nscalars}));
+  if (pkg->Param<bool>("u1_required")) {
+    pkg->AddField("u1_cons", m);
+  }
+  if (first_order_flux_correct && pkg->Param<bool>("fofc_final_stage_only") &&
+      integrator != Integrator::rk1) {
+    pkg->AddField("u1_prim", m);
+  }
+
+  // p/rho used in the stencils of the conduction kernels (filled once per kernel call)
+  if (pkg->Param<Conduction>("conduction") != Conduction::none) {
+    m = Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
+    pkg->AddField("p_over_rho", m);
+  }
+
+  // Registers of the RKL2 integrator (for the total energy): Y_0, Y_{j-2}, and M(Y_0)
+  if (pkg->Param<DiffInt>("diffint") == DiffInt::rkl2) {
+    m = Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
+    for (const auto &name : {"rkl2_Y0", "rkl2_Yjm2", "rkl2_MY0"}) {
+      pkg->AddField(name, m);
+    }
+  }
+
   const auto refine_str = pin->GetOrAddString("refinement", "type", "unset");
   if (refine_str == "pressure_gradient") {
-    pkg->CheckRefinementBlock = refinement::gradient::PressureGradient;
+    pkg->CheckRefinementMesh = refinement::gradient::PressureGradient;
     const auto thr = pin->GetOrAddReal("refinement", "threshold_pressure_gradient", 0.0);
     PARTHENON_REQUIRE(thr > 0.,
                       "Make sure to set refinement/threshold_pressure_gradient >0.");
     pkg->AddParam<Real>("refinement/threshold_pressure_gradient", thr);
+    // Hysteresis band: blocks are only derefined below a (smaller) separate threshold
+    const auto thr_deref =
+        pin->GetOrAddReal("refinement", "threshold_pressure_gradient_deref", 0.25 * thr);
+    PARTHENON_REQUIRE(thr_deref < thr, "Make sure to set "
+                                       "refinement/threshold_pressure_gradient_deref < "
+                                       "refinement/threshold_pressure_gradient");
+    pkg->AddParam<Real>("refinement/threshold_pressure_gradient_deref", thr_deref);
   } else if (refine_str == "xyvelocity_gradient") {
-    pkg->CheckRefinementBlock = refinement::gradient::VelocityGradient;
+    pkg->CheckRefinementMesh = refinement::gradient::VelocityGradient;
     const auto thr =
         pin->GetOrAddReal("refinement", "threshold_xyvelocity_gradient", 0.0);
     PARTHENON_REQUIRE(thr > 0.,
                       "Make sure to set refinement/threshold_xyvelocity_gradient >0.");
     pkg->AddParam<Real>("refinement/threshold_xyvelocity_gradient", thr);
+    const auto thr_deref =
+        pin->GetOrAddReal("refinement", "threshold_xyvelocity_gradient_deref", 0.5 * thr);
+    PARTHENON_REQUIRE(thr_deref < thr, "Make sure to set "
+                                       "refinement/threshold_xyvelocity_gradient_deref < "
+                                       "refinement/threshold_xyvelocity_gradient");
+    pkg->AddParam<Real>("refinement/threshold_xyvelocity_gradient_deref", thr_deref);
   } else if (refine_str == "maxdensity") {
-    pkg->CheckRefinementBlock = refinement::other::MaxDensity;
+    pkg->CheckRefinementMesh = refinement::other::MaxDensity;
     const auto deref_below =
         pin->GetOrAddReal("refinement", "maxdensity_deref_below", 0.0);
     const auto refine_above =
@@ -596,25 +1236,184 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
     pkg->AddParam<Real>("refinement/maxdensity_deref_below", deref_below);
     pkg->AddParam<Real>("refinement/maxdensity_refine_above", refine_above);
   } else if (refine_str == "user") {
-    pkg->CheckRefinementBlock = Hydro::ProblemCheckRefinementBlock;
+    if (Hydro::ProblemCheckRefinementMesh != nullptr) {
+      pkg->CheckRefinementMesh = Hydro::ProblemCheckRefinementMesh;
+    } else {
+      pkg->CheckRefinementBlock = Hydro::ProblemCheckRefinementBlock;
+    }
+  }
+
+  // Blocks are only tagged every check_interval cycles (to reduce remeshing)
+  const auto check_interval = pin->GetOrAddInteger("refinement", "check_interval", 1);
+  PARTHENON_REQUIRE_THROWS(check_interval >= 1,
+                           "refinement/check_interval needs to be >= 1");
+  pkg->AddParam<>("refinement/check_interval", check_interval);
+  if (pin->GetOrAddString("parthenon/mesh", "refinement", "none") == "adaptive") {
+    // Number of remesh events (0 or 1) and of created and destroyed blocks preceding the
+    // current cycle (see "cycle_counters" and CountRemeshEvents). The totals of the Mesh
+    // at the previous check are stored to calculate the differences.
+    pkg->AddParam<std::int64_t>("remesh_last_nbnew", 0, true);
+    pkg->AddParam<std::int64_t>("remesh_last_nbdel", 0, true);
+    auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+    auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+    for (const auto &key :
+         {"remesh_num_events", "remesh_num_created", "remesh_num_destroyed"}) {
+      pkg->AddParam<Real>(key, 0.0, true);
+      cycle_counters->Register(key, utils::ReductionOp::sum, false);
+      // Counts are identical on all ranks
+      hst_vars.emplace_back(utils::AccumulatedParamHstVar(
+          parthenon::UserHistoryOperation::max, "Hydro", "cycle_counters", key));
+    }
+    pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
   }
 
   if (ProblemInitPackageData != nullptr) {
     ProblemInitPackageData(pin, pkg.get());
   }
 
+  // Built last so that params changed by the problem generator are included
+  pkg->AddParam<>("hydro_params", MakeHydroParams(pkg.get()), true);
+
+  // Requires the history outputs and the hydro params above
+  utils::InitMemoryReport(pin, pkg.get());
+
   return pkg;
 }
 
+HydroParams MakeHydroParams(StateDescriptor *pkg) {
+  const auto fluid = pkg->Param<Fluid>("fluid");
+  // The EOS of the chosen fluid is copied (sharing the limiter counters) and the other
+  // one is constructed with the same floors and ceilings.
+  const auto make_params = [&](const auto &eos) {
+    return HydroParams(
+        AdiabaticHydroEOS(eos.GetPressureFloor(), eos.GetDensityFloor(),
+                          eos.GetInternalEFloor(), eos.GetVelocityCeiling(),
+                          eos.GetInternalECeiling(), eos.GetGamma()),
+        AdiabaticGLMMHDEOS(eos.GetPressureFloor(), eos.GetDensityFloor(),
+                           eos.GetInternalEFloor(), eos.GetVelocityCeiling(),
+                           eos.GetInternalECeiling(), eos.GetGamma()));
+  };
+  auto params = [&]() {
+    if (fluid == Fluid::euler) {
+      const auto &eos = pkg->Param<AdiabaticHydroEOS>("eos");
+      auto params = make_params(eos);
+      params.hydro_eos = eos;
+      return params;
+    }
+    const auto &eos = pkg->Param<AdiabaticGLMMHDEOS>("eos");
+    auto params = make_params(eos);
+    params.glmmhd_eos = eos;
+    return params;
+  }();
+
+  params.fluid = fluid;
+  params.recon = pkg->Param<Reconstruction>("reconstruction");
+  params.riemann = pkg->Param<RiemannSolver>("riemann");
+  params.nhydro = pkg->Param<int>("nhydro");
+  params.nscalars = pkg->Param<int>("nscalars");
+
+  params.cfl = pkg->Param<Real>("cfl");
+  params.calc_dt_hyp = pkg->Param<bool>("calc_dt_hyp");
+  params.max_dt = pkg->Param<Real>("max_dt");
+
+  if (params.riemann == RiemannSolver::hybrid_hllc ||
+      params.riemann == RiemannSolver::hybrid_hlld) {
+    params.hybrid_riemann.pressure_jump = pkg->Param<Real>("hybrid_pressure_jump");
+    params.hybrid_riemann.mach2 = SQR(pkg->Param<Real>("hybrid_mach"));
+    params.hybrid_riemann.beta = pkg->Param<Real>("hybrid_beta");
+  }
+
+  if (IsHybridReconstruction(params.recon)) {
+    params.hybrid_recon.threshold = pkg->Param<Real>("hybrid_recon_threshold");
+  }
+
+  params.glmmhd_fused_update = pkg->Param<bool>("glmmhd_fused_update");
+  params.reconstruct_all_vars = pkg->Param<bool>("reconstruct_all_vars");
+  params.transverse_stencil_cache = pkg->Param<bool>("transverse_stencil_cache");
+  params.cons_to_prim_nghost = pkg->Param<int>("cons_to_prim_nghost");
+
+  params.enable_cooling = pkg->Param<Cooling>("enable_cooling");
+  params.conduction = pkg->Param<Conduction>("conduction");
+  params.diffint = pkg->Param<DiffInt>("diffint");
+
+  params.c_h = fluid == Fluid::glmmhd ? pkg->Param<Real>("c_h") : 0.0;
+  params.scratch_level = pkg->Param<int>("scratch_level");
+  return params;
+}
+
+void RefreshHydroParams(StateDescriptor *pkg) {
+  auto *params = pkg->MutableParam<HydroParams>("hydro_params");
+  if (params->fluid == Fluid::glmmhd) {
+    params->c_h = pkg->Param<Real>("c_h");
+  }
+  params->scratch_level = pkg->Param<int>("scratch_level");
+}
+
+// Hyperbolic timestep constraint (without the CFL number) of a single cell
+template <Fluid fluid, typename EOS_t, typename Prim_t, typename Coords_t>
+KOKKOS_INLINE_FUNCTION Real HyperbolicTimestep(const EOS_t &eos, const Prim_t &prim,
+                                               const Coords_t &coords, const int ndim,
+                                               const int k, const int j, const int i) {
+  Real w[(NHYDRO)];
+  w[IDN] = prim(IDN, k, j, i);
+  w[IV1] = prim(IV1, k, j, i);
+  w[IV2] = prim(IV2, k, j, i);
+  w[IV3] = prim(IV3, k, j, i);
+  w[IPR] = prim(IPR, k, j, i);
+  Real lambda_max_x, lambda_max_y, lambda_max_z;
+  if constexpr (fluid == Fluid::euler) {
+    lambda_max_x = eos.SoundSpeed(w);
+    lambda_max_y = lambda_max_x;
+    lambda_max_z = lambda_max_x;
+
+  } else if constexpr (fluid == Fluid::glmmhd) {
+    lambda_max_x = eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB1, k, j, i),
+                                             prim(IB2, k, j, i), prim(IB3, k, j, i));
+    if (ndim > 1) {
+      lambda_max_y = eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB2, k, j, i),
+                                               prim(IB3, k, j, i), prim(IB1, k, j, i));
+    }
+    if (ndim > 2) {
+      lambda_max_z = eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB3, k, j, i),
+                                               prim(IB1, k, j, i), prim(IB2, k, j, i));
+    }
+  } else {
+    PARTHENON_FAIL("Unknown fluid in EstimateTimestep");
+  }
+  Real min_dt = coords.template Dxc<1>(k, j, i) / (fabs(w[IV1]) + lambda_max_x);
+  if (ndim > 1) {
+    min_dt =
+        fmin(min_dt, coords.template Dxc<2>(k, j, i) / (fabs(w[IV2]) + lambda_max_y));
+  }
+  if (ndim > 2) {
+    min_dt =
+        fmin(min_dt, coords.template Dxc<3>(k, j, i) / (fabs(w[IV3]) + lambda_max_z));
+  }
+  return min_dt;
+}
+
+// We need to save the the hyperbolic part to recover it later as
+// the divergence cleaning speed is only limited in relation to the other
+// hyperbolic signal speeds and not by (potentially more restrictive) diffusive
+// processes. The (thread-safe) contribution of the partition is merged into the rank
+// local minimum before it is globally reduced (see utils/global_reductions.hpp).
+template <Fluid fluid>
+void StoreHyperbolicTimestep(StateDescriptor *hydro_pkg, const MeshData<Real> *md,
+                             const Real dt_hyp) {
+  if constexpr (fluid == Fluid::glmmhd) {
+    hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions")
+        ->Contribute("dt_hyp", md, dt_hyp);
+  }
+}
+
 template <Fluid fluid>
 Real EstimateHyperbolicTimestep(MeshData<Real> *md) {
   // get to package via first block in Meshdata (which exists by construction)
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-  const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
+  const auto &params = hydro_pkg->Param<HydroParams>("hydro_params");
+  const auto &cfl_hyp = params.cfl;
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &eos_ =
-      hydro_pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                                 AdiabaticGLMMHDEOS>::type>("eos");
+  const auto &eos_ = params.GetEOS<fluid>();
 
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
@@ -632,62 +1431,49 @@ Real EstimateHyperbolicTimestep(MeshData<Real> *md) {
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt) {
         const auto &prim = prim_pack(b);
         const auto &coords = prim_pack.GetCoords(b);
-        // Need to reference variables here so that they are properly caught by
-        // nvcc, which cannot determine captured variables only used within constexpr if.
-        const auto &ndim = ndim_;
-        const auto &eos = eos_;
-
-        Real w[(NHYDRO)];
-        w[IDN] = prim(IDN, k, j, i);
-        w[IV1] = prim(IV1, k, j, i);
-        w[IV2] = prim(IV2, k, j, i);
-        w[IV3] = prim(IV3, k, j, i);
-        w[IPR] = prim(IPR, k, j, i);
-        Real lambda_max_x, lambda_max_y, lambda_max_z;
-        if constexpr (fluid == Fluid::euler) {
-          lambda_max_x = eos.SoundSpeed(w);
-          lambda_max_y = lambda_max_x;
-          lambda_max_z = lambda_max_x;
-
-        } else if constexpr (fluid == Fluid::glmmhd) {
-          lambda_max_x = eos.FastMagnetosonicSpeed(
-              w[IDN], w[IPR], prim(IB1, k, j, i), prim(IB2, k, j, i), prim(IB3, k, j, i));
-          if (ndim > 1) {
-            lambda_max_y =
-                eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB2, k, j, i),
-                                          prim(IB3, k, j, i), prim(IB1, k, j, i));
-          }
-          if (ndim > 2) {
-            lambda_max_z =
-                eos.FastMagnetosonicSpeed(w[IDN], w[IPR], prim(IB3, k, j, i),
-                                          prim(IB1, k, j, i), prim(IB2, k, j, i));
-          }
-        } else {
-          PARTHENON_FAIL("Unknown fluid in EstimateTimestep");
-        }
-        min_dt = fmin(min_dt, coords.Dxc<1>(k, j, i) / (fabs(w[IV1]) + lambda_max_x));
-        if (ndim > 1) {
-          min_dt = fmin(min_dt, coords.Dxc<2>(k, j, i) / (fabs(w[IV2]) + lambda_max_y));
-        }
-        if (ndim > 2) {
-          min_dt = fmin(min_dt, coords.Dxc<3>(k, j, i) / (fabs(w[IV3]) + lambda_max_z));
-        }
+        min_dt =
+            fmin(min_dt, HyperbolicTimestep<fluid>(eos_, prim, coords, ndim_, k, j, i));
       },
       Kokkos::Min<Real>(min_dt_hyperbolic));
 
-  // TODO(pgrete) THIS WORKAROUND IS NOT THREAD SAFE (though this will only become
-  // relevant once parthenon uses host-multithreading in the driver).
-  // We need to save the the hyperbolic part to recover it later as
-  // the divergence cleaning speed is only limited in relation to the other
-  // hyperbolic signal speeds and not by (potentially more restrictive) diffusive
-  // processes.
-  if constexpr (fluid == Fluid::glmmhd) {
-    auto dt_hyp_pkg = hydro_pkg->Param<Real>("dt_hyp");
-    if (cfl_hyp * min_dt_hyperbolic < dt_hyp_pkg) {
-      hydro_pkg->UpdateParam("dt_hyp", cfl_hyp * min_dt_hyperbolic);
+  StoreHyperbolicTimestep<fluid>(hydro_pkg.get(), md, cfl_hyp * min_dt_hyperbolic);
+  return cfl_hyp * min_dt_hyperbolic;
+}
+
+// Timestep constraints that are not covered by the fused
+// FillDerivedAndEstimateTimestep kernel, i.e., the ones that require primitive
+// variables of neighboring cells (conduction) or that are problem specific.
+Real EstimateRemainingTimestep(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &params = hydro_pkg->Param<HydroParams>("hydro_params");
+  auto min_dt = std::numeric_limits<Real>::max();
+
+  const auto diffint = params.diffint;
+  if (diffint == DiffInt::unsplit) {
+    min_dt = std::min(min_dt, EstimateConductionTimestep(md));
+  } else if (diffint == DiffInt::rkl2) {
+    // Rank local minimum that is globally reduced when the tasks of the next cycle are
+    // created and then used to determine the number of RKL2 stages.
+    const auto dt_diff = EstimateConductionTimestep(md);
+    hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions")
+        ->Contribute("dt_diff", md, dt_diff);
+    const auto rkl2_max_dt_ratio = hydro_pkg->Param<Real>("rkl2_max_dt_ratio");
+    if (rkl2_max_dt_ratio > 0.0) {
+      min_dt = std::min(min_dt, rkl2_max_dt_ratio * dt_diff);
     }
   }
-  return cfl_hyp * min_dt_hyperbolic;
+
+  if (ProblemEstimateTimestep != nullptr) {
+    min_dt = std::min(min_dt, ProblemEstimateTimestep(md));
+  }
+
+  // maximum user dt
+  const auto max_dt = params.max_dt;
+  if (max_dt > 0.0) {
+    min_dt = std::min(min_dt, max_dt);
+  }
+
+  return min_dt;
 }
 
 // provide the routine that estimates a stable timestep for this package
@@ -695,13 +1481,14 @@ template <Fluid fluid>
 Real EstimateTimestep(MeshData<Real> *md) {
   // get to package via first block in Meshdata (which exists by construction)
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &params = hydro_pkg->Param<HydroParams>("hydro_params");
   auto min_dt = std::numeric_limits<Real>::max();
 
-  if (hydro_pkg->Param<bool>("calc_dt_hyp")) {
+  if (params.calc_dt_hyp) {
     min_dt = std::min(min_dt, EstimateHyperbolicTimestep<fluid>(md));
   }
 
-  const auto &enable_cooling = hydro_pkg->Param<Cooling>("enable_cooling");
+  const auto &enable_cooling = params.enable_cooling;
 
   if (enable_cooling == Cooling::tabular) {
     const TabularCooling &tabular_cooling =
@@ -710,71 +1497,550 @@ Real EstimateTimestep(MeshData<Real> *md) {
     min_dt = std::min(min_dt, tabular_cooling.EstimateTimeStep(md));
   }
 
-  if (hydro_pkg->Param<Conduction>("conduction") != Conduction::none) {
-    min_dt = std::min(min_dt, EstimateConductionTimestep(md));
+  return std::min(min_dt, EstimateRemainingTimestep(md));
+}
+
+// Converts conserved to primitive variables (over the interior and the ghost zones set
+// by `hydro/cons_to_prim_nghost`) and, in the same sweep, estimates the hyperbolic and
+// cooling timestep constraints (in the interior). This replaces separate FillDerived and
+// EstimateTimestep tasks in the final stage and saves up to two additional passes over
+// the primitive variables. Results are identical to the separate tasks.
+template <Fluid fluid>
+TaskStatus FillDerivedAndEstimateTimestep(MeshData<Real> *md) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &params = hydro_pkg->Param<HydroParams>("hydro_params");
+  const auto &eos = params.GetEOS<fluid>();
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+  const auto &cfl_hyp = params.cfl;
+  const auto calc_dt_hyp = params.calc_dt_hyp;
+
+  // Cooling timestep is only calculated for a valid (positive and finite) cooling CFL,
+  // see TabularCooling::EstimateTimeStep.
+  // The cached cooling fields are filled in the same sweep (if enabled).
+  bool calc_dt_cool = false;
+  bool cache_cooling = false;
+  Real cooling_time_cfl = 0.0;
+  Real internal_e_floor = 0.0;
+  Real mbar_over_kb = 0.0;
+  cooling::CoolingTableObj cooling_table_obj;
+  const auto gm1 = eos.GetGamma() - 1.0;
+  if (params.enable_cooling == Cooling::tabular) {
+    const auto &tabular_cooling = hydro_pkg->Param<TabularCooling>("tabular_cooling");
+    cooling_time_cfl = tabular_cooling.GetCoolingTimeCFL();
+    calc_dt_cool = cooling_time_cfl > 0.0 && std::isfinite(cooling_time_cfl);
+    cache_cooling = tabular_cooling.CachesFields();
+    cooling_table_obj = tabular_cooling.GetCoolingTableObj();
+    mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
+    internal_e_floor = tabular_cooling.GetCoolingTimeInternalEFloor(mbar_over_kb * gm1);
   }
 
-  if (ProblemEstimateTimestep != nullptr) {
-    min_dt = std::min(min_dt, ProblemEstimateTimestep(md));
+  auto const cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  auto prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  parthenon::VariablePack<Real> cooling_time_pack, temperature_pack;
+  if (cache_cooling) {
+    cooling_time_pack = md->PackVariables(std::vector<std::string>{"cooling_time"});
+    temperature_pack = md->PackVariables(std::vector<std::string>{"temperature"});
   }
+  IndexRange ib, jb, kb;
+  GetConsToPrimBounds(md, params.cons_to_prim_nghost, ib, jb, kb);
+  const auto ib_int = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  const auto jb_int = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  const auto kb_int = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  const auto ndim = prim_pack.GetNdim();
+  // Skip the floor and ceiling branches if none is enabled (uniform branch)
+  const bool with_limiters = !eos.LimitersDisabled();
 
-  // maximum user dt
-  const auto max_dt = hydro_pkg->Param<Real>("max_dt");
-  if (max_dt > 0.0) {
-    min_dt = std::min(min_dt, max_dt);
+  Real min_dt_hyperbolic = std::numeric_limits<Real>::max();
+  Real min_cooling_time = std::numeric_limits<Real>::infinity();
+
+  Kokkos::parallel_reduce(
+      "FillDerivedAndEstimateTimestep",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &min_dt,
+                    Real &min_tcool) {
+        const auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        if (with_limiters) {
+          eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+        } else {
+          eos.template ConsToPrim<false>(cons, prim, nhydro, nscalars, k, j, i);
+        }
+
+        if (k < kb_int.s || k > kb_int.e || j < jb_int.s || j > jb_int.e ||
+            i < ib_int.s || i > ib_int.e) {
+          return;
+        }
+
+        if (calc_dt_hyp) {
+          const auto &coords = prim_pack.GetCoords(b);
+          min_dt =
+              fmin(min_dt, HyperbolicTimestep<fluid>(eos, prim, coords, ndim, k, j, i));
+        }
+        if (calc_dt_cool || cache_cooling) {
+          const Real rho = prim(IDN, k, j, i);
+          const Real internal_e = prim(IPR, k, j, i) / (rho * gm1);
+          const Real de_dt = cooling_table_obj.DeDt(internal_e, rho);
+          if (cache_cooling) {
+            cooling_time_pack(b, 0, k, j, i) = (de_dt != 0) ? -internal_e / de_dt : NAN;
+            temperature_pack(b, 0, k, j, i) = mbar_over_kb * prim(IPR, k, j, i) / rho;
+          }
+          if (calc_dt_cool) {
+            min_tcool = fmin(min_tcool, cooling_table_obj.CoolingTimeFromDeDt(
+                                            internal_e, de_dt, internal_e_floor));
+          }
+        }
+      },
+      Kokkos::Min<Real>(min_dt_hyperbolic), Kokkos::Min<Real>(min_cooling_time));
+
+  auto min_dt = std::numeric_limits<Real>::max();
+  if (calc_dt_hyp) {
+    StoreHyperbolicTimestep<fluid>(hydro_pkg.get(), md, cfl_hyp * min_dt_hyperbolic);
+    min_dt = std::min(min_dt, cfl_hyp * min_dt_hyperbolic);
+  }
+  if (calc_dt_cool) {
+    min_dt = std::min(min_dt, cooling_time_cfl * min_cooling_time);
   }
+  min_dt = std::min(min_dt, EstimateRemainingTimestep(md));
 
-  return min_dt;
+  md->SetAllowedDt(min_dt);
+  return TaskStatus::complete;
 }
 
-// Calculate fluxes using a tightly nested 3D loop over the entire block.
-// Currently only used for testing the LLF Riemann solver used in first-order flux corr.
-template <Fluid fluid>
-TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md) {
+// Accessor to the L/R states at a single interface so that the Riemann solvers (which
+// usually operate on i-pencils stored in scratch memory) can be used in the tight loop.
+struct InterfaceState {
+  const Real *w;
+  KOKKOS_FORCEINLINE_FUNCTION Real operator()(const int n, const int /*i*/) const {
+    return w[n];
+  }
+};
+
+// Riemann solver used in the flux kernels. The hybrid solvers hold the thresholds of
+// their indicator.
+template <Fluid fluid, RiemannSolver rsolver>
+Riemann<fluid, rsolver> MakeRiemann(const HydroParams &params) {
+  if constexpr (rsolver == RiemannSolver::hybrid_hllc ||
+                rsolver == RiemannSolver::hybrid_hlld) {
+    return Riemann<fluid, rsolver>(params.hybrid_riemann);
+  } else {
+    return Riemann<fluid, rsolver>();
+  }
+}
+
+// Calculate fluxes in direction XNDIR at a single face (where the face index refers to
+// the lower face of a cell) using a tightly nested 3D loop.
+// The states at each interface are reconstructed pointwise in the same kernel so
+// that no scratch memory is required and the innermost loop vectorizes on CPUs.
+// A functor (rather than a lambda) so that the kernel can either be launched directly
+// or added to a Kokkos graph, see CalculateFluxesTight.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver, int XNDIR,
+          typename ConsPack, typename PrimPack, typename EOS, typename CleaningSpeed>
+struct FluxesTightInDir {
+  static constexpr int ivx = XNDIR == parthenon::X1DIR   ? IV1
+                             : XNDIR == parthenon::X2DIR ? IV2
+                                                         : IV3;
+  ConsPack cons_in;
+  PrimPack prim_in;
+  Riemann<fluid, rsolver> riemann;
+  HybridReconstruction hybrid_recon;
+  EOS eos;
+  CleaningSpeed c_h; // c_h() is the hyperbolic divergence cleaning speed for GLM MHD
+  int nhydro;
+  int nscalars;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, const int k, const int j,
+                                         const int i) const {
+    auto &cons = cons_in(b);
+    const auto &prim = prim_in(b);
+    // Methods of the hybrid reconstructions (shared by all variables)
+    const auto hybrid_iface =
+        MakeHybridInterface<recon, XNDIR>(k, j, i, prim, hybrid_recon);
+    if constexpr (rsolver == RiemannSolver::llf) {
+      // LLF solver (only supports donor cell) directly works on the primitive vars
+      riemann.Solve(eos, k, j, i, ivx, prim, cons, c_h());
+    } else {
+      Real wl[GetNVars<fluid>()], wr[GetNVars<fluid>()];
+      for (int n = 0; n < nhydro; n++) {
+        ReconstructInterface<recon, XNDIR>(n, k, j, i, prim, wl[n], wr[n], hybrid_iface);
+      }
+      riemann.Solve(k, j, i, ivx, InterfaceState{wl}, InterfaceState{wr}, cons, eos,
+                    c_h());
+    }
+    // Passive scalars are upwinded based on the sign of the mass flux
+    if (nscalars > 0) {
+      const Real mass_flux = cons.flux(ivx, IDN, k, j, i);
+      for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+        Real ql, qr;
+        ReconstructInterface<recon, XNDIR>(n, k, j, i, prim, ql, qr, hybrid_iface);
+        cons.flux(ivx, n, k, j, i) = mass_flux * (mass_flux >= 0.0 ? ql : qr);
+      }
+    }
+  }
+};
+
+// Calls `launch(kernel, kl, ku, jl, ju, il, iu)` for the tight flux kernel of each
+// direction (and face if boundary_faces_only) with the face bounds
+// [kl,ku]x[jl,ju]x[il,iu] chosen so that all active fluxes (and only those) are
+// calculated. The kernels write disjoint fluxes, i.e., they are independent.
+// `c_h` provides the divergence cleaning speed to the kernels (see FluxesTightInDir).
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver,
+          bool boundary_faces_only, typename ConsPack, typename PrimPack, typename EOS,
+          typename CleaningSpeed, typename Launch>
+void ForEachFluxesTightKernel(const ConsPack &cons_in, const PrimPack &prim_in,
+                              const HydroParams &params, const EOS &eos,
+                              const CleaningSpeed &c_h, const int ndim,
+                              const IndexRange &ib, const IndexRange &jb,
+                              const IndexRange &kb, Launch &&launch) {
+  const auto riemann = MakeRiemann<fluid, rsolver>(params);
+  using X1Kernel = FluxesTightInDir<fluid, recon, rsolver, parthenon::X1DIR, ConsPack,
+                                    PrimPack, EOS, CleaningSpeed>;
+  using X2Kernel = FluxesTightInDir<fluid, recon, rsolver, parthenon::X2DIR, ConsPack,
+                                    PrimPack, EOS, CleaningSpeed>;
+  using X3Kernel = FluxesTightInDir<fluid, recon, rsolver, parthenon::X3DIR, ConsPack,
+                                    PrimPack, EOS, CleaningSpeed>;
+  const X1Kernel x1_kernel{cons_in, prim_in,       riemann,      params.hybrid_recon,
+                           eos,     c_h,           params.nhydro, params.nscalars};
+  const X2Kernel x2_kernel{cons_in, prim_in,       riemann,      params.hybrid_recon,
+                           eos,     c_h,           params.nhydro, params.nscalars};
+  const X3Kernel x3_kernel{cons_in, prim_in,       riemann,      params.hybrid_recon,
+                           eos,     c_h,           params.nhydro, params.nscalars};
+  if constexpr (boundary_faces_only) {
+    for (const int i : {ib.s, ib.e + 1}) {
+      launch(x1_kernel, kb.s, kb.e, jb.s, jb.e, i, i);
+    }
+    if (ndim >= 2) {
+      for (const int j : {jb.s, jb.e + 1}) {
+        launch(x2_kernel, kb.s, kb.e, j, j, ib.s, ib.e);
+      }
+    }
+    if (ndim >= 3) {
+      for (const int k : {kb.s, kb.e + 1}) {
+        launch(x3_kernel, k, k, jb.s, jb.e, ib.s, ib.e);
+      }
+    }
+  } else {
+    launch(x1_kernel, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e + 1);
+    if (ndim >= 2) {
+      launch(x2_kernel, kb.s, kb.e, jb.s, jb.e + 1, ib.s, ib.e);
+    }
+    if (ndim >= 3) {
+      launch(x3_kernel, kb.s, kb.e + 1, jb.s, jb.e, ib.s, ib.e);
+    }
+  }
+}
+
+// Number of interfaces in direction XNDIR of the face bounds [kl,ku]x[jl,ju]x[il,iu] at
+// which the hybrid Riemann solver uses the accurate solver. The interface states are
+// reconstructed pointwise (as in the tight flux kernel) so that the classification is
+// identical to the one of the flux kernels.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver, int XNDIR,
+          typename PrimPack, typename EOS>
+std::int64_t CountHybridRiemannAccurateInDir(const PrimPack &prim_pack,
+                                             const HydroParams &params, const EOS &eos,
+                                             const int kl, const int ku, const int jl,
+                                             const int ju, const int il, const int iu) {
+  const auto riemann = MakeRiemann<fluid, rsolver>(params);
+  const auto hybrid_recon = params.hybrid_recon;
+  const int nhydro = params.nhydro;
+  std::int64_t num_accurate = 0;
+  Kokkos::parallel_reduce(
+      "CountHybridRiemannInterfaces",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kl, jl, il}, {prim_pack.GetDim(5), ku + 1, ju + 1, iu + 1},
+          {1, 1, 1, iu + 1 - il}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                    std::int64_t &lnum_accurate) {
+        const auto &prim = prim_pack(b);
+        const auto hybrid_iface =
+            MakeHybridInterface<recon, XNDIR>(k, j, i, prim, hybrid_recon);
+        Real wl[GetNVars<fluid>()], wr[GetNVars<fluid>()];
+        for (int n = 0; n < nhydro; n++) {
+          ReconstructInterface<recon, XNDIR>(n, k, j, i, prim, wl[n], wr[n],
+                                             hybrid_iface);
+        }
+        lnum_accurate +=
+            riemann.RequiresAccurate(i, InterfaceState{wl}, InterfaceState{wr}, eos) ? 1
+                                                                                      : 0;
+      },
+      Kokkos::Sum<std::int64_t>(num_accurate));
+  return num_accurate;
+}
+
+// Counts the interfaces (of all directions) of the partition using the HLLE and the
+// accurate solver of a hybrid Riemann solver and contributes them to the
+// "cycle_counters". Only used for the history output (see hybrid_hst) so that the flux
+// kernels themselves do not need to count.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CountHybridRiemannInterfaces(std::shared_ptr<MeshData<Real>> &md) {
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  auto pkg = pmb->packages.Get("Hydro");
+  const auto &params = pkg->Param<HydroParams>("hydro_params");
+  const auto &eos = params.GetEOS<fluid>();
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const int ndim = pmb->pmy_mesh->ndim;
+  // Number of cells of the partition
+  const std::int64_t nb = prim_pack.GetDim(5);
+  const std::int64_t ni = ib.e - ib.s + 1;
+  const std::int64_t nj = jb.e - jb.s + 1;
+  const std::int64_t nk = kb.e - kb.s + 1;
+
+  std::int64_t num_total = nb * nk * nj * (ni + 1);
+  std::int64_t num_accurate =
+      CountHybridRiemannAccurateInDir<fluid, recon, rsolver, parthenon::X1DIR>(
+          prim_pack, params, eos, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e + 1);
+  if (ndim >= 2) {
+    num_total += nb * nk * (nj + 1) * ni;
+    num_accurate +=
+        CountHybridRiemannAccurateInDir<fluid, recon, rsolver, parthenon::X2DIR>(
+            prim_pack, params, eos, kb.s, kb.e, jb.s, jb.e + 1, ib.s, ib.e);
+  }
+  if (ndim >= 3) {
+    num_total += nb * (nk + 1) * nj * ni;
+    num_accurate +=
+        CountHybridRiemannAccurateInDir<fluid, recon, rsolver, parthenon::X3DIR>(
+            prim_pack, params, eos, kb.s, kb.e + 1, jb.s, jb.e, ib.s, ib.e);
+  }
 
-  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
-  auto cons_in = md->PackVariablesAndFluxes(flags_ind);
+  auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+  cycle_counters->Contribute("riemann_hlle_interfaces", md.get(),
+                             static_cast<Real>(num_total - num_accurate));
+  cycle_counters->Contribute("riemann_accurate_interfaces", md.get(),
+                             static_cast<Real>(num_accurate));
+  return TaskStatus::complete;
+}
+
+// Number of interior cells of the partition that are reconstructed with the high order
+// method of a hybrid reconstruction in direction XNDIR
+template <int XNDIR, typename PrimPack>
+std::int64_t CountHybridHighOrderCellsInDir(const PrimPack &prim_pack,
+                                            const HybridReconstruction &hybrid_recon,
+                                            const IndexRange &ib, const IndexRange &jb,
+                                            const IndexRange &kb) {
+  std::int64_t num_high_order = 0;
+  Kokkos::parallel_reduce(
+      "CountHybridReconstructionCells",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+          {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                    std::int64_t &lnum_high_order) {
+        lnum_high_order += HybridRequiresHighOrder<XNDIR>(k, j, i, prim_pack(b),
+                                                          hybrid_recon.threshold)
+                               ? 1
+                               : 0;
+      },
+      Kokkos::Sum<std::int64_t>(num_high_order));
+  return num_high_order;
+}
+
+// Counts the cell reconstructions (of all directions) of the partition using PLM and
+// the high order method of a hybrid reconstruction and contributes them to the
+// "cycle_counters". Only used for the history output (see hybrid_recon_hst) so that the
+// reconstruction itself does not need to count.
+TaskStatus CountHybridReconstructionCells(MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
   auto pkg = pmb->packages.Get("Hydro");
+  const auto &hybrid_recon = pkg->Param<HydroParams>("hydro_params").hybrid_recon;
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const int ndim = pmb->pmy_mesh->ndim;
 
-  const auto &eos =
-      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                           AdiabaticGLMMHDEOS>::type>("eos");
+  const std::int64_t num_cells = static_cast<std::int64_t>(prim_pack.GetDim(5)) *
+                                 (kb.e - kb.s + 1) * (jb.e - jb.s + 1) *
+                                 (ib.e - ib.s + 1);
+  std::int64_t num_high_order = CountHybridHighOrderCellsInDir<parthenon::X1DIR>(
+      prim_pack, hybrid_recon, ib, jb, kb);
+  if (ndim >= 2) {
+    num_high_order += CountHybridHighOrderCellsInDir<parthenon::X2DIR>(
+        prim_pack, hybrid_recon, ib, jb, kb);
+  }
+  if (ndim >= 3) {
+    num_high_order += CountHybridHighOrderCellsInDir<parthenon::X3DIR>(
+        prim_pack, hybrid_recon, ib, jb, kb);
+  }
 
-  // Hyperbolic divergence cleaning speed for GLM MHD
-  Real c_h = 0.0;
-  if (fluid == Fluid::glmmhd) {
-    c_h = pkg->Param<Real>("c_h");
+  auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+  cycle_counters->Contribute("recon_plm_cells", md,
+                             static_cast<Real>(ndim * num_cells - num_high_order));
+  cycle_counters->Contribute("recon_high_order_cells", md,
+                             static_cast<Real>(num_high_order));
+  return TaskStatus::complete;
+}
+
+// Moves the numbers of conversions in which each limiter was applied (counted on the
+// device by the EOS, see count_limiters) to the (rank local) "cycle_counters". Called
+// once per cycle after the final conversion so that the conversions after remeshing are
+// attributed to the following cycle.
+TaskStatus ContributeLimiterCounts(StateDescriptor *pkg) {
+  const auto limiter_counts =
+      pkg->Param<Fluid>("fluid") == Fluid::euler
+          ? pkg->Param<AdiabaticHydroEOS>("eos").GetLimiterCounts()
+          : pkg->Param<AdiabaticGLMMHDEOS>("eos").GetLimiterCounts();
+  const auto counts =
+      Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), limiter_counts);
+  Kokkos::deep_copy(limiter_counts, 0);
+  auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+  for (int n = 0; n < num_limiters; n++) {
+    cycle_counters->Contribute(limiter_count_keys[n], nullptr,
+                               static_cast<Real>(counts(n)));
   }
-  // TODO(pgrete) fix scalar fluxes, too
-  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+  return TaskStatus::complete;
+}
 
+// Whether the cached graphs of the partition were created for the same blocks (the weak
+// pointers are only expired once a block has been destroyed, e.g., by remeshing, so that
+// the addresses of the blocks cannot have been reused).
+bool AreFluxGraphsValid(const FluxGraph &flux_graph, const MeshData<Real> *md) {
+  if (static_cast<int>(flux_graph.blocks.size()) != md->NumBlocks()) {
+    return false;
+  }
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    if (flux_graph.blocks[b].expired() ||
+        flux_graph.blocks[b].lock() != md->GetBlockData(b)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Calculate fluxes using a tightly nested 3D loop over the entire block, i.e., without
+// scratch pad memory and with one kernel per direction. Typically faster on CPUs as
+// the flat loop over i vectorizes better than the team based pencils.
+// If boundary_faces_only, only the fluxes on the faces of the block (i.e., the ones
+// that are communicated for the flux correction with mesh refinement) are calculated.
+// With hydro/flux_graph, the (independent) kernels are captured in a Kokkos graph that
+// is reused across stages and cycles (see FluxGraph) so that they are launched at once.
+// Only these kernels are captured, not the other tasks of a stage.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver,
+          bool boundary_faces_only>
+TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto cons_in = md->PackVariablesAndFluxes(flags_ind);
+  auto pkg = pmb->packages.Get("Hydro");
+  const auto &params = pkg->Param<HydroParams>("hydro_params");
+  const auto &eos = params.GetEOS<fluid>();
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
   const int ndim = pmb->pmy_mesh->ndim;
-  auto riemann = Riemann<fluid, RiemannSolver::llf>();
-  // loop bounds are chosen so that all active fluxes are calculated
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "DC LLF fluxes", parthenon::DevExecSpace(), 0,
-      cons_in.GetDim(5) - 1, kb.s, kb.e + 1, jb.s, jb.e + 1, ib.s, ib.e + 1,
-      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
-        auto &cons = cons_in(b);
-        const auto &prim = prim_in(b);
-        riemann.Solve(eos, k, j, i, IV1, prim, cons, c_h);
-        if (ndim >= 2) {
-          riemann.Solve(eos, k, j, i, IV2, prim, cons, c_h);
-        }
-        if (ndim >= 3) {
-          riemann.Solve(eos, k, j, i, IV3, prim, cons, c_h);
-        }
-      });
+  const int nb = cons_in.GetDim(5);
+  // Hyperbolic divergence cleaning speed for GLM MHD
+  const Real c_h = fluid == Fluid::glmmhd ? params.c_h : 0.0;
+
+  if (!pkg->Param<bool>("flux_graph")) {
+    ForEachFluxesTightKernel<fluid, recon, rsolver, boundary_faces_only>(
+        cons_in, prim_in, params, eos, ConstCleaningSpeed{c_h}, ndim, ib, jb, kb,
+        [&](const auto &kernel, const int kl, const int ku, const int jl, const int ju,
+            const int il, const int iu) {
+          parthenon::par_for(DEFAULT_LOOP_PATTERN, "CalculateFluxesTight",
+                             parthenon::DevExecSpace(), 0, nb - 1, kl, ku, jl, ju, il, iu,
+                             kernel);
+        });
+  } else {
+    auto *flux_fun = CalculateFluxesTight<fluid, recon, rsolver, boundary_faces_only>;
+    auto &flux_graph =
+        pkg->MutableParam<utils::PartitionData<FluxGraph>>("flux_graphs")->Get(md.get());
+    if (!AreFluxGraphsValid(flux_graph, md.get())) {
+      flux_graph.graphs.clear();
+      flux_graph.blocks.clear();
+      for (int b = 0; b < md->NumBlocks(); b++) {
+        flux_graph.blocks.emplace_back(md->GetBlockData(b));
+      }
+    }
+    if (!flux_graph.c_h.is_allocated()) {
+      flux_graph.c_h = Kokkos::View<Real, parthenon::DevMemSpace>("flux graph c_h");
+    }
+    // Only copied (in stream order before the kernels) if c_h changed
+    if (!(flux_graph.c_h_host == c_h)) {
+      Kokkos::deep_copy(parthenon::DevExecSpace(), flux_graph.c_h, c_h);
+      flux_graph.c_h_host = c_h;
+    }
+    auto graph = flux_graph.graphs.find(flux_fun);
+    if (graph == flux_graph.graphs.end()) {
+      const auto c_h_dev = flux_graph.c_h;
+      auto new_graph = Kokkos::Experimental::create_graph(
+          parthenon::DevExecSpace(), [&](const auto &root) {
+            ForEachFluxesTightKernel<fluid, recon, rsolver, boundary_faces_only>(
+                cons_in, prim_in, params, eos, c_h_dev, ndim, ib, jb, kb,
+                [&](const auto &kernel, const int kl, const int ku, const int jl,
+                    const int ju, const int il, const int iu) {
+                  root.then_parallel_for(
+                      "CalculateFluxesTight",
+                      Kokkos::MDRangePolicy<parthenon::DevExecSpace, Kokkos::Rank<4>>(
+                          {0, kl, jl, il}, {nb, ku + 1, ju + 1, iu + 1}),
+                      kernel);
+                });
+          });
+      graph = flux_graph.graphs.emplace(flux_fun, std::move(new_graph)).first;
+    }
+    graph->second.submit();
+  }
+  // Operator split diffusive fluxes are calculated separately, see CalcDiffFluxes
+  if (!boundary_faces_only && params.diffint == DiffInt::unsplit) {
+    ThermalFluxAniso(md.get());
+  }
 
   return TaskStatus::complete;
 }
 
 // Calculate fluxes using scratch pad memory, i.e., over cached pencils in i-dir.
-template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+// Calculate the fluxes of all passive scalars in a single pass over the pencil.
+// The scalars are upwinded based on the sign of the mass flux, which is only loaded once
+// per interface (rather than once per scalar).
+template <typename T>
+KOKKOS_INLINE_FUNCTION void
+PassiveScalarFluxes(parthenon::team_mbr_t const &member, const int ivx, const int k,
+                    const int j, const int il, const int iu, const int nhydro,
+                    const int nscalars, const parthenon::ScratchPad2D<T> &wl,
+                    const parthenon::ScratchPad2D<T> &wr, VariableFluxPack<Real> &cons) {
+  if (nscalars == 0) return;
+  parthenon::par_for_inner(member, il, iu, [&](const int i) {
+    const Real mass_flux = cons.flux(ivx, IDN, k, j, i);
+    const bool upwind_left = mass_flux >= 0.0;
+    for (auto n = nhydro; n < nhydro + nscalars; ++n) {
+      cons.flux(ivx, n, k, j, i) = mass_flux * (upwind_left ? wl(n, i) : wr(n, i));
+    }
+  });
+}
+
+// Scratch memory per team requested by the (largest launch of the) chosen flux kernel
+// for pencils of nx1 cells (including ghost zones). Mirrors the sizes used in
+// CalculateFluxes and CalculateFluxesFused.
+std::size_t FluxScratchBytesPerTeam(StateDescriptor *pkg, const int nx1) {
+  const auto &params = pkg->Param<HydroParams>("hydro_params");
+  const int nvars = params.nhydro + params.nscalars;
+  const auto flux_kernel = pkg->Param<FluxKernel>("flux_kernel");
+  if (flux_kernel == FluxKernel::fused) {
+    return parthenon::ScratchPad2D<Real>::shmem_size(nvars, nx1) * 4;
+  }
+  if (flux_kernel != FluxKernel::scratch) {
+    return 0;
+  }
+  const int window_width =
+      params.transverse_stencil_cache
+          ? 2 * ReconstructionStencilHalfWidth(params.recon) + 1
+          : 0;
+  const auto pencil_bytes =
+      pkg->Param<bool>("mixed_precision")
+          ? parthenon::ScratchPad2D<float>::shmem_size(nvars, nx1)
+          : parthenon::ScratchPad2D<Real>::shmem_size(nvars, nx1);
+  return pencil_bytes * 3 + PencilWindow<X2DIR>::shmem_size(window_width, nvars, nx1);
+}
+
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver, typename ScratchReal>
 TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
@@ -793,31 +2059,35 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
   std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
   auto cons_in = md->PackVariablesAndFluxes(flags_ind);
   auto pkg = pmb->packages.Get("Hydro");
-  const auto nhydro = pkg->Param<int>("nhydro");
-  const auto nscalars = pkg->Param<int>("nscalars");
+  const auto &params = pkg->Param<HydroParams>("hydro_params");
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
 
-  const auto &eos =
-      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                           AdiabaticGLMMHDEOS>::type>("eos");
+  const auto &eos = params.GetEOS<fluid>();
 
   auto num_scratch_vars = nhydro + nscalars;
+  const auto recon_all_vars = params.reconstruct_all_vars;
+  const auto hybrid_recon = params.hybrid_recon;
+  // Rolling window of input pencils for the transverse sweeps (empty if disabled)
+  const auto stencil_cache = params.transverse_stencil_cache;
+  constexpr int ng = ReconstructionStencilHalfWidth(recon);
+  const int window_width = stencil_cache ? 2 * ng + 1 : 0;
 
   // Hyperbolic divergence cleaning speed for GLM MHD
   Real c_h = 0.0;
   if (fluid == Fluid::glmmhd) {
-    c_h = pkg->Param<Real>("c_h");
+    c_h = params.c_h;
   }
 
   auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
 
-  const int scratch_level =
-      pkg->Param<int>("scratch_level"); // 0 is actual scratch (tiny); 1 is HBM
+  const int scratch_level = params.scratch_level; // 0 is actual scratch (tiny); 1 is HBM
   const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
 
   size_t scratch_size_in_bytes =
-      parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 2;
+      parthenon::ScratchPad2D<ScratchReal>::shmem_size(num_scratch_vars, nx1) * 2;
 
-  auto riemann = Riemann<fluid, rsolver>();
+  const auto riemann = MakeRiemann<fluid, rsolver>(params);
 
   parthenon::par_for_outer(
       DEFAULT_OUTER_LOOP_PATTERN, "x1 flux", DevExecSpace(), scratch_size_in_bytes,
@@ -825,12 +2095,13 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
       KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k, const int j) {
         const auto &prim = prim_in(b);
         auto &cons = cons_in(b);
-        parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                         num_scratch_vars, nx1);
-        parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                         num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<ScratchReal> wl(member.team_scratch(scratch_level),
+                                                num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<ScratchReal> wr(member.team_scratch(scratch_level),
+                                                num_scratch_vars, nx1);
         // get reconstructed state on faces
-        Reconstruct<recon, X1DIR>(member, k, j, ib.s - 1, ib.e + 1, prim, wl, wr);
+        ReconstructPencil<recon, X1DIR>(member, recon_all_vars, k, j, ib.s - 1, ib.e + 1,
+                                        prim, wl, wr, hybrid_recon);
         // Sync all threads in the team so that scratch memory is consistent
         member.team_barrier();
 
@@ -838,22 +2109,16 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
         member.team_barrier();
 
         // Passive scalar fluxes
-        for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-          parthenon::par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
-            if (cons.flux(IV1, IDN, k, j, i) >= 0.0) {
-              cons.flux(IV1, n, k, j, i) = cons.flux(IV1, IDN, k, j, i) * wl(n, i);
-            } else {
-              cons.flux(IV1, n, k, j, i) = cons.flux(IV1, IDN, k, j, i) * wr(n, i);
-            }
-          });
-        }
+        PassiveScalarFluxes(member, IV1, k, j, ib.s, ib.e + 1, nhydro, nscalars, wl, wr,
+                            cons);
       });
 
   //--------------------------------------------------------------------------------------
   // j-direction
   if (pmb->pmy_mesh->ndim >= 2) {
     scratch_size_in_bytes =
-        parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 3;
+        parthenon::ScratchPad2D<ScratchReal>::shmem_size(num_scratch_vars, nx1) * 3 +
+        PencilWindow<X2DIR>::shmem_size(window_width, num_scratch_vars, nx1);
     // set the loop limits
     il = ib.s - 1, iu = ib.e + 1, kl = kb.s, ku = kb.e;
     if (pmb->block_size.nx3 == 1) // 2D
@@ -867,15 +2132,31 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
         KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k) {
           const auto &prim = prim_in(b);
           auto &cons = cons_in(b);
-          parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
-                                            num_scratch_vars, nx1);
+          parthenon::ScratchPad2D<ScratchReal> wl(member.team_scratch(scratch_level),
+                                                  num_scratch_vars, nx1);
+          parthenon::ScratchPad2D<ScratchReal> wr(member.team_scratch(scratch_level),
+                                                  num_scratch_vars, nx1);
+          parthenon::ScratchPad2D<ScratchReal> wlb(member.team_scratch(scratch_level),
+                                                   num_scratch_vars, nx1);
+          PencilWindow<X2DIR> window(member.team_scratch(scratch_level), prim,
+                                   jb.s - 1 - ng, window_width, nx1);
+          if (stencil_cache) {
+            for (int j = jb.s - 1 - ng; j < jb.s - 1 + ng; ++j) {
+              window.Load(member, k, j, il, iu);
+            }
+          }
           for (int j = jb.s - 1; j <= jb.e + 1; ++j) {
             // reconstruct L/R states at j
-            Reconstruct<recon, X2DIR>(member, k, j, il, iu, prim, wlb, wr);
+            if (stencil_cache) {
+              // only the leading pencil of the stencil is loaded from device memory
+              window.Load(member, k, j + ng, il, iu);
+              member.team_barrier();
+              ReconstructAllVars<recon, X2DIR>(member, k, j, il, iu, window, wlb, wr,
+                                               hybrid_recon);
+            } else {
+              ReconstructPencil<recon, X2DIR>(member, recon_all_vars, k, j, il, iu, prim,
+                                              wlb, wr, hybrid_recon);
+            }
             // Sync all threads in the team so that scratch memory is consistent
             member.team_barrier();
 
@@ -884,15 +2165,8 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
               member.team_barrier();
 
               // Passive scalar fluxes
-              for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-                parthenon::par_for_inner(member, il, iu, [&](const int i) {
-                  if (cons.flux(IV2, IDN, k, j, i) >= 0.0) {
-                    cons.flux(IV2, n, k, j, i) = cons.flux(IV2, IDN, k, j, i) * wl(n, i);
-                  } else {
-                    cons.flux(IV2, n, k, j, i) = cons.flux(IV2, IDN, k, j, i) * wr(n, i);
-                  }
-                });
-              }
+              PassiveScalarFluxes(member, IV2, k, j, il, iu, nhydro, nscalars, wl, wr,
+                                  cons);
               member.team_barrier();
             }
 
@@ -915,15 +2189,31 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
         KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int j) {
           const auto &prim = prim_in(b);
           auto &cons = cons_in(b);
-          parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
-                                           num_scratch_vars, nx1);
-          parthenon::ScratchPad2D<Real> wlb(member.team_scratch(scratch_level),
-                                            num_scratch_vars, nx1);
+          parthenon::ScratchPad2D<ScratchReal> wl(member.team_scratch(scratch_level),
+                                                  num_scratch_vars, nx1);
+          parthenon::ScratchPad2D<ScratchReal> wr(member.team_scratch(scratch_level),
+                                                  num_scratch_vars, nx1);
+          parthenon::ScratchPad2D<ScratchReal> wlb(member.team_scratch(scratch_level),
+                                                   num_scratch_vars, nx1);
+          PencilWindow<X3DIR> window(member.team_scratch(scratch_level), prim,
+                                   kb.s - 1 - ng, window_width, nx1);
+          if (stencil_cache) {
+            for (int k = kb.s - 1 - ng; k < kb.s - 1 + ng; ++k) {
+              window.Load(member, k, j, il, iu);
+            }
+          }
           for (int k = kb.s - 1; k <= kb.e + 1; ++k) {
-            // reconstruct L/R states at j
-            Reconstruct<recon, X3DIR>(member, k, j, il, iu, prim, wlb, wr);
+            // reconstruct L/R states at k
+            if (stencil_cache) {
+              // only the leading pencil of the stencil is loaded from device memory
+              window.Load(member, k + ng, j, il, iu);
+              member.team_barrier();
+              ReconstructAllVars<recon, X3DIR>(member, k, j, il, iu, window, wlb, wr,
+                                               hybrid_recon);
+            } else {
+              ReconstructPencil<recon, X3DIR>(member, recon_all_vars, k, j, il, iu, prim,
+                                              wlb, wr, hybrid_recon);
+            }
             // Sync all threads in the team so that scratch memory is consistent
             member.team_barrier();
 
@@ -932,15 +2222,8 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
               member.team_barrier();
 
               // Passive scalar fluxes
-              for (auto n = nhydro; n < nhydro + nscalars; ++n) {
-                parthenon::par_for_inner(member, il, iu, [&](const int i) {
-                  if (cons.flux(IV3, IDN, k, j, i) >= 0.0) {
-                    cons.flux(IV3, n, k, j, i) = cons.flux(IV3, IDN, k, j, i) * wl(n, i);
-                  } else {
-                    cons.flux(IV3, n, k, j, i) = cons.flux(IV3, IDN, k, j, i) * wr(n, i);
-                  }
-                });
-              }
+              PassiveScalarFluxes(member, IV3, k, j, il, iu, nhydro, nscalars, wl, wr,
+                                  cons);
               member.team_barrier();
             }
             // swap the arrays for the next step
@@ -951,8 +2234,147 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
         });
   }
 
-  const auto &conduction = pkg->Param<Conduction>("conduction");
-  if (conduction != Conduction::none) {
+  // Operator split diffusive fluxes are calculated separately, see CalcDiffFluxes
+  if (params.diffint == DiffInt::unsplit) {
+    ThermalFluxAniso(md.get());
+  }
+
+  return TaskStatus::complete;
+}
+
+// Calculate fluxes in all active directions using a single kernel.
+// Contrary to CalculateFluxes, which launches one kernel per direction (and, thus,
+// streams the primitive variables through memory once per direction), here a team works
+// on all i-pencils of a fixed (b,k) and calculates the x1, x2, and x3 fluxes of each
+// pencil before moving on to the next j. This way, the stencil data required for the
+// reconstruction is (likely) still in cache when it's reused by the other directions.
+// The x2 reconstruction reuses the cached states from the previous pencil (as in
+// CalculateFluxes) whereas the x3 reconstruction is done twice (at k-1 and k) as the
+// states at k-1 are not available in the team.
+// Loop limits (and thus the fluxes calculated) are identical to CalculateFluxes.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CalculateFluxesFused(std::shared_ptr<MeshData<Real>> &md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  const int ndim = pmb->pmy_mesh->ndim;
+
+  int jl, ju, kl, ku;
+  jl = jb.s, ju = jb.e, kl = kb.s, ku = kb.e;
+  if (ndim >= 2) {
+    jl = jb.s - 1, ju = jb.e + 1;
+  }
+  if (ndim >= 3) {
+    kl = kb.s - 1, ku = kb.e + 1;
+  }
+  // i-limits used for the x2 and x3 fluxes
+  const int il = ib.s - 1, iu = ib.e + 1;
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto cons_in = md->PackVariablesAndFluxes(flags_ind);
+  auto pkg = pmb->packages.Get("Hydro");
+  const auto &params = pkg->Param<HydroParams>("hydro_params");
+  const auto nhydro = params.nhydro;
+  const auto nscalars = params.nscalars;
+
+  const auto &eos = params.GetEOS<fluid>();
+
+  auto num_scratch_vars = nhydro + nscalars;
+  const auto recon_all_vars = params.reconstruct_all_vars;
+  const auto hybrid_recon = params.hybrid_recon;
+
+  // Hyperbolic divergence cleaning speed for GLM MHD
+  Real c_h = 0.0;
+  if (fluid == Fluid::glmmhd) {
+    c_h = params.c_h;
+  }
+
+  auto const &prim_in = md->PackVariables(std::vector<std::string>{"prim"});
+
+  const int scratch_level = params.scratch_level; // 0 is actual scratch (tiny); 1 is HBM
+  const int nx1 = pmb->cellbounds.ncellsi(IndexDomain::entire);
+
+  // Two persistent arrays for the x2 states cached from the previous pencil and two
+  // arrays for temporary L/R states
+  size_t scratch_size_in_bytes =
+      parthenon::ScratchPad2D<Real>::shmem_size(num_scratch_vars, nx1) * 4;
+
+  const auto riemann = MakeRiemann<fluid, rsolver>(params);
+
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "fused flux", DevExecSpace(), scratch_size_in_bytes,
+      scratch_level, 0, cons_in.GetDim(5) - 1, kl, ku,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k) {
+        const auto &prim = prim_in(b);
+        auto &cons = cons_in(b);
+        parthenon::ScratchPad2D<Real> wl(member.team_scratch(scratch_level),
+                                         num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<Real> wr(member.team_scratch(scratch_level),
+                                         num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<Real> wl2(member.team_scratch(scratch_level),
+                                          num_scratch_vars, nx1);
+        parthenon::ScratchPad2D<Real> wl2b(member.team_scratch(scratch_level),
+                                           num_scratch_vars, nx1);
+
+        for (int j = jl; j <= ju; ++j) {
+          //----------------------------------------------------------------------------
+          // i-direction
+          ReconstructPencil<recon, X1DIR>(member, recon_all_vars, k, j, ib.s - 1,
+                                          ib.e + 1, prim, wl, wr, hybrid_recon);
+          member.team_barrier();
+
+          riemann.Solve(member, k, j, ib.s, ib.e + 1, IV1, wl, wr, cons, eos, c_h);
+          member.team_barrier();
+          PassiveScalarFluxes(member, IV1, k, j, ib.s, ib.e + 1, nhydro, nscalars, wl,
+                              wr, cons);
+          member.team_barrier();
+
+          //----------------------------------------------------------------------------
+          // j-direction
+          if (ndim >= 2) {
+            // reconstruct L/R states at j (L states are stored for the next pencil)
+            ReconstructPencil<recon, X2DIR>(member, recon_all_vars, k, j, il, iu, prim,
+                                            wl2b, wr, hybrid_recon);
+            member.team_barrier();
+
+            if (j > jl) {
+              riemann.Solve(member, k, j, il, iu, IV2, wl2, wr, cons, eos, c_h);
+              member.team_barrier();
+              PassiveScalarFluxes(member, IV2, k, j, il, iu, nhydro, nscalars, wl2, wr,
+                                  cons);
+              member.team_barrier();
+            }
+
+            // swap the arrays for the next pencil
+            auto *tmp = wl2.data();
+            wl2.assign_data(wl2b.data());
+            wl2b.assign_data(tmp);
+          }
+
+          //----------------------------------------------------------------------------
+          // k-direction
+          if (ndim >= 3 && k > kl) {
+            // L states on the k-1/2 face are obtained from the reconstruction at k-1,
+            // after which the R states of the k-1 reconstruction are overwritten.
+            ReconstructPencil<recon, X3DIR>(member, recon_all_vars, k - 1, j, il, iu,
+                                            prim, wl, wr, hybrid_recon);
+            member.team_barrier();
+            ReconstructPencil<recon, X3DIR>(member, recon_all_vars, k, j, il, iu, prim,
+                                            wl2b, wr, hybrid_recon);
+            member.team_barrier();
+
+            riemann.Solve(member, k, j, il, iu, IV3, wl, wr, cons, eos, c_h);
+            member.team_barrier();
+            PassiveScalarFluxes(member, IV3, k, j, il, iu, nhydro, nscalars, wl, wr,
+                                cons);
+            member.team_barrier();
+          }
+        }
+      });
+
+  // Operator split diffusive fluxes are calculated separately, see CalcDiffFluxes
+  if (params.diffint == DiffInt::unsplit) {
     ThermalFluxAniso(md.get());
   }
 
@@ -968,14 +2390,18 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md) {
 // However, with AMR (and coarse/fine flux correction) we need to correct the local
 // fluxes first before calling coarse/fine flux correction.
 // In addition, it may be enough to call first order flux correction once at the
-// final stage (rather than at every stage as right row).
-// However, this'd require an additional register to store the initial state and
-// we should first evaluate where the tradeoff between extra computational costs
-// (multiple calls) versus extra memory usage is.
+// final stage (rather than at every stage), see `first_order_flux_correct_stages`.
+// In that case, the first order fluxes need to be calculated from the primitive
+// variables of the initial state (stored in "u1_prim", i.e., `use_initial_prim = true`),
+// which requires copying prim to u1 in the first stage.
+// The initial conserved variables are either stored in "u1_cons" (`initial_in_u1`) or,
+// in the first stage before the update, are the current ones.
+// The number of corrected cells is contributed to the "fofc_num_corrected" and
+// "fofc_num_need_floor" cycle counters and reported in the history output.
 template <Fluid fluid>
-TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
-                                 const Real gam0_, const Real gam1_,
-                                 const Real beta_dt_) {
+TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, const bool initial_in_u1,
+                                 const Real gam0_, const Real gam1_, const Real beta_dt_,
+                                 const bool use_initial_prim) {
   // Work around for CUDA <=11.6
   const Real gam0 = gam0_;
   const Real gam1 = gam1_;
@@ -988,18 +2414,20 @@ TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_dat
 
   std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
   auto u0_cons_pack = u0_data->PackVariablesAndFluxes(flags_ind);
-  auto const &u0_prim_pack = u0_data->PackVariables(std::vector<std::string>{"prim"});
-  auto u1_cons_pack = u1_data->PackVariablesAndFluxes(flags_ind);
+  // primitive variables used to calculate the first order fluxes
+  auto const &u0_prim_pack = u0_data->PackVariables(
+      std::vector<std::string>{use_initial_prim ? "u1_prim" : "prim"});
+  auto u1_cons_pack = u0_data->PackVariables(
+      std::vector<std::string>{initial_in_u1 ? "u1_cons" : "cons"});
   auto pkg = pmb->packages.Get("Hydro");
+  const auto &params = pkg->Param<HydroParams>("hydro_params");
 
-  const auto &eos =
-      pkg->Param<typename std::conditional<fluid == Fluid::euler, AdiabaticHydroEOS,
-                                           AdiabaticGLMMHDEOS>::type>("eos");
+  const auto &eos = params.GetEOS<fluid>();
 
   // Hyperbolic divergence cleaning speed for GLM MHD
   Real c_h = 0.0;
   if (fluid == Fluid::glmmhd) {
-    c_h = pkg->Param<Real>("c_h");
+    c_h = params.c_h;
   }
 
   const int ndim = pmb->pmy_mesh->ndim;
@@ -1008,32 +2436,72 @@ TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_dat
 
   auto riemann = Riemann<fluid, RiemannSolver::llf>();
 
+  // Cells are addressed by their flattened interior index
+  const int nb = u0_cons_pack.GetDim(5);
+  const int nk = kb.e - kb.s + 1;
+  const int nj = jb.e - jb.s + 1;
+  const int ni = ib.e - ib.s + 1;
+  const int num_cells = nb * nk * nj * ni;
+
+  auto &work_lists =
+      pkg->MutableParam<utils::PartitionData<FOFCWorkLists>>("fofc_work_lists")
+          ->Get(u0_data);
+  if (work_lists.corrected_cells.extent_int(0) < num_cells) {
+    work_lists.corrected_cells = ParArray1D<int>("fofc corrected cells", num_cells);
+    work_lists.check_cells = ParArray1D<int>("fofc check cells", num_cells);
+    work_lists.stamps = ParArray1D<int>("fofc stamps", num_cells);
+    work_lists.num_corrected_cells =
+        Kokkos::View<int, parthenon::DevMemSpace>("fofc num corrected cells");
+    work_lists.num_check_cells =
+        Kokkos::View<int, parthenon::DevMemSpace>("fofc num check cells");
+    work_lists.stamp = 0;
+  }
+  const auto corrected_cells = work_lists.corrected_cells;
+  const auto check_cells = work_lists.check_cells;
+  const auto stamps = work_lists.stamps;
+  const auto num_corrected_cells = work_lists.num_corrected_cells;
+  const auto num_check_cells = work_lists.num_check_cells;
+
   std::int64_t num_corrected, num_need_floor;
+  std::int64_t total_corrected = 0;
   // Potentially need multiple attempts as flux correction corrects 6 (in 3D) fluxes
   // of a single cell at the same time. So the neighboring cells need to be rechecked with
   // the corrected fluxes as the corrected fluxes in one cell may result in the need to
   // correct all the fluxes of an originally "good" neighboring cell.
+  // Only the first attempt checks all cells. As fluxes only change for corrected cells,
+  // later attempts only revisit the cells corrected in the previous attempt and their
+  // face neighbors (unless the work list is disabled).
+  const auto fofc_use_work_list = pkg->Param<bool>("fofc_use_work_list");
   size_t num_attempts = 0;
-  do {
+  int num_work = num_cells;
+  BlockWorkCounter block_work(u0_data, "block_cost_fofc");
+  while (true) {
     num_corrected = 0;
+    const bool use_work_list = fofc_use_work_list && num_attempts > 0;
+    Kokkos::deep_copy(num_corrected_cells, 0);
 
     Kokkos::parallel_reduce(
-        "FirstOrderFluxCorrect",
-        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
-            DevExecSpace(), {0, kb.s, jb.s, ib.s},
-            {u0_cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-            {1, 1, 1, ib.e + 1 - ib.s}),
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
-                      std::int64_t &lnum_corrected, std::int64_t &lnum_need_floor) {
+        "FirstOrderFluxCorrect", Kokkos::RangePolicy<>(DevExecSpace(), 0, num_work),
+        KOKKOS_LAMBDA(const int n, std::int64_t &lnum_corrected,
+                      std::int64_t &lnum_need_floor) {
+          const int cell = use_work_list ? check_cells(n) : n;
+          auto idx = cell;
+          const int i = ib.s + idx % ni;
+          idx /= ni;
+          const int j = jb.s + idx % nj;
+          idx /= nj;
+          const int k = kb.s + idx % nk;
+          const int b = idx / nk;
+
           const auto &coords = u0_cons_pack.GetCoords(b);
           const auto &u0_prim = u0_prim_pack(b);
           auto &u0_cons = u0_cons_pack(b);
 
           // In principle, the u_cons.fluxes could be updated in parallel by a different
           // thread resulting in a race conditon here.
-          // However, if the fluxes of a cell have been updated (anywhere) then the entire
-          // kernel will be called again anyway, and, at that point the already fixed
-          // u0_cons.fluxes will automaticlly be used here.
+          // However, if the fluxes of a cell have been updated then the cell (and its
+          // neighbors) will be checked again in the next attempt anyway, and, at that
+          // point the already fixed u0_cons.fluxes will automaticlly be used here.
           Real new_cons[NVAR];
           for (auto v = 0; v < NVAR; v++) {
             new_cons[v] =
@@ -1078,16 +2546,139 @@ TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_dat
             riemann.Solve(eos, k, j, i, IV3, u0_prim, u0_cons, c_h);
             riemann.Solve(eos, k + 1, j, i, IV3, u0_prim, u0_cons, c_h);
           }
+          corrected_cells(Kokkos::atomic_fetch_add(&num_corrected_cells(), 1)) = cell;
           lnum_corrected += 1;
+          block_work.Add(b, 1.0);
         },
         Kokkos::Sum<std::int64_t>(num_corrected),
         Kokkos::Sum<std::int64_t>(num_need_floor));
-    // TODO(pgrete) make this optional and global (potentially store values in Params)
-    // std::cout << "[" << parthenon::Globals::my_rank << "] Attempt: " << num_attempts
-    //           << " Corrected (center): " << num_corrected
-    //           << " Failed (will rely on floor): " << num_need_floor << std::endl;
+    total_corrected += num_corrected;
     num_attempts += 1;
-  } while (num_corrected > 0 && num_attempts < 4);
+    if (num_corrected == 0 || num_attempts >= 4) {
+      break;
+    }
+    if (!fofc_use_work_list) {
+      continue;
+    }
+
+    // Collect the corrected cells and their (interior) face neighbors without duplicates
+    if (work_lists.stamp == std::numeric_limits<int>::max()) {
+      Kokkos::deep_copy(stamps, 0);
+      work_lists.stamp = 0;
+    }
+    const int stamp = ++work_lists.stamp;
+    Kokkos::deep_copy(num_check_cells, 0);
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "FirstOrderFluxCorrect work list", DevExecSpace(), 0,
+        static_cast<int>(num_corrected) - 1, 0, 2 * ndim,
+        KOKKOS_LAMBDA(const int n, const int o) {
+          auto idx = corrected_cells(n);
+          int i = idx % ni;
+          idx /= ni;
+          int j = idx % nj;
+          idx /= nj;
+          int k = idx % nk;
+          const int b = idx / nk;
+          // o = 0 is the cell itself, o = 1,2 (3,4 and 5,6) the neighbors in x1 (x2, x3)
+          const int offset = (o % 2 == 1) ? -1 : 1;
+          i += (o == 1 || o == 2) ? offset : 0;
+          j += (o == 3 || o == 4) ? offset : 0;
+          k += (o == 5 || o == 6) ? offset : 0;
+          if (i < 0 || i >= ni || j < 0 || j >= nj || k < 0 || k >= nk) {
+            return;
+          }
+          const int cell = i + ni * (j + nj * (k + nk * b));
+          if (Kokkos::atomic_exchange(&stamps(cell), stamp) != stamp) {
+            check_cells(Kokkos::atomic_fetch_add(&num_check_cells(), 1)) = cell;
+          }
+        });
+    Kokkos::deep_copy(num_work, num_check_cells);
+  }
+
+  // Accumulate (rank local) statistics of this cycle for the history output.
+  // Note that a cell may be corrected multiple times (in multiple attempts or stages).
+  auto *cycle_counters = pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+  cycle_counters->Contribute("fofc_num_corrected", u0_data,
+                             static_cast<Real>(total_corrected));
+  cycle_counters->Contribute("fofc_num_need_floor", u0_data,
+                             static_cast<Real>(num_need_floor));
+  block_work.AddToBlockCosts(u0_data);
+
+  return TaskStatus::complete;
+}
+
+// Update of the first stage for integrators with gam0 = 0 and gam1 = 1 (i.e., all
+// integrators currently supported) that also stores the initial state in u1 (if
+// `store_initial`) within the same kernel.
+// This saves an additional read and write of the entire state compared to copying u0 to
+// u1 before the first stage followed by the default update.
+TaskStatus UpdateWithFluxDivergenceFirstStage(MeshData<Real> *u0_data,
+                                              const bool store_initial,
+                                              const Real beta_dt_) {
+  // Work around for CUDA <=11.6
+  const Real beta_dt = beta_dt_;
+
+  auto pmb = u0_data->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto u0_pack = u0_data->PackVariablesAndFluxes(flags_ind);
+  // cons is used as (never written) placeholder if the initial state is not stored
+  auto u1_pack = u0_data->PackVariables(
+      std::vector<std::string>{store_initial ? "u1_cons" : "cons"});
+
+  const int ndim = pmb->pmy_mesh->ndim;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "UpdateWithFluxDivergenceFirstStage", DevExecSpace(), 0,
+      u0_pack.GetDim(5) - 1, 0, u0_pack.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
+      KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+        const auto &coords = u0_pack.GetCoords(b);
+        auto &u0 = u0_pack(b);
+        const Real u_initial = u0(v, k, j, i);
+        if (store_initial) {
+          u1_pack(b, v, k, j, i) = u_initial;
+        }
+        u0(v, k, j, i) =
+            u_initial +
+            beta_dt * parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0);
+      });
+
+  return TaskStatus::complete;
+}
+
+// Update of all other stages (identical to Parthenon's UpdateWithFluxDivergence) with
+// the initial state stored in "u1_cons".
+TaskStatus UpdateWithFluxDivergence(MeshData<Real> *u0_data, const Real gam0_,
+                                    const Real gam1_, const Real beta_dt_) {
+  // Work around for CUDA <=11.6
+  const Real gam0 = gam0_;
+  const Real gam1 = gam1_;
+  const Real beta_dt = beta_dt_;
+
+  auto pmb = u0_data->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+
+  std::vector<parthenon::MetadataFlag> flags_ind({Metadata::Independent});
+  auto u0_pack = u0_data->PackVariablesAndFluxes(flags_ind);
+  auto u1_pack = u0_data->PackVariables(std::vector<std::string>{"u1_cons"});
+
+  const int ndim = pmb->pmy_mesh->ndim;
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "UpdateWithFluxDivergence", DevExecSpace(), 0,
+      u0_pack.GetDim(5) - 1, 0, u0_pack.GetDim(4) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e,
+      KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+        const auto &coords = u0_pack.GetCoords(b);
+        auto &u0 = u0_pack(b);
+        u0(v, k, j, i) =
+            gam0 * u0(v, k, j, i) + gam1 * u1_pack(b, v, k, j, i) +
+            beta_dt * parthenon::Update::FluxDivHelper(v, k, j, i, ndim, coords, u0);
+      });
 
   return TaskStatus::complete;
 }
@@ -17,9 +17,16 @@ namespace Hydro {
 
 parthenon::Packages_t ProcessPackages(std::unique_ptr<ParameterInput> &pin);
 std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin);
+// Assigns the per partition state of the package (e.g., work lists) to the current
+// partitions of the mesh. Must be called while no tasks are executed.
+void PreparePartitionData(StateDescriptor *pkg, parthenon::Mesh *pmesh);
 
 template <Fluid fluid>
 Real EstimateTimestep(MeshData<Real> *md);
+template <Fluid fluid>
+TaskStatus FillDerivedAndEstimateTimestep(MeshData<Real> *md);
+using FillDerivedAndEstimateTimestepFun_t =
+    decltype(FillDerivedAndEstimateTimestep<Fluid::euler>);
 
 using parthenon::SimTime;
 TaskStatus AddUnsplitSources(MeshData<Real> *md, const SimTime &tm, const Real beta_dt);
@@ -31,6 +38,8 @@ using SourceFun_t =
 using EstimateTimestepFun_t = std::function<Real(MeshData<Real> *md)>;
 using InitPackageDataFun_t =
     std::function<void(ParameterInput *pin, StateDescriptor *pkg)>;
+// Problem specific cost of a block (relative to the hydro update), see block_costs.hpp
+using BlockCostFun_t = std::function<Real(MeshBlock *pmb)>;
 
 extern SourceFun_t ProblemSourceFirstOrder;
 extern SourceFun_t ProblemSourceUnsplit;
@@ -38,26 +47,80 @@ extern SourceFun_t ProblemSourceStrangSplit;
 extern EstimateTimestepFun_t ProblemEstimateTimestep;
 extern InitPackageDataFun_t ProblemInitPackageData;
 extern std::function<AmrTag(MeshBlockData<Real> *mbd)> ProblemCheckRefinementBlock;
-
-template <Fluid fluid>
+// Batched version that tags all blocks of a MeshData partition (takes precedence)
+using CheckRefinementMeshFun_t =
+    std::function<void(MeshData<Real> *md, parthenon::ParArray1D<AmrTag> &amr_tags)>;
+extern CheckRefinementMeshFun_t ProblemCheckRefinementMesh;
+extern BlockCostFun_t ProblemBlockCost;
+
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver,
+          bool boundary_faces_only = false>
 TaskStatus CalculateFluxesTight(std::shared_ptr<MeshData<Real>> &md);
-template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+// ScratchReal is the type used to store the reconstructed states in scratch memory.
+// Using float (mixed precision) halves the scratch memory footprint whereas the Riemann
+// fluxes are still calculated in full precision.
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver,
+          typename ScratchReal = Real>
 TaskStatus CalculateFluxes(std::shared_ptr<MeshData<Real>> &md);
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CalculateFluxesFused(std::shared_ptr<MeshData<Real>> &md);
 using FluxFun_t =
     decltype(CalculateFluxes<Fluid::euler, Reconstruction::dc, RiemannSolver::hlle>);
+// Number of interfaces using each path of the hybrid Riemann solvers (see hybrid_hst)
+template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
+TaskStatus CountHybridRiemannInterfaces(std::shared_ptr<MeshData<Real>> &md);
+// Number of cells using each method of the hybrid reconstructions (see hybrid_recon_hst)
+TaskStatus CountHybridReconstructionCells(MeshData<Real> *md);
+// Limiter counts of the current cycle (see count_limiters)
+TaskStatus ContributeLimiterCounts(StateDescriptor *pkg);
+// Scratch memory per team (in bytes) requested by the chosen flux kernel
+std::size_t FluxScratchBytesPerTeam(StateDescriptor *pkg, int nx1);
 
 template <Fluid fluid>
-TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, MeshData<Real> *u1_data,
-                                 const Real gam0, const Real gam1, const Real beta_dt);
+TaskStatus FirstOrderFluxCorrect(MeshData<Real> *u0_data, const bool initial_in_u1,
+                                 const Real gam0, const Real gam1, const Real beta_dt,
+                                 const bool use_initial_prim);
 using FirstOrderFluxCorrectFun_t = decltype(FirstOrderFluxCorrect<Fluid::glmmhd>);
 
-using FluxFunKey_t = std::tuple<Fluid, Reconstruction, RiemannSolver>;
+TaskStatus UpdateWithFluxDivergenceFirstStage(MeshData<Real> *u0_data,
+                                              const bool store_initial,
+                                              const Real beta_dt);
+TaskStatus UpdateWithFluxDivergence(MeshData<Real> *u0_data, const Real gam0,
+                                    const Real gam1, const Real beta_dt);
+
+// Last element indicates whether reconstructed states are stored in single precision
+using FluxFunKey_t = std::tuple<Fluid, Reconstruction, RiemannSolver, FluxKernel, bool>;
+// Functions counting the interfaces of the hybrid Riemann solvers (independent of the
+// flux kernel)
+using CountFunKey_t = std::tuple<Fluid, Reconstruction, RiemannSolver>;
 
-// Add flux function pointer to map containing all compiled in flux functions
+// Add flux function pointers to map containing all compiled in flux functions
+// (for all flux kernels selected at configure time, see AthenaPK_FLUX_KERNELS)
 template <Fluid fluid, Reconstruction recon, RiemannSolver rsolver>
-void add_flux_fun(std::map<FluxFunKey_t, FluxFun_t *> &flux_functions) {
-  flux_functions[std::make_tuple(fluid, recon, rsolver)] =
+void add_flux_fun(std::map<FluxFunKey_t, FluxFun_t *> &flux_functions,
+                  std::map<CountFunKey_t, FluxFun_t *> &count_functions) {
+  if constexpr (rsolver == RiemannSolver::hybrid_hllc ||
+                rsolver == RiemannSolver::hybrid_hlld) {
+    count_functions[std::make_tuple(fluid, recon, rsolver)] =
+        Hydro::CountHybridRiemannInterfaces<fluid, recon, rsolver>;
+  }
+  flux_functions[std::make_tuple(fluid, recon, rsolver, FluxKernel::scratch, false)] =
       Hydro::CalculateFluxes<fluid, recon, rsolver>;
+#ifdef ATHENAPK_ENABLE_FLUX_KERNEL_FUSED
+  flux_functions[std::make_tuple(fluid, recon, rsolver, FluxKernel::fused, false)] =
+      Hydro::CalculateFluxesFused<fluid, recon, rsolver>;
+#endif
+#ifdef ATHENAPK_ENABLE_FLUX_KERNEL_TIGHT
+  flux_functions[std::make_tuple(fluid, recon, rsolver, FluxKernel::tight, false)] =
+      Hydro::CalculateFluxesTight<fluid, recon, rsolver>;
+  flux_functions[std::make_tuple(fluid, recon, rsolver, FluxKernel::tight_boundary,
+                                 false)] =
+      Hydro::CalculateFluxesTight<fluid, recon, rsolver, true>;
+#endif
+#ifdef ATHENAPK_ENABLE_MIXED_PRECISION
+  flux_functions[std::make_tuple(fluid, recon, rsolver, FluxKernel::scratch, true)] =
+      Hydro::CalculateFluxes<fluid, recon, rsolver, float>;
+#endif
 }
 
 // Get number of "fluid" variable used
@@ -4,6 +4,10 @@
 // Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
 #include <limits>
 #include <memory>
 #include <string>
@@ -19,9 +23,18 @@
 #include "../eos/adiabatic_hydro.hpp"
 #include "../pgen/cluster/agn_triggering.hpp"
 #include "../pgen/cluster/magnetic_tower.hpp"
+#include "../utils/async_output.hpp"
+#include "../utils/global_reductions.hpp"
+#include "../utils/memory_report.hpp"
+#include "../utils/task_timers.hpp"
+#include "autotune.hpp"
+#include "block_costs.hpp"
+#include "diffusion/diffusion.hpp"
 #include "glmmhd/glmmhd.hpp"
 #include "hydro.hpp"
 #include "hydro_driver.hpp"
+#include "hydro_params.hpp"
+#include "pack_size.hpp"
 
 using namespace parthenon::driver::prelude;
 
@@ -36,6 +49,32 @@ HydroDriver::HydroDriver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm
   pin->CheckDesired("parthenon/time", "cfl");
 }
 
+// Reports (once on rank 0 and whenever it changes) the device memory per block used for
+// the initial state of the integration (u1), which is only stored in the single copy
+// fields "u1_cons" (and "u1_prim"), compared to a clone of the base register.
+void ReportU1Bytes(MeshBlockData<Real> *u0, StateDescriptor *hydro_pkg) {
+  std::int64_t u1_bytes = 0;
+  std::int64_t clone_bytes = 0;
+  for (const auto &var : u0->GetVariableVector()) {
+    const auto bytes = utils::VariableBytes(*var);
+    if (var->label() == "u1_cons" || var->label() == "u1_prim") {
+      u1_bytes += bytes;
+    } else if (!var->IsSet(Metadata::OneCopy)) {
+      // Variables with a single copy would be shared by all registers anyway
+      clone_bytes += bytes;
+    }
+  }
+  if (u1_bytes == hydro_pkg->Param<std::int64_t>("u1_bytes")) {
+    return;
+  }
+  hydro_pkg->UpdateParam("u1_bytes", u1_bytes);
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "Initial state (u1) uses " << u1_bytes << " bytes per block (a clone "
+              << "of all variables of the base register would use " << clone_bytes
+              << " bytes)." << std::endl;
+  }
+}
+
 // Calculate mininum dx, which is used in calculating the divergence cleaning speed c_h
 TaskStatus CalculateGlobalMinDx(MeshData<Real> *md) {
   auto pmb = md->GetBlockData(0)->GetBlockPointer();
@@ -66,16 +105,164 @@ TaskStatus CalculateGlobalMinDx(MeshData<Real> *md) {
       },
       Kokkos::Min<Real>(mindx));
 
-  // Reduction to host var is blocking and only have one of this tasks run at the same
-  // time so modifying the package should be safe.
-  auto mindx_pkg = hydro_pkg->Param<Real>("mindx");
-  if (mindx < mindx_pkg) {
-    hydro_pkg->UpdateParam("mindx", mindx);
+  // Thread-safe contribution to the rank local minimum (see utils/global_reductions.hpp)
+  hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions")
+      ->Contribute("mindx", md, mindx);
+
+  return TaskStatus::complete;
+}
+
+// Exchange ghost zones either with Parthenon's default exchange tasks, with separate
+// tasks for local (same rank) and nonlocal neighbors so that local copies overlap with
+// MPI communication (split), or with a single set of tasks for all neighbors
+// (combined). Prolongation of ghost zones on multilevel meshes is only handled by
+// Parthenon's default exchange tasks.
+TaskID AddGhostExchangeTasks(TaskID dependency, TaskList &tl,
+                             std::shared_ptr<MeshData<Real>> &md,
+                             const BoundaryExchange boundary_exchange,
+                             const bool multilevel, utils::TaskTimers *timers) {
+  using parthenon::BoundaryType;
+  TaskID none(0);
+  if (boundary_exchange == BoundaryExchange::parthenon) {
+    return parthenon::AddBoundaryExchangeTasks(dependency, tl, md, multilevel);
+  }
+  auto start_recv =
+      timers->AddTask(tl, none, "StartReceiveBoundBufs",
+                      parthenon::StartReceiveBoundBufs<BoundaryType::any>, md);
+  if (boundary_exchange == BoundaryExchange::combined) {
+    auto send = timers->AddTask(tl, dependency, "SendBoundBufs",
+                                parthenon::SendBoundBufs<BoundaryType::any>, md);
+    auto recv = timers->AddTask(tl, dependency | start_recv, "ReceiveBoundBufs",
+                                parthenon::ReceiveBoundBufs<BoundaryType::any>, md);
+    return timers->AddTask(tl, recv, "SetBounds",
+                           parthenon::SetBounds<BoundaryType::any>, md);
+  }
+  // Nonlocal buffers are sent first so that messages are in flight during local copies
+  auto send_nonlocal =
+      timers->AddTask(tl, dependency, "SendBoundBufs (nonlocal)",
+                      parthenon::SendBoundBufs<BoundaryType::nonlocal>, md);
+  auto send_local = timers->AddTask(tl, send_nonlocal, "SendBoundBufs (local)",
+                                    parthenon::SendBoundBufs<BoundaryType::local>, md);
+  auto recv_local =
+      timers->AddTask(tl, dependency | start_recv, "ReceiveBoundBufs (local)",
+                      parthenon::ReceiveBoundBufs<BoundaryType::local>, md);
+  auto set_local = timers->AddTask(tl, recv_local, "SetBounds (local)",
+                                   parthenon::SetBounds<BoundaryType::local>, md);
+  auto recv_nonlocal =
+      timers->AddTask(tl, dependency | start_recv, "ReceiveBoundBufs (nonlocal)",
+                      parthenon::ReceiveBoundBufs<BoundaryType::nonlocal>, md);
+  auto set_nonlocal = timers->AddTask(tl, recv_nonlocal, "SetBounds (nonlocal)",
+                                      parthenon::SetBounds<BoundaryType::nonlocal>, md);
+  return set_local | set_nonlocal;
+}
+
+// Operator split integration of the diffusive terms over tau using RKL2 super-time-
+// stepping. Each of the s stages calculates the diffusive fluxes (including the flux
+// correction on multilevel meshes), updates the total energy, and exchanges the ghost
+// zones. The primitive variables (including the ghost zones) are then required by the
+// following stage (and the hyperbolic fluxes).
+void AddRKL2Tasks(TaskCollection &tc, Mesh *pmesh, BlockList_t &blocks,
+                  StateDescriptor *hydro_pkg, const Real tau,
+                  const bool fill_derived_final, utils::TaskTimers *timers) {
+  TaskID none(0);
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  const auto boundary_exchange = hydro_pkg->Param<BoundaryExchange>("boundary_exchange");
+  const int s = RKL2NumStages(tau, hydro_pkg->Param<Real>("dt_diff"));
+
+  for (int n = 1; n <= s; n++) {
+    TaskRegion &stage_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+      auto &tl = stage_region[i];
+      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+      timers->AddTask(tl, none, "StartReceiveFluxCorrections",
+                      parthenon::StartReceiveFluxCorrections, mu0);
+      auto calc_flux =
+          timers->AddTask(tl, none, "CalcDiffFluxes", CalcDiffFluxes, mu0.get());
+      timers->AddTask(tl, calc_flux, "LoadAndSendFluxCorrections",
+                      parthenon::LoadAndSendFluxCorrections, mu0);
+      auto recv_flx = timers->AddTask(tl, calc_flux, "ReceiveFluxCorrections",
+                                      parthenon::ReceiveFluxCorrections, mu0);
+      auto set_flx = timers->AddTask(tl, recv_flx, "SetFluxCorrections",
+                                     parthenon::SetFluxCorrections, mu0);
+      auto update = timers->AddTask(tl, set_flx, "RKL2StageUpdate", RKL2StageUpdate,
+                                    mu0.get(), n, s, tau);
+      AddGhostExchangeTasks(update, tl, mu0, boundary_exchange, pmesh->multilevel,
+                            timers);
+    }
+
+    TaskRegion &bc_region = tc.AddRegion(blocks.size());
+    for (int i = 0; i < blocks.size(); i++) {
+      auto &u0 = blocks[i]->meshblock_data.Get("base");
+      timers->AddTask(bc_region[i], none, "ApplyBoundaryConditions",
+                      parthenon::ApplyBoundaryConditions, u0);
+    }
+
+    if (n < s || fill_derived_final) {
+      TaskRegion &fill_derived_region = tc.AddRegion(num_partitions);
+      for (int i = 0; i < num_partitions; i++) {
+        auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+        timers->AddTask(fill_derived_region[i], none, "FillDerived",
+                        parthenon::Update::FillDerived<MeshData<Real>>, mu0.get());
+      }
+    }
   }
+}
 
+// Timing of the ghost zone exchange (only used if hydro/time_boundary_exchange is set).
+// Both tasks are executed in single task regions directly before and after the exchange
+// so that only the exchange is timed.
+TaskStatus StartBoundaryExchangeTimer(StateDescriptor *hydro_pkg) {
+  Kokkos::fence();
+  const std::chrono::duration<Real> now =
+      std::chrono::steady_clock::now().time_since_epoch();
+  hydro_pkg->UpdateParam("boundary_exchange_start", now.count());
+  return TaskStatus::complete;
+}
+
+TaskStatus StopBoundaryExchangeTimer(StateDescriptor *hydro_pkg, const bool report,
+                                     const int ncycle) {
+  Kokkos::fence();
+  const std::chrono::duration<Real> now =
+      std::chrono::steady_clock::now().time_since_epoch();
+  auto time = hydro_pkg->Param<Real>("boundary_exchange_time") + now.count() -
+              hydro_pkg->Param<Real>("boundary_exchange_start");
+  if (report) {
+    // The slowest rank determines the time to solution
+#ifdef MPI_PARALLEL
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_PARTHENON_REAL,
+                                      MPI_MAX, MPI_COMM_WORLD));
+#endif
+    if (parthenon::Globals::my_rank == 0) {
+      std::cout << "Boundary exchange time in cycle " << ncycle << ": " << time << " s"
+                << std::endl;
+    }
+    time = 0.0;
+  }
+  hydro_pkg->UpdateParam("boundary_exchange_time", time);
   return TaskStatus::complete;
 }
 
+// Contributes the number of remesh events and created/destroyed blocks (from the totals
+// tracked by the Mesh) since the previous call to the "cycle_counters" of this cycle.
+void CountRemeshEvents(Mesh *pmesh, StateDescriptor *hydro_pkg) {
+  const auto nbnew = static_cast<std::int64_t>(pmesh->nbnew);
+  const auto nbdel = static_cast<std::int64_t>(pmesh->nbdel);
+  const auto num_created = nbnew - hydro_pkg->Param<std::int64_t>("remesh_last_nbnew");
+  const auto num_destroyed = nbdel - hydro_pkg->Param<std::int64_t>("remesh_last_nbdel");
+  if (num_created == 0 && num_destroyed == 0) {
+    return;
+  }
+  auto *cycle_counters =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+  cycle_counters->Contribute("remesh_num_events", nullptr, 1.0);
+  cycle_counters->Contribute("remesh_num_created", nullptr,
+                             static_cast<Real>(num_created));
+  cycle_counters->Contribute("remesh_num_destroyed", nullptr,
+                             static_cast<Real>(num_destroyed));
+  hydro_pkg->UpdateParam("remesh_last_nbnew", nbnew);
+  hydro_pkg->UpdateParam("remesh_last_nbdel", nbdel);
+}
+
 // See the advection.hpp declaration for a description of how this function gets called.
 TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
   TaskCollection tc;
@@ -90,144 +277,177 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
 
   const int num_partitions = pmesh->DefaultNumPartitions();
 
-  // calculate agn triggering accretion rate
-  if ((stage == 1) &&
-      hydro_pkg->AllParams().hasKey("agn_triggering_reduce_accretion_rate") &&
-      hydro_pkg->Param<bool>("agn_triggering_reduce_accretion_rate")) {
+  // The initial state is stored in u1 as part of the first stage update (if supported by
+  // the integrator) and u1 is not required at all for single stage integrators.
+  const bool fused_u1_init = hydro_pkg->Param<bool>("fused_u1_init") &&
+                             integrator->gam0[0] == 0.0 && integrator->gam1[0] == 1.0;
+  const bool u1_required = !fused_u1_init || integrator->nstages > 1;
+  PARTHENON_REQUIRE(!u1_required || hydro_pkg->Param<bool>("u1_required"),
+                    "Integrator requires u1 but u1_cons has not been added.");
+
+  // First order flux correction either in every stage or only in the final stage (using
+  // the initial primitive variables stored in u1 for multi-stage integrators).
+  const bool fofc = hydro_pkg->Param<bool>("first_order_flux_correct");
+  const bool fofc_final_stage_only =
+      fofc && hydro_pkg->Param<bool>("fofc_final_stage_only");
+  const bool fofc_initial_prim = fofc_final_stage_only && integrator->nstages > 1;
+  const bool fofc_this_stage =
+      fofc && (!fofc_final_stage_only || stage == integrator->nstages);
+
+  // Block face fluxes are calculated and sent first. Not possible if fluxes are
+  // corrected in this stage as the correction requires all fluxes, or with unsplit
+  // diffusion as the boundary flux kernel only calculates the hyperbolic fluxes.
+  const bool overlap_flux_correction =
+      pmesh->multilevel && !fofc_this_stage &&
+      hydro_pkg->Param<DiffInt>("diffint") != DiffInt::unsplit &&
+      hydro_pkg->Param<bool>("overlap_flux_correction");
+
+  const auto boundary_exchange = hydro_pkg->Param<BoundaryExchange>("boundary_exchange");
+  const bool time_boundary_exchange = hydro_pkg->Param<bool>("time_boundary_exchange");
+  const bool rkl2 = hydro_pkg->Param<DiffInt>("diffint") == DiffInt::rkl2;
+
+  // Costs of the blocks (for the load balancing) are estimated during each cycle
+  if (stage == 1) {
+    ResetBlockCosts(blocks, hydro_pkg.get());
+  }
 
-    // need to make sure that there's only one region in order to MPI_reduce to work
-    TaskRegion &single_task_region = tc.AddRegion(1);
-    auto &tl = single_task_region[0];
-    // First globally reset triggering quantities
-    auto prev_task =
-        tl.AddTask(none, cluster::AGNTriggeringResetTriggering, hydro_pkg.get());
+  // The number of blocks per rank changes with remeshing and load balancing
+  if (stage == 1) {
+    ReevaluatePackSize(pmesh, hydro_pkg.get());
+    Hydro::PreparePartitionData(hydro_pkg.get(), pmesh);
+  }
 
-    // Adding one task for each partition. Given that they're all in one task list
-    // they'll be executed sequentially. Given that a par_reduce to a host var is
-    // blocking it's also save to store the variable in the Params for now.
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_agn_triggering =
-          tl.AddTask(prev_task, cluster::AGNTriggeringReduceTriggering, mu0.get(), tm.dt);
-      prev_task = new_agn_triggering;
-    }
-#ifdef MPI_PARALLEL
-    auto reduce_agn_triggering =
-        tl.AddTask(prev_task, cluster::AGNTriggeringMPIReduceTriggering, hydro_pkg.get());
-    prev_task = reduce_agn_triggering;
-#endif
+  // Contributions of the previous stage (e.g., the rank local timestep constraints) are
+  // merged into the params before they are used below and the accumulators are assigned
+  // to the current partitions (see utils/global_reductions.hpp).
+  hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions")
+      ->PrepareContributions(hydro_pkg.get(), pmesh);
+  // Statistics reported in the history output are only accumulated over a single cycle
+  auto *cycle_counters =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+  if (stage == 1) {
+    cycle_counters->ResetParams(hydro_pkg.get(), 0.0);
+  }
+  // Remeshing (if any) took place after the previous cycle
+  if (stage == 1 && pmesh->adaptive) {
+    CountRemeshEvents(pmesh, hydro_pkg.get());
+  }
+  cycle_counters->PrepareContributions(hydro_pkg.get(), pmesh);
 
-    // Remove accreted gas
-    for (int i = 0; i < num_partitions; i++) {
-      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_remove_accreted_gas =
-          tl.AddTask(prev_task, cluster::AGNTriggeringFinalizeTriggering, mu0.get(), tm);
-      prev_task = new_remove_accreted_gas;
-    }
+  // All tasks are added through the timers (named profiling regions and optional
+  // timing, see utils/task_timers.hpp)
+  auto *timers = hydro_pkg->MutableParam<utils::TaskTimers>("task_timers");
+  if (stage == 1) {
+    timers->BeginCycle(pmesh, tm.ncycle);
   }
 
-  for (int i = 0; i < blocks.size(); i++) {
-    auto &pmb = blocks[i];
-    // Using "base" as u0, which already exists (and returned by using plain Get())
-    auto &u0 = pmb->meshblock_data.Get();
+  // Potentially switch the flux launch configuration (before any flux task is added)
+  if ((stage == 1) && hydro_pkg->Param<bool>("autotune")) {
+    AdvanceFluxAutotuner(hydro_pkg.get(), blocks[0].get());
+  }
+  const bool time_fluxes =
+      hydro_pkg->Param<bool>("autotune") &&
+      hydro_pkg->Param<FluxAutotuner>("flux_autotuner").IsTuning();
+
+  // u1 is stored in fields of the base register (see "u1_cons"), i.e., no separate
+  // register is created
+  if (stage == 1 && u1_required) {
+    ReportU1Bytes(blocks[0]->meshblock_data.Get().get(), hydro_pkg.get());
+  }
+  // At startup and after remeshing (once all registers exist)
+  if (stage == 1) {
+    utils::ReportMemory(pmesh, hydro_pkg.get());
+    hydro_pkg->Param<std::shared_ptr<utils::AsyncOutput>>("async_output")
+        ->SnapshotIfDue(pmesh, pinput, tm, app_input->MeshBlockUserWorkBeforeOutput);
+  }
 
-    // Create meshblock data for register u1.
-    // This is a noop if u1 already exists.
-    // TODO(pgrete) update to derive from other quanity as u1 does not require fluxes
-    if (stage == 1) {
-      pmb->meshblock_data.Add("u1", u0);
-    }
+  const bool agn_triggering =
+      hydro_pkg->AllParams().hasKey("agn_triggering_reduce_accretion_rate") &&
+      hydro_pkg->Param<bool>("agn_triggering_reduce_accretion_rate");
+  const bool magnetic_tower_power_scaling =
+      hydro_pkg->AllParams().hasKey("magnetic_tower_power_scaling") &&
+      hydro_pkg->Param<bool>("magnetic_tower_power_scaling");
+  const bool global_reductions =
+      (stage == 1) && (agn_triggering || hydro_pkg->Param<bool>("calc_c_h") ||
+                       magnetic_tower_power_scaling);
+  // The AGN triggering quantities are only reduced every
+  // agn_triggering/update_interval cycles (over the time since the last update).
+  Real agn_triggering_update_dt = 0.0;
+  const bool agn_triggering_update =
+      (stage == 1) && agn_triggering &&
+      cluster::AGNTriggeringPrepareCycle(hydro_pkg.get(), tm, agn_triggering_update_dt);
+  // The magnetic tower power contributions are either reduced (at stage 1) or lagged,
+  // i.e., accumulated by the source term in the final stage of the previous cycle.
+  const bool magnetic_tower_reduce_contribs =
+      magnetic_tower_power_scaling &&
+      cluster::MagneticTowerPrepareStage(hydro_pkg.get(), pmesh, stage,
+                                         integrator->nstages, tm);
+  // The global minimum dx (for uniform Cartesian coordinates) only changes if the finest
+  // level of the mesh changes so it is cached and only recalculated after remeshing.
+  // Load balancing does not change the global minimum (all ranks hold the global
+  // value after the reduction).
+  const bool calc_mindx = (stage == 1) && hydro_pkg->Param<bool>("calc_c_h") &&
+                          hydro_pkg->Param<int>("mindx_level") != pmesh->current_level;
+  if (calc_mindx) {
+    hydro_pkg->UpdateParam("mindx", std::numeric_limits<Real>::max());
+    hydro_pkg->UpdateParam("mindx_level", pmesh->current_level);
   }
 
-  // Calculate hyperbolic divergence cleaning speed
-  // TODO(pgrete) Calculating mindx is only required after remeshing. Need to find a clean
-  // solution for this one-off global reduction.
-  if (hydro_pkg->Param<bool>("calc_c_h") && (stage == 1)) {
-    // need to make sure that there's only one region in order to MPI_reduce to work
-    TaskRegion &single_task_region = tc.AddRegion(1);
-    auto &tl = single_task_region[0];
-    // Adding one task for each partition. Not using a (new) single partition containing
-    // all blocks here as this (default) split is also used for the following tasks and
-    // thus does not create an overhead (such as creating a new MeshBlockPack that is just
-    // used here). Given that all partitions are in one task list they'll be executed
-    // sequentially. Given that a par_reduce to a host var is blocking it's also save to
-    // store the variable in the Params for now.
-    auto prev_task = none;
+  // Rank local contributions to all global reductions (AGN triggering accretion rate,
+  // minimum dx for the hyperbolic divergence cleaning speed c_h, and magnetic tower
+  // scaling) followed by a single non-blocking global reduction, see
+  // utils/global_reductions.hpp.
+  if (global_reductions) {
+    // The params have been reset above (or in AGNTriggeringPrepareCycle) and the
+    // contributions of each partition are accumulated separately so that the
+    // contributing tasks of different partitions may be executed concurrently.
+    if (magnetic_tower_reduce_contribs) {
+      cluster::MagneticTowerResetPowerContribs(hydro_pkg.get());
+    }
+    TaskRegion &contrib_region = tc.AddRegion(num_partitions);
     for (int i = 0; i < num_partitions; i++) {
+      auto &tl = contrib_region[i];
       auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_mindx = tl.AddTask(prev_task, CalculateGlobalMinDx, mu0.get());
-      prev_task = new_mindx;
+      auto prev_task = none;
+      if (agn_triggering_update) {
+        prev_task = timers->AddTask(tl, prev_task, "AGNTriggeringReduceTriggering",
+                                    cluster::AGNTriggeringReduceTriggering, mu0.get(),
+                                    agn_triggering_update_dt);
+      }
+      if (calc_mindx) {
+        prev_task = timers->AddTask(tl, prev_task, "CalculateGlobalMinDx",
+                                    CalculateGlobalMinDx, mu0.get());
+      }
+      if (magnetic_tower_reduce_contribs) {
+        prev_task = timers->AddTask(tl, prev_task, "MagneticTowerReducePowerContribs",
+                                    cluster::MagneticTowerReducePowerContribs, mu0.get(),
+                                    tm);
+      }
     }
-    auto reduce_c_h = prev_task;
-#ifdef MPI_PARALLEL
-    reduce_c_h = tl.AddTask(
-        prev_task,
-        [](StateDescriptor *hydro_pkg) {
-          Real mins[2];
-          mins[0] = hydro_pkg->Param<Real>("mindx");
-          mins[1] = hydro_pkg->Param<Real>("dt_hyp");
-          PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, mins, 2, MPI_PARTHENON_REAL,
-                                            MPI_MIN, MPI_COMM_WORLD));
-
-          hydro_pkg->UpdateParam("mindx", mins[0]);
-          hydro_pkg->UpdateParam("dt_hyp", mins[1]);
-          return TaskStatus::complete;
-        },
-        hydro_pkg.get());
-#endif
-    // Finally update c_h
-    auto update_c_h = tl.AddTask(
-        reduce_c_h,
-        [](StateDescriptor *hydro_pkg) {
-          const auto &mindx = hydro_pkg->Param<Real>("mindx");
-          const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
-          const auto &dt_hyp = hydro_pkg->Param<Real>("dt_hyp");
-          hydro_pkg->UpdateParam("c_h", cfl_hyp * mindx / dt_hyp);
-          return TaskStatus::complete;
-        },
-        hydro_pkg.get());
+    // Merges the contributions (in partition order) at the region boundary
+    TaskRegion &single_task_region = tc.AddRegion(1);
+    auto &tl = single_task_region[0];
+    timers->AddTask(tl, none, "StartGlobalReductions", utils::StartGlobalReductions,
+                    hydro_pkg.get());
   }
 
-  // calculate magnetic tower scaling
-  if ((stage == 1) && hydro_pkg->AllParams().hasKey("magnetic_tower_power_scaling") &&
-      hydro_pkg->Param<bool>("magnetic_tower_power_scaling")) {
-    const auto &magnetic_tower =
-        hydro_pkg->Param<cluster::MagneticTower>("magnetic_tower");
-
-    // need to make sure that there's only one region in order to MPI_reduce to work
+  // Remove accreted gas (requires the global accretion rate)
+  if (stage == 1 && agn_triggering) {
     TaskRegion &single_task_region = tc.AddRegion(1);
     auto &tl = single_task_region[0];
-    // First globally reset magnetic_tower_linear_contrib and
-    // magnetic_tower_quadratic_contrib
-    auto prev_task =
-        tl.AddTask(none, cluster::MagneticTowerResetPowerContribs, hydro_pkg.get());
-
-    // Adding one task for each partition. Given that they're all in one task list
-    // they'll be executed sequentially. Given that a par_reduce to a host var is
-    // blocking it's also save to store the variable in the Params for now.
+    auto prev_task = timers->AddTask(tl, none, "FinishGlobalReductions",
+                                     utils::FinishGlobalReductions, hydro_pkg.get());
+    if (agn_triggering_update) {
+      timers->AddTask(tl, prev_task, "AGNTriggeringWriteTriggering",
+                      cluster::AGNTriggeringWriteTriggering, hydro_pkg.get(), tm);
+    }
+    TaskRegion &finalize_region = tc.AddRegion(num_partitions);
     for (int i = 0; i < num_partitions; i++) {
+      auto &tl = finalize_region[i];
       auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-      auto new_magnetic_tower_power_contrib =
-          tl.AddTask(prev_task, cluster::MagneticTowerReducePowerContribs, mu0.get(), tm);
-      prev_task = new_magnetic_tower_power_contrib;
+      timers->AddTask(tl, none, "AGNTriggeringFinalizeTriggering",
+                      cluster::AGNTriggeringFinalizeTriggering, mu0.get(), tm);
     }
-#ifdef MPI_PARALLEL
-    auto reduce_magnetic_tower_power_contrib = tl.AddTask(
-        prev_task,
-        [](StateDescriptor *hydro_pkg) {
-          Real magnetic_tower_contribs[] = {
-              hydro_pkg->Param<Real>("magnetic_tower_linear_contrib"),
-              hydro_pkg->Param<Real>("magnetic_tower_quadratic_contrib")};
-          PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, magnetic_tower_contribs, 2,
-                                            MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-          hydro_pkg->UpdateParam("magnetic_tower_linear_contrib",
-                                 magnetic_tower_contribs[0]);
-          hydro_pkg->UpdateParam("magnetic_tower_quadratic_contrib",
-                                 magnetic_tower_contribs[1]);
-          return TaskStatus::complete;
-        },
-        hydro_pkg.get());
-#endif
   }
 
   // First add split sources before the main time integration
@@ -242,10 +462,24 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       // the source term is applied to all active registers in the flux calculation.
       // IMPORTANT 2: The tasks should work using `cons` variables as input as in the
       // final step, `prim` are not updated yet from the flux calculation.
-      tl.AddTask(none, AddSplitSourcesStrang, mu0.get(), tm);
+      timers->AddTask(tl, none, "AddSplitSourcesStrang", AddSplitSourcesStrang, mu0.get(),
+                      tm);
     }
   }
 
+  // Strang split diffusion, i.e., a dt/2 update. The number of stages depends on the
+  // global diffusive timestep, which is thus required when the tasks are created
+  // (and reused for the final update in the last stage).
+  if (stage == 1 && rkl2) {
+#ifdef MPI_PARALLEL
+    auto dt_diff = hydro_pkg->Param<Real>("dt_diff");
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &dt_diff, 1, MPI_PARTHENON_REAL,
+                                      MPI_MIN, MPI_COMM_WORLD));
+    hydro_pkg->UpdateParam("dt_diff", dt_diff);
+#endif
+    AddRKL2Tasks(tc, pmesh, blocks, hydro_pkg.get(), 0.5 * tm.dt, true, timers);
+  }
+
   // Now start the main time integration by resetting the registers
   TaskRegion &async_region_init_int = tc.AddRegion(num_task_lists_executed_independently);
   for (int i = 0; i < blocks.size(); i++) {
@@ -253,20 +487,50 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     auto &tl = async_region_init_int[i];
     auto &u0 = pmb->meshblock_data.Get();
     // init u1, see (11) in Athena++ method paper
-    if (stage == 1) {
-      auto &u1 = pmb->meshblock_data.Get("u1");
-      auto init_u1 = tl.AddTask(
-          none,
-          [](MeshBlockData<Real> *u0, MeshBlockData<Real> *u1, bool copy_prim) {
-            u1->Get("cons").data.DeepCopy(u0->Get("cons").data);
+    // With the fused init, the conserved variables are stored in the first stage update.
+    if (stage == 1 && (!fused_u1_init || fofc_initial_prim)) {
+      auto init_u1 = timers->AddTask(
+          tl, none, "InitU1",
+          [](MeshBlockData<Real> *u0, bool copy_cons, bool copy_prim) {
+            if (copy_cons) {
+              u0->Get("u1_cons").data.DeepCopy(u0->Get("cons").data);
+            }
             if (copy_prim) {
-              u1->Get("prim").data.DeepCopy(u0->Get("prim").data);
+              u0->Get("u1_prim").data.DeepCopy(u0->Get("prim").data);
             }
             return TaskStatus::complete;
           },
-          // First order flux correction needs the original prim variables in the
-          // during the correction.
-          u0.get(), u1.get(), hydro_pkg->Param<bool>("first_order_flux_correct"));
+          // First order flux correction in the final stage needs the original prim
+          // variables (including ghost zones) to calculate the first order fluxes.
+          u0.get(), !fused_u1_init, fofc_initial_prim);
+    }
+  }
+
+  // The global reductions overlap with the split sources and register initialization
+  // above but are required in the following (e.g., c_h in the flux calculation).
+  if (global_reductions) {
+    TaskRegion &single_task_region = tc.AddRegion(1);
+    auto &tl = single_task_region[0];
+    auto finish_reductions =
+        timers->AddTask(tl, none, "FinishGlobalReductions", utils::FinishGlobalReductions,
+                        hydro_pkg.get());
+    // Finally update c_h
+    if (hydro_pkg->Param<bool>("calc_c_h")) {
+      timers->AddTask(
+          tl, finish_reductions, "UpdateCh",
+          [](StateDescriptor *hydro_pkg) {
+            const auto &mindx = hydro_pkg->Param<Real>("mindx");
+            const auto &cfl_hyp = hydro_pkg->Param<Real>("cfl");
+            const auto &dt_hyp = hydro_pkg->Param<Real>("dt_hyp");
+            hydro_pkg->UpdateParam("c_h", cfl_hyp * mindx / dt_hyp);
+            RefreshHydroParams(hydro_pkg);
+            return TaskStatus::complete;
+          },
+          hydro_pkg.get());
+    }
+    if (magnetic_tower_power_scaling) {
+      timers->AddTask(tl, finish_reductions, "MagneticTowerCheckLaggedPowerContribs",
+                      cluster::MagneticTowerCheckLaggedPowerContribs, hydro_pkg.get());
     }
   }
 
@@ -276,44 +540,112 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
   for (int i = 0; i < num_partitions; i++) {
     auto &tl = single_tasklist_per_pack_region[i];
     auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-    auto &mu1 = pmesh->mesh_data.GetOrAdd("u1", i);
-    tl.AddTask(none, parthenon::StartReceiveFluxCorrections, mu0);
+    // With the fused init u1 is only populated in the first stage update. Before, u0
+    // contains the (identical) initial state.
+    const bool initial_in_u1 = !(stage == 1 && fused_u1_init);
+    timers->AddTask(tl, none, "StartReceiveFluxCorrections",
+                    parthenon::StartReceiveFluxCorrections, mu0);
+
+    // Fluxes on the block faces are calculated (and sent) before all fluxes
+    auto calc_flux_dep = none;
+    auto send_flx = none;
+    FluxFun_t *calc_flux_bnd_fun = nullptr;
+    if (overlap_flux_correction) {
+      const auto flux_bnd_str =
+          (stage == 1) ? "flux_boundary_first_stage" : "flux_boundary_other_stage";
+      calc_flux_bnd_fun = hydro_pkg->Param<FluxFun_t *>(flux_bnd_str);
+      auto calc_flux_bnd =
+          timers->AddTask(tl, none, "CalculateFluxes (boundary)", calc_flux_bnd_fun, mu0);
+      send_flx = timers->AddTask(tl, calc_flux_bnd, "LoadAndSendFluxCorrections",
+                                 parthenon::LoadAndSendFluxCorrections, mu0);
+      // Fluxes can only be overwritten once they have been loaded into the buffers
+      calc_flux_dep = send_flx;
+    }
 
     const auto flux_str = (stage == 1) ? "flux_first_stage" : "flux_other_stage";
     FluxFun_t *calc_flux_fun = hydro_pkg->Param<FluxFun_t *>(flux_str);
-    auto calc_flux = tl.AddTask(none, calc_flux_fun, mu0);
+    auto calc_flux =
+        time_fluxes ? timers->AddTask(tl, calc_flux_dep, "CalculateFluxes",
+                                      CalculateFluxesTimed, mu0, calc_flux_fun)
+                    : timers->AddTask(tl, calc_flux_dep, "CalculateFluxes", calc_flux_fun,
+                                      mu0);
+
+    // Statistics of the hybrid Riemann solvers (only reads the primitive variables)
+    const auto hybrid_count_str =
+        (stage == 1) ? "hybrid_count_first_stage" : "hybrid_count_other_stage";
+    if (hydro_pkg->AllParams().hasKey(hybrid_count_str)) {
+      timers->AddTask(tl, none, "CountHybridRiemannInterfaces",
+                      hydro_pkg->Param<FluxFun_t *>(hybrid_count_str), mu0);
+    }
+
+    // Statistics of the hybrid reconstructions (in the stages using them)
+    if (hydro_pkg->AllParams().hasKey("hybrid_recon_count_first_stage") &&
+        (stage > 1 || hydro_pkg->Param<bool>("hybrid_recon_count_first_stage"))) {
+      timers->AddTask(tl, none, "CountHybridReconstructionCells",
+                      CountHybridReconstructionCells, mu0.get());
+    }
+
+    // Recalculate (cheap) face fluxes so that they are identical to the ones sent.
+    // Not required for the tight kernel, which uses the identical code path.
+    if (overlap_flux_correction &&
+        hydro_pkg->Param<FluxKernel>("flux_kernel") != FluxKernel::tight) {
+      calc_flux = timers->AddTask(tl, calc_flux, "CalculateFluxes (boundary)",
+                                  calc_flux_bnd_fun, mu0);
+    }
 
     // TODO(pgrete) figure out what to do about the sources from the first stage
     // that are potentially disregarded when the (m)hd fluxes are corrected in the second
     // stage.
+    // Note that the correction is done before the fluxes are sent to coarser neighbors
+    // so that the fine/coarse flux correction uses the corrected fluxes.
     TaskID first_order_flux_correct = calc_flux;
-    if (hydro_pkg->Param<bool>("first_order_flux_correct")) {
+    if (fofc_this_stage) {
       auto *first_order_flux_correct_fun =
           hydro_pkg->Param<FirstOrderFluxCorrectFun_t *>("first_order_flux_correct_fun");
-      first_order_flux_correct =
-          tl.AddTask(calc_flux, first_order_flux_correct_fun, mu0.get(), mu1.get(),
-                     integrator->gam0[stage - 1], integrator->gam1[stage - 1],
-                     integrator->beta[stage - 1] * integrator->dt);
+      first_order_flux_correct = timers->AddTask(
+          tl, calc_flux, "FirstOrderFluxCorrect", first_order_flux_correct_fun, mu0.get(),
+          initial_in_u1, integrator->gam0[stage - 1], integrator->gam1[stage - 1],
+          integrator->beta[stage - 1] * integrator->dt, fofc_initial_prim);
     }
 
-    auto send_flx =
-        tl.AddTask(first_order_flux_correct, parthenon::LoadAndSendFluxCorrections, mu0);
+    if (!overlap_flux_correction) {
+      send_flx =
+          timers->AddTask(tl, first_order_flux_correct, "LoadAndSendFluxCorrections",
+                          parthenon::LoadAndSendFluxCorrections, mu0);
+    }
     auto recv_flx =
-        tl.AddTask(first_order_flux_correct, parthenon::ReceiveFluxCorrections, mu0);
-    auto set_flx = tl.AddTask(recv_flx, parthenon::SetFluxCorrections, mu0);
+        timers->AddTask(tl, first_order_flux_correct, "ReceiveFluxCorrections",
+                        parthenon::ReceiveFluxCorrections, mu0);
+    auto set_flx = timers->AddTask(tl, recv_flx, "SetFluxCorrections",
+                                   parthenon::SetFluxCorrections, mu0);
 
     // compute the divergence of fluxes of conserved variables
-    auto update = tl.AddTask(
-        set_flx, parthenon::Update::UpdateWithFluxDivergence<MeshData<Real>>, mu0.get(),
-        mu1.get(), integrator->gam0[stage - 1], integrator->gam1[stage - 1],
-        integrator->beta[stage - 1] * integrator->dt);
+    auto update = none;
+    if (hydro_pkg->Param<bool>("glmmhd_fused_update")) {
+      auto *update_fun = hydro_pkg->Param<GLMMHD::UpdateFun_t *>("glmmhd_update_fun");
+      const bool first_stage = stage == 1 && fused_u1_init;
+      update = timers->AddTask(tl, set_flx, "UpdateWithFluxDivergence", update_fun,
+                               mu0.get(), u1_required, integrator->gam0[stage - 1],
+                               integrator->gam1[stage - 1],
+                               integrator->beta[stage - 1] * integrator->dt, first_stage);
+    } else if (stage == 1 && fused_u1_init) {
+      update = timers->AddTask(tl, set_flx, "UpdateWithFluxDivergence",
+                               UpdateWithFluxDivergenceFirstStage, mu0.get(), u1_required,
+                               integrator->beta[stage - 1] * integrator->dt);
+    } else {
+      update = timers->AddTask(tl, set_flx, "UpdateWithFluxDivergence",
+                               UpdateWithFluxDivergence, mu0.get(),
+                               integrator->gam0[stage - 1], integrator->gam1[stage - 1],
+                               integrator->beta[stage - 1] * integrator->dt);
+    }
 
     // Add non-operator split source terms.
     // Note: Directly update the "cons" variables of mu0 based on the "prim" variables
     // of mu0 as the "cons" variables have already been updated in this stage from the
     // fluxes in the previous step.
-    auto source_unsplit = tl.AddTask(update, AddUnsplitSources, mu0.get(), tm,
-                                     integrator->beta[stage - 1] * integrator->dt);
+    auto source_unsplit =
+        timers->AddTask(tl, update, "AddUnsplitSources", AddUnsplitSources, mu0.get(), tm,
+                        integrator->beta[stage - 1] * integrator->dt);
 
     auto source_split_first_order = source_unsplit;
 
@@ -322,22 +654,43 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
       // IMPORTANT: The tasks should work using `cons` variables as input as in the
       // final step, `prim` are not updated yet from the flux calculation.
       auto source_split_strang_final =
-          tl.AddTask(source_unsplit, AddSplitSourcesStrang, mu0.get(), tm);
+          timers->AddTask(tl, source_unsplit, "AddSplitSourcesStrang",
+                          AddSplitSourcesStrang, mu0.get(), tm);
 
       // Add operator split source terms at first order, i.e., full dt update
       // after all stages of the integration.
       // Not recommended for but allows easy "reset" of variable for some
       // problem types, see random blasts.
       source_split_first_order =
-          tl.AddTask(source_split_strang_final, AddSplitSourcesFirstOrder, mu0.get(), tm);
+          timers->AddTask(tl, source_split_strang_final, "AddSplitSourcesFirstOrder",
+                          AddSplitSourcesFirstOrder, mu0.get(), tm);
     }
 
     // Update ghost cells (local and non local)
-    // TODO(someone) experiment with split (local/nonlocal) comms with respect to
-    // performance for various tests (static, amr, block sizes) and then decide on the
-    // best impl. Go with default call (split local/nonlocal) for now.
-    parthenon::AddBoundaryExchangeTasks(source_split_first_order, tl, mu0,
-                                        pmesh->multilevel);
+    if (!time_boundary_exchange) {
+      AddGhostExchangeTasks(source_split_first_order, tl, mu0, boundary_exchange,
+                            pmesh->multilevel, timers);
+    }
+  }
+
+  // Separate regions so that the time of the ghost zone exchange can be measured, see
+  // tst/regression/test_suites/performance_comm for a benchmark of both strategies.
+  if (time_boundary_exchange) {
+    TaskRegion &start_timer_region = tc.AddRegion(1);
+    timers->AddTask(start_timer_region[0], none, "StartBoundaryExchangeTimer",
+                    StartBoundaryExchangeTimer, hydro_pkg.get());
+
+    TaskRegion &exchange_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+      AddGhostExchangeTasks(none, exchange_region[i], mu0, boundary_exchange,
+                            pmesh->multilevel, timers);
+    }
+
+    TaskRegion &stop_timer_region = tc.AddRegion(1);
+    timers->AddTask(stop_timer_region[0], none, "StopBoundaryExchangeTimer",
+                    StopBoundaryExchangeTimer, hydro_pkg.get(),
+                    stage == integrator->nstages, tm.ncycle);
   }
 
   TaskRegion &async_region_3 = tc.AddRegion(num_task_lists_executed_independently);
@@ -352,44 +705,85 @@ TaskCollection HydroDriver::MakeTaskCollection(BlockList_t &blocks, int stage) {
     //}
 
     // set physical boundaries
-    auto set_bc = tl.AddTask(prolongBound, parthenon::ApplyBoundaryConditions, u0);
+    auto set_bc = timers->AddTask(tl, prolongBound, "ApplyBoundaryConditions",
+                                  parthenon::ApplyBoundaryConditions, u0);
+  }
+
+  // Final Strang split diffusion update. The diffusive fluxes require the primitive
+  // variables of the updated state, which are subsequently calculated again (together
+  // with the new timestep) below.
+  if (stage == integrator->nstages && rkl2) {
+    TaskRegion &fill_derived_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+      timers->AddTask(fill_derived_region[i], none, "FillDerived",
+                      parthenon::Update::FillDerived<MeshData<Real>>, mu0.get());
+    }
+    AddRKL2Tasks(tc, pmesh, blocks, hydro_pkg.get(), 0.5 * tm.dt, false, timers);
   }
 
   // Single task in single (serial) region to reset global vars used in reductions in the
   // first stage.
-  if (stage == integrator->nstages && hydro_pkg->Param<bool>("calc_c_h")) {
+  if (stage == integrator->nstages && (hydro_pkg->Param<bool>("calc_c_h") || rkl2)) {
     TaskRegion &reset_reduction_vars_region = tc.AddRegion(1);
     auto &tl = reset_reduction_vars_region[0];
-    tl.AddTask(
-        none,
-        [](StateDescriptor *hydro_pkg) {
-          hydro_pkg->UpdateParam("mindx", std::numeric_limits<Real>::max());
-          hydro_pkg->UpdateParam("dt_hyp", std::numeric_limits<Real>::max());
+    timers->AddTask(
+        tl, none, "ResetReductionVars",
+        [](StateDescriptor *hydro_pkg, const bool calc_c_h, const bool rkl2) {
+          if (calc_c_h) {
+            hydro_pkg->UpdateParam("dt_hyp", std::numeric_limits<Real>::max());
+          }
+          if (rkl2) {
+            hydro_pkg->UpdateParam("dt_diff", std::numeric_limits<Real>::max());
+          }
           return TaskStatus::complete;
         },
-        hydro_pkg.get());
+        hydro_pkg.get(), hydro_pkg->Param<bool>("calc_c_h"), rkl2);
   }
 
   TaskRegion &single_tasklist_per_pack_region_3 = tc.AddRegion(num_partitions);
   for (int i = 0; i < num_partitions; i++) {
     auto &tl = single_tasklist_per_pack_region_3[i];
     auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
-    auto fill_derived =
-        tl.AddTask(none, parthenon::Update::FillDerived<MeshData<Real>>, mu0.get());
-
-    if (stage == integrator->nstages) {
-      auto new_dt = tl.AddTask(
-          fill_derived, parthenon::Update::EstimateTimestep<MeshData<Real>>, mu0.get());
+    if (stage == integrator->nstages && hydro_pkg->Param<bool>("fused_dt_estimate")) {
+      // Hydro is the only package with derived fields and timestep constraints so that
+      // both can be handled in a single fused task in the final stage.
+      auto *fill_derived_and_estimate_dt =
+          hydro_pkg->Param<FillDerivedAndEstimateTimestepFun_t *>(
+              "fill_derived_and_estimate_timestep_fun");
+      auto new_dt = timers->AddTask(tl, none, "FillDerivedAndEstimateTimestep",
+                                    fill_derived_and_estimate_dt, mu0.get());
+    } else {
+      auto fill_derived =
+          timers->AddTask(tl, none, "FillDerived",
+                          parthenon::Update::FillDerived<MeshData<Real>>, mu0.get());
+
+      if (stage == integrator->nstages) {
+        auto new_dt = timers->AddTask(tl, fill_derived, "EstimateTimestep",
+                                      parthenon::Update::EstimateTimestep<MeshData<Real>>,
+                                      mu0.get());
+      }
     }
   }
 
-  if (stage == integrator->nstages && pmesh->adaptive) {
-    TaskRegion &async_region_4 = tc.AddRegion(num_task_lists_executed_independently);
-    for (int i = 0; i < blocks.size(); i++) {
+  // The limiter counters are shared by all partitions of the rank
+  if (stage == integrator->nstages && hydro_pkg->Param<bool>("count_limiters")) {
+    TaskRegion &limiter_counts_region = tc.AddRegion(1);
+    timers->AddTask(limiter_counts_region[0], none, "ContributeLimiterCounts",
+                    ContributeLimiterCounts, hydro_pkg.get());
+  }
+
+  const auto check_interval = hydro_pkg->Param<int>("refinement/check_interval");
+  if (stage == integrator->nstages && pmesh->adaptive &&
+      tm.ncycle % check_interval == 0) {
+    // Tag all blocks of a partition at once (see refinement.hpp)
+    TaskRegion &async_region_4 = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
       auto &tl = async_region_4[i];
-      auto &u0 = blocks[i]->meshblock_data.Get("base");
-      auto tag_refine =
-          tl.AddTask(none, parthenon::Refinement::Tag<MeshBlockData<Real>>, u0.get());
+      auto &mu0 = pmesh->mesh_data.GetOrAdd("base", i);
+      auto tag_refine = timers->AddTask(tl, none, "Tag",
+                                        parthenon::Refinement::Tag<MeshData<Real>>,
+                                        mu0.get());
     }
   }
 
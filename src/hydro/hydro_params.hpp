@@ -0,0 +1,96 @@
+#ifndef HYDRO_HYDRO_PARAMS_HPP_
+#define HYDRO_HYDRO_PARAMS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file hydro_params.hpp
+//  \brief Typed run parameters of the hydro package used in hot (host) code paths
+//
+// Tasks are called per partition and per stage so that (with many small partitions) the
+// string keyed lookups of the individual package params add up to a noticeable host
+// overhead between kernel launches. HydroParams collects these params and is stored as
+// a single package param ("hydro_params") that is built at the end of
+// Hydro::Initialize. The individual params remain the reference (e.g., for problem
+// generators) and the two mutable entries (c_h and scratch_level) are refreshed
+// whenever the corresponding individual params are updated.
+
+// Parthenon headers
+#include <interface/state_descriptor.hpp>
+#include <mesh/mesh.hpp>
+
+// AthenaPK headers
+#include "../eos/adiabatic_glmmhd.hpp"
+#include "../eos/adiabatic_hydro.hpp"
+#include "../main.hpp"
+#include "../recon/hybrid_simple.hpp"
+
+namespace Hydro {
+
+// Thresholds of the indicator of the hybrid Riemann solvers (see rsolvers/hybrid.hpp).
+// The accurate solver is used if any threshold is exceeded.
+struct HybridRiemannParams {
+  Real pressure_jump; // relative pressure jump |p_L - p_R| / min(p_L, p_R)
+  Real mach2;         // square of the Mach number (of the L or R state)
+  Real beta;          // (MHD only) the accurate solver is used below this plasma beta
+};
+
+struct HydroParams {
+  // Both equations of state are stored (with identical floors and ceilings) so that the
+  // struct is independent of the fluid. Only the one of the chosen fluid is used.
+  HydroParams(const AdiabaticHydroEOS &hydro_eos, const AdiabaticGLMMHDEOS &glmmhd_eos)
+      : hydro_eos(hydro_eos), glmmhd_eos(glmmhd_eos) {}
+
+  template <Fluid fluid>
+  const auto &GetEOS() const {
+    if constexpr (fluid == Fluid::euler) {
+      return hydro_eos;
+    } else {
+      return glmmhd_eos;
+    }
+  }
+
+  Fluid fluid;
+  Reconstruction recon;
+  RiemannSolver riemann;
+  int nhydro, nscalars;
+
+  Real cfl;
+  bool calc_dt_hyp;
+  Real max_dt;
+
+  bool glmmhd_fused_update;
+  bool reconstruct_all_vars, transverse_stencil_cache;
+  int cons_to_prim_nghost;
+
+  HybridRiemannParams hybrid_riemann;
+  HybridReconstruction hybrid_recon;
+
+  Cooling enable_cooling;
+  Conduction conduction;
+  DiffInt diffint;
+
+  // mutable
+  Real c_h;          // hyperbolic divergence cleaning speed (GLM MHD only)
+  int scratch_level; // (changed by the flux autotuner)
+
+  AdiabaticHydroEOS hydro_eos;
+  AdiabaticGLMMHDEOS glmmhd_eos;
+};
+
+// Builds the run parameters from the individual params of the package
+HydroParams MakeHydroParams(parthenon::StateDescriptor *pkg);
+
+// Refreshes the mutable entries from the corresponding individual params (to be called
+// after those are updated)
+void RefreshHydroParams(parthenon::StateDescriptor *pkg);
+
+inline const HydroParams &GetHydroParams(parthenon::MeshData<Real> *md) {
+  auto pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  return pkg->Param<HydroParams>("hydro_params");
+}
+
+} // namespace Hydro
+
+#endif // HYDRO_HYDRO_PARAMS_HPP_
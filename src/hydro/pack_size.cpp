@@ -0,0 +1,119 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file pack_size.cpp
+//  \brief Automatic choice of the number of blocks per MeshData partition (pack)
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "pack_size.hpp"
+#include "utils/error_checking.hpp"
+
+namespace Hydro {
+
+int EstimatePackSize(const int num_blocks, const std::int64_t cells_per_block,
+                     const int concurrency, const Real oversubscription,
+                     const int min_partitions) {
+  if (num_blocks < 1) {
+    return 1;
+  }
+  const auto target_cells = oversubscription * static_cast<Real>(concurrency);
+  const auto ncells = static_cast<Real>(std::max<std::int64_t>(cells_per_block, 1));
+  auto pack_size = static_cast<int>(std::ceil(target_cells / ncells));
+  // Keep the requested minimum number of partitions (as long as there are enough blocks)
+  const auto max_pack_size = (num_blocks + min_partitions - 1) / min_partitions;
+  pack_size = std::min(pack_size, max_pack_size);
+  return std::clamp(pack_size, 1, num_blocks);
+}
+
+void InitPackSize(ParameterInput *pin, StateDescriptor *pkg) {
+  const auto auto_pack_size = pin->GetOrAddBoolean("hydro", "auto_pack_size", false);
+  pkg->AddParam<>("auto_pack_size", auto_pack_size);
+  if (!auto_pack_size) {
+    return;
+  }
+  const auto oversubscription = pin->GetOrAddReal("hydro", "pack_oversubscription", 4.0);
+  const auto min_partitions = pin->GetOrAddInteger("hydro", "pack_min_partitions", 1);
+  PARTHENON_REQUIRE_THROWS(oversubscription > 0.0,
+                           "AthenaPK hydro: pack_oversubscription must be positive");
+  PARTHENON_REQUIRE_THROWS(min_partitions > 0,
+                           "AthenaPK hydro: pack_min_partitions must be positive");
+  pkg->AddParam<>("pack_oversubscription", oversubscription);
+  pkg->AddParam<>("pack_min_partitions", min_partitions);
+  // Threads that can be resident on the device (or host threads) at the same time
+  const auto concurrency = static_cast<int>(DevExecSpace().concurrency());
+  pkg->AddParam<>("pack_concurrency", concurrency);
+
+  // Root grid blocks (evenly) distributed over all ranks. Blocks created by the initial
+  // refinement are only accounted for by the first reevaluation.
+  std::int64_t num_root_blocks = 1;
+  std::int64_t cells_per_block = 1;
+  for (const auto &dir : {"1", "2", "3"}) {
+    const auto nx = pin->GetOrAddInteger("parthenon/mesh", std::string("nx") + dir, 1);
+    const auto nx_block =
+        pin->GetOrAddInteger("parthenon/meshblock", std::string("nx") + dir, nx);
+    num_root_blocks *= nx / nx_block;
+    cells_per_block *= nx_block;
+  }
+  const auto num_blocks = static_cast<int>(
+      (num_root_blocks + parthenon::Globals::nranks - 1) / parthenon::Globals::nranks);
+
+  pkg->AddParam<>("pack_size_num_blocks", num_blocks, true);
+  // An explicit pack size (including the one chosen by a previous run on restarts)
+  // takes precedence.
+  if (pin->DoesParameterExist("parthenon/mesh", "pack_size")) {
+    return;
+  }
+  const auto pack_size = EstimatePackSize(num_blocks, cells_per_block, concurrency,
+                                          oversubscription, min_partitions);
+  pin->SetInteger("parthenon/mesh", "pack_size", pack_size);
+
+  if (parthenon::Globals::my_rank == 0) {
+    std::cout << "Automatic pack size: " << pack_size << " block(s) per pack for "
+              << num_blocks << " block(s) of " << cells_per_block
+              << " cells per rank and a concurrency of " << concurrency << std::endl;
+  }
+}
+
+void ReevaluatePackSize(Mesh *pmesh, StateDescriptor *pkg) {
+  if (!pkg->Param<bool>("auto_pack_size")) {
+    return;
+  }
+  const auto num_blocks = static_cast<int>(pmesh->block_list.size());
+  if (num_blocks == pkg->Param<int>("pack_size_num_blocks")) {
+    return;
+  }
+  pkg->UpdateParam("pack_size_num_blocks", num_blocks);
+
+  const auto &block_size = pmesh->block_list.front()->block_size;
+  const auto cells_per_block =
+      static_cast<std::int64_t>(block_size.nx1) * block_size.nx2 * block_size.nx3;
+  const auto pack_size =
+      EstimatePackSize(num_blocks, cells_per_block, pkg->Param<int>("pack_concurrency"),
+                       pkg->Param<Real>("pack_oversubscription"),
+                       pkg->Param<int>("pack_min_partitions"));
+  const auto num_partitions = (num_blocks + pack_size - 1) / pack_size;
+  // The pack size of the Mesh is fixed after its construction so that a changed
+  // estimate can only be applied by restarting with the reported pack_size.
+  if (num_partitions != pmesh->DefaultNumPartitions() &&
+      parthenon::Globals::my_rank == 0) {
+    std::cout << "Automatic pack size: " << num_blocks << " block(s) on rank 0 would "
+              << "use a pack_size of " << pack_size << " (" << num_partitions
+              << " partitions instead of " << pmesh->DefaultNumPartitions()
+              << "). Set parthenon/mesh/pack_size on restart to apply." << std::endl;
+  }
+}
+
+} // namespace Hydro
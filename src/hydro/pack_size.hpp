@@ -0,0 +1,39 @@
+#ifndef HYDRO_PACK_SIZE_HPP_
+#define HYDRO_PACK_SIZE_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file pack_size.hpp
+//  \brief Automatic choice of the number of blocks per MeshData partition (pack)
+
+// C++ headers
+#include <cstdint>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+using namespace parthenon::package::prelude;
+
+namespace Hydro {
+
+// Number of blocks per pack so that each pack contains (at least) `oversubscription`
+// times as many cells as the device can process concurrently (so that a kernel over a
+// pack fills the device) while keeping at least `min_partitions` partitions per rank
+// (so that tasks of different partitions can overlap with communication).
+int EstimatePackSize(int num_blocks, std::int64_t cells_per_block, int concurrency,
+                     Real oversubscription, int min_partitions);
+
+// Sets `parthenon/mesh/pack_size` from the estimate for the root grid (only if enabled
+// via hydro/auto_pack_size and if not set explicitly or by a previous run when
+// restarting). Needs to be called before the Mesh is constructed.
+void InitPackSize(ParameterInput *pin, StateDescriptor *pkg);
+
+// Reevaluates the estimate if the number of blocks on this rank changed (e.g., after
+// remeshing or load balancing) and reports if it differs from the current partitioning.
+void ReevaluatePackSize(Mesh *pmesh, StateDescriptor *pkg);
+
+} // namespace Hydro
+
+#endif // HYDRO_PACK_SIZE_HPP_
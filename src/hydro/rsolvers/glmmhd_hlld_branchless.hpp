@@ -0,0 +1,353 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+//! \file glmmhd_hlld_branchless.hpp
+//! \brief HLLD Riemann solver for adiabatic MHD without data dependent branches.
+//!
+//! Same states and fluxes as the default HLLD solver (glmmhd_hlld.hpp) but the
+//! degenerate cases and the five wave regions are handled by computing all candidates
+//! and selecting the result (ternary operators that compile to predicated
+//! selects/blends) rather than by branching. This reduces warp divergence on GPUs and
+//! allows vectorization of the interface loop on CPUs at the cost of always computing
+//! all intermediate states. The fluxes agree with the default solver to round-off (the
+//! divisions in eqns (44)-(47) are replaced by multiplications with the reciprocal).
+//!
+//! REFERENCES:
+//! - T. Miyoshi & K. Kusano, "A multi-state HLL approximate Riemann solver for ideal
+//!   MHD", JCP, 208, 315 (2005)
+
+#ifndef RSOLVERS_GLMMHD_HLLD_BRANCHLESS_HPP_
+#define RSOLVERS_GLMMHD_HLLD_BRANCHLESS_HPP_
+
+// C++ headers
+#include <algorithm> // max(), min()
+#include <cmath>     // sqrt()
+
+// Athena headers
+#include "../../eos/adiabatic_glmmhd.hpp"
+#include "../../main.hpp"
+#include "glmmhd_hlld.hpp" // Cons1D and SMALL_NUMBER
+#include "interface/variable_pack.hpp"
+#include "rsolvers.hpp"
+
+template <>
+struct Riemann<Fluid::glmmhd, RiemannSolver::hlld_branchless> {
+  template <typename T>
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+        const int iu, const int ivx, const ScratchPad2D<T> &wl,
+        const ScratchPad2D<T> &wr, VariableFluxPack<Real> &cons,
+        const AdiabaticGLMMHDEOS &eos, const Real c_h) {
+    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+      Solve(k, j, i, ivx, wl, wr, cons, eos, c_h);
+    });
+  }
+
+  // Flux of one side of the contact, i.e., the outer flux plus the jumps across the
+  // fast and Alfven waves that are crossed to reach the interface
+  static KOKKOS_FORCEINLINE_FUNCTION Real SideFlux(const Real f, const bool add_st,
+                                                   const Real df_st, const bool add_dst,
+                                                   const Real df_dst) {
+    return f + (add_st ? df_st : 0.0) + (add_dst ? df_dst : 0.0);
+  }
+
+  // Flux at a single interface i-1/2 with wl(n, i) and wr(n, i) being the L/R states
+  template <typename State, typename Fluxes>
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(const int k, const int j, const int i, const int ivx, const State &wl,
+        const State &wr, Fluxes &cons, const AdiabaticGLMMHDEOS &eos,
+        const Real c_h) {
+    const int ivy = IV1 + ((ivx - IV1) + 1) % 3;
+    const int ivz = IV1 + ((ivx - IV1) + 2) % 3;
+    const int iBx = ivx - 1 + NHYDRO;
+    const int iBy = ivy - 1 + NHYDRO;
+    const int iBz = ivz - 1 + NHYDRO;
+
+    const auto gamma = eos.GetGamma();
+    const auto gm1 = gamma - 1.0;
+    const auto igm1 = 1.0 / gm1;
+
+    constexpr int NGLMMHD = 9;
+
+    Real wli[NGLMMHD], wri[NGLMMHD], flxi[NGLMMHD];
+    Real spd[5];                     // signal speeds, left to right
+    Cons1D ul, ur;                   // L/R states, conserved variables (computed)
+    Cons1D ulst, uldst, urdst, urst; // Conserved variable for all states
+    Cons1D fl, fr;                   // Fluxes for left & right states
+
+    //--- Step 1.  Load L/R states into local variables
+
+    wli[IDN] = wl(IDN, i);
+    wli[IV1] = wl(ivx, i);
+    wli[IV2] = wl(ivy, i);
+    wli[IV3] = wl(ivz, i);
+    wli[IPR] = wl(IPR, i);
+    wli[IB1] = wl(iBx, i);
+    wli[IB2] = wl(iBy, i);
+    wli[IB3] = wl(iBz, i);
+    wli[IPS] = wl(IPS, i);
+
+    wri[IDN] = wr(IDN, i);
+    wri[IV1] = wr(ivx, i);
+    wri[IV2] = wr(ivy, i);
+    wri[IV3] = wr(ivz, i);
+    wri[IPR] = wr(IPR, i);
+    wri[IB1] = wr(iBx, i);
+    wri[IB2] = wr(iBy, i);
+    wri[IB3] = wr(iBz, i);
+    wri[IPS] = wr(IPS, i);
+
+    // first solve the decoupled state, see eq (24) in Mignone & Tzeferacos (2010)
+    const Real bxi = 0.5 * (wli[IB1] + wri[IB1]) - 0.5 / c_h * (wri[IPS] - wli[IPS]);
+    const Real psii = 0.5 * (wli[IPS] + wri[IPS]) - 0.5 * c_h * (wri[IB1] - wli[IB1]);
+    // and store flux
+    flxi[IB1] = psii;
+    flxi[IPS] = SQR(c_h) * bxi;
+
+    // Compute L/R states for selected conserved variables
+    const Real bxsq = bxi * bxi;
+    // (KGF): group transverse vector components for floating-point associativity
+    // symmetry
+    const Real pbl = 0.5 * (bxsq + (SQR(wli[IB2]) + SQR(wli[IB3])));
+    const Real pbr = 0.5 * (bxsq + (SQR(wri[IB2]) + SQR(wri[IB3])));
+    const Real kel = 0.5 * wli[IDN] * (SQR(wli[IV1]) + (SQR(wli[IV2]) + SQR(wli[IV3])));
+    const Real ker = 0.5 * wri[IDN] * (SQR(wri[IV1]) + (SQR(wri[IV2]) + SQR(wri[IV3])));
+
+    ul.d = wli[IDN];
+    ul.mx = wli[IV1] * ul.d;
+    ul.my = wli[IV2] * ul.d;
+    ul.mz = wli[IV3] * ul.d;
+    ul.e = wli[IPR] * igm1 + kel + pbl;
+    ul.by = wli[IB2];
+    ul.bz = wli[IB3];
+
+    ur.d = wri[IDN];
+    ur.mx = wri[IV1] * ur.d;
+    ur.my = wri[IV2] * ur.d;
+    ur.mz = wri[IV3] * ur.d;
+    ur.e = wri[IPR] * igm1 + ker + pbr;
+    ur.by = wri[IB2];
+    ur.bz = wri[IB3];
+
+    //--- Step 2.  Compute L & R wave speeds according to Miyoshi & Kusano, eqn. (67)
+
+    const auto cfl =
+        eos.FastMagnetosonicSpeed(wli[IDN], wli[IPR], wli[IB1], wli[IB2], wli[IB3]);
+    const auto cfr =
+        eos.FastMagnetosonicSpeed(wri[IDN], wri[IPR], wri[IB1], wri[IB2], wri[IB3]);
+
+    spd[0] = std::min(wli[IV1] - cfl, wri[IV1] - cfr);
+    spd[4] = std::max(wli[IV1] + cfl, wri[IV1] + cfr);
+
+    //--- Step 3.  Compute L/R fluxes
+
+    const Real ptl = wli[IPR] + pbl; // total pressures L,R
+    const Real ptr = wri[IPR] + pbr;
+
+    fl.d = ul.mx;
+    fl.mx = ul.mx * wli[IV1] + ptl - bxsq;
+    fl.my = ul.my * wli[IV1] - bxi * ul.by;
+    fl.mz = ul.mz * wli[IV1] - bxi * ul.bz;
+    fl.e = wli[IV1] * (ul.e + ptl - bxsq) - bxi * (wli[IV2] * ul.by + wli[IV3] * ul.bz);
+    fl.by = ul.by * wli[IV1] - bxi * wli[IV2];
+    fl.bz = ul.bz * wli[IV1] - bxi * wli[IV3];
+
+    fr.d = ur.mx;
+    fr.mx = ur.mx * wri[IV1] + ptr - bxsq;
+    fr.my = ur.my * wri[IV1] - bxi * ur.by;
+    fr.mz = ur.mz * wri[IV1] - bxi * ur.bz;
+    fr.e = wri[IV1] * (ur.e + ptr - bxsq) - bxi * (wri[IV2] * ur.by + wri[IV3] * ur.bz);
+    fr.by = ur.by * wri[IV1] - bxi * wri[IV2];
+    fr.bz = ur.bz * wri[IV1] - bxi * wri[IV3];
+
+    //--- Step 4.  Compute middle and Alfven wave speeds
+
+    const Real sdl = spd[0] - wli[IV1]; // S_i-u_i (i=L or R)
+    const Real sdr = spd[4] - wri[IV1];
+
+    // S_M: eqn (38) of Miyoshi & Kusano
+    // (KGF): group ptl, ptr terms for floating-point associativity symmetry
+    spd[2] = (sdr * ur.mx - sdl * ul.mx + (ptl - ptr)) / (sdr * ur.d - sdl * ul.d);
+
+    const Real sdml = spd[0] - spd[2]; // S_i-S_M (i=L or R)
+    const Real sdmr = spd[4] - spd[2];
+    const Real sdml_inv = 1.0 / sdml;
+    const Real sdmr_inv = 1.0 / sdmr;
+    // eqn (43) of Miyoshi & Kusano
+    ulst.d = ul.d * sdl * sdml_inv;
+    urst.d = ur.d * sdr * sdmr_inv;
+    const Real ulst_d_inv = 1.0 / ulst.d;
+    const Real urst_d_inv = 1.0 / urst.d;
+    const Real sqrtdl = std::sqrt(ulst.d);
+    const Real sqrtdr = std::sqrt(urst.d);
+
+    // eqn (51) of Miyoshi & Kusano
+    spd[1] = spd[2] - std::abs(bxi) / sqrtdl;
+    spd[3] = spd[2] + std::abs(bxi) / sqrtdr;
+
+    //--- Step 5.  Compute intermediate states
+    // eqn (23) explicitly becomes eq (41) of Miyoshi & Kusano
+    const Real ptstl = ptl + ul.d * sdl * (spd[2] - wli[IV1]);
+    const Real ptstr = ptr + ur.d * sdr * (spd[2] - wri[IV1]);
+    const Real ptst = 0.5 * (ptstr + ptstl); // total pressure (star state)
+
+    // ul* - eqn (39) of M&K
+    // In the degenerate case, the transverse velocities and fields are continuous across
+    // the fast wave, which is identical to eqns (44)-(47) with tmp_v = 0 and tmp_b = 1.
+    ulst.mx = ulst.d * spd[2];
+    const Real denl = ul.d * sdl * sdml - bxsq;
+    const bool degenerate_l = std::abs(denl) < (SMALL_NUMBER)*ptst;
+    const Real denl_inv = degenerate_l ? 0.0 : 1.0 / denl;
+    // eqns (44) and (46) of M&K
+    const Real tmp_vl = bxi * (sdl - sdml) * denl_inv;
+    ulst.my = ulst.d * (wli[IV2] - ul.by * tmp_vl);
+    ulst.mz = ulst.d * (wli[IV3] - ul.bz * tmp_vl);
+    // eqns (45) and (47) of M&K
+    const Real tmp_bl = degenerate_l ? 1.0 : (ul.d * SQR(sdl) - bxsq) * denl_inv;
+    ulst.by = ul.by * tmp_bl;
+    ulst.bz = ul.bz * tmp_bl;
+    // v_i* dot B_i*
+    // (KGF): group transverse momenta terms for floating-point associativity symmetry
+    const Real vbstl =
+        (ulst.mx * bxi + (ulst.my * ulst.by + ulst.mz * ulst.bz)) * ulst_d_inv;
+    // eqn (48) of M&K
+    // (KGF): group transverse by, bz terms for floating-point associativity symmetry
+    ulst.e = (sdl * ul.e - ptl * wli[IV1] + ptst * spd[2] +
+              bxi * (wli[IV1] * bxi + (wli[IV2] * ul.by + wli[IV3] * ul.bz) - vbstl)) *
+             sdml_inv;
+
+    // ur* - eqn (39) of M&K
+    urst.mx = urst.d * spd[2];
+    const Real denr = ur.d * sdr * sdmr - bxsq;
+    const bool degenerate_r = std::abs(denr) < (SMALL_NUMBER)*ptst;
+    const Real denr_inv = degenerate_r ? 0.0 : 1.0 / denr;
+    // eqns (44) and (46) of M&K
+    const Real tmp_vr = bxi * (sdr - sdmr) * denr_inv;
+    urst.my = urst.d * (wri[IV2] - ur.by * tmp_vr);
+    urst.mz = urst.d * (wri[IV3] - ur.bz * tmp_vr);
+    // eqns (45) and (47) of M&K
+    const Real tmp_br = degenerate_r ? 1.0 : (ur.d * SQR(sdr) - bxsq) * denr_inv;
+    urst.by = ur.by * tmp_br;
+    urst.bz = ur.bz * tmp_br;
+    // v_i* dot B_i*
+    // (KGF): group transverse momenta terms for floating-point associativity symmetry
+    const Real vbstr =
+        (urst.mx * bxi + (urst.my * urst.by + urst.mz * urst.bz)) * urst_d_inv;
+    // eqn (48) of M&K
+    // (KGF): group transverse by, bz terms for floating-point associativity symmetry
+    urst.e = (sdr * ur.e - ptr * wri[IV1] + ptst * spd[2] +
+              bxi * (wri[IV1] * bxi + (wri[IV2] * ur.by + wri[IV3] * ur.bz) - vbstr)) *
+             sdmr_inv;
+
+    // ul** and ur** - if Bx is near zero, same as *-states
+    // Both candidates are computed and the ** state is selected per component.
+    const bool bx_zero = 0.5 * bxsq < (SMALL_NUMBER)*ptst;
+    const Real invsumd = 1.0 / (sqrtdl + sqrtdr);
+    const Real bxsig = (bxi > 0.0 ? 1.0 : -1.0);
+
+    // eqn (59) of M&K
+    const Real vydst =
+        invsumd * (sqrtdl * (ulst.my * ulst_d_inv) + sqrtdr * (urst.my * urst_d_inv) +
+                   bxsig * (urst.by - ulst.by));
+    // eqn (60) of M&K
+    const Real vzdst =
+        invsumd * (sqrtdl * (ulst.mz * ulst_d_inv) + sqrtdr * (urst.mz * urst_d_inv) +
+                   bxsig * (urst.bz - ulst.bz));
+    // eqn (61) of M&K
+    const Real bydst = invsumd * (sqrtdl * urst.by + sqrtdr * ulst.by +
+                                  bxsig * sqrtdl * sqrtdr *
+                                      ((urst.my * urst_d_inv) - (ulst.my * ulst_d_inv)));
+    // eqn (62) of M&K
+    const Real bzdst = invsumd * (sqrtdl * urst.bz + sqrtdr * ulst.bz +
+                                  bxsig * sqrtdl * sqrtdr *
+                                      ((urst.mz * urst_d_inv) - (ulst.mz * ulst_d_inv)));
+
+    uldst.d = ulst.d;
+    urdst.d = urst.d;
+    uldst.mx = ulst.mx;
+    urdst.mx = urst.mx;
+    uldst.my = bx_zero ? ulst.my : uldst.d * vydst;
+    urdst.my = bx_zero ? urst.my : urdst.d * vydst;
+    uldst.mz = bx_zero ? ulst.mz : uldst.d * vzdst;
+    urdst.mz = bx_zero ? urst.mz : urdst.d * vzdst;
+    uldst.by = bx_zero ? ulst.by : bydst;
+    urdst.by = bx_zero ? urst.by : bydst;
+    uldst.bz = bx_zero ? ulst.bz : bzdst;
+    urdst.bz = bx_zero ? urst.bz : bzdst;
+
+    // eqn (63) of M&K
+    const Real vbdst = spd[2] * bxi + (uldst.my * bydst + uldst.mz * bzdst) / uldst.d;
+    uldst.e = bx_zero ? ulst.e : ulst.e - sqrtdl * bxsig * (vbstl - vbdst);
+    urdst.e = bx_zero ? urst.e : urst.e + sqrtdr * bxsig * (vbstr - vbdst);
+
+    //--- Step 6.  Compute flux
+    uldst.d = spd[1] * (uldst.d - ulst.d);
+    uldst.mx = spd[1] * (uldst.mx - ulst.mx);
+    uldst.my = spd[1] * (uldst.my - ulst.my);
+    uldst.mz = spd[1] * (uldst.mz - ulst.mz);
+    uldst.e = spd[1] * (uldst.e - ulst.e);
+    uldst.by = spd[1] * (uldst.by - ulst.by);
+    uldst.bz = spd[1] * (uldst.bz - ulst.bz);
+
+    ulst.d = spd[0] * (ulst.d - ul.d);
+    ulst.mx = spd[0] * (ulst.mx - ul.mx);
+    ulst.my = spd[0] * (ulst.my - ul.my);
+    ulst.mz = spd[0] * (ulst.mz - ul.mz);
+    ulst.e = spd[0] * (ulst.e - ul.e);
+    ulst.by = spd[0] * (ulst.by - ul.by);
+    ulst.bz = spd[0] * (ulst.bz - ul.bz);
+
+    urdst.d = spd[3] * (urdst.d - urst.d);
+    urdst.mx = spd[3] * (urdst.mx - urst.mx);
+    urdst.my = spd[3] * (urdst.my - urst.my);
+    urdst.mz = spd[3] * (urdst.mz - urst.mz);
+    urdst.e = spd[3] * (urdst.e - urst.e);
+    urdst.by = spd[3] * (urdst.by - urst.by);
+    urdst.bz = spd[3] * (urdst.bz - urst.bz);
+
+    urst.d = spd[4] * (urst.d - ur.d);
+    urst.mx = spd[4] * (urst.mx - ur.mx);
+    urst.my = spd[4] * (urst.my - ur.my);
+    urst.mz = spd[4] * (urst.mz - ur.mz);
+    urst.e = spd[4] * (urst.e - ur.e);
+    urst.by = spd[4] * (urst.by - ur.by);
+    urst.bz = spd[4] * (urst.bz - ur.bz);
+
+    // Wave region selection. As spd[0] <= spd[1] <= spd[2] <= spd[3] <= spd[4] this
+    // matches the if-else cascade of the default solver:
+    // Fl (supersonic), Fl*, Fl**, Fr**, Fr*, Fr (supersonic).
+    const bool use_left = spd[0] >= 0.0 || (spd[4] > 0.0 && spd[2] >= 0.0);
+    const bool add_lst = spd[0] < 0.0;
+    const bool add_ldst = add_lst && spd[1] < 0.0;
+    const bool add_rst = spd[4] > 0.0;
+    const bool add_rdst = add_rst && spd[3] > 0.0;
+
+    flxi[IDN] = use_left ? SideFlux(fl.d, add_lst, ulst.d, add_ldst, uldst.d)
+                         : SideFlux(fr.d, add_rst, urst.d, add_rdst, urdst.d);
+    flxi[IV1] = use_left ? SideFlux(fl.mx, add_lst, ulst.mx, add_ldst, uldst.mx)
+                         : SideFlux(fr.mx, add_rst, urst.mx, add_rdst, urdst.mx);
+    flxi[IV2] = use_left ? SideFlux(fl.my, add_lst, ulst.my, add_ldst, uldst.my)
+                         : SideFlux(fr.my, add_rst, urst.my, add_rdst, urdst.my);
+    flxi[IV3] = use_left ? SideFlux(fl.mz, add_lst, ulst.mz, add_ldst, uldst.mz)
+                         : SideFlux(fr.mz, add_rst, urst.mz, add_rdst, urdst.mz);
+    flxi[IEN] = use_left ? SideFlux(fl.e, add_lst, ulst.e, add_ldst, uldst.e)
+                         : SideFlux(fr.e, add_rst, urst.e, add_rdst, urdst.e);
+    flxi[IB2] = use_left ? SideFlux(fl.by, add_lst, ulst.by, add_ldst, uldst.by)
+                         : SideFlux(fr.by, add_rst, urst.by, add_rdst, urdst.by);
+    flxi[IB3] = use_left ? SideFlux(fl.bz, add_lst, ulst.bz, add_ldst, uldst.bz)
+                         : SideFlux(fr.bz, add_rst, urst.bz, add_rdst, urdst.bz);
+
+    cons.flux(ivx, IDN, k, j, i) = flxi[IDN];
+    cons.flux(ivx, ivx, k, j, i) = flxi[IV1];
+    cons.flux(ivx, ivy, k, j, i) = flxi[IV2];
+    cons.flux(ivx, ivz, k, j, i) = flxi[IV3];
+    cons.flux(ivx, IEN, k, j, i) = flxi[IEN];
+    cons.flux(ivx, iBx, k, j, i) = flxi[IB1];
+    cons.flux(ivx, iBy, k, j, i) = flxi[IB2];
+    cons.flux(ivx, iBz, k, j, i) = flxi[IB3];
+    cons.flux(ivx, IPS, k, j, i) = flxi[IPS];
+  }
+};
+#endif // RSOLVERS_GLMMHD_HLLD_BRANCHLESS_HPP_
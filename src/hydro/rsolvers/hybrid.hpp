@@ -0,0 +1,101 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file hybrid.hpp
+//! \brief Hybrid Riemann solvers that use the (cheaper) HLLE solver in smooth, weakly
+//! magnetized regions and the (more accurate) HLLC/HLLD solvers elsewhere.
+//!
+//! A fast local indicator (relative pressure jump, Mach number, and plasma beta of the
+//! L/R states) selects the solver for each interface individually (in all flux kernels)
+//! so that the fluxes are independent of the flux kernel.
+//! The solvers do not count the interfaces using each path. This is done by a separate
+//! (optional) kernel, see CountHybridRiemannInterfaces.
+
+#ifndef RSOLVERS_HYBRID_HPP_
+#define RSOLVERS_HYBRID_HPP_
+
+// C++ headers
+#include <algorithm> // min()
+#include <cmath>     // abs()
+
+// AthenaPK headers
+#include "../../main.hpp"
+#include "../hydro_params.hpp"
+#include "rsolvers.hpp"
+
+template <Fluid fluid, RiemannSolver accurate_rsolver>
+struct HybridRiemann {
+  using Accurate = Riemann<fluid, accurate_rsolver>;
+  using Cheap = Riemann<fluid, RiemannSolver::hlle>;
+
+  explicit HybridRiemann(const Hydro::HybridRiemannParams &params) : params(params) {}
+
+  // Whether the accurate solver is required at interface i-1/2
+  template <typename State, typename EOS>
+  KOKKOS_INLINE_FUNCTION bool RequiresAccurate(const int i, const State &wl,
+                                               const State &wr, const EOS &eos) const {
+    const Real pl = wl(IPR, i);
+    const Real pr = wr(IPR, i);
+    if (std::abs(pl - pr) > params.pressure_jump * std::min(pl, pr)) {
+      return true;
+    }
+    // M^2 = v^2 / c_s^2 = rho v^2 / (gamma p)
+    const Real gamma = eos.GetGamma();
+    const Real vl2 = SQR(wl(IV1, i)) + SQR(wl(IV2, i)) + SQR(wl(IV3, i));
+    const Real vr2 = SQR(wr(IV1, i)) + SQR(wr(IV2, i)) + SQR(wr(IV3, i));
+    if (wl(IDN, i) * vl2 > params.mach2 * gamma * pl ||
+        wr(IDN, i) * vr2 > params.mach2 * gamma * pr) {
+      return true;
+    }
+    if constexpr (fluid == Fluid::glmmhd) {
+      // beta = 2 p / B^2
+      const Real bl2 = SQR(wl(IB1, i)) + SQR(wl(IB2, i)) + SQR(wl(IB3, i));
+      const Real br2 = SQR(wr(IB1, i)) + SQR(wr(IB2, i)) + SQR(wr(IB3, i));
+      if (2.0 * pl < params.beta * bl2 || 2.0 * pr < params.beta * br2) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename T, typename EOS>
+  KOKKOS_INLINE_FUNCTION void
+  Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+        const int iu, const int ivx, const parthenon::ScratchPad2D<T> &wl,
+        const parthenon::ScratchPad2D<T> &wr, VariableFluxPack<Real> &cons,
+        const EOS &eos, const Real c_h) const {
+    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+      Solve(k, j, i, ivx, wl, wr, cons, eos, c_h);
+    });
+  }
+
+  // Flux at a single interface i-1/2 with wl(n, i) and wr(n, i) being the L/R states
+  template <typename State, typename Fluxes, typename EOS>
+  KOKKOS_INLINE_FUNCTION void Solve(const int k, const int j, const int i, const int ivx,
+                                    const State &wl, const State &wr, Fluxes &cons,
+                                    const EOS &eos, const Real c_h) const {
+    if (RequiresAccurate(i, wl, wr, eos)) {
+      Accurate::Solve(k, j, i, ivx, wl, wr, cons, eos, c_h);
+    } else {
+      Cheap::Solve(k, j, i, ivx, wl, wr, cons, eos, c_h);
+    }
+  }
+
+  Hydro::HybridRiemannParams params;
+};
+
+template <>
+struct Riemann<Fluid::euler, RiemannSolver::hybrid_hllc>
+    : HybridRiemann<Fluid::euler, RiemannSolver::hllc> {
+  using HybridRiemann::HybridRiemann;
+};
+
+template <>
+struct Riemann<Fluid::glmmhd, RiemannSolver::hybrid_hlld>
+    : HybridRiemann<Fluid::glmmhd, RiemannSolver::hlld> {
+  using HybridRiemann::HybridRiemann;
+};
+
+#endif // RSOLVERS_HYBRID_HPP_
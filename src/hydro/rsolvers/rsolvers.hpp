@@ -26,7 +26,9 @@ struct Riemann;
 // now include the specializations
 #include "glmmhd_dc_llf.hpp"
 #include "glmmhd_hlld.hpp"
+#include "glmmhd_hlld_branchless.hpp"
 #include "glmmhd_hlle.hpp"
+#include "hybrid.hpp"
 #include "hydro_dc_llf.hpp"
 #include "hydro_hllc.hpp"
 #include "hydro_hlle.hpp"
@@ -34,32 +36,52 @@ struct Riemann;
 // "none" solvers for runs/testing without fluid evolution, i.e., just reset fluxes
 template <>
 struct Riemann<Fluid::euler, RiemannSolver::none> {
+  template <typename T>
   static KOKKOS_INLINE_FUNCTION void
   Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-        const int iu, const int ivx, const parthenon::ScratchPad2D<Real> &wl,
-        const parthenon::ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const int iu, const int ivx, const parthenon::ScratchPad2D<T> &wl,
+        const parthenon::ScratchPad2D<T> &wr, VariableFluxPack<Real> &cons,
         const AdiabaticHydroEOS &eos, const Real c_h) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
-      for (size_t v = 0; v < Hydro::GetNVars<Fluid::euler>(); v++) {
-        cons.flux(ivx, v, k, j, i) = 0.0;
-      }
+      Solve(k, j, i, ivx, wl, wr, cons, eos, c_h);
     });
   }
+
+  // Flux at a single interface i-1/2 with wl(n, i) and wr(n, i) being the L/R states
+  template <typename State, typename Fluxes>
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(const int k, const int j, const int i, const int ivx, const State &wl,
+        const State &wr, Fluxes &cons, const AdiabaticHydroEOS &eos,
+        const Real c_h) {
+    for (size_t v = 0; v < Hydro::GetNVars<Fluid::euler>(); v++) {
+      cons.flux(ivx, v, k, j, i) = 0.0;
+    }
+  }
 };
 
 template <>
 struct Riemann<Fluid::glmmhd, RiemannSolver::none> {
+  template <typename T>
   static KOKKOS_INLINE_FUNCTION void
   Solve(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-        const int iu, const int ivx, const parthenon::ScratchPad2D<Real> &wl,
-        const parthenon::ScratchPad2D<Real> &wr, VariableFluxPack<Real> &cons,
+        const int iu, const int ivx, const parthenon::ScratchPad2D<T> &wl,
+        const parthenon::ScratchPad2D<T> &wr, VariableFluxPack<Real> &cons,
         const AdiabaticGLMMHDEOS &eos, const Real c_h) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
-      for (size_t v = 0; v < Hydro::GetNVars<Fluid::glmmhd>(); v++) {
-        cons.flux(ivx, v, k, j, i) = 0.0;
-      }
+      Solve(k, j, i, ivx, wl, wr, cons, eos, c_h);
     });
   }
+
+  // Flux at a single interface i-1/2 with wl(n, i) and wr(n, i) being the L/R states
+  template <typename State, typename Fluxes>
+  static KOKKOS_INLINE_FUNCTION void
+  Solve(const int k, const int j, const int i, const int ivx, const State &wl,
+        const State &wr, Fluxes &cons, const AdiabaticGLMMHDEOS &eos,
+        const Real c_h) {
+    for (size_t v = 0; v < Hydro::GetNVars<Fluid::glmmhd>(); v++) {
+      cons.flux(ivx, v, k, j, i) = 0.0;
+    }
+  }
 };
 
 #endif // RSOLVERS_RSOLVERS_HPP_
@@ -17,11 +17,33 @@
 #include <mesh/domain.hpp>
 #include <mesh/meshblock_pack.hpp>
 
+// C++ headers
+#include <string>
+#include <vector>
+
 // AthenaPK headers
 #include "../../main.hpp"
 
 namespace cluster {
 
+// Applies the source term of a radial gravitational acceleration g_r (given as g_r / r)
+template <typename CV, typename PV, typename Coords>
+KOKKOS_FORCEINLINE_FUNCTION void
+AddRadialGravitySrc(CV &cons, const PV &prim, const Coords &coords,
+                    const parthenon::Real g_over_r, const parthenon::Real beta_dt,
+                    const int k, const int j, const int i) {
+  using parthenon::Real;
+  // Apply g_r as a source term
+  const Real den = prim(IDN, k, j, i);
+  const Real src = beta_dt * den * g_over_r;
+  cons(IM1, k, j, i) -= src * coords.template Xc<1>(i);
+  cons(IM2, k, j, i) -= src * coords.template Xc<2>(j);
+  cons(IM3, k, j, i) -= src * coords.template Xc<3>(k);
+  cons(IEN, k, j, i) -= src * (coords.template Xc<1>(i) * prim(IV1, k, j, i) +
+                               coords.template Xc<2>(j) * prim(IV2, k, j, i) +
+                               coords.template Xc<3>(k) * prim(IV3, k, j, i));
+}
+
 template <typename GravitationalField>
 void GravitationalFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                                const parthenon::Real beta_dt,
@@ -50,19 +72,94 @@ void GravitationalFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                  coords.Xc<3>(k) * coords.Xc<3>(k));
 
         const Real g_r = gravitationalField.g_from_r(r);
+        AddRadialGravitySrc(cons, prim, coords, (r == 0) ? 0 : g_r / r, beta_dt, k, j, i);
+      });
+}
+
+// Stores g_r / r of a static gravitational field in the "gravity_g_over_r" field so
+// that the source term does not need to evaluate the profile.
+template <typename GravitationalField>
+void FillGravitationalField(parthenon::MeshData<parthenon::Real> *md,
+                            GravitationalField gravitationalField) {
+  using parthenon::IndexDomain;
+  using parthenon::IndexRange;
+  using parthenon::Real;
+
+  const auto &g_pack = md->PackVariables(std::vector<std::string>{"gravity_g_over_r"});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "FillGravitationalField", parthenon::DevExecSpace(), 0,
+      g_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+        const auto &coords = g_pack.GetCoords(b);
+        const Real r =
+            sqrt(coords.Xc<1>(i) * coords.Xc<1>(i) + coords.Xc<2>(j) * coords.Xc<2>(j) +
+                 coords.Xc<3>(k) * coords.Xc<3>(k));
+        g_pack(b, 0, k, j, i) = (r == 0) ? 0 : gravitationalField.g_from_r(r) / r;
+      });
+}
+
+// Source term using the gravitational field stored by FillGravitationalField
+inline void CachedGravitationalFieldSrcTerm(parthenon::MeshData<parthenon::Real> *md,
+                                            const parthenon::Real beta_dt) {
+  using parthenon::IndexDomain;
+  using parthenon::IndexRange;
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  const auto &g_pack = md->PackVariables(std::vector<std::string>{"gravity_g_over_r"});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
-        // Apply g_r as a source term
-        const Real den = prim(IDN, k, j, i);
-        const Real src = (r == 0) ? 0 : beta_dt * den * g_r / r;
-        cons(IM1, k, j, i) -= src * coords.Xc<1>(i);
-        cons(IM2, k, j, i) -= src * coords.Xc<2>(j);
-        cons(IM3, k, j, i) -= src * coords.Xc<3>(k);
-        cons(IEN, k, j, i) -= src * (coords.Xc<1>(i) * prim(IV1, k, j, i) +
-                                     coords.Xc<2>(j) * prim(IV2, k, j, i) +
-                                     coords.Xc<3>(k) * prim(IV3, k, j, i));
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "CachedGravitationalFieldSrcTerm", parthenon::DevExecSpace(),
+      0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+        auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
+        AddRadialGravitySrc(cons, prim, coords, g_pack(b, 0, k, j, i), beta_dt, k, j, i);
       });
 }
 
+// Per cell functors of the above source terms to be used in fused source term kernels
+template <typename GravitationalField>
+struct GravitationalFieldSrc {
+  GravitationalField gravitational_field;
+  parthenon::Real beta_dt;
+
+  template <typename CV, typename Coords>
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, CV &cons, CV &prim,
+                                         const Coords &coords, const int k, const int j,
+                                         const int i) const {
+    const parthenon::Real x = coords.template Xc<1>(i);
+    const parthenon::Real y = coords.template Xc<2>(j);
+    const parthenon::Real z = coords.template Xc<3>(k);
+    const parthenon::Real r = sqrt(x * x + y * y + z * z);
+    const parthenon::Real g_over_r =
+        (r == 0) ? 0 : gravitational_field.g_from_r(r) / r;
+    AddRadialGravitySrc(cons, prim, coords, g_over_r, beta_dt, k, j, i);
+  }
+};
+
+// Requires the "gravity_g_over_r" field to be filled by FillGravitationalField
+template <typename GPack>
+struct CachedGravitationalFieldSrc {
+  GPack g_pack;
+  parthenon::Real beta_dt;
+
+  template <typename CV, typename Coords>
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, CV &cons, CV &prim,
+                                         const Coords &coords, const int k, const int j,
+                                         const int i) const {
+    AddRadialGravitySrc(cons, prim, coords, g_pack(b, 0, k, j, i), beta_dt, k, j, i);
+  }
+};
+
 } // namespace cluster
 
 #endif // HYDRO_SRCTERMS_GRAVITATIONAL_FIELD_HPP_
@@ -9,10 +9,19 @@
 //========================================================================================
 
 // C++ headers
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <limits>
 
+// POSIX headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
 #include <globals.hpp>
@@ -21,11 +30,109 @@
 
 // AthenaPK headers
 #include "../../units.hpp"
+#include "../../utils/global_reductions.hpp"
+#include "../../utils/partition_data.hpp"
+#include "../block_costs.hpp"
 #include "tabular_cooling.hpp"
 #include "utils/error_checking.hpp"
 
 namespace cooling {
 using namespace parthenon;
+using Hydro::BlockWorkCounter;
+
+namespace {
+// Binary cooling table layout (native endianness):
+// char[8] magic, int64 n_temp, double log_temp_start, double d_log_temp,
+// double log_lambdas[n_temp] (log10 of the cooling rate in units of lambda_units_cgs)
+constexpr char binary_table_magic[8] = {'A', 'P', 'K', 'C', 'O', 'O', 'L', '1'};
+constexpr std::size_t binary_table_header_size =
+    sizeof(binary_table_magic) + sizeof(std::int64_t) + 2 * sizeof(double);
+
+// Reads the table from the memory mapped file. Returns an error message (empty on
+// success) instead of throwing so that the error can be broadcast to all ranks.
+std::string ReadBinaryCoolingTableFile(const std::string &filename, std::int64_t &n_temp,
+                                       double header[2], std::vector<double> &data) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return "Could not open binary cooling table " + filename;
+  }
+  struct stat file_stat;
+  const bool stat_failed = fstat(fd, &file_stat) != 0;
+  if (stat_failed ||
+      static_cast<std::size_t>(file_stat.st_size) < binary_table_header_size) {
+    close(fd);
+    return "Binary cooling table " + filename + " is too small.";
+  }
+  const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+  void *ptr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return "Could not map binary cooling table " + filename;
+  }
+  const auto *bytes = static_cast<const char *>(ptr);
+  std::string error;
+  std::size_t offset = sizeof(binary_table_magic);
+  if (std::memcmp(bytes, binary_table_magic, sizeof(binary_table_magic)) != 0) {
+    error = "File " + filename + " is not a binary cooling table.";
+  } else {
+    std::memcpy(&n_temp, bytes + offset, sizeof(n_temp));
+    offset += sizeof(n_temp);
+    std::memcpy(header, bytes + offset, 2 * sizeof(double));
+    offset += 2 * sizeof(double);
+    if (n_temp < 0 || file_size != offset + n_temp * sizeof(double)) {
+      error = "Size of binary cooling table " + filename + " does not match its header.";
+    } else {
+      data.resize(n_temp);
+      std::memcpy(data.data(), bytes + offset, n_temp * sizeof(double));
+    }
+  }
+  munmap(ptr, file_size);
+  return error;
+}
+
+// Only the first rank of each node reads the file and the (small) table is subsequently
+// broadcast within the node so that the file system is accessed once per node. Note
+// that each rank stores its own copy of the table (as for ASCII tables).
+void ReadBinaryCoolingTable(const std::string &filename, Real &log_temp_start,
+                            Real &d_log_temp, std::vector<Real> &log_lambdas) {
+  int node_rank = 0;
+#ifdef MPI_PARALLEL
+  MPI_Comm node_comm;
+  PARTHENON_MPI_CHECK(MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED,
+                                          Globals::my_rank, MPI_INFO_NULL, &node_comm));
+  PARTHENON_MPI_CHECK(MPI_Comm_rank(node_comm, &node_rank));
+#endif
+
+  double header[2] = {0.0, 0.0};
+  std::int64_t n_temp = 0;
+  std::vector<double> data;
+  std::string error;
+  if (node_rank == 0) {
+    error = ReadBinaryCoolingTableFile(filename, n_temp, header, data);
+  }
+#ifdef MPI_PARALLEL
+  // All ranks of the node fail together (rather than waiting for the table)
+  int failed = error.empty() ? 0 : 1;
+  PARTHENON_MPI_CHECK(MPI_Bcast(&failed, 1, MPI_INT, 0, node_comm));
+  if (failed != 0) {
+    PARTHENON_MPI_CHECK(MPI_Comm_free(&node_comm));
+    PARTHENON_THROW(node_rank == 0 ? error
+                                   : "Reading binary cooling table " + filename +
+                                         " failed on the first rank of the node.");
+  }
+  PARTHENON_MPI_CHECK(MPI_Bcast(&n_temp, 1, MPI_INT64_T, 0, node_comm));
+  PARTHENON_MPI_CHECK(MPI_Bcast(header, 2, MPI_DOUBLE, 0, node_comm));
+  data.resize(n_temp);
+  PARTHENON_MPI_CHECK(
+      MPI_Bcast(data.data(), static_cast<int>(n_temp), MPI_DOUBLE, 0, node_comm));
+  PARTHENON_MPI_CHECK(MPI_Comm_free(&node_comm));
+#endif
+  PARTHENON_REQUIRE_THROWS(error.empty(), error);
+  log_temp_start = header[0];
+  d_log_temp = header[1];
+  log_lambdas.assign(data.begin(), data.end());
+}
+} // namespace
 
 TabularCooling::TabularCooling(ParameterInput *pin,
                                std::shared_ptr<parthenon::StateDescriptor> hydro_pkg) {
@@ -52,7 +159,36 @@ TabularCooling::TabularCooling(ParameterInput *pin,
     integrator_ = CoolIntegrator::undefined;
   }
   max_iter_ = pin->GetOrAddInteger("cooling", "max_iter", 100);
+  // Number of subcycles after which cells are compacted into a work list (0 disables)
+  compaction_iter_ = pin->GetOrAddInteger("cooling", "compaction_iter", 4);
+  if (integrator_ == CoolIntegrator::rk12 || integrator_ == CoolIntegrator::rk45) {
+    hydro_pkg->AddParam<>("cooling_work_lists", utils::PartitionData<CoolingWorkLists>(),
+                          true);
+    // Subcycling statistics (rank local) of the current cycle: total and maximum number
+    // of subcycles (of a cell) and number of compacted cells
+    auto *cycle_counters =
+        hydro_pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+    auto hst_vars = hydro_pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+    for (const auto &[key, op] :
+         {std::make_pair("cooling_num_subcycles", utils::ReductionOp::sum),
+          std::make_pair("cooling_max_subcycles", utils::ReductionOp::max),
+          std::make_pair("cooling_num_compacted", utils::ReductionOp::sum)}) {
+      hydro_pkg->AddParam<Real>(key, 0.0, true);
+      cycle_counters->Register(key, op, false);
+      hst_vars.emplace_back(utils::AccumulatedParamHstVar(
+          op == utils::ReductionOp::max ? parthenon::UserHistoryOperation::max
+                                        : parthenon::UserHistoryOperation::sum,
+          "Hydro", "cycle_counters", key));
+    }
+    hydro_pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
+  }
   cooling_time_cfl_ = pin->GetOrAddReal("cooling", "cfl", 0.1);
+  cache_fields_ = pin->GetOrAddBoolean("cooling", "cache_fields", false);
+  if (cache_fields_) {
+    auto m = Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
+    hydro_pkg->AddField("cooling_time", m);
+    hydro_pkg->AddField("temperature", m);
+  }
   d_log_temp_tol_ = pin->GetOrAddReal("cooling", "d_log_temp_tol", 1e-8);
   d_e_tol_ = pin->GetOrAddReal("cooling", "d_e_tol", 1e-8);
   // negative means disabled
@@ -60,75 +196,94 @@ TabularCooling::TabularCooling(ParameterInput *pin,
 
   std::stringstream msg;
 
-  /****************************************
-   * Read tab file with IOWrapper
-   ****************************************/
-  IOWrapper input;
-  input.Open(table_filename.c_str(), IOWrapper::FileMode::read);
-
-  /****************************************
-   * Read tab file from IOWrapper into a stringstream tab
-   ****************************************/
-  std::stringstream tab_ss;
-  const int bufsize = 4096;
-  char *buf = new char[bufsize];
-  std::ptrdiff_t ret;
-  parthenon::IOWrapperSizeT word_size = sizeof(char);
-
-  do {
-    if (Globals::my_rank == 0) { // only the master process reads the cooling table
-      ret = input.Read(buf, word_size, bufsize);
+  std::vector<Real> log_temps, log_lambdas;
+  const auto table_format = pin->GetOrAddString("cooling", "table_format", "ascii");
+  if (table_format == "binary") {
+    // Pre-converted table (see inputs/cooling_tables/convert_cooling_table.py) that
+    // does not require parsing and that is only read once per node
+    Real log_temp_start, d_log_temp;
+    ReadBinaryCoolingTable(table_filename, log_temp_start, d_log_temp, log_lambdas);
+    for (size_t i = 0; i < log_lambdas.size(); i++) {
+      log_temps.push_back(log_temp_start + static_cast<Real>(i) * d_log_temp);
+      log_lambdas[i] -= std::log10(lambda_units);
     }
+  } else if (table_format == "ascii") {
+    /****************************************
+     * Read tab file with IOWrapper
+     ****************************************/
+    IOWrapper input;
+    input.Open(table_filename.c_str(), IOWrapper::FileMode::read);
+
+    /****************************************
+     * Read tab file from IOWrapper into a stringstream tab
+     ****************************************/
+    std::stringstream tab_ss;
+    const int bufsize = 4096;
+    char *buf = new char[bufsize];
+    std::ptrdiff_t ret;
+    parthenon::IOWrapperSizeT word_size = sizeof(char);
+
+    do {
+      if (Globals::my_rank == 0) { // only the master process reads the cooling table
+        ret = input.Read(buf, word_size, bufsize);
+      }
 #ifdef MPI_PARALLEL
-    // then broadcasts it
-    // no need for fence as cooling table is independent of execution/memory space
-    MPI_Bcast(&ret, sizeof(std::ptrdiff_t), MPI_BYTE, 0, MPI_COMM_WORLD);
-    MPI_Bcast(buf, ret, MPI_BYTE, 0, MPI_COMM_WORLD);
+      // then broadcasts it
+      // no need for fence as cooling table is independent of execution/memory space
+      MPI_Bcast(&ret, sizeof(std::ptrdiff_t), MPI_BYTE, 0, MPI_COMM_WORLD);
+      MPI_Bcast(buf, ret, MPI_BYTE, 0, MPI_COMM_WORLD);
 #endif
-    tab_ss.write(buf, ret); // add the buffer into the stream
-  } while (ret == bufsize); // till EOF (or par_end is found)
-
-  delete[] buf;
-  input.Close();
-
-  /****************************************
-   * Determine log_temps and and log_lambdas vectors
-   ****************************************/
-  std::vector<Real> log_temps, log_lambdas;
-  std::string line;
-  std::size_t first_char;
-  while (tab_ss.good()) {
-    getline(tab_ss, line);
-    if (line.empty()) continue;                          // skip blank line
-    first_char = line.find_first_not_of(" ");            // skip white space
-    if (first_char == std::string::npos) continue;       // line is all white space
-    if (line.compare(first_char, 1, "#") == 0) continue; // skip comments
-
-    // Parse the numbers on the line
-    std::istringstream iss(line);
-    std::vector<std::string> line_data{std::istream_iterator<std::string>{iss},
-                                       std::istream_iterator<std::string>{}};
-    // Check size
-    if (line_data.empty() || line_data.size() <= std::max(log_temp_col, log_lambda_col)) {
-      msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "Index " << std::max(log_temp_col, log_lambda_col) << " out of range on \""
-          << line << "\"" << std::endl;
-      PARTHENON_FAIL(msg);
-    }
-
-    try {
-      const Real log_temp = std::stod(line_data[log_temp_col]);
-      const Real log_lambda = std::stod(line_data[log_lambda_col]);
-
-      // Add to growing list
-      log_temps.push_back(log_temp);
-      log_lambdas.push_back(log_lambda - std::log10(lambda_units));
-
-    } catch (const std::invalid_argument &ia) {
-      msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
-          << "Number: \"" << ia.what() << "\" could not be parsed as double" << std::endl;
-      PARTHENON_FAIL(msg);
+      tab_ss.write(buf, ret); // add the buffer into the stream
+    } while (ret == bufsize); // till EOF (or par_end is found)
+
+    delete[] buf;
+    input.Close();
+
+    /****************************************
+     * Determine log_temps and and log_lambdas vectors
+     ****************************************/
+    std::string line;
+    std::size_t first_char;
+    while (tab_ss.good()) {
+      getline(tab_ss, line);
+      if (line.empty()) continue;                          // skip blank line
+      first_char = line.find_first_not_of(" ");            // skip white space
+      if (first_char == std::string::npos) continue;       // line is all white space
+      if (line.compare(first_char, 1, "#") == 0) continue; // skip comments
+
+      // Parse the numbers on the line
+      std::istringstream iss(line);
+      std::vector<std::string> line_data{std::istream_iterator<std::string>{iss},
+                                         std::istream_iterator<std::string>{}};
+      // Check size
+      if (line_data.empty() ||
+          line_data.size() <= std::max(log_temp_col, log_lambda_col)) {
+        msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
+            << "Index " << std::max(log_temp_col, log_lambda_col) << " out of range on \""
+            << line << "\"" << std::endl;
+        PARTHENON_FAIL(msg);
+      }
+
+      try {
+        const Real log_temp = std::stod(line_data[log_temp_col]);
+        const Real log_lambda = std::stod(line_data[log_lambda_col]);
+
+        // Add to growing list
+        log_temps.push_back(log_temp);
+        log_lambdas.push_back(log_lambda - std::log10(lambda_units));
+
+      } catch (const std::invalid_argument &ia) {
+        msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
+            << "Number: \"" << ia.what() << "\" could not be parsed as double"
+            << std::endl;
+        PARTHENON_FAIL(msg);
+      }
     }
+  } else {
+    msg << "### FATAL ERROR in function [TabularCooling::TabularCooling]" << std::endl
+        << "Unknown cooling/table_format \"" << table_format
+        << "\". Options are \"ascii\" and \"binary\"." << std::endl;
+    PARTHENON_FAIL(msg);
   }
 
   /****************************************
@@ -261,9 +416,13 @@ TabularCooling::TabularCooling(ParameterInput *pin,
   const auto adiabatic_index = hydro_pkg->Param<Real>("AdiabaticIndex");
   const auto He_mass_fraction = hydro_pkg->Param<Real>("He_mass_fraction");
 
+  // Optional (faster) table representation using piecewise power laws in log2 space
+  const auto fast_table = pin->GetOrAddBoolean("cooling", "fast_table", false);
+
   cooling_table_obj_ = CoolingTableObj(log_lambdas_, log_temp_start_, log_temp_final_,
                                        d_log_temp_, n_temp_, mbar_over_kb,
-                                       adiabatic_index, 1.0 - He_mass_fraction, units);
+                                       adiabatic_index, 1.0 - He_mass_fraction, units,
+                                       fast_table);
 }
 
 void TabularCooling::SrcTerm(MeshData<Real> *md, const Real dt) const {
@@ -278,6 +437,151 @@ void TabularCooling::SrcTerm(MeshData<Real> *md, const Real dt) const {
   }
 }
 
+namespace {
+// State of the (adaptive) cooling subcycling of a single cell
+struct CoolingSubcycleState {
+  Real sub_t;            // current subcycle time
+  Real sub_dt;           // timestep of the next subcycle
+  Real internal_e;       // current specific internal energy
+  unsigned int sub_iter; // number of subcycles done so far
+};
+
+// Advance the subcycling of a single cell by at most `num_iter` subcycles.
+// Returns true if the cell reached the end of the timestep (or stopped cooling).
+template <typename RKStepper>
+KOKKOS_INLINE_FUNCTION bool
+AdvanceCoolingSubcycles(const CoolingTableObj &cooling_table_obj, const Real rho,
+                        const Real dt, const Real min_sub_dt, const Real d_e_tol,
+                        const Real internal_e_floor, const unsigned int max_iter,
+                        const Real epsilon, const unsigned int num_iter,
+                        CoolingSubcycleState &state) {
+  auto &sub_t = state.sub_t;
+  auto &sub_dt = state.sub_dt;
+  auto &internal_e = state.internal_e;
+  auto &sub_iter = state.sub_iter;
+
+  bool dedt_valid = true;
+
+  // Wrap DeDt into a functor for the RKStepper
+  auto DeDt_wrapper = [&](const Real t, const Real e, bool &valid) {
+    return cooling_table_obj.DeDt(e, rho, valid);
+  };
+
+  // check for dedt != 0.0 required in case cooling floor it hit during subcycling
+  auto is_cooling = [&]() {
+    return (sub_t * (1 + epsilon) < dt) &&
+           (DeDt_wrapper(sub_t, internal_e, dedt_valid) != 0.0);
+  };
+
+  for (unsigned int n = 0; n < num_iter && is_cooling(); n++) {
+    if (sub_iter > max_iter) {
+      // Due to sub_dt >= min_dt, this error should never happen
+      PARTHENON_FAIL("FATAL ERROR in [TabularCooling::SubcyclingFixedIntSrcTerm]: Sub "
+                     "cycles exceed max_iter (This should be impossible)");
+    }
+
+    // Next higher order estimate
+    Real internal_e_next_h;
+    // Error in estimate of higher order
+    Real d_e_err;
+    // Number of attempts on this subcycle
+    unsigned int sub_attempt = 0;
+    // Whether to reattempt this subcycle
+    bool reattempt_sub = true;
+    do {
+      // Next lower order estimate
+      Real internal_e_next_l;
+      // Do one dual order RK step
+      dedt_valid = true;
+      RKStepper::Step(sub_t, sub_dt, internal_e, DeDt_wrapper, internal_e_next_h,
+                      internal_e_next_l, dedt_valid);
+
+      sub_attempt++;
+
+      if (!dedt_valid) {
+        if (sub_dt == min_sub_dt) {
+          // Cooling is so fast that even the minimum subcycle dt would lead to
+          // negative internal energy -- so just cool to the floor of the cooling
+          // table
+          sub_dt = (dt - sub_t);
+          internal_e_next_h = internal_e_floor;
+          reattempt_sub = false;
+        } else {
+          reattempt_sub = true;
+          sub_dt = min_sub_dt;
+        }
+      } else {
+
+        // Compute error
+        d_e_err = fabs((internal_e_next_h - internal_e_next_l) / internal_e_next_h);
+
+        reattempt_sub = false;
+        // Accepting or reattempting the subcycle:
+        //
+        // -If the error is small, accept the subcycle
+        //
+        // -If the error on the subcycle is too high, compute a new time
+        // step to reattempt the subcycle
+        //   -But if the new time step is smaller than the minimum subcycle
+        //   time step (total step duration/ max iterations), just use the
+        //   minimum subcycle time step instead
+
+        if (std::isnan(d_e_err)) {
+          reattempt_sub = true;
+          sub_dt = min_sub_dt;
+        } else if (d_e_err >= d_e_tol && sub_dt > min_sub_dt) {
+          // Reattempt this subcycle
+          reattempt_sub = true;
+          // Error was too high, shrink the timestep
+          if (d_e_tol == 0) {
+            sub_dt = min_sub_dt;
+          } else {
+            sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
+          }
+          // Don't drop timestep under maximum iteration count
+          if (sub_dt < min_sub_dt || sub_attempt >= max_iter) {
+            sub_dt = min_sub_dt;
+          }
+        }
+      }
+
+    } while (reattempt_sub);
+    // Accept this subcycle
+    sub_t += sub_dt;
+
+    internal_e = internal_e_next_h;
+
+    // skip to the end of subcycling if error is 0 (very unlikely)
+    if (d_e_err == 0) {
+      sub_dt = dt - sub_t;
+    } else {
+      // Grow the timestep
+      // (or shrink in case d_e_err >= d_e_tol and sub_dt is already at min_sub_dt)
+      sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
+    }
+
+    if (d_e_tol == 0) {
+      sub_dt = min_sub_dt;
+    }
+
+    // Don't drop timestep under the minimum step size
+    sub_dt = std::max(sub_dt, min_sub_dt);
+
+    // Limit by end time
+    sub_dt = std::min(sub_dt, dt - sub_t);
+
+    sub_iter++;
+  }
+  return !is_cooling();
+}
+} // namespace
+
+// The subcycling is done in two phases to reduce the divergence (e.g., of threads in a
+// warp on GPUs) as only few cells typically require many subcycles.
+// In the first phase, all cells are subcycled for at most `compaction_iter_` subcycles.
+// The remaining (hard) cells are compacted into a work list (storing the current state
+// of the subcycling) and subcycled until the end of the timestep in the second phase.
+// Results are independent of `compaction_iter_`.
 template <typename RKStepper>
 void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt_,
                                                const RKStepper rk_stepper) const {
@@ -296,6 +600,7 @@ void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt
   const Real min_sub_dt = dt / max_iter;
 
   const Real d_e_tol = d_e_tol_;
+  const Real epsilon = KEpsilon_;
 
   // Determine the cooling floor, whichever is higher of the cooling table floor
   // or fluid solver floor
@@ -313,10 +618,45 @@ void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
 
-  par_for(
-      DEFAULT_LOOP_PATTERN, "TabularCooling::SubcyclingSplitSrcTerm", DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+  // Number of subcycles is used as cost estimate for the load balancing
+  BlockWorkCounter block_work(md, "block_cost_cooling_subcycle");
+
+  // Work list for the second phase (sized for all cells of the container)
+  const auto compaction = compaction_iter_ > 0;
+  const auto first_phase_iter =
+      compaction ? compaction_iter_ : std::numeric_limits<unsigned int>::max();
+  const int nb = cons_pack.GetDim(5);
+  const int nk = kb.e - kb.s + 1;
+  const int nj = jb.e - jb.s + 1;
+  const int ni = ib.e - ib.s + 1;
+  auto &work_lists = hydro_pkg
+                         ->MutableParam<utils::PartitionData<CoolingWorkLists>>(
+                             "cooling_work_lists")
+                         ->Get(md);
+  if (!work_lists.num_cells.is_allocated()) {
+    work_lists.num_cells =
+        Kokkos::View<int, parthenon::DevMemSpace>("num cooling work cells");
+  }
+  if (compaction && work_lists.cells.extent_int(0) < nb * nk * nj * ni) {
+    work_lists.cells = ParArray1D<int>("cooling work cells", nb * nk * nj * ni);
+    work_lists.states = ParArray2D<Real>("cooling work states", nb * nk * nj * ni, 4);
+  }
+  Kokkos::deep_copy(work_lists.num_cells, 0);
+  const auto work_cells = work_lists.cells;
+  const auto work_states = work_lists.states;
+  const auto num_work_cells = work_lists.num_cells;
+
+  // Statistics for the history output
+  std::int64_t num_subcycles = 0;
+  std::int64_t max_subcycles = 0;
+
+  Kokkos::parallel_reduce(
+      "TabularCooling::SubcyclingSplitSrcTerm",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(DevExecSpace(), {0, kb.s, jb.s, ib.s},
+                                             {nb, kb.e + 1, jb.e + 1, ib.e + 1},
+                                             {1, 1, 1, ni}),
+      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+                    std::int64_t &lnum_subcycles, std::int64_t &lmax_subcycles) {
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         // Need to use `cons` here as prim may still contain state at t_0;
@@ -335,146 +675,119 @@ void TabularCooling::SubcyclingFixedIntSrcTerm(MeshData<Real> *md, const Real dt
         internal_e /= rho;
         const Real internal_e_initial = internal_e;
 
-        bool dedt_valid = true;
-
-        // Wrap DeDt into a functor for the RKStepper
-        auto DeDt_wrapper = [&](const Real t, const Real e, bool &valid) {
-          return cooling_table_obj.DeDt(e, rho, valid);
-        };
-
-        Real sub_t = 0; // current subcycle time
-        // Try full dt. If error is too large adaptive timestepping will reduce sub_dt
-        Real sub_dt = dt;
-
         // Check if cooling is actually happening, e.g., when T below T_cool_min or if
         // temperature is already below floor.
-        const Real dedt_initial = DeDt_wrapper(0.0, internal_e_initial, dedt_valid);
+        const Real dedt_initial = cooling_table_obj.DeDt(internal_e_initial, rho);
         if (dedt_initial == 0.0 || internal_e_initial <= internal_e_floor) {
           return;
         }
 
+        // Try full dt. If error is too large adaptive timestepping will reduce sub_dt.
         // Use minumum subcycle timestep when d_e_tol == 0
-        if (d_e_tol == 0) {
-          sub_dt = min_sub_dt;
-        }
-
-        unsigned int sub_iter = 0;
-        // check for dedt != 0.0 required in case cooling floor it hit during subcycling
-        while ((sub_t * (1 + KEpsilon_) < dt) &&
-               (DeDt_wrapper(sub_t, internal_e, dedt_valid) != 0.0)) {
-
-          if (sub_iter > max_iter) {
-            // Due to sub_dt >= min_dt, this error should never happen
-            PARTHENON_FAIL(
-                "FATAL ERROR in [TabularCooling::SubcyclingFixedIntSrcTerm]: Sub "
-                "cycles exceed max_iter (This should be impossible)");
-          }
-
-          // Next higher order estimate
-          Real internal_e_next_h;
-          // Error in estimate of higher order
-          Real d_e_err;
-          // Number of attempts on this subcycle
-          unsigned int sub_attempt = 0;
-          // Whether to reattempt this subcycle
-          bool reattempt_sub = true;
-          do {
-            // Next lower order estimate
-            Real internal_e_next_l;
-            // Do one dual order RK step
-            dedt_valid = true;
-            RKStepper::Step(sub_t, sub_dt, internal_e, DeDt_wrapper, internal_e_next_h,
-                            internal_e_next_l, dedt_valid);
-
-            sub_attempt++;
-
-            if (!dedt_valid) {
-              if (sub_dt == min_sub_dt) {
-                // Cooling is so fast that even the minimum subcycle dt would lead to
-                // negative internal energy -- so just cool to the floor of the cooling
-                // table
-                sub_dt = (dt - sub_t);
-                internal_e_next_h = internal_e_floor;
-                reattempt_sub = false;
-              } else {
-                reattempt_sub = true;
-                sub_dt = min_sub_dt;
-              }
-            } else {
-
-              // Compute error
-              d_e_err = fabs((internal_e_next_h - internal_e_next_l) / internal_e_next_h);
-
-              reattempt_sub = false;
-              // Accepting or reattempting the subcycle:
-              //
-              // -If the error is small, accept the subcycle
-              //
-              // -If the error on the subcycle is too high, compute a new time
-              // step to reattempt the subcycle
-              //   -But if the new time step is smaller than the minimum subcycle
-              //   time step (total step duration/ max iterations), just use the
-              //   minimum subcycle time step instead
-
-              if (std::isnan(d_e_err)) {
-                reattempt_sub = true;
-                sub_dt = min_sub_dt;
-              } else if (d_e_err >= d_e_tol && sub_dt > min_sub_dt) {
-                // Reattempt this subcycle
-                reattempt_sub = true;
-                // Error was too high, shrink the timestep
-                if (d_e_tol == 0) {
-                  sub_dt = min_sub_dt;
-                } else {
-                  sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
-                }
-                // Don't drop timestep under maximum iteration count
-                if (sub_dt < min_sub_dt || sub_attempt >= max_iter) {
-                  sub_dt = min_sub_dt;
-                }
-              }
-            }
-
-          } while (reattempt_sub);
-          // Accept this subcycle
-          sub_t += sub_dt;
-
-          internal_e = internal_e_next_h;
-
-          // skip to the end of subcycling if error is 0 (very unlikely)
-          if (d_e_err == 0) {
-            sub_dt = dt - sub_t;
-          } else {
-            // Grow the timestep
-            // (or shrink in case d_e_err >= d_e_tol and sub_dt is already at min_sub_dt)
-            sub_dt = RKStepper::OptimalStep(sub_dt, d_e_err, d_e_tol);
-          }
-
-          if (d_e_tol == 0) {
-            sub_dt = min_sub_dt;
-          }
-
-          // Don't drop timestep under the minimum step size
-          sub_dt = std::max(sub_dt, min_sub_dt);
-
-          // Limit by end time
-          sub_dt = std::min(sub_dt, dt - sub_t);
-
-          sub_iter++;
+        CoolingSubcycleState state{0.0, (d_e_tol == 0) ? min_sub_dt : dt, internal_e, 0};
+
+        const bool done = AdvanceCoolingSubcycles<RKStepper>(
+            cooling_table_obj, rho, dt, min_sub_dt, d_e_tol, internal_e_floor, max_iter,
+            epsilon, first_phase_iter, state);
+
+        if (!done) {
+          // Continue in the second phase
+          const int n = Kokkos::atomic_fetch_add(&num_work_cells(), 1);
+          work_cells(n) = i - ib.s + ni * (j - jb.s + nj * (k - kb.s + nk * b));
+          work_states(n, 0) = state.sub_t;
+          work_states(n, 1) = state.sub_dt;
+          work_states(n, 2) = state.internal_e;
+          work_states(n, 3) = static_cast<Real>(state.sub_iter);
+          return;
         }
+        block_work.Add(b, static_cast<Real>(state.sub_iter));
+        lnum_subcycles += state.sub_iter;
+        lmax_subcycles = std::max(lmax_subcycles, std::int64_t(state.sub_iter));
 
         // If cooled below floor, reset to floor value.
         // This could happen if the floor value is larger than the lower end of the
         // cooling table or if they are close and the last subcycle in the cooling above
         // the lower end pushed the temperature below the lower end (and the floor).
-        internal_e = (internal_e > internal_e_floor) ? internal_e : internal_e_floor;
+        internal_e = (state.internal_e > internal_e_floor) ? state.internal_e
+                                                          : internal_e_floor;
 
         // Remove the cooling from the total energy density
         cons(IEN, k, j, i) += rho * (internal_e - internal_e_initial);
         // Latter technically not required if no other tasks follows before
         // ConservedToPrim conversion, but keeping it for now (better safe than sorry).
         prim(IPR, k, j, i) = rho * internal_e * gm1;
-      });
+      },
+      Kokkos::Sum<std::int64_t>(num_subcycles), Kokkos::Max<std::int64_t>(max_subcycles));
+
+  int num_hard_cells = 0;
+  if (compaction) {
+    Kokkos::deep_copy(num_hard_cells, num_work_cells);
+  }
+  if (num_hard_cells > 0) {
+    std::int64_t num_subcycles_hard = 0;
+    std::int64_t max_subcycles_hard = 0;
+    Kokkos::parallel_reduce(
+        "TabularCooling::SubcyclingSplitSrcTerm compacted",
+        Kokkos::RangePolicy<>(DevExecSpace(), 0, num_hard_cells),
+        KOKKOS_LAMBDA(const int &n, std::int64_t &lnum_subcycles,
+                      std::int64_t &lmax_subcycles) {
+          auto idx = work_cells(n);
+          const int i = ib.s + idx % ni;
+          idx /= ni;
+          const int j = jb.s + idx % nj;
+          idx /= nj;
+          const int k = kb.s + idx % nk;
+          const int b = idx / nk;
+
+          auto &cons = cons_pack(b);
+          auto &prim = prim_pack(b);
+          const Real rho = cons(IDN, k, j, i);
+          Real internal_e_initial =
+              cons(IEN, k, j, i) -
+              0.5 *
+                  (SQR(cons(IM1, k, j, i)) + SQR(cons(IM2, k, j, i)) +
+                   SQR(cons(IM3, k, j, i))) /
+                  rho;
+          if (mhd_enabled) {
+            internal_e_initial -= 0.5 * (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
+                                         SQR(cons(IB3, k, j, i)));
+          }
+          internal_e_initial /= rho;
+
+          CoolingSubcycleState state{work_states(n, 0), work_states(n, 1),
+                                     work_states(n, 2),
+                                     static_cast<unsigned int>(work_states(n, 3))};
+          AdvanceCoolingSubcycles<RKStepper>(
+              cooling_table_obj, rho, dt, min_sub_dt, d_e_tol, internal_e_floor, max_iter,
+              epsilon, std::numeric_limits<unsigned int>::max(), state);
+
+          block_work.Add(b, static_cast<Real>(state.sub_iter));
+          lnum_subcycles += state.sub_iter;
+          lmax_subcycles = std::max(lmax_subcycles, std::int64_t(state.sub_iter));
+
+          // Same floor and update as in the first phase
+          const Real internal_e = (state.internal_e > internal_e_floor)
+                                      ? state.internal_e
+                                      : internal_e_floor;
+          cons(IEN, k, j, i) += rho * (internal_e - internal_e_initial);
+          prim(IPR, k, j, i) = rho * internal_e * gm1;
+        },
+        Kokkos::Sum<std::int64_t>(num_subcycles_hard),
+        Kokkos::Max<std::int64_t>(max_subcycles_hard));
+    num_subcycles += num_subcycles_hard;
+    max_subcycles = std::max(max_subcycles, max_subcycles_hard);
+  }
+  block_work.AddToBlockCosts(md);
+
+  // Accumulate (rank local) statistics of this cycle for the history output
+  auto *cycle_counters =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("cycle_counters");
+  cycle_counters->Contribute("cooling_num_subcycles", md,
+                             static_cast<Real>(num_subcycles));
+  cycle_counters->Contribute("cooling_max_subcycles", md,
+                             static_cast<Real>(max_subcycles));
+  cycle_counters->Contribute("cooling_num_compacted", md,
+                             static_cast<Real>(num_hard_cells));
 }
 
 void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
@@ -491,10 +804,11 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
   const Real X_by_mh2 =
       std::pow((1 - hydro_pkg->Param<Real>("He_mass_fraction")) / units.mh(), 2);
 
-  const auto lambdas = lambdas_;
-  const auto temps = temps_;
-  const auto alpha_k = townsend_alpha_k_;
-  const auto Y_k = townsend_Y_k_;
+  // Read-only as the bin lookups below are data dependent
+  const CoolingTableView lambdas = lambdas_;
+  const CoolingTableView temps = temps_;
+  const CoolingTableView alpha_k = townsend_alpha_k_;
+  const CoolingTableView Y_k = townsend_Y_k_;
 
   const auto internal_e_floor = T_floor_ / mbar_gm1_over_kb;
   const auto temp_cool_floor = std::pow(10.0, log_temp_start_); // low end of cool table
@@ -595,29 +909,28 @@ void TabularCooling::TownsendSrcTerm(parthenon::MeshData<parthenon::Real> *md,
 }
 
 Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
-  if (cooling_time_cfl_ <= 0.0) {
-    return std::numeric_limits<Real>::max();
-  }
-
-  if (isnan(cooling_time_cfl_) || isinf(cooling_time_cfl_)) {
-    return std::numeric_limits<Real>::infinity();
+  const bool calc_dt = cooling_time_cfl_ > 0.0 && std::isfinite(cooling_time_cfl_);
+  if (!calc_dt && !cache_fields_) {
+    return cooling_time_cfl_ <= 0.0 ? std::numeric_limits<Real>::max()
+                                    : std::numeric_limits<Real>::infinity();
   }
 
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
   const CoolingTableObj cooling_table_obj = cooling_table_obj_;
   const auto gm1 = (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
-  const auto mbar_gm1_over_kb = hydro_pkg->Param<Real>("mbar_over_kb") * gm1;
-
-  // Determine the cooling floor, whichever is higher of the cooling table floor
-  // or fluid solver floor
-  const auto temp_cool_floor = std::pow(10.0, log_temp_start_); // low end of cool table
-  const Real temp_floor = (T_floor_ > temp_cool_floor) ? T_floor_ : temp_cool_floor;
-
-  const Real internal_e_floor = temp_floor / mbar_gm1_over_kb; // specific internal en.
+  const auto mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
+  const auto mbar_gm1_over_kb = mbar_over_kb * gm1;
+  const Real internal_e_floor = GetCoolingTimeInternalEFloor(mbar_gm1_over_kb);
 
   // Grab some necessary variables
   const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const bool cache_fields = cache_fields_;
+  parthenon::VariablePack<Real> cooling_time_pack, temperature_pack;
+  if (cache_fields) {
+    cooling_time_pack = md->PackVariables(std::vector<std::string>{"cooling_time"});
+    temperature_pack = md->PackVariables(std::vector<std::string>{"temperature"});
+  }
   IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
   IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
@@ -638,23 +951,38 @@ Real TabularCooling::EstimateTimeStep(MeshData<Real> *md) const {
         const Real pres = prim(IPR, k, j, i);
 
         const Real internal_e = pres / (rho * gm1);
-
         const Real de_dt = cooling_table_obj.DeDt(internal_e, rho);
 
-        // Compute cooling time
-        // If de_dt is zero (temperature is smaller than lower end of cooling table) or
-        // current temp is below floor, use infinite cooling time
-        const Real cooling_time = ((de_dt == 0) || (internal_e < internal_e_floor))
-                                      ? std::numeric_limits<Real>::infinity()
-                                      : fabs(internal_e / de_dt);
+        if (cache_fields) {
+          cooling_time_pack(b, 0, k, j, i) = (de_dt != 0) ? -internal_e / de_dt : NAN;
+          temperature_pack(b, 0, k, j, i) = mbar_over_kb * pres / rho;
+        }
+
+        const Real cooling_time =
+            cooling_table_obj.CoolingTimeFromDeDt(internal_e, de_dt, internal_e_floor);
 
         thread_min_cooling_time = std::min(cooling_time, thread_min_cooling_time);
       },
       reducer_min);
 
+  if (cooling_time_cfl_ <= 0.0) {
+    return std::numeric_limits<Real>::max();
+  }
+  if (!calc_dt) {
+    return std::numeric_limits<Real>::infinity();
+  }
   return cooling_time_cfl_ * min_cooling_time;
 }
 
+Real TabularCooling::GetCoolingTimeInternalEFloor(const Real mbar_gm1_over_kb) const {
+  // Determine the cooling floor, whichever is higher of the cooling table floor
+  // or fluid solver floor
+  const auto temp_cool_floor = std::pow(10.0, log_temp_start_); // low end of cool table
+  const Real temp_floor = (T_floor_ > temp_cool_floor) ? T_floor_ : temp_cool_floor;
+
+  return temp_floor / mbar_gm1_over_kb; // specific internal en.
+}
+
 void TabularCooling::TestCoolingTable(ParameterInput *pin) const {
 
   const std::string test_filename = pin->GetString("cooling", "test_filename");
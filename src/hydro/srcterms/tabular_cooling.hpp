@@ -11,6 +11,7 @@
 // C++ headers
 #include <fstream>   // stringstream
 #include <iterator>  // istream_iterator
+#include <limits>    // numeric_limits
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // string
@@ -87,6 +88,12 @@ struct RK45Stepper {
 
 enum class CoolIntegrator { undefined, rk12, rk45, townsend };
 
+// Read-only view of a (small) cooling table. The lookups use data dependent indices, so
+// the random access trait lets them use the read-only/texture cache on GPUs.
+using CoolingTableView =
+    Kokkos::View<const parthenon::Real *, parthenon::LayoutWrapper,
+                 parthenon::DevMemSpace, Kokkos::MemoryTraits<Kokkos::RandomAccess>>;
+
 class CoolingTableObj {
   /************************************************************
    *  Cooling Table Object, for interpolating a cooling rate out of a cooling
@@ -96,7 +103,7 @@ class CoolingTableObj {
    ************************************************************/
  private:
   // Log cooling rate/ne^3
-  parthenon::ParArray1D<parthenon::Real> log_lambdas_;
+  CoolingTableView log_lambdas_;
 
   // Spacing of cooling table
   // TODO: assumes evenly spaced cooling table
@@ -109,6 +116,13 @@ class CoolingTableObj {
   // (Hydrogen mass fraction / hydrogen atomic mass)^2
   parthenon::Real x_H_over_m_h2_;
 
+  // Fast table: piecewise power laws in log2 space, i.e., log2 of the cooling rates and
+  // their difference to the next entry, so that the interpolation is a single
+  // multiply-add (in units of bins) and requires log2 and exp2 (but no divisions).
+  bool fast_table_ = false;
+  parthenon::Real log2_temp_start_, log2_temp_final_, inv_d_log2_temp_;
+  CoolingTableView log2_lambdas_, d_log2_lambdas_;
+
  public:
   CoolingTableObj()
       : log_lambdas_(), log_temp_start_(NAN), log_temp_final_(NAN), d_log_temp_(NAN),
@@ -118,11 +132,35 @@ class CoolingTableObj {
                   const parthenon::Real log_temp_final, const parthenon::Real d_log_temp,
                   const unsigned int n_temp, const parthenon::Real mbar_over_kb,
                   const parthenon::Real adiabatic_index, const parthenon::Real x_H,
-                  const Units units)
+                  const Units units, const bool fast_table = false)
       : log_lambdas_(log_lambdas), log_temp_start_(log_temp_start),
         log_temp_final_(log_temp_final), d_log_temp_(d_log_temp), n_temp_(n_temp),
         mbar_gm1_over_k_B_(mbar_over_kb * (adiabatic_index - 1)),
-        x_H_over_m_h2_(SQR(x_H / units.mh())) {}
+        x_H_over_m_h2_(SQR(x_H / units.mh())), fast_table_(fast_table) {
+    if (fast_table_) {
+      const parthenon::Real log2_10 = std::log2(10.0);
+      log2_temp_start_ = log_temp_start_ * log2_10;
+      log2_temp_final_ = log_temp_final_ * log2_10;
+      inv_d_log2_temp_ = 1.0 / (d_log_temp_ * log2_10);
+      parthenon::ParArray1D<parthenon::Real> log2_lambdas("log2_lambdas", n_temp_);
+      parthenon::ParArray1D<parthenon::Real> d_log2_lambdas("d_log2_lambdas", n_temp_);
+      auto host_log_lambdas =
+          Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(), log_lambdas);
+      auto host_log2_lambdas = Kokkos::create_mirror_view(log2_lambdas);
+      auto host_d_log2_lambdas = Kokkos::create_mirror_view(d_log2_lambdas);
+      for (unsigned int i = 0; i < n_temp_; i++) {
+        host_log2_lambdas(i) = host_log_lambdas(i) * log2_10;
+      }
+      for (unsigned int i = 0; i < n_temp_; i++) {
+        host_d_log2_lambdas(i) =
+            (i + 1 < n_temp_) ? host_log2_lambdas(i + 1) - host_log2_lambdas(i) : 0.0;
+      }
+      Kokkos::deep_copy(log2_lambdas, host_log2_lambdas);
+      Kokkos::deep_copy(d_log2_lambdas, host_d_log2_lambdas);
+      log2_lambdas_ = log2_lambdas;
+      d_log2_lambdas_ = d_log2_lambdas;
+    }
+  }
 
   // Interpolate a cooling rate from the table
   // from internal energy density and density
@@ -136,6 +174,9 @@ class CoolingTableObj {
     }
 
     const Real temp = mbar_gm1_over_k_B_ * e;
+    if (fast_table_) {
+      return DeDtFastTable(temp, rho);
+    }
     const Real log_temp = log10(temp);
     Real log_lambda;
     if (log_temp < log_temp_start_) {
@@ -172,11 +213,62 @@ class CoolingTableObj {
     return de_dt;
   }
 
+  // Same as above (identical up to roundoff) using the fast table
+  KOKKOS_INLINE_FUNCTION parthenon::Real DeDtFastTable(const parthenon::Real &temp,
+                                                       const parthenon::Real &rho) const {
+    using namespace parthenon;
+
+    const Real log2_temp = log2(temp);
+    Real log2_lambda;
+    if (log2_temp < log2_temp_start_) {
+      return 0;
+    } else if (log2_temp > log2_temp_final_) {
+      // Above table, free-free cooling (see above)
+      log2_lambda = 0.5 * (log2_temp - log2_temp_final_) + log2_lambdas_(n_temp_ - 1);
+    } else {
+      // Position in the table in units of bins
+      const Real x = (log2_temp - log2_temp_start_) * inv_d_log2_temp_;
+      // Last entry only reached for temp == temp_final (up to roundoff)
+      unsigned int i_temp = static_cast<unsigned int>(x);
+      i_temp = (i_temp < n_temp_ - 1) ? i_temp : n_temp_ - 2;
+      log2_lambda = log2_lambdas_(i_temp) + (x - i_temp) * d_log2_lambdas_(i_temp);
+    }
+    // Return de/dt
+    return -exp2(log2_lambda) * x_H_over_m_h2_ * rho;
+  }
+
   KOKKOS_INLINE_FUNCTION parthenon::Real DeDt(const parthenon::Real &e,
                                               const parthenon::Real &rho) const {
     bool is_valid = true;
     return DeDt(e, rho, is_valid);
   }
+
+  // Cooling time from specific internal energy and density.
+  // If de_dt is zero (temperature is smaller than lower end of cooling table) or
+  // current internal energy is below the floor, the cooling time is infinite.
+  KOKKOS_INLINE_FUNCTION parthenon::Real
+  CoolingTime(const parthenon::Real &e, const parthenon::Real &rho,
+              const parthenon::Real &e_floor) const {
+    return CoolingTimeFromDeDt(e, DeDt(e, rho), e_floor);
+  }
+
+  // Same as above for an already interpolated cooling rate
+  KOKKOS_INLINE_FUNCTION parthenon::Real
+  CoolingTimeFromDeDt(const parthenon::Real &e, const parthenon::Real &de_dt,
+                      const parthenon::Real &e_floor) const {
+    return ((de_dt == 0) || (e < e_floor))
+               ? std::numeric_limits<parthenon::Real>::infinity()
+               : fabs(e / de_dt);
+  }
+};
+
+// Work list (reused across calls) of the subcycling of a partition containing the
+// flattened cell index and the state (sub_t, sub_dt, internal_e, sub_iter) of the cells
+// still subcycling.
+struct CoolingWorkLists {
+  parthenon::ParArray1D<int> cells;
+  parthenon::ParArray2D<parthenon::Real> states;
+  Kokkos::View<int, parthenon::DevMemSpace> num_cells;
 };
 
 class TabularCooling {
@@ -186,8 +278,8 @@ class TabularCooling {
   parthenon::Real log_temp_start_, log_temp_final_, d_log_temp_, lambda_final_;
 
   // Table of log cooling rates
-  // TODO(forrestglines): Make log_lambdas_ explicitly a texture cache array, use CUDA to
-  // interpolate directly
+  // The tables are only accessed through (read-only) CoolingTableViews in the kernels.
+  // TODO(forrestglines): Use CUDA to interpolate directly
   // Log versions are used in subcyling cooling where cooling rates are interpolated
   // Non-log versions are used for Townsend cooling
   parthenon::ParArray1D<parthenon::Real> log_lambdas_;
@@ -209,9 +301,19 @@ class TabularCooling {
   // Maximum number of iterations/subcycles
   unsigned int max_iter_;
 
+  // Number of subcycles in the first phase after which the remaining cells are
+  // compacted into a work list for the second phase (0 disables the compaction)
+  unsigned int compaction_iter_;
+  // The work lists of the second phase (one per partition) are stored in the
+  // "cooling_work_lists" param
+
   // Cooling CFL
   parthenon::Real cooling_time_cfl_;
 
+  // Store the cooling time and temperature (of the interior cells) in the
+  // `cooling_time` and `temperature` fields whenever the cooling timestep is estimated
+  bool cache_fields_;
+
   // Minimum timestep that the cooling may limit the simulation timestep
   // Use nonpositive values to disable
   parthenon::Real min_cooling_timestep_;
@@ -242,6 +344,21 @@ class TabularCooling {
 
   parthenon::Real EstimateTimeStep(parthenon::MeshData<parthenon::Real> *md) const;
 
+  // Cooling CFL number used in the timestep estimate
+  parthenon::Real GetCoolingTimeCFL() const { return cooling_time_cfl_; }
+
+  // Whether the `cooling_time` (-e/de_dt, NaN if not cooling) and `temperature` fields
+  // are filled (in the interior) as part of every timestep estimate, i.e., they contain
+  // the state at the end of the last cycle (or after initialization and remeshing) and
+  // can be used by outputs and work at the beginning of a cycle without additional
+  // table lookups.
+  bool CachesFields() const { return cache_fields_; }
+
+  // Specific internal energy floor used in the timestep estimate, i.e., whichever is
+  // higher of the cooling table floor or fluid solver floor
+  parthenon::Real
+  GetCoolingTimeInternalEFloor(const parthenon::Real mbar_gm1_over_kb) const;
+
   // Get a lightweight object for computing cooling rate from the cooling table
   const CoolingTableObj GetCoolingTableObj() const { return cooling_table_obj_; }
 
@@ -14,6 +14,8 @@
 #include "main.hpp"
 
 #include "pgen/pgen.hpp"
+#include "utils/async_output.hpp"
+#include "utils/task_timers.hpp"
 // Initialize defaults for package specific callback functions
 namespace Hydro {
 InitPackageDataFun_t ProblemInitPackageData = nullptr;
@@ -22,6 +24,8 @@ SourceFun_t ProblemSourceStrangSplit = nullptr;
 SourceFun_t ProblemSourceUnsplit = nullptr;
 EstimateTimestepFun_t ProblemEstimateTimestep = nullptr;
 std::function<AmrTag(MeshBlockData<Real> *mbd)> ProblemCheckRefinementBlock = nullptr;
+CheckRefinementMeshFun_t ProblemCheckRefinementMesh = nullptr;
+BlockCostFun_t ProblemBlockCost = nullptr;
 } // namespace Hydro
 
 int main(int argc, char *argv[]) {
@@ -48,40 +52,42 @@ int main(int argc, char *argv[]) {
 
   if (problem == "linear_wave") {
     pman.app_input->InitUserMeshData = linear_wave::InitUserMeshData;
-    pman.app_input->ProblemGenerator = linear_wave::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = linear_wave::ProblemGenerator;
     pman.app_input->UserWorkAfterLoop = linear_wave::UserWorkAfterLoop;
   } else if (problem == "linear_wave_mhd") {
     pman.app_input->InitUserMeshData = linear_wave_mhd::InitUserMeshData;
-    pman.app_input->ProblemGenerator = linear_wave_mhd::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = linear_wave_mhd::ProblemGenerator;
     pman.app_input->UserWorkAfterLoop = linear_wave_mhd::UserWorkAfterLoop;
   } else if (problem == "cpaw") {
     pman.app_input->InitUserMeshData = cpaw::InitUserMeshData;
-    pman.app_input->ProblemGenerator = cpaw::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = cpaw::ProblemGenerator;
     pman.app_input->UserWorkAfterLoop = cpaw::UserWorkAfterLoop;
   } else if (problem == "cloud") {
     pman.app_input->InitUserMeshData = cloud::InitUserMeshData;
-    pman.app_input->ProblemGenerator = cloud::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = cloud::ProblemGenerator;
     pman.app_input->boundary_conditions[parthenon::BoundaryFace::inner_x2] =
         cloud::InflowWindX2;
-    Hydro::ProblemCheckRefinementBlock = cloud::ProblemCheckRefinementBlock;
+    Hydro::ProblemCheckRefinementMesh = cloud::ProblemCheckRefinementMesh;
+    Hydro::ProblemInitPackageData = cloud::ProblemInitPackageData;
+    pman.app_input->PostStepMeshUserWorkInLoop = cloud::TrackCloud;
   } else if (problem == "blast") {
     pman.app_input->InitUserMeshData = blast::InitUserMeshData;
-    pman.app_input->ProblemGenerator = blast::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = blast::ProblemGenerator;
     pman.app_input->UserWorkAfterLoop = blast::UserWorkAfterLoop;
   } else if (problem == "advection") {
     pman.app_input->InitUserMeshData = advection::InitUserMeshData;
-    pman.app_input->ProblemGenerator = advection::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = advection::ProblemGenerator;
   } else if (problem == "orszag_tang") {
-    pman.app_input->ProblemGenerator = orszag_tang::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = orszag_tang::ProblemGenerator;
   } else if (problem == "diffusion") {
-    pman.app_input->ProblemGenerator = diffusion::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = diffusion::ProblemGenerator;
   } else if (problem == "field_loop") {
-    pman.app_input->ProblemGenerator = field_loop::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = field_loop::ProblemGenerator;
     Hydro::ProblemInitPackageData = field_loop::ProblemInitPackageData;
   } else if (problem == "kh") {
-    pman.app_input->ProblemGenerator = kh::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = kh::ProblemGenerator;
   } else if (problem == "rand_blast") {
-    pman.app_input->ProblemGenerator = rand_blast::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = rand_blast::ProblemGenerator;
     Hydro::ProblemInitPackageData = rand_blast::ProblemInitPackageData;
     Hydro::ProblemSourceFirstOrder = rand_blast::RandomBlasts;
   } else if (problem == "cluster") {
@@ -90,14 +96,17 @@ int main(int argc, char *argv[]) {
     Hydro::ProblemInitPackageData = cluster::ProblemInitPackageData;
     Hydro::ProblemSourceUnsplit = cluster::ClusterSrcTerm;
     Hydro::ProblemEstimateTimestep = cluster::ClusterEstimateTimestep;
+    Hydro::ProblemBlockCost = cluster::ClusterBlockCost;
+    pman.app_input->PostStepDiagnosticsInLoop = cluster::ClusterPostStepDiagnostics;
   } else if (problem == "sod") {
-    pman.app_input->ProblemGenerator = sod::ProblemGenerator;
+    pman.app_input->MeshProblemGenerator = sod::ProblemGenerator;
   } else if (problem == "turbulence") {
     pman.app_input->MeshProblemGenerator = turbulence::ProblemGenerator;
     Hydro::ProblemInitPackageData = turbulence::ProblemInitPackageData;
     Hydro::ProblemSourceFirstOrder = turbulence::Driving;
     pman.app_input->InitMeshBlockUserData = turbulence::SetPhases;
     pman.app_input->MeshBlockUserWorkBeforeOutput = turbulence::UserWorkBeforeOutput;
+    pman.app_input->PostStepDiagnosticsInLoop = turbulence::PostStepDiagnostics;
   } else {
     // parthenon throw error message for the invalid problem
     std::stringstream msg;
@@ -118,6 +127,12 @@ int main(int argc, char *argv[]) {
 
     // This line actually runs the simulation
     driver.Execute();
+
+    // End of run report of the task timers (if enabled)
+    auto hydro_pkg = pman.pmesh->packages.Get("Hydro");
+    hydro_pkg->MutableParam<utils::TaskTimers>("task_timers")->Report();
+    // Wait for pending snapshots (if enabled)
+    hydro_pkg->Param<std::shared_ptr<utils::AsyncOutput>>("async_output")->Finalize();
   }
 
   // call MPI_Finalize and Kokkos::finalize if necessary
@@ -30,12 +30,39 @@ enum {
 // array indices for 1D primitives: velocity, transverse components of field
 enum { IV1 = 1, IV2 = 2, IV3 = 3, IPR = 4 };
 
-enum class RiemannSolver { undefined, none, hlle, llf, hllc, hlld };
-enum class Reconstruction { undefined, dc, plm, ppm, wenoz, weno3, limo3 };
+enum class RiemannSolver {
+  undefined,
+  none,
+  hlle,
+  llf,
+  hllc,
+  hlld,
+  hlld_branchless,
+  hybrid_hllc,
+  hybrid_hlld
+};
+enum class Reconstruction {
+  undefined,
+  dc,
+  plm,
+  ppm,
+  wenoz,
+  weno3,
+  limo3,
+  hybrid_ppm,
+  hybrid_wenoz
+};
 enum class Integrator { undefined, rk1, rk2, vl2, rk3 };
 enum class Fluid { undefined, euler, glmmhd };
+// tight_boundary only calculates the fluxes on the block faces and is used internally
+// for overlapping the flux correction communication with the flux calculation.
+enum class FluxKernel { undefined, scratch, fused, tight, tight_boundary };
+enum class BoundaryExchange { undefined, parthenon, split, combined };
 enum class Cooling { none, tabular };
 enum class Conduction { none, spitzer, thermal_diff };
+// Integration of the diffusive terms, i.e., unsplit (added to the hyperbolic fluxes) or
+// operator split super-time-stepping
+enum class DiffInt { none, unsplit, rkl2 };
 
 enum class Hst { idx, ekin, emag, divb };
 
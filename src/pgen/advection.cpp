@@ -19,6 +19,7 @@
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <vector>
 
 // Parthenon headers
 #include "config.hpp"
@@ -72,10 +73,11 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
 //  \brief Simple advection problem generator for 1D/2D/3D problems.
 //========================================================================================
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
   const auto vx = pin->GetOrAddReal("problem/advection", "vx", 0.0);
   const auto vy = pin->GetOrAddReal("problem/advection", "vy", 0.0);
   const auto vz = pin->GetOrAddReal("problem/advection", "vz", 0.0);
@@ -91,14 +93,12 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
   auto gm1 = (gam - 1.0);
 
   // initialize conserved variables
-  auto &rc = pmb->meshblock_data.Get();
-  auto &u_dev = rc->Get("cons").data;
-  auto &coords = pmb->coords;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  pmb->par_for(
+      "ProblemGenerator: Advection", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
         Real rho = rho0;
         Real rsq = coords.Xc<1>(i) * coords.Xc<1>(i) + coords.Xc<2>(j) * coords.Xc<2>(j) +
                    coords.Xc<3>(k) * coords.Xc<3>(k);
@@ -115,11 +115,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
         u(IM3, k, j, i) = mz;
 
         u(IEN, k, j, i) = p0 / gm1 + 0.5 * (mx * mx + my * my + mz * mz) / rho;
-      }
-    }
-  }
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
+      });
 }
 
 } // namespace advection
@@ -117,12 +117,29 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
   }
 }
 
+// Index of the first value larger than `val` in the sorted `vals` (equivalent to
+// std::upper_bound) limited to the last value, i.e., cells beyond the last pixel center
+// use the last pixel.
+KOKKOS_INLINE_FUNCTION int UpperBound(const parthenon::ParArray1D<Real> &vals,
+                                      const int n, const Real val) {
+  int lo = 0, hi = n;
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (vals(mid) <= val) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo < n ? lo : n - 1;
+}
+
 //========================================================================================
-//! \fn void ProblemGenerator(MeshBlock &pmb, ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //  \brief Spherical blast wave test problem generator
 //========================================================================================
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
   Real rout = pin->GetReal("problem/blast", "radius_outer");
   Real rin = pin->GetOrAddReal("problem/blast", "radius_inner", rout);
   Real pa = pin->GetOrAddReal("problem/blast", "pressure_ambient", 1.0);
@@ -137,20 +154,44 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
   Real y0 = pin->GetOrAddReal("problem/blast", "x2_0", 0.0);
   Real z0 = pin->GetOrAddReal("problem/blast", "x3_0", 0.0);
 
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  // Copy the image (if any) to the device
+  const bool use_image = use_input_image;
+  const int nx1_img = use_image ? img_nx1 : 1;
+  const int nx2_img = use_image ? img_nx2 : 1;
+  parthenon::ParArray2D<int> img("image_data", nx2_img, nx1_img);
+  parthenon::ParArray1D<Real> img_x("image_x", nx1_img);
+  parthenon::ParArray1D<Real> img_y("image_y", nx2_img);
+  if (use_image) {
+    auto img_h = Kokkos::create_mirror_view(img);
+    auto img_x_h = Kokkos::create_mirror_view(img_x);
+    auto img_y_h = Kokkos::create_mirror_view(img_y);
+    for (int img_j = 0; img_j < nx2_img; img_j++) {
+      img_y_h(img_j) = image_y.at(img_j);
+      for (int img_i = 0; img_i < nx1_img; img_i++) {
+        img_h(img_j, img_i) = image_data(img_j, img_i);
+      }
+    }
+    for (int img_i = 0; img_i < nx1_img; img_i++) {
+      img_x_h(img_i) = image_x.at(img_i);
+    }
+    Kokkos::deep_copy(img, img_h);
+    Kokkos::deep_copy(img_x, img_x_h);
+    Kokkos::deep_copy(img_y, img_y_h);
+  }
 
   // initialize conserved variables
-  auto &rc = pmb->meshblock_data.Get();
-  auto &u_dev = rc->Get("cons").data;
-  auto &coords = pmb->coords;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
   // setup uniform ambient medium with spherical over-pressured region
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
+  pmb->par_for(
+      "ProblemGenerator: Blast", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
         Real den = da;
         Real pres = pa;
         Real x = coords.Xc<1>(i);
@@ -158,15 +199,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
         Real z = coords.Xc<3>(k);
         Real rad = std::sqrt(SQR(x - x0) + SQR(y - y0) + SQR(z - z0));
 
-        if (use_input_image) {
-          auto x_idx = std::distance(
-              image_x.begin(),
-              std::upper_bound(image_x.begin(), image_x.end(), coords.Xc<1>(i)));
-          auto y_idx = std::distance(
-              image_y.begin(),
-              std::upper_bound(image_y.begin(), image_y.end(), coords.Xc<2>(j)));
+        if (use_image) {
+          const int x_idx = UpperBound(img_x, nx1_img, x);
+          const int y_idx = UpperBound(img_y, nx2_img, y);
 
-          if (image_data(y_idx, x_idx) != 0) {
+          if (img(y_idx, x_idx) != 0) {
             den = drat * da;
             // pres = prat * pa;
           }
@@ -195,11 +232,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
         u(IM2, k, j, i) = 0.0;
         u(IM3, k, j, i) = 0.0;
         u(IEN, k, j, i) = pres / gm1;
-      }
-    }
-  }
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
+      });
 }
 
 void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm) {
@@ -11,6 +11,8 @@
 #include <algorithm> // min, max
 #include <cmath>     // log
 #include <cstring>   // strcmp()
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include "mesh/mesh.hpp"
@@ -24,6 +26,7 @@
 
 // AthenaPK headers
 #include "../main.hpp"
+#include "../refinement/refinement.hpp"
 #include "../units.hpp"
 
 namespace cloud {
@@ -33,6 +36,11 @@ Real rho_wind, mom_wind, rhoe_wind, r_cloud, rho_cloud;
 Real Bx = 0.0;
 Real By = 0.0;
 
+// Cloud tracking: velocity and offset (in x2) of the frame relative to the lab frame
+bool tracking = false;
+int tracking_interval = 1;
+Real v_wind_lab, v_frame, x2_frame;
+
 //========================================================================================
 //! \fn void InitUserMeshData(Mesh *mesh, ParameterInput *pin)
 //  \brief Function to initialize problem-specific data in mesh class.  Can also be used
@@ -83,7 +91,21 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
     }
   }
 
-  mom_wind = rho_wind * v_wind;
+  // Restored from the input on restarts
+  tracking = pin->GetOrAddBoolean("problem/cloud", "tracking", false);
+  tracking_interval = pin->GetOrAddInteger("problem/cloud", "tracking_interval", 1);
+  v_frame = pin->GetOrAddReal("problem/cloud", "frame_velocity", 0.0);
+  x2_frame = pin->GetOrAddReal("problem/cloud", "frame_offset", 0.0);
+  if (tracking) {
+    PARTHENON_REQUIRE_THROWS(pkg->Param<int>("nscalars") >= 1,
+                             "problem/cloud/tracking requires hydro/nscalars >= 1.");
+    PARTHENON_REQUIRE_THROWS(tracking_interval >= 1,
+                             "problem/cloud/tracking_interval must be >= 1.");
+  }
+  v_wind_lab = v_wind;
+
+  // Inflow as seen in the (potentially) moving frame
+  mom_wind = rho_wind * (v_wind - v_frame);
 
   std::stringstream msg;
   msg << std::setprecision(2);
@@ -102,6 +124,11 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
   msg << "## Uniform pressure (code units): " << pressure << std::endl;
   msg << "## Wind sonic Mach: " << v_wind / c_s_wind << std::endl;
   msg << "## Cloud crushing time: " << t_cc / units.myr() << " Myr" << std::endl;
+  if (tracking) {
+    msg << "## Cloud tracking frame every " << tracking_interval
+        << " cycle(s), current frame velocity: " << v_frame / units.km_s() << " km/s"
+        << std::endl;
+  }
 
   // (potentially) rescale global times only at the beginning of a simulation
   auto rescale_code_time_to_tcc =
@@ -139,14 +166,15 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //  \brief Problem Generator for the cloud in wind setup
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
   auto hydro_pkg = pmb->packages.Get("Hydro");
-  auto ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  auto jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  auto kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   const auto nhydro = hydro_pkg->Param<int>("nhydro");
   const auto nscalars = hydro_pkg->Param<int>("nscalars");
@@ -159,30 +187,30 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
 
   auto steepness = pin->GetOrAddReal("problem/cloud", "cloud_steepness", 10);
 
+  // Local copies of the problem parameters so that they're captured by value
+  const Real rho_wind_ = rho_wind, mom_wind_ = mom_wind, rhoe_wind_ = rhoe_wind;
+  const Real r_cloud_ = r_cloud, rho_cloud_ = rho_cloud, Bx_ = Bx, By_ = By;
+
   // initialize conserved variables
-  auto &mbd = pmb->meshblock_data.Get();
-  auto &u_dev = mbd->Get("cons").data;
-  auto &coords = pmb->coords;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-
-  // Read problem parameters
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  pmb->par_for(
+      "ProblemGenerator: Cloud", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
         const Real x = coords.Xc<1>(i);
         const Real y = coords.Xc<2>(j);
         const Real z = coords.Xc<3>(k);
         const Real rad = std::sqrt(SQR(x) + SQR(y) + SQR(z));
 
-        Real rho = rho_wind + 0.5 * (rho_cloud - rho_wind) *
-                                  (1.0 - std::tanh(steepness * (rad / r_cloud - 1.0)));
+        Real rho = rho_wind_ + 0.5 * (rho_cloud_ - rho_wind_) *
+                                   (1.0 - std::tanh(steepness * (rad / r_cloud_ - 1.0)));
 
         Real mom;
         // Factor 1.3 as used in Grønnow, Tepper-García, & Bland-Hawthorn 2018,
         // i.e., outside the cloud boundary region (for steepness 10)
-        if (rad > 1.3 * r_cloud) {
-          mom = mom_wind;
+        if (rad > 1.3 * r_cloud_) {
+          mom = mom_wind_;
         } else {
           mom = 0.0;
         }
@@ -190,26 +218,21 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
         u(IDN, k, j, i) = rho;
         u(IM2, k, j, i) = mom;
         // Can use rhoe_wind here as simulation is setup in pressure equil.
-        u(IEN, k, j, i) = rhoe_wind + 0.5 * mom * mom / rho;
+        u(IEN, k, j, i) = rhoe_wind_ + 0.5 * mom * mom / rho;
 
         if (mhd_enabled) {
-          u(IB1, k, j, i) = Bx;
-          u(IB2, k, j, i) = By;
-          u(IEN, k, j, i) += 0.5 * (Bx * Bx + By * By);
+          u(IB1, k, j, i) = Bx_;
+          u(IB2, k, j, i) = By_;
+          u(IEN, k, j, i) += 0.5 * (Bx_ * Bx_ + By_ * By_);
         }
 
         // Init passive scalars
         for (auto n = nhydro; n < nhydro + nscalars; n++) {
-          if (rad <= r_cloud) {
+          if (rad <= r_cloud_) {
             u(n, k, j, i) = 1.0 * rho;
           }
         }
-      }
-    }
-  }
-
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
+      });
 }
 
 void InflowWindX2(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
@@ -239,9 +262,112 @@ void InflowWindX2(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse) {
       });
 }
 
-parthenon::AmrTag ProblemCheckRefinementBlock(MeshBlockData<Real> *mbd) {
-  auto pmb = mbd->GetBlockPointer();
-  auto w = mbd->Get("prim").data;
+//----------------------------------------------------------------------------------------
+//! \fn void ProblemInitPackageData(ParameterInput *pin, StateDescriptor *pkg)
+//  \brief History output of the frame velocity and offset (if tracking the cloud)
+
+void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg) {
+  if (!pin->GetOrAddBoolean("problem/cloud", "tracking", false)) {
+    return;
+  }
+  auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+  // Same (global) values on all ranks
+  hst_vars.emplace_back(parthenon::HistoryOutputVar(
+      parthenon::UserHistoryOperation::max,
+      [](MeshData<Real> *md) { return v_frame; }, "cloud_frame_v2"));
+  hst_vars.emplace_back(parthenon::HistoryOutputVar(
+      parthenon::UserHistoryOperation::max,
+      [](MeshData<Real> *md) { return x2_frame; }, "cloud_frame_x2"));
+  pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TrackCloud(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
+//  \brief Boosts the frame (every `tracking_interval` cycles) by the mass weighted x2
+//  velocity of the cloud (traced by the first passive scalar) so that the cloud stays at
+//  rest. The gas and the inflow are Galilean transformed, i.e., the velocity (and the
+//  kinetic energy) of all cells (including ghost zones) is changed by the same amount.
+
+void TrackCloud(Mesh *pmesh, ParameterInput *pin, const parthenon::SimTime &tm) {
+  if (!tracking) {
+    return;
+  }
+  // Offset of the frame accumulated during the last step
+  x2_frame += v_frame * tm.dt;
+  pin->SetReal("problem/cloud", "frame_offset", x2_frame);
+  if (tm.ncycle % tracking_interval != 0) {
+    return;
+  }
+
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+  const int num_partitions = pmesh->DefaultNumPartitions();
+
+  // Cloud mass and x2 momentum (as traced by the passive scalar) in the current frame
+  Real sums[2] = {0.0, 0.0};
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+    const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+    const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+    Real md_mass = 0.0;
+    Real md_mom = 0.0;
+    Kokkos::parallel_reduce(
+        "cloud::TrackCloud::Reduce",
+        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+            parthenon::DevExecSpace(), {0, kb.s, jb.s, ib.s},
+            {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+            {1, 1, 1, ib.e + 1 - ib.s}),
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmass,
+                      Real &lmom) {
+          const auto &coords = cons_pack.GetCoords(b);
+          const auto mass = cons_pack(b, nhydro, k, j, i) * coords.CellVolume(k, j, i);
+          lmass += mass;
+          lmom += mass * prim_pack(b, IV2, k, j, i);
+        },
+        Kokkos::Sum<Real>(md_mass), Kokkos::Sum<Real>(md_mom));
+    sums[0] += md_mass;
+    sums[1] += md_mom;
+  }
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_PARTHENON_REAL, MPI_SUM,
+                                    MPI_COMM_WORLD));
+#endif // MPI_PARALLEL
+  if (sums[0] <= 0.0) {
+    return;
+  }
+  const Real dv = sums[1] / sums[0];
+
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+    const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+    const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "cloud::TrackCloud::Boost", parthenon::DevExecSpace(), 0,
+        cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          auto &cons = cons_pack(b);
+          const auto rho = cons(IDN, k, j, i);
+          cons(IEN, k, j, i) += (0.5 * rho * dv - cons(IM2, k, j, i)) * dv;
+          cons(IM2, k, j, i) -= rho * dv;
+          prim_pack(b, IV2, k, j, i) -= dv;
+        });
+  }
+
+  v_frame += dv;
+  mom_wind = rho_wind * (v_wind_lab - v_frame);
+  pin->SetReal("problem/cloud", "frame_velocity", v_frame);
+}
+
+void ProblemCheckRefinementMesh(MeshData<Real> *md,
+                                parthenon::ParArray1D<parthenon::AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
 
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
@@ -250,18 +376,12 @@ parthenon::AmrTag ProblemCheckRefinementBlock(MeshBlockData<Real> *mbd) {
   auto hydro_pkg = pmb->packages.Get("Hydro");
   const auto nhydro = hydro_pkg->Param<int>("nhydro");
 
-  Real maxscalar = 0.0;
-  pmb->par_reduce(
-      "cloud refinement", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e + 1,
-      KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lmaxscalar) {
+  refinement::TagMaxCriterion(
+      md, amr_tags, "cloud refinement", kb, jb, IndexRange{ib.s, ib.e + 1}, 0.01, 0.001,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
         // scalar is first variable after hydro vars
-        lmaxscalar = std::max(lmaxscalar, w(nhydro, k, j, i));
-      },
-      Kokkos::Max<Real>(maxscalar));
-
-  if (maxscalar > 0.01) return parthenon::AmrTag::refine;
-  if (maxscalar < 0.001) return parthenon::AmrTag::derefine;
-  return parthenon::AmrTag::same;
-};
+        return prim_pack(b, nhydro, k, j, i);
+      });
+}
 
 } // namespace cloud
@@ -16,13 +16,17 @@
 
 // C++ headers
 #include <algorithm> // min, max
+#include <cctype>    // isspace
 #include <cmath>     // sqrt()
 #include <cstdio>    // fopen(), fprintf(), freopen()
 #include <iostream>  // endl
 #include <limits>
+#include <set>
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <utility>   // pair
+#include <vector>
 
 // Parthenon headers
 #include "kokkos_abstraction.hpp"
@@ -39,14 +43,18 @@
 #include "../hydro/srcterms/tabular_cooling.hpp"
 #include "../main.hpp"
 #include "../utils/few_modes_ft.hpp"
+#include "../utils/partition_data.hpp"
 
 // Cluster headers
 #include "cluster/agn_feedback.hpp"
 #include "cluster/agn_triggering.hpp"
+#include "cluster/cluster_analysis.hpp"
 #include "cluster/cluster_gravity.hpp"
 #include "cluster/entropy_profiles.hpp"
+#include "cluster/fused_srcterms.hpp"
 #include "cluster/hydrostatic_equilibrium_sphere.hpp"
 #include "cluster/magnetic_tower.hpp"
+#include "cluster/region_of_interest.hpp"
 #include "cluster/snia_feedback.hpp"
 #include "parthenon_array_generic.hpp"
 #include "utils/error_checking.hpp"
@@ -56,6 +64,98 @@ using namespace parthenon::driver::prelude;
 using namespace parthenon::package::prelude;
 using utils::few_modes_ft::FewModesFT;
 
+// Clips -- ceilings on temperature, velocity, alfven velocity, and density floor --
+// within a radius of the AGN. Requires up to date primitive variables.
+struct ClusterClipsSrc {
+  Real dfloor, eceil, vceil, vceil2, vAceil2, clip_r2, gm1;
+  bool active;
+
+  explicit ClusterClipsSrc(parthenon::StateDescriptor *hydro_pkg)
+      : dfloor(hydro_pkg->Param<Real>("cluster_dfloor")),
+        eceil(hydro_pkg->Param<Real>("cluster_eceil")),
+        vceil(hydro_pkg->Param<Real>("cluster_vceil")), vceil2(SQR(vceil)),
+        vAceil2(SQR(hydro_pkg->Param<Real>("cluster_vAceil"))),
+        clip_r2(SQR(hydro_pkg->Param<Real>("cluster_clip_r"))),
+        gm1(hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0) {
+    const auto clip_r = hydro_pkg->Param<Real>("cluster_clip_r");
+    active = clip_r > 0 && (dfloor > 0 || eceil < std::numeric_limits<Real>::infinity() ||
+                            vceil < std::numeric_limits<Real>::infinity() ||
+                            vAceil2 < std::numeric_limits<Real>::infinity());
+  }
+
+  // Apply the clips to a cell within the clipping radius
+  template <typename CV>
+  KOKKOS_INLINE_FUNCTION void Apply(CV &cons, CV &prim, const int k, const int j,
+                                    const int i) const {
+    if (dfloor > 0) {
+      const Real rho = prim(IDN, k, j, i);
+      if (rho < dfloor) {
+        cons(IDN, k, j, i) = dfloor;
+        prim(IDN, k, j, i) = dfloor;
+      }
+    }
+
+    if (vceil < std::numeric_limits<Real>::infinity()) {
+      // Apply velocity ceiling
+      const Real v2 = SQR(prim(IV1, k, j, i)) + SQR(prim(IV2, k, j, i)) +
+                      SQR(prim(IV3, k, j, i));
+      if (v2 > vceil2) {
+        // Fix the velocity to the velocity ceiling
+        const Real v = sqrt(v2);
+        cons(IM1, k, j, i) *= vceil / v;
+        cons(IM2, k, j, i) *= vceil / v;
+        cons(IM3, k, j, i) *= vceil / v;
+        prim(IV1, k, j, i) *= vceil / v;
+        prim(IV2, k, j, i) *= vceil / v;
+        prim(IV3, k, j, i) *= vceil / v;
+
+        // Remove kinetic energy
+        cons(IEN, k, j, i) -= 0.5 * prim(IDN, k, j, i) * (v2 - vceil2);
+      }
+    }
+
+    if (vAceil2 < std::numeric_limits<Real>::infinity()) {
+      // Apply Alfven velocity ceiling by raising density
+      const Real rho = prim(IDN, k, j, i);
+      const Real B2 = (SQR(prim(IB1, k, j, i)) + SQR(prim(IB2, k, j, i)) +
+                       SQR(prim(IB3, k, j, i)));
+
+      // compute Alfven mach number
+      const Real va2 = (B2 / rho);
+
+      if (va2 > vAceil2) {
+        // Increase the density to match the alfven velocity ceiling
+        const Real rho_new = std::sqrt(B2 / vAceil2);
+        cons(IDN, k, j, i) = rho_new;
+        prim(IDN, k, j, i) = rho_new;
+      }
+    }
+
+    if (eceil < std::numeric_limits<Real>::infinity()) {
+      // Apply  internal energy ceiling as a pressure ceiling
+      const Real internal_e = prim(IPR, k, j, i) / (gm1 * prim(IDN, k, j, i));
+      if (internal_e > eceil) {
+        cons(IEN, k, j, i) -= prim(IDN, k, j, i) * (internal_e - eceil);
+        prim(IPR, k, j, i) = gm1 * prim(IDN, k, j, i) * eceil;
+      }
+    }
+  }
+
+  template <typename CV, typename Coords>
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, CV &cons, CV &prim,
+                                         const Coords &coords, const int k, const int j,
+                                         const int i) const {
+    if (!active) {
+      return;
+    }
+    const Real r2 = SQR(coords.template Xc<1>(i)) + SQR(coords.template Xc<2>(j)) +
+                    SQR(coords.template Xc<3>(k));
+    if (r2 < clip_r2) {
+      Apply(cons, prim, k, j, i);
+    }
+  }
+};
+
 template <class EOS>
 void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
                        const Real beta_dt, const EOS eos) {
@@ -64,15 +164,9 @@ void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
 
   // Apply clips -- ceilings on temperature, velocity, alfven velocity, and
   // density floor -- within a radius of the AGN
-  const auto &dfloor = hydro_pkg->Param<Real>("cluster_dfloor");
-  const auto &eceil = hydro_pkg->Param<Real>("cluster_eceil");
-  const auto &vceil = hydro_pkg->Param<Real>("cluster_vceil");
-  const auto &vAceil = hydro_pkg->Param<Real>("cluster_vAceil");
-  const auto &clip_r = hydro_pkg->Param<Real>("cluster_clip_r");
-
-  if (clip_r > 0 && (dfloor > 0 || eceil < std::numeric_limits<Real>::infinity() ||
-                     vceil < std::numeric_limits<Real>::infinity() ||
-                     vAceil < std::numeric_limits<Real>::infinity())) {
+  const ClusterClipsSrc clips(hydro_pkg.get());
+
+  if (clips.active) {
     // Grab some necessary variables
     const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
     const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
@@ -81,11 +175,7 @@ void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
     IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
     const auto nhydro = hydro_pkg->Param<int>("nhydro");
     const auto nscalars = hydro_pkg->Param<int>("nscalars");
-
-    const Real clip_r2 = SQR(clip_r);
-    const Real vceil2 = SQR(vceil);
-    const Real vAceil2 = SQR(vAceil);
-    const Real gm1 = (hydro_pkg->Param<Real>("AdiabaticIndex") - 1.0);
+    const Real clip_r2 = clips.clip_r2;
 
     parthenon::par_for(
         DEFAULT_LOOP_PATTERN, "Cluster::ApplyClusterClips", parthenon::DevExecSpace(), 0,
@@ -101,59 +191,7 @@ void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
           if (r2 < clip_r2) {
             // Cell falls within clipping radius
             eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-
-            if (dfloor > 0) {
-              const Real rho = prim(IDN, k, j, i);
-              if (rho < dfloor) {
-                cons(IDN, k, j, i) = dfloor;
-                prim(IDN, k, j, i) = dfloor;
-              }
-            }
-
-            if (vceil < std::numeric_limits<Real>::infinity()) {
-              // Apply velocity ceiling
-              const Real v2 = SQR(prim(IV1, k, j, i)) + SQR(prim(IV2, k, j, i)) +
-                              SQR(prim(IV3, k, j, i));
-              if (v2 > vceil2) {
-                // Fix the velocity to the velocity ceiling
-                const Real v = sqrt(v2);
-                cons(IM1, k, j, i) *= vceil / v;
-                cons(IM2, k, j, i) *= vceil / v;
-                cons(IM3, k, j, i) *= vceil / v;
-                prim(IV1, k, j, i) *= vceil / v;
-                prim(IV2, k, j, i) *= vceil / v;
-                prim(IV3, k, j, i) *= vceil / v;
-
-                // Remove kinetic energy
-                cons(IEN, k, j, i) -= 0.5 * prim(IDN, k, j, i) * (v2 - vceil2);
-              }
-            }
-
-            if (vAceil2 < std::numeric_limits<Real>::infinity()) {
-              // Apply Alfven velocity ceiling by raising density
-              const Real rho = prim(IDN, k, j, i);
-              const Real B2 = (SQR(prim(IB1, k, j, i)) + SQR(prim(IB2, k, j, i)) +
-                               SQR(prim(IB3, k, j, i)));
-
-              // compute Alfven mach number
-              const Real va2 = (B2 / rho);
-
-              if (va2 > vAceil2) {
-                // Increase the density to match the alfven velocity ceiling
-                const Real rho_new = std::sqrt(B2 / vAceil2);
-                cons(IDN, k, j, i) = rho_new;
-                prim(IDN, k, j, i) = rho_new;
-              }
-            }
-
-            if (eceil < std::numeric_limits<Real>::infinity()) {
-              // Apply  internal energy ceiling as a pressure ceiling
-              const Real internal_e = prim(IPR, k, j, i) / (gm1 * prim(IDN, k, j, i));
-              if (internal_e > eceil) {
-                cons(IEN, k, j, i) -= prim(IDN, k, j, i) * (internal_e - eceil);
-                prim(IPR, k, j, i) = gm1 * prim(IDN, k, j, i) * eceil;
-              }
-            }
+            clips.Apply(cons, prim, k, j, i);
           }
         });
   }
@@ -172,17 +210,107 @@ void ApplyClusterClips(MeshData<Real> *md, const parthenon::SimTime &tm,
   }
 }
 
+// (Re)fill the cached gravitational field if the blocks of the partition changed
+void UpdateCachedGravitationalField(MeshData<Real> *md,
+                                    parthenon::StateDescriptor *hydro_pkg) {
+  // Per partition so that concurrently executed source term tasks do not share state
+  auto &cached_signature =
+      hydro_pkg
+          ->MutableParam<utils::PartitionData<std::vector<Real>>>(
+              "gravity_partition_signatures")
+          ->Get(md);
+  auto signature = PartitionSignature(md);
+  if (cached_signature != signature) {
+    FillGravitationalField(md, hydro_pkg->Param<ClusterGravity>("cluster_gravity"));
+    cached_signature = std::move(signature);
+  }
+}
+
+// Gravity, SNIA feedback, and clips in a single kernel with a single recovery of the
+// primitive variables (before the clips, which require them)
+template <class EOS, class SNIASrc>
+void FusedClusterSrcTerm(MeshData<Real> *md, const Real beta_dt, const EOS &eos,
+                         const SNIASrc &snia_src) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto cons_to_prim = ConsToPrimSrc<EOS>{eos, hydro_pkg->Param<int>("nhydro"),
+                                               hydro_pkg->Param<int>("nscalars")};
+  const ClusterClipsSrc clips(hydro_pkg.get());
+  const std::string label = "Cluster::FusedClusterSrcTerm";
+
+  if (!hydro_pkg->Param<bool>("gravity_srcterm")) {
+    ApplyFusedSrcTerms(md, label, NoSrc(), snia_src, cons_to_prim, clips);
+    return;
+  }
+  const auto gravity_mode = hydro_pkg->Param<GravityMode>("gravity_mode");
+  if (gravity_mode == GravityMode::analytic) {
+    const auto gravity_src = GravitationalFieldSrc<ClusterGravity>{
+        hydro_pkg->Param<ClusterGravity>("cluster_gravity"), beta_dt};
+    ApplyFusedSrcTerms(md, label, gravity_src, snia_src, cons_to_prim, clips);
+  } else if (gravity_mode == GravityMode::table) {
+    const auto gravity_src = GravitationalFieldSrc<TabulatedClusterGravity>{
+        hydro_pkg->Param<TabulatedClusterGravity>("cluster_gravity_table"), beta_dt};
+    ApplyFusedSrcTerms(md, label, gravity_src, snia_src, cons_to_prim, clips);
+  } else {
+    UpdateCachedGravitationalField(md, hydro_pkg.get());
+    const auto g_pack = md->PackVariables(std::vector<std::string>{"gravity_g_over_r"});
+    const auto gravity_src =
+        CachedGravitationalFieldSrc<decltype(g_pack)>{g_pack, beta_dt};
+    ApplyFusedSrcTerms(md, label, gravity_src, snia_src, cons_to_prim, clips);
+  }
+}
+
+template <class EOS>
+void FusedClusterSrcTerm(MeshData<Real> *md, const Real beta_dt, const EOS &eos) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &snia_feedback = hydro_pkg->Param<SNIAFeedback>("snia_feedback");
+  if (snia_feedback.cached_density_) {
+    FusedClusterSrcTerm(md, beta_dt, eos, snia_feedback.GetCachedSrc(md, beta_dt));
+  } else {
+    FusedClusterSrcTerm(md, beta_dt, eos, snia_feedback.GetSrc(beta_dt));
+  }
+}
+
 void ClusterSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm,
                     const Real beta_dt) {
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
+  if (hydro_pkg->Param<bool>("cluster_fused_srcterms")) {
+    // The AGN feedback and magnetic tower remain separate kernels as they are restricted
+    // to the blocks intersecting the feedback region.
+    const auto &agn_feedback = hydro_pkg->Param<AGNFeedback>("agn_feedback");
+    agn_feedback.FeedbackSrcTerm(md, beta_dt, tm);
+
+    const auto &magnetic_tower = hydro_pkg->Param<MagneticTower>("magnetic_tower");
+    magnetic_tower.FixedFieldSrcTerm(md, beta_dt, tm);
+
+    auto fluid = hydro_pkg->Param<Fluid>("fluid");
+    if (fluid == Fluid::euler) {
+      FusedClusterSrcTerm(md, beta_dt, hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
+    } else if (fluid == Fluid::glmmhd) {
+      FusedClusterSrcTerm(md, beta_dt, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
+    } else {
+      PARTHENON_FAIL("Cluster::ClusterSrcTerm: Unknown EOS");
+    }
+    return;
+  }
+
   const bool &gravity_srcterm = hydro_pkg->Param<bool>("gravity_srcterm");
 
   if (gravity_srcterm) {
     const ClusterGravity &cluster_gravity =
         hydro_pkg->Param<ClusterGravity>("cluster_gravity");
 
-    GravitationalFieldSrcTerm(md, beta_dt, cluster_gravity);
+    const auto gravity_mode = hydro_pkg->Param<GravityMode>("gravity_mode");
+    if (gravity_mode == GravityMode::analytic) {
+      GravitationalFieldSrcTerm(md, beta_dt, cluster_gravity);
+    } else if (gravity_mode == GravityMode::table) {
+      const auto &cluster_gravity_table =
+          hydro_pkg->Param<TabulatedClusterGravity>("cluster_gravity_table");
+      GravitationalFieldSrcTerm(md, beta_dt, cluster_gravity_table);
+    } else {
+      UpdateCachedGravitationalField(md, hydro_pkg.get());
+      CachedGravitationalFieldSrcTerm(md, beta_dt);
+    }
   }
 
   const auto &agn_feedback = hydro_pkg->Param<AGNFeedback>("agn_feedback");
@@ -211,6 +339,86 @@ Real ClusterEstimateTimestep(MeshData<Real> *md) {
   return min_dt;
 }
 
+// Variables listed in any output except history and restart outputs
+std::set<std::string> OutputVariables(ParameterInput *pin) {
+  std::set<std::string> variables;
+  for (auto *pib = pin->pfirst_block; pib != nullptr; pib = pib->pnext) {
+    const auto &block = pib->block_name;
+    if (block.compare(0, 16, "parthenon/output") != 0 ||
+        !pin->DoesParameterExist(block, "variables")) {
+      continue;
+    }
+    if (pin->DoesParameterExist(block, "file_type") &&
+        (pin->GetString(block, "file_type") == "hst" ||
+         pin->GetString(block, "file_type") == "rst")) {
+      continue;
+    }
+    std::stringstream var_list(pin->GetString(block, "variables"));
+    std::string var;
+    while (std::getline(var_list, var, ',')) {
+      var.erase(std::remove_if(var.begin(), var.end(), ::isspace), var.end());
+      variables.insert(var);
+    }
+  }
+  return variables;
+}
+
+// Smallest possible cell size (on the finest level) and distance of the domain corner
+// farthest from the origin
+Real FinestCellSize(ParameterInput *pin) {
+  const auto numlevel = pin->GetOrAddInteger("parthenon/mesh", "numlevel", 1);
+  Real min_dx = std::numeric_limits<Real>::max();
+  for (const auto &dir : {"1", "2", "3"}) {
+    const auto xmin = pin->GetReal("parthenon/mesh", std::string("x") + dir + "min");
+    const auto xmax = pin->GetReal("parthenon/mesh", std::string("x") + dir + "max");
+    const auto nx = pin->GetInteger("parthenon/mesh", std::string("nx") + dir);
+    if (nx > 1) {
+      min_dx = std::min(min_dx, (xmax - xmin) / nx);
+    }
+  }
+  return min_dx / std::pow(2.0, numlevel - 1);
+}
+
+Real DomainCornerRadius(ParameterInput *pin) {
+  Real r_max2 = 0.0;
+  for (const auto &dir : {"1", "2", "3"}) {
+    const auto xmin = pin->GetReal("parthenon/mesh", std::string("x") + dir + "min");
+    const auto xmax = pin->GetReal("parthenon/mesh", std::string("x") + dir + "max");
+    r_max2 += SQR(std::max(std::abs(xmin), std::abs(xmax)));
+  }
+  return std::sqrt(r_max2);
+}
+
+// Additional cost (for the load balancing) of blocks intersecting the AGN feedback
+// region, i.e., the sphere around the origin containing the thermal feedback sphere and
+// the kinetic jet cylinders of any orientation.
+Real ClusterBlockCost(MeshBlock *pmb) {
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto &agn_feedback = hydro_pkg->Param<AGNFeedback>("agn_feedback");
+  if (agn_feedback.disabled_) {
+    return 0.0;
+  }
+  const Real r_feedback = std::max(
+      agn_feedback.thermal_radius_,
+      std::hypot(agn_feedback.kinetic_jet_radius_,
+                 agn_feedback.kinetic_jet_offset_ + agn_feedback.kinetic_jet_thickness_));
+
+  const Real dist2 = BlockDistanceToOrigin2(pmb->block_size, false);
+  return (dist2 < SQR(r_feedback)) ? hydro_pkg->Param<Real>("agn_feedback_block_cost")
+                                   : 0.0;
+}
+
+//========================================================================================
+//! \fn void ClusterPostStepDiagnostics(Mesh *pmesh, ParameterInput *pin,
+//!                                     const SimTime &tm)
+//! \brief Writes the in-situ radial profiles and phase-space histograms when due
+//========================================================================================
+void ClusterPostStepDiagnostics(Mesh *pmesh, ParameterInput *pin, const SimTime &tm) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  hydro_pkg->MutableParam<ClusterAnalysis>("cluster_analysis")
+      ->ComputeIfDue(pmesh, pin, tm);
+}
+
 //========================================================================================
 //! \fn void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor
 //! *hydro_pkg) \brief Init package data from parameter input
@@ -289,6 +497,37 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
       pin->GetBoolean("problem/cluster/gravity", "gravity_srcterm");
   hydro_pkg->AddParam<>("gravity_srcterm", gravity_srcterm);
 
+  // Evaluation of the static gravitational acceleration in the source term: analytic,
+  // from a radial lookup table, or from a cached per cell field (rebuilt after remeshing)
+  const auto gravity_mode_str =
+      pin->GetOrAddString("problem/cluster/gravity", "g_mode", "analytic");
+  auto gravity_mode = GravityMode::analytic;
+  if (gravity_mode_str == "analytic") {
+    gravity_mode = GravityMode::analytic;
+  } else if (gravity_mode_str == "table") {
+    gravity_mode = GravityMode::table;
+    // By default, the table covers [half of the smallest possible cell size, distance of
+    // the domain corner farthest from the origin]
+    const auto r_min = pin->GetOrAddReal("problem/cluster/gravity", "g_table_r_min",
+                                         0.5 * FinestCellSize(pin));
+    const auto r_max = pin->GetOrAddReal("problem/cluster/gravity", "g_table_r_max",
+                                         DomainCornerRadius(pin));
+    const auto n_r =
+        pin->GetOrAddInteger("problem/cluster/gravity", "g_table_size", 4096);
+    hydro_pkg->AddParam<>("cluster_gravity_table",
+                          TabulatedClusterGravity(cluster_gravity, r_min, r_max, n_r));
+  } else if (gravity_mode_str == "cached") {
+    gravity_mode = GravityMode::cached;
+    hydro_pkg->AddField("gravity_g_over_r",
+                        Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy}));
+    hydro_pkg->AddParam<>("gravity_partition_signatures",
+                          utils::PartitionData<std::vector<Real>>(), true);
+  } else {
+    PARTHENON_FAIL("Unknown problem/cluster/gravity/g_mode. Options are: analytic, "
+                   "table, cached");
+  }
+  hydro_pkg->AddParam<>("gravity_mode", gravity_mode);
+
   /************************************************************
    * Read Initial Entropy Profile
    ************************************************************/
@@ -302,6 +541,13 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
 
   HydrostaticEquilibriumSphere hse_sphere(pin, hydro_pkg, cluster_gravity,
                                           entropy_profile);
+  // The shared profile is integrated (or reloaded) once on every rank rather than for
+  // every meshblock
+  if (hse_sphere.SharedProfile() && !init_uniform_gas) {
+    hydro_pkg->AddParam<>("hydrostatic_equilibirum_shared_profile",
+                          hse_sphere.generate_shared_P_rho_profile(
+                              FinestCellSize(pin), DomainCornerRadius(pin)));
+  }
 
   /************************************************************
    * Read Precessing Jet Coordinate system
@@ -313,7 +559,14 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
    * Read AGN Feedback
    ************************************************************/
 
+  // Blocks intersecting the regions of the AGN triggering and feedback source terms
+  hydro_pkg->AddParam<>("cluster_roi", RegionOfInterest(), true);
+
   AGNFeedback agn_feedback(pin, hydro_pkg);
+  // Additional cost of blocks in the feedback region (if hydro/block_costs is enabled)
+  hydro_pkg->AddParam<Real>(
+      "agn_feedback_block_cost",
+      pin->GetOrAddReal("problem/cluster/agn_feedback", "block_cost", 1.0));
 
   /************************************************************
    * Read AGN Triggering
@@ -375,34 +628,66 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *hyd
   hydro_pkg->AddParam("cluster_vAceil", vAceil);
   hydro_pkg->AddParam("cluster_clip_r", clip_r);
 
+  // Apply gravity, SNIA feedback, and clips in a single kernel (after the AGN feedback
+  // and magnetic tower rather than in between)
+  const auto fused_srcterms =
+      pin->GetOrAddBoolean("problem/cluster", "fused_srcterms", false);
+  hydro_pkg->AddParam("cluster_fused_srcterms", fused_srcterms);
+
   /************************************************************
    * Add derived fields
    * NOTE: these must be filled in UserWorkBeforeOutput
    ************************************************************/
 
-  auto m = Metadata({Metadata::Cell, Metadata::OneCopy}, std::vector<int>({1}));
-
-  // log10 of cell-centered radius
-  hydro_pkg->AddField("log10_cell_radius", m);
-  // entropy
-  hydro_pkg->AddField("entropy", m);
-  // sonic Mach number v/c_s
-  hydro_pkg->AddField("mach_sonic", m);
-  // temperature
-  hydro_pkg->AddField("temperature", m);
-
+  // By default, only the derived fields listed in the `variables` of any (non history
+  // and non restart) output are allocated and filled.
+  const auto derived_fields_str =
+      pin->GetOrAddString("problem/cluster", "derived_fields", "auto");
+  PARTHENON_REQUIRE_THROWS(derived_fields_str == "auto" || derived_fields_str == "all",
+                           "Unknown problem/cluster/derived_fields. Options are: auto, "
+                           "all");
+  const auto output_variables = OutputVariables(pin);
+
+  std::vector<std::string> derived_candidates = {
+      "log10_cell_radius", // log10 of cell-centered radius
+      "entropy",
+      "mach_sonic", // sonic Mach number v/c_s
+      "temperature"};
   if (hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular) {
-    // cooling time
-    hydro_pkg->AddField("cooling_time", m);
+    derived_candidates.emplace_back("cooling_time");
   }
-
   if (hydro_pkg->Param<Fluid>("fluid") == Fluid::glmmhd) {
-    // alfven Mach number v_A/c_s
-    hydro_pkg->AddField("mach_alfven", m);
+    derived_candidates.emplace_back("mach_alfven"); // alfven Mach number v/v_A
+    derived_candidates.emplace_back("plasma_beta");
+  }
+
+  // Cooling time and temperature fields cached by the cooling (in the timestep
+  // estimate) are already filled and need not be recomputed before outputs.
+  std::set<std::string> cached_fields;
+  if (hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular &&
+      hydro_pkg->Param<cooling::TabularCooling>("tabular_cooling").CachesFields()) {
+    cached_fields = {"cooling_time", "temperature"};
+  }
 
-    // plasma beta
-    hydro_pkg->AddField("plasma_beta", m);
+  auto m = Metadata({Metadata::Cell, Metadata::OneCopy}, std::vector<int>({1}));
+  std::set<std::string> derived_fields;
+  for (const auto &field : derived_candidates) {
+    if (cached_fields.count(field) > 0) {
+      continue;
+    }
+    if (derived_fields_str == "all" || output_variables.count(field) > 0) {
+      hydro_pkg->AddField(field, m);
+      derived_fields.insert(field);
+    }
   }
+  hydro_pkg->AddParam("cluster_derived_fields", derived_fields);
+  // Cycle in which the derived fields were last filled (for all blocks at once)
+  hydro_pkg->AddParam("cluster_derived_fields_cycle", -1, true);
+
+  /************************************************************
+   * Read in-situ analysis (radial profiles and phase-space histograms)
+   ************************************************************/
+  hydro_pkg->AddParam<>("cluster_analysis", ClusterAnalysis(pin, hydro_pkg), true);
 
   /************************************************************
    * Add infrastructure for initial pertubations
@@ -533,7 +818,11 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
               ->Param<HydrostaticEquilibriumSphere<ClusterGravity, ACCEPTEntropyProfile>>(
                   "hydrostatic_equilibirum_sphere");
 
-      const auto P_rho_profile = he_sphere.generate_P_rho_profile(ib, jb, kb, coords);
+      using PRhoProfile_t = PRhoProfile<ClusterGravity, ACCEPTEntropyProfile>;
+      const auto P_rho_profile =
+          he_sphere.SharedProfile()
+              ? hydro_pkg->Param<PRhoProfile_t>("hydrostatic_equilibirum_shared_profile")
+              : he_sphere.generate_P_rho_profile(ib, jb, kb, coords);
 
       // initialize conserved variables
       parthenon::par_for(
@@ -677,6 +966,10 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
   auto const &cons = md->PackVariables(std::vector<std::string>{"cons"});
   const auto num_blocks = md->NumBlocks();
 
+  // Rank local sums used for normalization (see below)
+  Real v2_sum = 0.0;
+  Real b2_sum = 0.0;
+
   const auto sigma_v = pin->GetOrAddReal("problem/cluster/init_perturb", "sigma_v", 0.0);
 
   if (sigma_v != 0.0) {
@@ -692,8 +985,6 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
     const Real dt = 1.0;
     few_modes_ft.Generate(md, dt, "tmp_perturb");
 
-    Real v2_sum = 0.0; // used for normalization
-
     auto perturb_pack = md->PackVariables(std::vector<std::string>{"tmp_perturb"});
 
     pmb->par_reduce(
@@ -717,30 +1008,6 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
                   coords.CellVolume(k, j, i) / SQR(rho);
         },
         v2_sum);
-
-#ifdef MPI_PARALLEL
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &v2_sum, 1, MPI_PARTHENON_REAL,
-                                      MPI_SUM, MPI_COMM_WORLD));
-#endif // MPI_PARALLEL
-
-    const auto Lx = pmesh->mesh_size.x1max - pmesh->mesh_size.x1min;
-    const auto Ly = pmesh->mesh_size.x2max - pmesh->mesh_size.x2min;
-    const auto Lz = pmesh->mesh_size.x3max - pmesh->mesh_size.x3min;
-    auto v_norm = std::sqrt(v2_sum / (Lx * Ly * Lz) / (SQR(sigma_v)));
-
-    pmb->par_for(
-        "Norm sigma_v", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
-          const auto &u = cons(b);
-
-          u(IM1, k, j, i) /= v_norm;
-          u(IM2, k, j, i) /= v_norm;
-          u(IM3, k, j, i) /= v_norm;
-
-          u(IEN, k, j, i) +=
-              0.5 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i)) + SQR(u(IM3, k, j, i))) /
-              u(IDN, k, j, i);
-        });
   }
 
   /************************************************************
@@ -760,8 +1027,6 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
     const Real dt = 1.0;
     few_modes_ft.Generate(md, dt, "tmp_perturb");
 
-    Real b2_sum = 0.0; // used for normalization
-
     auto perturb_pack = md->PackVariables(std::vector<std::string>{"tmp_perturb"});
 
     pmb->par_reduce(
@@ -795,134 +1060,208 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
                   coords.CellVolume(k, j, i);
         },
         b2_sum);
+  }
 
+  /************************************************************
+   * Normalize initial perturbations
+   ************************************************************/
+  // The velocity and magnetic field perturbations are normalized together so that a
+  // single collective is required.
+  if (sigma_v != 0.0 || sigma_b != 0.0) {
+    Kokkos::Array<Real, 2> sums{{v2_sum, b2_sum}};
 #ifdef MPI_PARALLEL
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &b2_sum, 1, MPI_PARTHENON_REAL,
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 2, MPI_PARTHENON_REAL,
                                       MPI_SUM, MPI_COMM_WORLD));
 #endif // MPI_PARALLEL
 
     const auto Lx = pmesh->mesh_size.x1max - pmesh->mesh_size.x1min;
     const auto Ly = pmesh->mesh_size.x2max - pmesh->mesh_size.x2min;
     const auto Lz = pmesh->mesh_size.x3max - pmesh->mesh_size.x3min;
-    auto b_norm = std::sqrt(b2_sum / (Lx * Ly * Lz) / (SQR(sigma_b)));
+    const bool norm_v = sigma_v != 0.0;
+    const bool norm_b = sigma_b != 0.0;
+    const auto vol = Lx * Ly * Lz;
+    const auto v_norm = norm_v ? std::sqrt(sums[0] / vol / SQR(sigma_v)) : 1.0;
+    const auto b_norm = norm_b ? std::sqrt(sums[1] / vol / SQR(sigma_b)) : 1.0;
 
     pmb->par_for(
-        "Norm sigma_b", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        "Norm sigma_v and sigma_b", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
         KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
           const auto &u = cons(b);
 
-          u(IB1, k, j, i) /= b_norm;
-          u(IB2, k, j, i) /= b_norm;
-          u(IB3, k, j, i) /= b_norm;
+          if (norm_v) {
+            u(IM1, k, j, i) /= v_norm;
+            u(IM2, k, j, i) /= v_norm;
+            u(IM3, k, j, i) /= v_norm;
+
+            u(IEN, k, j, i) += 0.5 *
+                               (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i)) +
+                                SQR(u(IM3, k, j, i))) /
+                               u(IDN, k, j, i);
+          }
+          if (norm_b) {
+            u(IB1, k, j, i) /= b_norm;
+            u(IB2, k, j, i) /= b_norm;
+            u(IB3, k, j, i) /= b_norm;
 
-          u(IEN, k, j, i) +=
-              0.5 * (SQR(u(IB1, k, j, i)) + SQR(u(IB2, k, j, i)) + SQR(u(IB3, k, j, i)));
+            u(IEN, k, j, i) += 0.5 * (SQR(u(IB1, k, j, i)) + SQR(u(IB2, k, j, i)) +
+                                      SQR(u(IB3, k, j, i)));
+          }
         });
   }
 }
 
-void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin) {
-  // get hydro
-  auto pkg = pmb->packages.Get("Hydro");
+// Fills a derived field (including ghost cells) of all blocks of a partition, where
+// func(b, k, j, i) returns the value of the field in a cell
+template <typename Function>
+void FillDerivedField(MeshData<Real> *md, const std::string &name, const Function &func) {
+  const auto &field_pack = md->PackVariables(std::vector<std::string>{name});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::entire);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::entire);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::entire);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "Cluster::FillDerivedField", parthenon::DevExecSpace(), 0,
+      field_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        field_pack(b, 0, k, j, i) = func(b, k, j, i);
+      });
+}
+
+void FillDerivedFields(MeshData<Real> *md, ParameterInput *pin) {
+  auto pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &derived_fields =
+      pkg->Param<std::set<std::string>>("cluster_derived_fields");
+  const auto needed = [&](const std::string &field) {
+    return derived_fields.count(field) > 0;
+  };
+
   const Real gam = pin->GetReal("hydro", "gamma");
   const Real gm1 = (gam - 1.0);
 
   // get prim vars
-  auto &data = pmb->meshblock_data.Get();
-  auto const &prim = data->Get("prim").data;
-
-  // get derived fields
-  auto &log10_radius = data->Get("log10_cell_radius").data;
-  auto &entropy = data->Get("entropy").data;
-  auto &mach_sonic = data->Get("mach_sonic").data;
-  auto &temperature = data->Get("temperature").data;
-
-  // for computing temperature from primitives
-  auto units = pkg->Param<Units>("units");
-  auto mbar_over_kb = pkg->Param<Real>("mbar_over_kb");
-  auto mbar = mbar_over_kb * units.k_boltzmann();
-
-  // fill derived vars (*including ghost cells*)
-  auto &coords = pmb->coords;
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::entire);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
-
-  pmb->par_for(
-      "Cluster::UserWorkBeforeOutput", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int k, const int j, const int i) {
-        // get gas properties
-        const Real rho = prim(IDN, k, j, i);
-        const Real v1 = prim(IV1, k, j, i);
-        const Real v2 = prim(IV2, k, j, i);
-        const Real v3 = prim(IV3, k, j, i);
-        const Real P = prim(IPR, k, j, i);
-
-        // compute radius
-        const Real x = coords.Xc<1>(i);
-        const Real y = coords.Xc<2>(j);
-        const Real z = coords.Xc<3>(k);
-        const Real r2 = SQR(x) + SQR(y) + SQR(z);
-        log10_radius(k, j, i) = 0.5 * std::log10(r2);
-
-        // compute entropy
-        const Real K = P / std::pow(rho / mbar, gam);
-        entropy(k, j, i) = K;
-
-        const Real v_mag = std::sqrt(SQR(v1) + SQR(v2) + SQR(v3));
-        const Real c_s = std::sqrt(gam * P / rho); // ideal gas EOS
-        const Real M_s = v_mag / c_s;
-        mach_sonic(k, j, i) = M_s;
-
-        // compute temperature
-        temperature(k, j, i) = mbar_over_kb * P / rho;
-      });
-  if (pkg->Param<Cooling>("enable_cooling") == Cooling::tabular) {
-    auto &cooling_time = data->Get("cooling_time").data;
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+
+  if (needed("log10_cell_radius")) {
+    FillDerivedField(
+        md, "log10_cell_radius",
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          // compute radius
+          const auto &coords = prim_pack.GetCoords(b);
+          const Real x = coords.Xc<1>(i);
+          const Real y = coords.Xc<2>(j);
+          const Real z = coords.Xc<3>(k);
+          const Real r2 = SQR(x) + SQR(y) + SQR(z);
+          return 0.5 * std::log10(r2);
+        });
+  }
+
+  if (needed("entropy") || needed("temperature")) {
+    // for computing temperature from primitives
+    auto units = pkg->Param<Units>("units");
+    auto mbar_over_kb = pkg->Param<Real>("mbar_over_kb");
+    auto mbar = mbar_over_kb * units.k_boltzmann();
+
+    if (needed("entropy")) {
+      FillDerivedField(
+          md, "entropy",
+          KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+            const Real rho = prim_pack(b, IDN, k, j, i);
+            const Real P = prim_pack(b, IPR, k, j, i);
+            return P / std::pow(rho / mbar, gam);
+          });
+    }
+    if (needed("temperature")) {
+      FillDerivedField(
+          md, "temperature",
+          KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+            return mbar_over_kb * prim_pack(b, IPR, k, j, i) / prim_pack(b, IDN, k, j, i);
+          });
+    }
+  }
+
+  if (needed("mach_sonic")) {
+    FillDerivedField(
+        md, "mach_sonic",
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const Real rho = prim_pack(b, IDN, k, j, i);
+          const Real v_mag = std::sqrt(SQR(prim_pack(b, IV1, k, j, i)) +
+                                       SQR(prim_pack(b, IV2, k, j, i)) +
+                                       SQR(prim_pack(b, IV3, k, j, i)));
+          const Real c_s = std::sqrt(gam * prim_pack(b, IPR, k, j, i) / rho); // ideal gas
+          return v_mag / c_s;
+        });
+  }
 
+  if (needed("cooling_time")) {
     // get cooling function
     const cooling::TabularCooling &tabular_cooling =
         pkg->Param<cooling::TabularCooling>("tabular_cooling");
     const auto cooling_table_obj = tabular_cooling.GetCoolingTableObj();
 
-    pmb->par_for(
-        "Cluster::UserWorkBeforeOutput::CoolingTime", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int k, const int j, const int i) {
+    FillDerivedField(
+        md, "cooling_time",
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
           // get gas properties
-          const Real rho = prim(IDN, k, j, i);
-          const Real P = prim(IPR, k, j, i);
+          const Real rho = prim_pack(b, IDN, k, j, i);
+          const Real P = prim_pack(b, IPR, k, j, i);
 
           // compute cooling time
           const Real eint = P / (rho * gm1);
           const Real edot = cooling_table_obj.DeDt(eint, rho);
-          cooling_time(k, j, i) = (edot != 0) ? -eint / edot : NAN;
+          return (edot != 0) ? -eint / edot : NAN;
         });
   }
 
-  if (pkg->Param<Fluid>("fluid") == Fluid::glmmhd) {
-    auto &plasma_beta = data->Get("plasma_beta").data;
-    auto &mach_alfven = data->Get("mach_alfven").data;
-
-    pmb->par_for(
-        "Cluster::UserWorkBeforeOutput::MHD", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int k, const int j, const int i) {
-          // get gas properties
-          const Real rho = prim(IDN, k, j, i);
-          const Real P = prim(IPR, k, j, i);
-          const Real Bx = prim(IB1, k, j, i);
-          const Real By = prim(IB2, k, j, i);
-          const Real Bz = prim(IB3, k, j, i);
-          const Real B2 = (SQR(Bx) + SQR(By) + SQR(Bz));
-
+  if (needed("mach_alfven")) {
+    FillDerivedField(
+        md, "mach_alfven",
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const Real rho = prim_pack(b, IDN, k, j, i);
+          const Real v_mag = std::sqrt(SQR(prim_pack(b, IV1, k, j, i)) +
+                                       SQR(prim_pack(b, IV2, k, j, i)) +
+                                       SQR(prim_pack(b, IV3, k, j, i)));
+          const Real B2 = SQR(prim_pack(b, IB1, k, j, i)) +
+                          SQR(prim_pack(b, IB2, k, j, i)) +
+                          SQR(prim_pack(b, IB3, k, j, i));
           // compute Alfven mach number
           const Real v_A = std::sqrt(B2 / rho);
-          const Real c_s = std::sqrt(gam * P / rho); // ideal gas EOS
-          mach_alfven(k, j, i) = mach_sonic(k, j, i) * c_s / v_A;
+          return v_mag / v_A;
+        });
+  }
 
+  if (needed("plasma_beta")) {
+    FillDerivedField(
+        md, "plasma_beta",
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const Real B2 = SQR(prim_pack(b, IB1, k, j, i)) +
+                          SQR(prim_pack(b, IB2, k, j, i)) +
+                          SQR(prim_pack(b, IB3, k, j, i));
           // compute plasma beta
-          plasma_beta(k, j, i) = (B2 != 0) ? P / (0.5 * B2) : NAN;
+          return (B2 != 0) ? prim_pack(b, IPR, k, j, i) / (0.5 * B2) : NAN;
         });
   }
 }
 
+void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin) {
+  auto pkg = pmb->packages.Get("Hydro");
+  if (pkg->Param<std::set<std::string>>("cluster_derived_fields").empty()) {
+    return;
+  }
+
+  // This function is called for every block before each output but the derived fields
+  // of all blocks are filled at once (by partition) on the first call within a cycle.
+  auto pmesh = pmb->pmy_mesh;
+  auto &last_cycle = *pkg->MutableParam<int>("cluster_derived_fields_cycle");
+  if (last_cycle == pmesh->ncycle) {
+    return;
+  }
+  last_cycle = pmesh->ncycle;
+
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int i = 0; i < num_partitions; i++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", i);
+    FillDerivedFields(md.get(), pin);
+  }
+}
+
 } // namespace cluster
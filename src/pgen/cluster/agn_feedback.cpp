@@ -8,6 +8,7 @@
 //  tower
 
 #include <cmath>
+#include <limits>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
@@ -26,6 +27,7 @@
 #include "agn_triggering.hpp"
 #include "cluster_utils.hpp"
 #include "magnetic_tower.hpp"
+#include "region_of_interest.hpp"
 
 namespace cluster {
 using namespace parthenon;
@@ -289,11 +291,23 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
       hydro_pkg->Param<JetCoordsFactory>("jet_coords_factory");
   const JetCoords jet_coords = jet_coords_factory.CreateJetCoords(time);
 
+  // Only loop over the blocks intersecting the thermal feedback sphere unless the kinetic
+  // jet is active (as the velocity and internal energy ceilings are then applied
+  // everywhere).
+  parthenon::ParArray1D<int> roi_blocks;
+  const int num_roi_blocks =
+      hydro_pkg->MutableParam<RegionOfInterest>("cluster_roi")
+          ->BlocksInSphere(md, "agn_feedback",
+                           (jet_density > 0) ? std::numeric_limits<Real>::infinity()
+                                             : thermal_radius_,
+                           false, roi_blocks);
+
   // Appy kinietic jet and thermal feedback
   parthenon::par_for(
       DEFAULT_LOOP_PATTERN, "HydroAGNFeedback::FeedbackSrcTerm",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      parthenon::DevExecSpace(), 0, num_roi_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = roi_blocks(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -327,8 +341,7 @@ void AGNFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
 
             // Get the vector of the jet axis
             Real jet_axis_x, jet_axis_y, jet_axis_z;
-            jet_coords.JetCylToSimCartVector(cos_theta, sin_theta, 0, 0, 1, jet_axis_x,
-                                             jet_axis_y, jet_axis_z);
+            jet_coords.JetAxis(jet_axis_x, jet_axis_y, jet_axis_z);
 
             const Real sign_jet = (h > 0) ? 1 : -1; // Above or below jet-disk
 
@@ -22,11 +22,14 @@
 // Athena headers
 #include "../../eos/adiabatic_glmmhd.hpp"
 #include "../../eos/adiabatic_hydro.hpp"
+#include "../../hydro/srcterms/tabular_cooling.hpp"
 #include "../../main.hpp"
 #include "../../units.hpp"
+#include "../../utils/global_reductions.hpp"
 #include "agn_feedback.hpp"
 #include "agn_triggering.hpp"
 #include "cluster_utils.hpp"
+#include "region_of_interest.hpp"
 
 namespace cluster {
 using namespace parthenon;
@@ -64,6 +67,7 @@ AGNTriggering::AGNTriggering(parthenon::ParameterInput *pin,
       bondi_n0_(pin->GetOrAddReal(block, "bondi_n0", 0)),
       bondi_beta_(pin->GetOrAddReal(block, "bondi_beta", 0)),
       accretion_cfl_(pin->GetOrAddReal(block, "accretion_cfl", 1e-1)),
+      update_interval_(pin->GetOrAddInteger(block, "update_interval", 1)),
       remove_accreted_mass_(pin->GetOrAddBoolean(block, "removed_accreted_mass", true)),
       write_to_file_(pin->GetOrAddBoolean(block, "write_to_file", false)),
       triggering_filename_(
@@ -77,32 +81,25 @@ AGNTriggering::AGNTriggering(parthenon::ParameterInput *pin,
 
   mean_molecular_mass_ = mu * units.atomic_mass_unit();
 
+  PARTHENON_REQUIRE_THROWS(update_interval_ >= 1,
+                           "agn_triggering/update_interval must be >= 1.");
+
   if (triggering_mode_ == AGNTriggeringMode::NONE) {
     hydro_pkg->AddParam<bool>("agn_triggering_reduce_accretion_rate", false);
   } else {
     hydro_pkg->AddParam<bool>("agn_triggering_reduce_accretion_rate", true);
   }
-  switch (triggering_mode_) {
-  case AGNTriggeringMode::COLD_GAS: {
-    hydro_pkg->AddParam<Real>("agn_triggering_cold_mass", 0, Params::Mutability::Restart);
-    break;
-  }
-  case AGNTriggeringMode::BOOSTED_BONDI:
-  case AGNTriggeringMode::BOOTH_SCHAYE: {
-    hydro_pkg->AddParam<Real>("agn_triggering_total_mass", 0,
-                              Params::Mutability::Restart);
-    hydro_pkg->AddParam<Real>("agn_triggering_mass_weighted_density", 0,
-                              Params::Mutability::Restart);
-    hydro_pkg->AddParam<Real>("agn_triggering_mass_weighted_velocity", 0,
-                              Params::Mutability::Restart);
-    hydro_pkg->AddParam<Real>("agn_triggering_mass_weighted_cs", 0,
-                              Params::Mutability::Restart);
-    break;
-  }
-  case AGNTriggeringMode::NONE: {
-    break;
-  }
+  // Rank local contributions are globally reduced together with other reductions
+  auto *global_reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+  for (const auto &param : TriggeringParams()) {
+    hydro_pkg->AddParam<Real>(param, 0, Params::Mutability::Restart);
+    global_reductions->Register(param, utils::ReductionOp::sum);
   }
+  // The first cycle (also after restarts) always updates
+  hydro_pkg->AddParam<int>("agn_triggering_cycles_since_update", update_interval_ - 1,
+                           true);
+  hydro_pkg->AddParam<Real>("agn_triggering_time_since_update", 0.0, true);
 
   // Set up writing the triggering to file, used for debugging and regression
   // testing. Note that this is written every timestep, which is more
@@ -148,19 +145,44 @@ void AGNTriggering::ReduceColdMass(parthenon::Real &cold_mass,
   const auto units = hydro_pkg->Param<Units>("units");
   const Real mean_molecular_mass_by_kb = mean_molecular_mass_ / units.k_boltzmann();
 
+  // The temperature of interior cells is taken from the fields cached by the cooling
+  // (when enabled) that contain the state at the beginning of the cycle (converted
+  // from the mean molecular mass used in the cooling).
+  const bool cached_temp =
+      hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular &&
+      hydro_pkg->Param<cooling::TabularCooling>("tabular_cooling").CachesFields();
+  parthenon::VariablePack<Real> temp_pack;
+  Real cached_temp_factor = 0;
+  if (cached_temp) {
+    temp_pack = md->PackVariables(std::vector<std::string>{"temperature"});
+    cached_temp_factor =
+        mean_molecular_mass_by_kb / hydro_pkg->Param<Real>("mbar_over_kb");
+  }
+
   const Real cold_temp_thresh = cold_temp_thresh_;
   const Real cold_t_acc = cold_t_acc_;
 
   const bool remove_accreted_mass = remove_accreted_mass_;
 
+  // Only loop over the blocks (including ghost zones) intersecting the accretion region
+  parthenon::ParArray1D<int> roi_blocks;
+  const int num_roi_blocks =
+      hydro_pkg->MutableParam<RegionOfInterest>("cluster_roi")
+          ->BlocksInSphere(md, "agn_triggering_entire", accretion_radius_, true,
+                           roi_blocks);
+  if (num_roi_blocks == 0) {
+    return;
+  }
+
   Real md_cold_mass = 0;
 
   parthenon::par_reduce(
       parthenon::loop_pattern_mdrange_tag, "AGNTriggering::ReduceColdGas",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      parthenon::DevExecSpace(), 0, num_roi_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
       ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
                     Real &team_cold_mass) {
+        const int b = roi_blocks(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -168,16 +190,19 @@ void AGNTriggering::ReduceColdMass(parthenon::Real &cold_mass,
         const parthenon::Real r2 =
             pow(coords.Xc<1>(i), 2) + pow(coords.Xc<2>(j), 2) + pow(coords.Xc<3>(k), 2);
         if (r2 < accretion_radius2) {
+          const bool interior = k >= int_kb.s && k <= int_kb.e && j >= int_jb.s &&
+                                j <= int_jb.e && i >= int_ib.s && i <= int_ib.e;
 
           const Real temp =
-              mean_molecular_mass_by_kb * prim(IPR, k, j, i) / prim(IDN, k, j, i);
+              (cached_temp && interior)
+                  ? cached_temp_factor * temp_pack(b, 0, k, j, i)
+                  : mean_molecular_mass_by_kb * prim(IPR, k, j, i) / prim(IDN, k, j, i);
 
           if (temp <= cold_temp_thresh) {
 
             const Real cell_cold_mass = prim(IDN, k, j, i) * coords.CellVolume(k, j, i);
 
-            if (k >= int_kb.s && k <= int_kb.e && j >= int_jb.s && j <= int_jb.e &&
-                i >= int_ib.s && i <= int_ib.e) {
+            if (interior) {
               // Only reduce the cold gas that exists on the interior grid
               team_cold_mass += cell_cold_mass;
             }
@@ -225,15 +250,25 @@ void AGNTriggering::ReduceBondiTriggeringQuantities(
 
   const parthenon::Real gamma = gamma_;
 
+  // Only loop over the blocks intersecting the accretion region
+  parthenon::ParArray1D<int> roi_blocks;
+  const int num_roi_blocks =
+      hydro_pkg->MutableParam<RegionOfInterest>("cluster_roi")
+          ->BlocksInSphere(md, "agn_triggering_interior", accretion_radius_, false,
+                           roi_blocks);
+  if (num_roi_blocks == 0) {
+    return;
+  }
+
   Kokkos::parallel_reduce(
       "AGNTriggering::ReduceBondi",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+          {num_roi_blocks, kb.e + 1, jb.e + 1, ib.e + 1}, {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
                     Real &ltotal_mass_red, Real &lmass_weighted_density_red,
                     Real &lmass_weighted_velocity_red, Real &lmass_weighted_cs_red) {
+        const int b = roi_blocks(n);
         auto &prim = prim_pack(b);
         const auto &coords = prim_pack.GetCoords(b);
         const parthenon::Real r2 =
@@ -290,10 +325,21 @@ void AGNTriggering::RemoveBondiAccretedGas(parthenon::MeshData<parthenon::Real>
   const Real accretion_rate = GetAccretionRate(hydro_pkg.get());
   const Real total_mass = hydro_pkg->Param<Real>("agn_triggering_total_mass");
 
+  // Only loop over the blocks (including ghost zones) intersecting the accretion region
+  parthenon::ParArray1D<int> roi_blocks;
+  const int num_roi_blocks =
+      hydro_pkg->MutableParam<RegionOfInterest>("cluster_roi")
+          ->BlocksInSphere(md, "agn_triggering_entire", accretion_radius_, true,
+                           roi_blocks);
+  if (num_roi_blocks == 0) {
+    return;
+  }
+
   parthenon::par_for(
       parthenon::loop_pattern_mdrange_tag, "AGNTriggering::RemoveBondiAccretedGas",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      parthenon::DevExecSpace(), 0, num_roi_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = roi_blocks(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -364,6 +410,60 @@ AGNTriggering::GetAccretionRate(parthenon::StateDescriptor *hydro_pkg) const {
   return 0;
 }
 
+std::vector<std::string> AGNTriggering::TriggeringParams() const {
+  switch (triggering_mode_) {
+  case AGNTriggeringMode::COLD_GAS: {
+    return {"agn_triggering_cold_mass"};
+  }
+  case AGNTriggeringMode::BOOSTED_BONDI:
+  case AGNTriggeringMode::BOOTH_SCHAYE: {
+    return {"agn_triggering_total_mass", "agn_triggering_mass_weighted_density",
+            "agn_triggering_mass_weighted_velocity", "agn_triggering_mass_weighted_cs"};
+  }
+  case AGNTriggeringMode::NONE: {
+    break;
+  }
+  }
+  return {};
+}
+
+bool AGNTriggeringPrepareCycle(parthenon::StateDescriptor *hydro_pkg,
+                               const parthenon::SimTime &tm, parthenon::Real &update_dt) {
+  const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
+  const int cycles = hydro_pkg->Param<int>("agn_triggering_cycles_since_update") + 1;
+  const Real elapsed = hydro_pkg->Param<Real>("agn_triggering_time_since_update") + tm.dt;
+
+  // Timescale on which the accreted mass changes (from the last update)
+  Real t_acc = std::numeric_limits<Real>::max();
+  if (agn_triggering.triggering_mode_ == AGNTriggeringMode::COLD_GAS) {
+    t_acc = agn_triggering.cold_t_acc_;
+  } else {
+    const Real total_mass = hydro_pkg->Param<Real>("agn_triggering_total_mass");
+    const Real mdot = (total_mass > 0) ? agn_triggering.GetAccretionRate(hydro_pkg) : 0;
+    t_acc = (mdot > 0) ? total_mass / mdot : 0;
+  }
+  // All ranks agree as all quantities are global
+  const bool update = cycles >= agn_triggering.update_interval_ ||
+                      elapsed > agn_triggering.accretion_cfl_ * t_acc;
+
+  auto *global_reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+  for (const auto &param : agn_triggering.TriggeringParams()) {
+    global_reductions->SetActive(param, update);
+  }
+  if (update) {
+    AGNTriggeringResetTriggering(hydro_pkg);
+    update_dt = elapsed;
+    hydro_pkg->UpdateParam("agn_triggering_cycles_since_update", 0);
+    hydro_pkg->UpdateParam("agn_triggering_time_since_update", 0.0);
+  } else {
+    update_dt = 0.0;
+    hydro_pkg->UpdateParam("agn_triggering_cycles_since_update", cycles);
+    hydro_pkg->UpdateParam("agn_triggering_time_since_update", elapsed);
+  }
+  return update;
+}
+
 parthenon::TaskStatus
 AGNTriggeringResetTriggering(parthenon::StateDescriptor *hydro_pkg) {
   const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
@@ -395,9 +495,13 @@ AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
 
+  // Thread-safe contributions of this partition to the rank local sums that have been
+  // reset in AGNTriggeringPrepareCycle (see utils/global_reductions.hpp)
+  auto *global_reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
   switch (agn_triggering.triggering_mode_) {
   case AGNTriggeringMode::COLD_GAS: {
-    Real cold_mass = hydro_pkg->Param<parthenon::Real>("agn_triggering_cold_mass");
+    Real cold_mass = 0.0;
 
     auto fluid = hydro_pkg->Param<Fluid>("fluid");
     if (fluid == Fluid::euler) {
@@ -410,27 +514,26 @@ AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
       PARTHENON_FAIL("AGNTriggeringReduceTriggeringQuantities: Unknown EOS");
     }
 
-    hydro_pkg->UpdateParam("agn_triggering_cold_mass", cold_mass);
+    global_reductions->Contribute("agn_triggering_cold_mass", md, cold_mass);
     break;
   }
   case AGNTriggeringMode::BOOSTED_BONDI:
   case AGNTriggeringMode::BOOTH_SCHAYE: {
-    Real total_mass = hydro_pkg->Param<parthenon::Real>("agn_triggering_total_mass");
-    Real mass_weighted_density =
-        hydro_pkg->Param<parthenon::Real>("agn_triggering_mass_weighted_density");
-    Real mass_weighted_velocity =
-        hydro_pkg->Param<parthenon::Real>("agn_triggering_mass_weighted_velocity");
-    Real mass_weighted_cs =
-        hydro_pkg->Param<parthenon::Real>("agn_triggering_mass_weighted_cs");
+    Real total_mass = 0.0;
+    Real mass_weighted_density = 0.0;
+    Real mass_weighted_velocity = 0.0;
+    Real mass_weighted_cs = 0.0;
 
     agn_triggering.ReduceBondiTriggeringQuantities(
         total_mass, mass_weighted_density, mass_weighted_velocity, mass_weighted_cs, md);
 
-    hydro_pkg->UpdateParam("agn_triggering_total_mass", total_mass);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_density", mass_weighted_density);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_velocity",
-                           mass_weighted_velocity);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_cs", mass_weighted_cs);
+    global_reductions->Contribute("agn_triggering_total_mass", md, total_mass);
+    global_reductions->Contribute("agn_triggering_mass_weighted_density", md,
+                                  mass_weighted_density);
+    global_reductions->Contribute("agn_triggering_mass_weighted_velocity", md,
+                                  mass_weighted_velocity);
+    global_reductions->Contribute("agn_triggering_mass_weighted_cs", md,
+                                  mass_weighted_cs);
     break;
   }
   case AGNTriggeringMode::NONE: {
@@ -441,50 +544,40 @@ AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
 }
 
 parthenon::TaskStatus
-AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg) {
-#ifdef MPI_PARALLEL
+AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
+                                const parthenon::SimTime &tm) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
-  switch (agn_triggering.triggering_mode_) {
-  case AGNTriggeringMode::COLD_GAS: {
 
-    Real accretion_rate = hydro_pkg->Param<Real>("agn_triggering_cold_mass");
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &accretion_rate, 1,
-                                      MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-    hydro_pkg->UpdateParam("agn_triggering_cold_mass", accretion_rate);
-    break;
-  }
-  case AGNTriggeringMode::BOOSTED_BONDI:
-  case AGNTriggeringMode::BOOTH_SCHAYE: {
-    Real triggering_quantities[] = {
-        hydro_pkg->Param<Real>("agn_triggering_total_mass"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_density"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_velocity"),
-        hydro_pkg->Param<Real>("agn_triggering_mass_weighted_cs"),
-    };
-
-    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &triggering_quantities, 4,
-                                      MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
-
-    hydro_pkg->UpdateParam("agn_triggering_total_mass", triggering_quantities[0]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_density",
-                           triggering_quantities[1]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_velocity",
-                           triggering_quantities[2]);
-    hydro_pkg->UpdateParam("agn_triggering_mass_weighted_cs", triggering_quantities[3]);
-    break;
-  }
-  case AGNTriggeringMode::NONE: {
-    break;
-  }
+  // Remove accreted gas if using a Bondi-like mode
+  if (agn_triggering.remove_accreted_mass_) {
+    switch (agn_triggering.triggering_mode_) {
+    case AGNTriggeringMode::BOOSTED_BONDI:
+    case AGNTriggeringMode::BOOTH_SCHAYE: {
+      auto fluid = hydro_pkg->Param<Fluid>("fluid");
+      if (fluid == Fluid::euler) {
+        agn_triggering.RemoveBondiAccretedGas(md, tm.dt,
+                                              hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
+      } else if (fluid == Fluid::glmmhd) {
+        agn_triggering.RemoveBondiAccretedGas(
+            md, tm.dt, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
+      } else {
+        PARTHENON_FAIL("AGNTriggeringFinalizeTriggering: Unknown EOS");
+      }
+      break;
+    }
+    case AGNTriggeringMode::COLD_GAS: // Already removed during reduction
+    case AGNTriggeringMode::NONE: {
+      break;
+    }
+    }
   }
-#endif
+
   return TaskStatus::complete;
 }
 
-parthenon::TaskStatus
-AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
-                                const parthenon::SimTime &tm) {
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+parthenon::TaskStatus AGNTriggeringWriteTriggering(parthenon::StateDescriptor *hydro_pkg,
+                                                   const parthenon::SimTime &tm) {
   const auto &agn_triggering = hydro_pkg->Param<AGNTriggering>("agn_triggering");
 
   // Append quantities to file if applicable
@@ -493,7 +586,7 @@ AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
     triggering_file.open(agn_triggering.triggering_filename_, std::ofstream::app);
 
     triggering_file << tm.time << " " << tm.dt << " "
-                    << agn_triggering.GetAccretionRate(hydro_pkg.get()) << " ";
+                    << agn_triggering.GetAccretionRate(hydro_pkg) << " ";
 
     switch (agn_triggering.triggering_mode_) {
     case AGNTriggeringMode::COLD_GAS: {
@@ -522,31 +615,6 @@ AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
     triggering_file << std::endl;
     triggering_file.close();
   }
-
-  // Remove accreted gas if using a Bondi-like mode
-  if (agn_triggering.remove_accreted_mass_) {
-    switch (agn_triggering.triggering_mode_) {
-    case AGNTriggeringMode::BOOSTED_BONDI:
-    case AGNTriggeringMode::BOOTH_SCHAYE: {
-      auto fluid = hydro_pkg->Param<Fluid>("fluid");
-      if (fluid == Fluid::euler) {
-        agn_triggering.RemoveBondiAccretedGas(md, tm.dt,
-                                              hydro_pkg->Param<AdiabaticHydroEOS>("eos"));
-      } else if (fluid == Fluid::glmmhd) {
-        agn_triggering.RemoveBondiAccretedGas(
-            md, tm.dt, hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos"));
-      } else {
-        PARTHENON_FAIL("AGNTriggeringFinalizeTriggering: Unknown EOS");
-      }
-      break;
-    }
-    case AGNTriggeringMode::COLD_GAS: // Already removed during reduction
-    case AGNTriggeringMode::NONE: {
-      break;
-    }
-    }
-  }
-
   return TaskStatus::complete;
 }
 
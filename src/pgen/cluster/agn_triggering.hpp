@@ -8,6 +8,10 @@
 //! \file agn_triggering.hpp
 //  \brief  Class for computing AGN triggering from Bondi-like and cold gas accretion
 
+// C++ headers
+#include <string>
+#include <vector>
+
 // parthenon headers
 #include <basic_types.hpp>
 #include <interface/state_descriptor.hpp>
@@ -55,6 +59,12 @@ class AGNTriggering {
   // Used in timestep estimation
   const parthenon::Real accretion_cfl_;
 
+  // Maximum number of cycles between updates of the accretion rate. In between, the rate
+  // of the last update is used (and with cold gas triggering the cold gas is removed at
+  // the next update) as long as the time since the last update is below
+  // accretion_cfl_ times the accretion timescale.
+  const int update_interval_;
+
   // Useful for debugging
   const bool remove_accreted_mass_;
 
@@ -93,6 +103,9 @@ class AGNTriggering {
   // reduced quantities
   parthenon::Real GetAccretionRate(parthenon::StateDescriptor *hydro_pkg) const;
 
+  // Params of the hydro package holding the (globally reduced) triggering quantities
+  std::vector<std::string> TriggeringParams() const;
+
   friend parthenon::TaskStatus
   AGNTriggeringResetTriggering(parthenon::StateDescriptor *hydro_pkg);
 
@@ -100,9 +113,6 @@ class AGNTriggering {
   AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
                                 const parthenon::Real dt);
 
-  friend parthenon::TaskStatus
-  AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg);
-
   friend parthenon::TaskStatus
   AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
                                   const parthenon::SimTime &tm);
@@ -113,19 +123,28 @@ class AGNTriggering {
   parthenon::Real EstimateTimeStep(parthenon::MeshData<parthenon::Real> *md) const;
 };
 
+// To be called (on the host) when the tasks of the first stage of a cycle are created.
+// Returns whether the triggering quantities are updated (reduced) in this cycle, which
+// then resets the quantities and sets `update_dt` to the time since the last update
+// (including this cycle). Otherwise, the quantities are excluded from the global
+// reductions.
+bool AGNTriggeringPrepareCycle(parthenon::StateDescriptor *hydro_pkg,
+                               const parthenon::SimTime &tm, parthenon::Real &update_dt);
+
 parthenon::TaskStatus AGNTriggeringResetTriggering(parthenon::StateDescriptor *hydro_pkg);
 
 parthenon::TaskStatus
 AGNTriggeringReduceTriggering(parthenon::MeshData<parthenon::Real> *md,
                               const parthenon::Real dt);
 
-parthenon::TaskStatus
-AGNTriggeringMPIReduceTriggering(parthenon::StateDescriptor *hydro_pkg);
-
 parthenon::TaskStatus
 AGNTriggeringFinalizeTriggering(parthenon::MeshData<parthenon::Real> *md,
                                 const parthenon::SimTime &tm);
 
+// Append the triggering quantities to the triggering file (if enabled)
+parthenon::TaskStatus AGNTriggeringWriteTriggering(parthenon::StateDescriptor *hydro_pkg,
+                                                   const parthenon::SimTime &tm);
+
 } // namespace cluster
 
 #endif // CLUSTER_AGN_TRIGGERING_HPP_
@@ -0,0 +1,226 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file cluster_analysis.cpp
+//  \brief In-situ radial profiles and phase-space histograms of the cluster gas
+
+// C++ headers
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <kokkos_abstraction.hpp>
+#include <mesh/domain.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../../hydro/srcterms/tabular_cooling.hpp"
+#include "../../main.hpp"
+#include "../../units.hpp"
+#include "cluster_analysis.hpp"
+
+namespace cluster {
+using namespace parthenon;
+
+ClusterAnalysis::ClusterAnalysis(ParameterInput *pin, StateDescriptor *hydro_pkg) {
+  const std::string block = "problem/cluster/analysis";
+  dt_ = pin->GetOrAddReal(block, "dt", -1.0);
+  enabled_ = dt_ > 0.0;
+  // Stored in the input so that the cadence is continued after restarts
+  next_time_ = pin->GetOrAddReal(block, "next_time", 0.0);
+  file_number_ = pin->GetOrAddInteger(block, "file_number", 0);
+  basename_ = pin->GetOrAddString(block, "basename", "cluster_analysis");
+
+  n_r_ = pin->GetOrAddInteger(block, "num_r_bins", 64);
+  log_r_min_ = std::log10(pin->GetOrAddReal(block, "r_min", 1e-3));
+  log_r_max_ = std::log10(pin->GetOrAddReal(block, "r_max", 1.0));
+
+  n_rho_ = pin->GetOrAddInteger(block, "num_rho_bins", 64);
+  log_rho_min_ = std::log10(pin->GetOrAddReal(block, "rho_min", 1e-6));
+  log_rho_max_ = std::log10(pin->GetOrAddReal(block, "rho_max", 1e2));
+  n_temp_ = pin->GetOrAddInteger(block, "num_temp_bins", 64);
+  log_temp_min_ = std::log10(pin->GetOrAddReal(block, "temp_min", 1e4));
+  log_temp_max_ = std::log10(pin->GetOrAddReal(block, "temp_max", 1e9));
+
+  if (enabled_) {
+    PARTHENON_REQUIRE_THROWS(n_r_ > 0 && log_r_max_ > log_r_min_ && n_rho_ > 0 &&
+                                 log_rho_max_ > log_rho_min_ && n_temp_ > 0 &&
+                                 log_temp_max_ > log_temp_min_,
+                             "Invalid bins for the cluster analysis");
+    PARTHENON_REQUIRE_THROWS(hydro_pkg->AllParams().hasKey("mbar_over_kb"),
+                             "Cluster analysis requires units and gas composition.");
+  }
+}
+
+void ClusterAnalysis::ComputeIfDue(Mesh *pmesh, ParameterInput *pin,
+                                   const SimTime &tm) {
+  if (!enabled_ || tm.time < next_time_) {
+    return;
+  }
+  Compute(pmesh, tm);
+
+  file_number_ += 1;
+  // Skip missed analysis times (e.g., for dt smaller than the timestep)
+  while (next_time_ <= tm.time) {
+    next_time_ += dt_;
+  }
+  pin->SetReal("problem/cluster/analysis", "next_time", next_time_);
+  pin->SetInteger("problem/cluster/analysis", "file_number", file_number_);
+}
+
+void ClusterAnalysis::Compute(Mesh *pmesh, const SimTime &tm) const {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+
+  const Real gam = hydro_pkg->Param<Real>("AdiabaticIndex");
+  const Real gm1 = gam - 1.0;
+  const auto units = hydro_pkg->Param<Units>("units");
+  const Real mbar_over_kb = hydro_pkg->Param<Real>("mbar_over_kb");
+  const Real mbar = mbar_over_kb * units.k_boltzmann();
+
+  const bool with_cooling =
+      hydro_pkg->Param<Cooling>("enable_cooling") == Cooling::tabular;
+  // Default table object if cooling is disabled (never evaluated)
+  cooling::CoolingTableObj cooling_table_obj;
+  // Use the cooling time and temperature cached by the cooling (if enabled)
+  bool cached = false;
+  if (with_cooling) {
+    const auto &tabular_cooling =
+        hydro_pkg->Param<cooling::TabularCooling>("tabular_cooling");
+    cooling_table_obj = tabular_cooling.GetCoolingTableObj();
+    cached = tabular_cooling.CachesFields();
+  }
+
+  // All bins in a single array so that they are reduced with a single collective
+  const int n_r = n_r_;
+  const int n_rho = n_rho_;
+  const int n_temp = n_temp_;
+  const int n_profile = n_r * num_quan;
+  const int n_phase = n_rho * n_temp;
+  ParArray1D<Real> bins("cluster analysis bins", n_profile + 2 * n_phase);
+
+  const Real log_r_min = log_r_min_;
+  const Real inv_dlog_r = n_r / (log_r_max_ - log_r_min_);
+  const Real log_rho_min = log_rho_min_;
+  const Real inv_dlog_rho = n_rho / (log_rho_max_ - log_rho_min_);
+  const Real log_temp_min = log_temp_min_;
+  const Real inv_dlog_temp = n_temp / (log_temp_max_ - log_temp_min_);
+
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+    parthenon::VariablePack<Real> tcool_pack, temp_pack;
+    if (cached) {
+      tcool_pack = md->PackVariables(std::vector<std::string>{"cooling_time"});
+      temp_pack = md->PackVariables(std::vector<std::string>{"temperature"});
+    }
+    IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "ClusterAnalysis::Compute", parthenon::DevExecSpace(), 0,
+        prim_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+          const auto &coords = prim_pack.GetCoords(b);
+          const Real rho = prim_pack(b, IDN, k, j, i);
+          const Real P = prim_pack(b, IPR, k, j, i);
+          const Real vol = coords.CellVolume(k, j, i);
+          const Real mass = rho * vol;
+          const Real temp = cached ? temp_pack(b, 0, k, j, i) : mbar_over_kb * P / rho;
+
+          const Real r2 =
+              SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k));
+          const int ir =
+              static_cast<int>(floor((0.5 * log10(r2) - log_r_min) * inv_dlog_r));
+          if (ir >= 0 && ir < n_r) {
+            const Real entropy = P / pow(rho / mbar, gam);
+            Real tcool = 0.0;
+            if (cached) {
+              const Real tcool_cell = tcool_pack(b, 0, k, j, i);
+              tcool = std::isnan(tcool_cell) ? 0.0 : tcool_cell;
+            } else if (with_cooling) {
+              const Real eint = P / (rho * gm1);
+              const Real edot = cooling_table_obj.DeDt(eint, rho);
+              tcool = (edot != 0) ? -eint / edot : 0.0;
+            }
+            Real *shell = &bins(ir * num_quan);
+            Kokkos::atomic_add(&shell[volume], vol);
+            Kokkos::atomic_add(&shell[ProfileQuantity::mass], mass);
+            Kokkos::atomic_add(&shell[mass_temp], mass * temp);
+            Kokkos::atomic_add(&shell[mass_entropy], mass * entropy);
+            Kokkos::atomic_add(&shell[mass_tcool], mass * tcool);
+          }
+
+          const int irho =
+              static_cast<int>(floor((log10(rho) - log_rho_min) * inv_dlog_rho));
+          const int itemp =
+              static_cast<int>(floor((log10(temp) - log_temp_min) * inv_dlog_temp));
+          if (irho >= 0 && irho < n_rho && itemp >= 0 && itemp < n_temp) {
+            const int n = n_profile + 2 * (irho * n_temp + itemp);
+            Kokkos::atomic_add(&bins(n), mass);
+            Kokkos::atomic_add(&bins(n + 1), vol);
+          }
+        });
+  }
+
+  auto bins_host = bins.GetHostMirrorAndCopy();
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, bins_host.data(),
+                                    static_cast<int>(bins_host.size()),
+                                    MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
+#endif
+  if (Globals::my_rank != 0) {
+    return;
+  }
+
+  std::stringstream number;
+  number << std::setw(5) << std::setfill('0') << file_number_;
+  {
+    std::ofstream os(basename_ + ".profiles." + number.str() + ".dat");
+    os << std::scientific << std::setprecision(8);
+    os << "# time = " << tm.time << " cycle = " << tm.ncycle << std::endl;
+    os << "# [1]=r_inner [2]=r_outer [3]=volume [4]=mass [5]=rho [6]=T_mass_weighted "
+          "[7]=K_mass_weighted";
+    if (with_cooling) {
+      os << " [8]=t_cool_mass_weighted";
+    }
+    os << std::endl;
+    for (int ir = 0; ir < n_r; ir++) {
+      const Real *shell = &bins_host(ir * num_quan);
+      const Real m = shell[ProfileQuantity::mass];
+      os << std::pow(10.0, log_r_min + ir / inv_dlog_r) << " "
+         << std::pow(10.0, log_r_min + (ir + 1) / inv_dlog_r) << " " << shell[volume]
+         << " " << m << " " << ((shell[volume] > 0) ? m / shell[volume] : 0.0) << " "
+         << ((m > 0) ? shell[mass_temp] / m : 0.0) << " "
+         << ((m > 0) ? shell[mass_entropy] / m : 0.0);
+      if (with_cooling) {
+        os << " " << ((m > 0) ? shell[mass_tcool] / m : 0.0);
+      }
+      os << std::endl;
+    }
+  }
+  {
+    std::ofstream os(basename_ + ".phase." + number.str() + ".dat");
+    os << std::scientific << std::setprecision(8);
+    os << "# time = " << tm.time << " cycle = " << tm.ncycle << std::endl;
+    os << "# [1]=log10_rho_lower [2]=log10_T_lower [3]=mass [4]=volume" << std::endl;
+    for (int irho = 0; irho < n_rho; irho++) {
+      for (int itemp = 0; itemp < n_temp; itemp++) {
+        const int n = n_profile + 2 * (irho * n_temp + itemp);
+        os << log_rho_min + irho / inv_dlog_rho << " "
+           << log_temp_min + itemp / inv_dlog_temp << " " << bins_host(n) << " "
+           << bins_host(n + 1) << std::endl;
+      }
+    }
+  }
+}
+
+} // namespace cluster
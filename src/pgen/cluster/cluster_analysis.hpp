@@ -0,0 +1,61 @@
+#ifndef CLUSTER_CLUSTER_ANALYSIS_HPP_
+#define CLUSTER_CLUSTER_ANALYSIS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file cluster_analysis.hpp
+//  \brief In-situ radial profiles and phase-space histograms of the cluster gas
+
+// C++ headers
+#include <string>
+
+// parthenon headers
+#include <basic_types.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+
+namespace cluster {
+
+/************************************************************
+ *  ClusterAnalysis
+ *
+ *  Bins the gas in logarithmic radial shells around the origin (volume, mass, and
+ *  mass weighted temperature, entropy, and cooling time) and in a 2D histogram of
+ *  log10 density and log10 temperature (mass and volume). The bins are accumulated on
+ *  device, reduced across ranks with a single collective, and written as text tables
+ *  by rank 0 every `dt`.
+ ************************************************************/
+class ClusterAnalysis {
+ public:
+  // Quantities binned in each radial shell
+  enum ProfileQuantity { volume, mass, mass_temp, mass_entropy, mass_tcool, num_quan };
+
+  ClusterAnalysis(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg);
+
+  // Computes and writes the profiles and histograms if the next analysis time is
+  // reached.
+  void ComputeIfDue(parthenon::Mesh *pmesh, parthenon::ParameterInput *pin,
+                    const parthenon::SimTime &tm);
+
+ private:
+  void Compute(parthenon::Mesh *pmesh, const parthenon::SimTime &tm) const;
+
+  bool enabled_;
+  parthenon::Real dt_, next_time_;
+  int file_number_;
+  std::string basename_;
+
+  // Logarithmic radial shells
+  int n_r_;
+  parthenon::Real log_r_min_, log_r_max_;
+  // Phase-space (log10 density, log10 temperature) grid
+  int n_rho_, n_temp_;
+  parthenon::Real log_rho_min_, log_rho_max_, log_temp_min_, log_temp_max_;
+};
+
+} // namespace cluster
+
+#endif // CLUSTER_CLUSTER_ANALYSIS_HPP_
@@ -8,7 +8,12 @@
 //! \file cluster_gravity.hpp
 //  \brief Class for defining gravitational acceleration for a cluster+bcg+smbh
 
+// C++ headers
+#include <cmath>
+#include <string>
+
 // Parthenon headers
+#include <kokkos_abstraction.hpp>
 #include <parameter_input.hpp>
 
 // AthenaPK headers
@@ -233,6 +238,48 @@ class ClusterGravity {
   friend class SNIAFeedback;
 };
 
+// How the (static) gravitational acceleration is evaluated in the source term
+enum class GravityMode { analytic, table, cached };
+
+/************************************************************
+ *  Radial lookup table of the gravitational acceleration of a ClusterGravity
+ *  (linearly interpolated in log r) for cheaper evaluation within kernels.
+ *  The analytic profile is used outside of the tabulated range.
+ ************************************************************/
+class TabulatedClusterGravity {
+  ClusterGravity analytic_;
+  parthenon::ParArray1D<parthenon::Real> g_table_;
+  parthenon::Real log_r_min_, inv_d_log_r_;
+  int n_r_;
+
+ public:
+  TabulatedClusterGravity(const ClusterGravity &analytic, const parthenon::Real r_min,
+                          const parthenon::Real r_max, const int n_r)
+      : analytic_(analytic), g_table_("cluster_gravity_g_table", n_r),
+        log_r_min_(std::log(r_min)), n_r_(n_r) {
+    PARTHENON_REQUIRE(n_r > 1 && r_min > 0.0 && r_max > r_min,
+                      "Invalid range or size of the cluster gravity table");
+    inv_d_log_r_ = (n_r - 1) / (std::log(r_max) - log_r_min_);
+    auto g_table_host = g_table_.GetHostMirror();
+    for (int n = 0; n < n_r; n++) {
+      g_table_host(n) = analytic.g_from_r(std::exp(log_r_min_ + n / inv_d_log_r_));
+    }
+    g_table_.DeepCopy(g_table_host);
+  }
+
+  KOKKOS_INLINE_FUNCTION parthenon::Real g_from_r(const parthenon::Real r) const
+      __attribute__((always_inline)) {
+    const parthenon::Real x = (log(r) - log_r_min_) * inv_d_log_r_;
+    // also covers r = 0, i.e., x = -inf
+    if (!(x >= 0.0) || x >= n_r_ - 1) {
+      return analytic_.g_from_r(r);
+    }
+    const int idx = static_cast<int>(x);
+    const parthenon::Real w = x - idx;
+    return (1.0 - w) * g_table_(idx) + w * g_table_(idx + 1);
+  }
+};
+
 } // namespace cluster
 
 #endif // CLUSTER_CLUSTER_GRAVITY_HPP_
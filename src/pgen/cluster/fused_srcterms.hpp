@@ -0,0 +1,75 @@
+#ifndef CLUSTER_FUSED_SRCTERMS_HPP_
+#define CLUSTER_FUSED_SRCTERMS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file fused_srcterms.hpp
+//  \brief Kernel applying a sequence of per cell source terms in a single sweep
+//
+// Each source term is a device functor with the signature
+//   operator()(const int b, CV &cons, CV &prim, const Coords &coords,
+//              const int k, const int j, const int i) const
+// that updates the conserved (and potentially primitive) variables of a single cell.
+// The functors are applied in the order they are passed.
+
+// C++ headers
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <interface/mesh_data.hpp>
+#include <kokkos_abstraction.hpp>
+#include <mesh/domain.hpp>
+
+namespace cluster {
+
+// Recovers the primitive variables (e.g., before source terms that require them)
+template <typename EOS>
+struct ConsToPrimSrc {
+  EOS eos;
+  int nhydro, nscalars;
+
+  template <typename CV, typename Coords>
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, CV &cons, CV &prim,
+                                         const Coords &coords, const int k, const int j,
+                                         const int i) const {
+    eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+  }
+};
+
+// Placeholder for disabled source terms
+struct NoSrc {
+  template <typename CV, typename Coords>
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, CV &cons, CV &prim,
+                                         const Coords &coords, const int k, const int j,
+                                         const int i) const {}
+};
+
+template <typename... Srcs>
+void ApplyFusedSrcTerms(parthenon::MeshData<parthenon::Real> *md,
+                        const std::string &label, const Srcs... srcs) {
+  using parthenon::IndexDomain;
+  using parthenon::IndexRange;
+
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, label, parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1,
+      kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+        auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
+        (srcs(b, cons, prim, coords, k, j, i), ...);
+      });
+}
+
+} // namespace cluster
+
+#endif // CLUSTER_FUSED_SRCTERMS_HPP_
@@ -11,8 +11,12 @@
 //========================================================================================
 
 // C++ headers
+#include <cstdint>
 #include <fstream>
 #include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
@@ -59,6 +63,11 @@ HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::
   r_sampling_ =
       pin->GetOrAddReal("problem/cluster/hydrostatic_equilibrium", "r_sampling", 4.0);
 
+  shared_profile_ = pin->GetOrAddBoolean("problem/cluster/hydrostatic_equilibrium",
+                                         "shared_profile", false);
+  profile_file_ =
+      pin->GetOrAddString("problem/cluster/hydrostatic_equilibrium", "profile_file", "");
+
   // Test out the HSE sphere if requested
   const bool test_he_sphere = pin->GetOrAddBoolean(
       "problem/cluster/hydrostatic_equilibrium", "test_he_sphere", false);
@@ -118,6 +127,28 @@ std::ostream &PRhoProfile<GravitationalField, EntropyProfile>::write_to_ostream(
   return os;
 }
 
+/************************************************************
+ * PRhoProfile::write_binary
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+void PRhoProfile<GravitationalField, EntropyProfile>::write_binary(
+    std::ostream &os) const {
+  auto host_p = Kokkos::create_mirror_view(p_);
+  Kokkos::deep_copy(host_p, p_);
+
+  const Real k_fix = sphere_.entropy_profile_.K_from_r(sphere_.r_fix_);
+  const Real p_fix = sphere_.P_from_rho_K(sphere_.rho_fix_, k_fix);
+  const std::int64_t n_r = n_r_;
+  os.write(reinterpret_cast<const char *>(&r_start_), sizeof(Real));
+  os.write(reinterpret_cast<const char *>(&r_end_), sizeof(Real));
+  os.write(reinterpret_cast<const char *>(&n_r), sizeof(n_r));
+  os.write(reinterpret_cast<const char *>(&p_fix), sizeof(Real));
+  for (int i = 0; i < n_r_; i++) {
+    const Real p = host_p(i);
+    os.write(reinterpret_cast<const char *>(&p), sizeof(Real));
+  }
+}
+
 /************************************************************
  *HydrostaticEquilibriumSphere::generate_P_rho_profile(x,y,z)
  ************************************************************/
@@ -252,6 +283,75 @@ HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::generate_P_rho
                                                          r(n_r - 1), *this);
 }
 
+/************************************************************
+ * HydrostaticEquilibriumSphere::generate_shared_P_rho_profile(min_dx, r_max)
+ ************************************************************/
+template <typename GravitationalField, typename EntropyProfile>
+PRhoProfile<GravitationalField, EntropyProfile>
+HydrostaticEquilibriumSphere<GravitationalField, EntropyProfile>::
+    generate_shared_P_rho_profile(const Real min_dx, const Real r_max) const {
+  // Same resolution and padding as the per meshblock profiles of the finest blocks
+  const Real dr = std::min(min_dx, entropy_profile_.r_k_) / r_sampling_;
+  const Real r_start = 0.0;
+  Real r_end = std::max(r_max, r_fix_) + r_sampling_ * dr;
+  const auto n_r = static_cast<unsigned int>(ceil((r_end - r_start) / dr));
+  r_end = r_start + dr * (n_r - 1);
+
+  std::ifstream profile_in;
+  if (!profile_file_.empty()) {
+    profile_in.open(profile_file_, std::ios::binary);
+  }
+  if (!profile_in.is_open()) {
+    auto profile = generate_P_rho_profile(r_start, r_end, n_r);
+    if (!profile_file_.empty() && Globals::my_rank == 0) {
+      std::ofstream profile_out(profile_file_, std::ios::binary);
+      profile.write_binary(profile_out);
+    }
+    return profile;
+  }
+
+  // Reload the profile, which needs to match the current setup
+  Real file_r_start, file_r_end, file_p_fix;
+  std::int64_t file_n_r;
+  profile_in.read(reinterpret_cast<char *>(&file_r_start), sizeof(Real));
+  profile_in.read(reinterpret_cast<char *>(&file_r_end), sizeof(Real));
+  profile_in.read(reinterpret_cast<char *>(&file_n_r), sizeof(file_n_r));
+  profile_in.read(reinterpret_cast<char *>(&file_p_fix), sizeof(Real));
+  const Real p_fix = P_from_rho_K(rho_fix_, entropy_profile_.K_from_r(r_fix_));
+  const auto matches = [](const Real a, const Real b) {
+    return std::abs(a - b) <= 1e-12 * std::max(std::abs(a), std::abs(b));
+  };
+  if (!profile_in || file_n_r != n_r || !matches(file_r_start, r_start) ||
+      !matches(file_r_end, r_end) || !matches(file_p_fix, p_fix)) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in function "
+           "[HydrostaticEquilibriumSphere::generate_shared_P_rho_profile]"
+        << std::endl
+        << "Profile in " << profile_file_ << " does not match the current setup. "
+        << "Remove the file to regenerate it." << std::endl;
+    PARTHENON_FAIL(msg);
+  }
+  std::vector<Real> p_in(n_r);
+  profile_in.read(reinterpret_cast<char *>(p_in.data()), n_r * sizeof(Real));
+  PARTHENON_REQUIRE(profile_in.good(), "Incomplete profile in " + profile_file_);
+
+  ParArray1D<parthenon::Real> device_r("PRhoProfile r", n_r);
+  ParArray1D<parthenon::Real> device_p("PRhoProfile p", n_r);
+  auto r = Kokkos::create_mirror_view(device_r);
+  auto p = Kokkos::create_mirror_view(device_p);
+  // Same radii as in generate_P_rho_profile
+  const Real dr_profile = (r_end - r_start) / (n_r - 1.0);
+  for (int i = 0; i < n_r; i++) {
+    r(i) = r_start + i * dr_profile;
+    p(i) = p_in[i];
+  }
+  Kokkos::deep_copy(device_r, r);
+  Kokkos::deep_copy(device_p, p);
+
+  return PRhoProfile<GravitationalField, EntropyProfile>(device_r, device_p, r(0),
+                                                         r(n_r - 1), *this);
+}
+
 // Instantiate HydrostaticEquilibriumSphere
 template class HydrostaticEquilibriumSphere<ClusterGravity, ACCEPTEntropyProfile>;
 
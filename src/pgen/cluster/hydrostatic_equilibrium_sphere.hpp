@@ -8,6 +8,10 @@
 //! \file hydrostatic_equilbirum_sphere
 //  \brief Class for initializing a sphere in hydrostatic equiblibrium
 
+// C++ headers
+#include <ostream>
+#include <string>
+
 // Parthenon headers
 #include <mesh/domain.hpp>
 #include <parameter_input.hpp>
@@ -49,6 +53,11 @@ class HydrostaticEquilibriumSphere {
   // R mesh sampling parameter
   parthenon::Real r_sampling_;
 
+  // Use a single profile (at the finest resolution) for all meshblocks
+  bool shared_profile_;
+  // File to reload the shared profile from (or save it to if it does not exist yet)
+  std::string profile_file_;
+
   /************************************************************
    * Functions to build the cluster model
    *
@@ -145,6 +154,15 @@ class HydrostaticEquilibriumSphere {
   generate_P_rho_profile(const parthenon::Real r_start, const parthenon::Real r_end,
                          const unsigned int n_R) const;
 
+  // Profile covering all radii up to r_max at the resolution of the smallest cells
+  // (of size min_dx) shared by all meshblocks. The profile is reloaded from (or saved
+  // to) `profile_file_` if set.
+  PRhoProfile<GravitationalField, EntropyProfile>
+  generate_shared_P_rho_profile(const parthenon::Real min_dx,
+                                const parthenon::Real r_max) const;
+
+  bool SharedProfile() const { return shared_profile_; }
+
   template <typename GF, typename EP>
   friend class PRhoProfile;
 };
@@ -195,6 +213,10 @@ class PRhoProfile {
     return rho_r;
   }
   std::ostream &write_to_ostream(std::ostream &os) const;
+
+  // Binary dump of the profile (r_start, r_end, n_r, P at r_fix, followed by P(r))
+  // that can be reloaded by HydrostaticEquilibriumSphere::generate_shared_P_rho_profile
+  void write_binary(std::ostream &os) const;
 };
 
 } // namespace cluster
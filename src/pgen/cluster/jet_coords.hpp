@@ -24,17 +24,30 @@ namespace cluster {
  ************************************************************/
 class JetCoords {
  private:
-  // cos and sin of angle of the jet axis off the z-axis
-  const parthenon::Real cos_theta_jet_axis_, sin_theta_jet_axis_;
-  // cos and sin of angle of the jet axis around the z-axis
-  const parthenon::Real cos_phi_jet_axis_, sin_phi_jet_axis_;
+  // Rotation matrix (direction cosine matrix) from simulation cartesian to jet cartesian
+  // coordinates, i.e., the rows are the jet x, y, and z (axis) unit vectors in
+  // simulation coordinates. Precomputed (on the host) from the angle of the jet axis off
+  // the z-axis (theta) and around the z-axis (phi) so that the transformations in
+  // kernels only require multiplies.
+  parthenon::Real rot_[3][3];
 
  public:
   explicit JetCoords(const parthenon::Real theta_jet_axis,
-                     const parthenon::Real phi_jet_axis)
-      : cos_theta_jet_axis_(cos(theta_jet_axis)),
-        sin_theta_jet_axis_(sin(theta_jet_axis)), cos_phi_jet_axis_(cos(phi_jet_axis)),
-        sin_phi_jet_axis_(sin(phi_jet_axis)) {}
+                     const parthenon::Real phi_jet_axis) {
+    const parthenon::Real cos_theta = cos(theta_jet_axis);
+    const parthenon::Real sin_theta = sin(theta_jet_axis);
+    const parthenon::Real cos_phi = cos(phi_jet_axis);
+    const parthenon::Real sin_phi = sin(phi_jet_axis);
+    rot_[0][0] = cos_phi * cos_theta;
+    rot_[0][1] = sin_phi * cos_theta;
+    rot_[0][2] = -sin_theta;
+    rot_[1][0] = -sin_phi;
+    rot_[1][1] = cos_phi;
+    rot_[1][2] = 0.0;
+    rot_[2][0] = sin_theta * cos_phi;
+    rot_[2][1] = sin_phi * sin_theta;
+    rot_[2][2] = cos_theta;
+  }
 
   // Convert simulation cartesian coordinates to jet cylindrical coordinates
   KOKKOS_INLINE_FUNCTION void
@@ -44,21 +57,20 @@ class JetCoords {
                         parthenon::Real &h_jet) const __attribute__((always_inline)) {
 
     // Position in jet-cartesian coordinates
-    const parthenon::Real x_jet = x_sim * cos_phi_jet_axis_ * cos_theta_jet_axis_ +
-                                  y_sim * sin_phi_jet_axis_ * cos_theta_jet_axis_ -
-                                  z_sim * sin_theta_jet_axis_;
-    const parthenon::Real y_jet = -x_sim * sin_phi_jet_axis_ + y_sim * cos_phi_jet_axis_;
-    const parthenon::Real z_jet = x_sim * sin_theta_jet_axis_ * cos_phi_jet_axis_ +
-                                  y_sim * sin_phi_jet_axis_ * sin_theta_jet_axis_ +
-                                  z_sim * cos_theta_jet_axis_;
+    const parthenon::Real x_jet =
+        rot_[0][0] * x_sim + rot_[0][1] * y_sim + rot_[0][2] * z_sim;
+    const parthenon::Real y_jet = rot_[1][0] * x_sim + rot_[1][1] * y_sim;
+    const parthenon::Real z_jet =
+        rot_[2][0] * x_sim + rot_[2][1] * y_sim + rot_[2][2] * z_sim;
 
     // Position in jet-cylindrical coordinates
-    r_jet = sqrt(pow(fabs(x_jet), 2) + pow(fabs(y_jet), 2));
+    r_jet = sqrt(x_jet * x_jet + y_jet * y_jet);
     // Setting cos_theta and sin_theta to 0 for r = 0 as all places where
     // those variables are used (SimCardToJetCylCoords) an r = 0 leads to the x and y
     // component being 0, too.
-    cos_theta_jet = (r_jet != 0) ? x_jet / r_jet : 0;
-    sin_theta_jet = (r_jet != 0) ? y_jet / r_jet : 0;
+    const parthenon::Real inv_r_jet = (r_jet != 0) ? 1.0 / r_jet : 0;
+    cos_theta_jet = x_jet * inv_r_jet;
+    sin_theta_jet = y_jet * inv_r_jet;
     h_jet = z_jet;
   }
 
@@ -73,14 +85,20 @@ class JetCoords {
     const parthenon::Real v_y_jet = v_r_jet * sin_theta_jet + v_theta_jet * cos_theta_jet;
     const parthenon::Real v_z_jet = v_h_jet;
 
-    // Multiply v_jet by the DCM matrix to take Jet cartesian to Simulation Cartesian
-    v_x_sim = v_x_jet * cos_phi_jet_axis_ * cos_theta_jet_axis_ -
-              v_y_jet * sin_phi_jet_axis_ +
-              v_z_jet * sin_theta_jet_axis_ * cos_phi_jet_axis_;
-    v_y_sim = v_x_jet * sin_phi_jet_axis_ * cos_theta_jet_axis_ +
-              v_y_jet * cos_phi_jet_axis_ +
-              v_z_jet * sin_phi_jet_axis_ * sin_theta_jet_axis_;
-    v_z_sim = -v_x_jet * sin_theta_jet_axis_ + v_z_jet * cos_theta_jet_axis_;
+    // Multiply v_jet by the transposed DCM matrix to take Jet cartesian to Simulation
+    // Cartesian
+    v_x_sim = rot_[0][0] * v_x_jet + rot_[1][0] * v_y_jet + rot_[2][0] * v_z_jet;
+    v_y_sim = rot_[0][1] * v_x_jet + rot_[1][1] * v_y_jet + rot_[2][1] * v_z_jet;
+    v_z_sim = rot_[0][2] * v_x_jet + rot_[2][2] * v_z_jet;
+  }
+
+  // Unit vector of the jet axis in simulation cartesian coordinates
+  KOKKOS_INLINE_FUNCTION void JetAxis(parthenon::Real &x_sim, parthenon::Real &y_sim,
+                                      parthenon::Real &z_sim) const
+      __attribute__((always_inline)) {
+    x_sim = rot_[2][0];
+    y_sim = rot_[2][1];
+    z_sim = rot_[2][2];
   }
 };
 /************************************************************
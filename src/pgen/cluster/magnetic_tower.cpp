@@ -7,7 +7,9 @@
 //  \brief Class for defining magnetic towers
 
 // Parthenon headers
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <coordinates/uniform_cartesian.hpp>
 #include <globals.hpp>
 #include <interface/state_descriptor.hpp>
@@ -21,10 +23,22 @@
 #include "../../units.hpp"
 #include "cluster_utils.hpp"
 #include "magnetic_tower.hpp"
+#include "region_of_interest.hpp"
 
 namespace cluster {
 using namespace parthenon;
 
+int MagneticTower::GetROIBlocks(parthenon::MeshData<parthenon::Real> *md,
+                                parthenon::ParArray1D<int> &roi_blocks) const {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  // Include the ghost zones as the potential is also calculated in the first ghost zone
+  return hydro_pkg->MutableParam<RegionOfInterest>("cluster_roi")
+      ->BlocksInSphere(md, "magnetic_tower",
+                       (roi_radius_ > 0) ? roi_radius_
+                                         : std::numeric_limits<Real>::infinity(),
+                       true, roi_blocks);
+}
+
 void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mass_to_add,
                                parthenon::MeshData<parthenon::Real> *md,
                                const parthenon::SimTime &tm) const {
@@ -58,6 +72,12 @@ void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mas
 
   const auto &eos = hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos");
 
+  parthenon::ParArray1D<int> roi_blocks;
+  const int num_roi_blocks = GetROIBlocks(md, roi_blocks);
+  if (num_roi_blocks == 0) {
+    return;
+  }
+
   // Construct magnetic vector potential then compute magnetic fields
 
   // Currently reallocates this vector potential everytime step and constructs
@@ -86,9 +106,10 @@ void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mas
   // Construct the magnetic tower potential
   parthenon::par_for(
       DEFAULT_LOOP_PATTERN, "MagneticTower::AddFieldSrcTerm::ConstructPotential",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, a_kb.s, a_kb.e, a_jb.s,
-      a_jb.e, a_ib.s, a_ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+      parthenon::DevExecSpace(), 0, num_roi_blocks - 1, a_kb.s, a_kb.e, a_jb.s, a_jb.e,
+      a_ib.s, a_ib.e,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = roi_blocks(n);
         // Compute and apply potential
         const auto &coords = cons_pack.GetCoords(b);
 
@@ -101,11 +122,25 @@ void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mas
         A(2, b, k, j, i) = a_z_;
       });
 
+  // With the lagged power contributions, the contributions of the updated field (after
+  // the final stage) are reduced as a by-product (see ReducePowerContribs)
+  const bool accumulate_contribs =
+      hydro_pkg->AllParams().hasKey("magnetic_tower_accumulate_contribs") &&
+      hydro_pkg->Param<bool>("magnetic_tower_accumulate_contribs");
+  const MagneticTowerObj mt_unit =
+      MagneticTowerObj(1, alpha_, l_scale_, 0, l_mass_scale_, jet_coords);
+  Real linear_contrib_red = 0.0;
+  Real quadratic_contrib_red = 0.0;
+
   // Take the curl of the potential and apply the new magnetic field
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "MagneticTower::MagneticFieldSrcTerm::ApplyPotential",
-      parthenon::DevExecSpace(), 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
-      ib.e, KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+  Kokkos::parallel_reduce(
+      "MagneticTower::MagneticFieldSrcTerm::ApplyPotential",
+      Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+          DevExecSpace(), {0, kb.s, jb.s, ib.s},
+          {num_roi_blocks, kb.e + 1, jb.e + 1, ib.e + 1}, {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
+                    Real &llinear_contrib_red, Real &lquadratic_contrib_red) {
+        const int b = roi_blocks(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -136,7 +171,29 @@ void MagneticTower::AddSrcTerm(parthenon::Real field_to_add, parthenon::Real mas
         const Real cell_delta_rho =
             mt.DensityFromSimCart(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k));
         cons(IDN, k, j, i) += cell_delta_rho;
-      });
+
+        if (accumulate_contribs) {
+          const Real cell_volume = coords.CellVolume(k, j, i);
+          Real bu_x, bu_y, bu_z;
+          mt_unit.FieldInSimCart(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k), bu_x,
+                                 bu_y, bu_z);
+          llinear_contrib_red += (cons(IB1, k, j, i) * bu_x + cons(IB2, k, j, i) * bu_y +
+                                  cons(IB3, k, j, i) * bu_z) *
+                                 cell_volume;
+          lquadratic_contrib_red +=
+              0.5 * (bu_x * bu_x + bu_y * bu_y + bu_z * bu_z) * cell_volume;
+        }
+      },
+      linear_contrib_red, quadratic_contrib_red);
+
+  if (accumulate_contribs) {
+    auto *global_reductions =
+        hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+    global_reductions->Contribute("magnetic_tower_lagged_linear_contrib", md,
+                                  linear_contrib_red);
+    global_reductions->Contribute("magnetic_tower_lagged_quadratic_contrib", md,
+                                  quadratic_contrib_red);
+  }
 }
 
 // Compute the increase to magnetic energy (1/2*B**2) over local meshes.  Adds
@@ -167,6 +224,12 @@ void MagneticTower::ReducePowerContribs(parthenon::Real &linear_contrib,
   const MagneticTowerObj mt =
       MagneticTowerObj(1, alpha_, l_scale_, 0, l_mass_scale_, jet_coords);
 
+  parthenon::ParArray1D<int> roi_blocks;
+  const int num_roi_blocks = GetROIBlocks(md, roi_blocks);
+  if (num_roi_blocks == 0) {
+    return;
+  }
+
   // Get the reduction of the linear and quadratic contributions ready
   Real linear_contrib_red, quadratic_contrib_red;
 
@@ -174,10 +237,10 @@ void MagneticTower::ReducePowerContribs(parthenon::Real &linear_contrib,
       "MagneticTowerScaleFactor",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           DevExecSpace(), {0, kb.s, jb.s, ib.s},
-          {prim_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
-          {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i,
+          {num_roi_blocks, kb.e + 1, jb.e + 1, ib.e + 1}, {1, 1, 1, ib.e + 1 - ib.s}),
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i,
                     Real &llinear_contrib_red, Real &lquadratic_contrib_red) {
+        const int b = roi_blocks(n);
         auto &cons = cons_pack(b);
         auto &prim = prim_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -260,13 +323,17 @@ void MagneticTower::PowerSrcTerm(const parthenon::Real power,
                                  parthenon::MeshData<parthenon::Real> *md,
                                  const parthenon::Real beta_dt,
                                  const parthenon::SimTime &tm) const {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   if (power == 0) {
-    // Nothing to inject, return
+    // Nothing to inject, return (and the contributions are not accumulated)
+    if (hydro_pkg->AllParams().hasKey("magnetic_tower_accumulate_contribs") &&
+        hydro_pkg->Param<bool>("magnetic_tower_accumulate_contribs")) {
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions")
+          ->Contribute("magnetic_tower_lagged_invalid", md, 1.0);
+    }
     return;
   }
 
-  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
-
   const Real linear_contrib = hydro_pkg->Param<Real>("magnetic_tower_linear_contrib");
   const Real quadratic_contrib =
       hydro_pkg->Param<Real>("magnetic_tower_quadratic_contrib");
@@ -291,6 +358,62 @@ void MagneticTower::PowerSrcTerm(const parthenon::Real power,
   AddSrcTerm(field_to_add, mass_to_add, md, tm);
 }
 
+bool MagneticTowerPrepareStage(parthenon::StateDescriptor *hydro_pkg,
+                               parthenon::Mesh *pmesh, const int stage, const int nstages,
+                               const parthenon::SimTime &tm) {
+  const auto &magnetic_tower = hydro_pkg->Param<MagneticTower>("magnetic_tower");
+  if (magnetic_tower.power_contribs_refresh_interval_ == 1) {
+    return true;
+  }
+  bool reduce_contribs = false;
+  if (stage == 1) {
+    // The lagged contributions are valid if they were accumulated in the final stage of
+    // the previous cycle and the mesh did not change since
+    const bool lagged_valid =
+        hydro_pkg->Param<int>("magnetic_tower_lagged_cycle") == tm.ncycle - 1 &&
+        hydro_pkg->Param<Real>("magnetic_tower_lagged_invalid") == 0.0 &&
+        !pmesh->modified;
+    const auto cycles_since_refresh =
+        hydro_pkg->Param<int>("magnetic_tower_cycles_since_refresh");
+    const auto interval = hydro_pkg->Param<int>("magnetic_tower_refresh_interval");
+    // (Rank local) contributions that are reduced with the other global reductions
+    const auto lagged_linear_contrib =
+        hydro_pkg->Param<Real>("magnetic_tower_lagged_linear_contrib");
+    const auto lagged_quadratic_contrib =
+        hydro_pkg->Param<Real>("magnetic_tower_lagged_quadratic_contrib");
+    if (lagged_valid && cycles_since_refresh + 1 < interval) {
+      hydro_pkg->UpdateParam("magnetic_tower_linear_contrib", lagged_linear_contrib);
+      hydro_pkg->UpdateParam("magnetic_tower_quadratic_contrib",
+                             lagged_quadratic_contrib);
+      hydro_pkg->UpdateParam("magnetic_tower_cycles_since_refresh",
+                             cycles_since_refresh + 1);
+      hydro_pkg->UpdateParam("magnetic_tower_compare_contribs", false);
+      // Unused but still (sum) reduced
+      hydro_pkg->UpdateParam("magnetic_tower_compared_linear_contrib", 0.0);
+      hydro_pkg->UpdateParam("magnetic_tower_compared_quadratic_contrib", 0.0);
+    } else {
+      // Compared to the exact contributions after the reduction
+      hydro_pkg->UpdateParam("magnetic_tower_compared_linear_contrib",
+                             lagged_linear_contrib);
+      hydro_pkg->UpdateParam("magnetic_tower_compared_quadratic_contrib",
+                             lagged_quadratic_contrib);
+      hydro_pkg->UpdateParam("magnetic_tower_cycles_since_refresh", 0);
+      hydro_pkg->UpdateParam("magnetic_tower_compare_contribs", lagged_valid);
+      reduce_contribs = true;
+    }
+  }
+  // Prepare the accumulation of the contributions in the source term of the final stage
+  const bool final_stage = stage == nstages;
+  hydro_pkg->UpdateParam("magnetic_tower_accumulate_contribs", final_stage);
+  if (final_stage) {
+    hydro_pkg->UpdateParam("magnetic_tower_lagged_cycle", tm.ncycle);
+    hydro_pkg->UpdateParam("magnetic_tower_lagged_linear_contrib", 0.0);
+    hydro_pkg->UpdateParam("magnetic_tower_lagged_quadratic_contrib", 0.0);
+    hydro_pkg->UpdateParam("magnetic_tower_lagged_invalid", 0.0);
+  }
+  return reduce_contribs;
+}
+
 parthenon::TaskStatus
 MagneticTowerResetPowerContribs(parthenon::StateDescriptor *hydro_pkg) {
   hydro_pkg->UpdateParam("magnetic_tower_linear_contrib", 0.0);
@@ -305,14 +428,41 @@ MagneticTowerReducePowerContribs(parthenon::MeshData<parthenon::Real> *md,
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &magnetic_tower = hydro_pkg->Param<MagneticTower>("magnetic_tower");
 
-  parthenon::Real linear_contrib =
-      hydro_pkg->Param<parthenon::Real>("magnetic_tower_linear_contrib");
-  parthenon::Real quadratic_contrib =
-      hydro_pkg->Param<parthenon::Real>("magnetic_tower_quadratic_contrib");
+  // Thread-safe contributions of this partition to the rank local sums
+  parthenon::Real linear_contrib = 0.0;
+  parthenon::Real quadratic_contrib = 0.0;
   magnetic_tower.ReducePowerContribs(linear_contrib, quadratic_contrib, md, tm);
 
-  hydro_pkg->UpdateParam("magnetic_tower_linear_contrib", linear_contrib);
-  hydro_pkg->UpdateParam("magnetic_tower_quadratic_contrib", quadratic_contrib);
+  auto *global_reductions =
+      hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+  global_reductions->Contribute("magnetic_tower_linear_contrib", md, linear_contrib);
+  global_reductions->Contribute("magnetic_tower_quadratic_contrib", md,
+                                quadratic_contrib);
+  return TaskStatus::complete;
+}
+
+parthenon::TaskStatus
+MagneticTowerCheckLaggedPowerContribs(parthenon::StateDescriptor *hydro_pkg) {
+  if (!hydro_pkg->AllParams().hasKey("magnetic_tower_compare_contribs") ||
+      !hydro_pkg->Param<bool>("magnetic_tower_compare_contribs")) {
+    return TaskStatus::complete;
+  }
+  const auto &magnetic_tower = hydro_pkg->Param<MagneticTower>("magnetic_tower");
+  const auto rel_diff = [&](const std::string &name) {
+    const auto exact = hydro_pkg->Param<Real>("magnetic_tower_" + name);
+    const auto lagged = hydro_pkg->Param<Real>("magnetic_tower_compared_" + name);
+    return (exact == lagged) ? 0.0 : std::abs(lagged - exact) / std::abs(exact);
+  };
+  const Real error = std::max(rel_diff("linear_contrib"), rel_diff("quadratic_contrib"));
+  // Same (global) values on all ranks so that all ranks agree on the interval
+  auto interval = hydro_pkg->Param<int>("magnetic_tower_refresh_interval");
+  if (error > magnetic_tower.power_contribs_tol_) {
+    interval = std::max(1, interval / 2);
+  } else {
+    interval = std::min(magnetic_tower.power_contribs_refresh_interval_, 2 * interval);
+  }
+  hydro_pkg->UpdateParam("magnetic_tower_refresh_interval", interval);
+  hydro_pkg->UpdateParam("magnetic_tower_compare_contribs", false);
   return TaskStatus::complete;
 }
 
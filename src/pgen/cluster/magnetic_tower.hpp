@@ -16,6 +16,7 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "../../utils/global_reductions.hpp"
 #include "jet_coords.hpp"
 
 namespace cluster {
@@ -50,7 +51,7 @@ class MagneticTowerObj {
   PotentialInJetCyl(const parthenon::Real r, const parthenon::Real h,
                     parthenon::Real &a_r, parthenon::Real &a_theta,
                     parthenon::Real &a_h) const __attribute__((always_inline)) {
-    const parthenon::Real exp_r2_h2 = exp(-pow(r / l_scale_, 2) - pow(h / l_scale_, 2));
+    const parthenon::Real exp_r2_h2 = exp(-SQR(r / l_scale_) - SQR(h / l_scale_));
     // Compute the potential in jet cylindrical coordinates
     a_r = 0.0;
     a_theta = field_ * l_scale_ * (r / l_scale_) * exp_r2_h2;
@@ -81,11 +82,11 @@ class MagneticTowerObj {
                 parthenon::Real &b_theta, parthenon::Real &b_h) const
       __attribute__((always_inline)) {
 
-    const parthenon::Real exp_r2_h2 = exp(-pow(r / l_scale_, 2) - pow(h / l_scale_, 2));
+    const parthenon::Real exp_r2_h2 = exp(-SQR(r / l_scale_) - SQR(h / l_scale_));
     // Compute the field in jet cylindrical coordinates
     b_r = field_ * 2 * (h / l_scale_) * (r / l_scale_) * exp_r2_h2;
     b_theta = field_ * alpha_ * (r / l_scale_) * exp_r2_h2;
-    b_h = field_ * 2 * (1 - pow(r / l_scale_, 2)) * exp_r2_h2;
+    b_h = field_ * 2 * (1 - SQR(r / l_scale_)) * exp_r2_h2;
   }
 
   // Compute Magnetic field in Simulation Cartesian coordinates
@@ -133,6 +134,16 @@ class MagneticTower {
   const parthenon::Real fixed_mass_rate_;
   const parthenon::Real l_mass_scale_;
 
+  // Radius beyond which the (Gaussian) tower is neglected in the source terms so that
+  // only blocks intersecting this sphere are updated (disabled if not positive).
+  const parthenon::Real roi_radius_;
+
+  // Maximum number of cycles between exact reductions of the power contributions (using
+  // the contributions lagged by one cycle in between) and tolerance for the relative
+  // difference between lagged and exact contributions (see docs/cluster.md).
+  const int power_contribs_refresh_interval_;
+  const parthenon::Real power_contribs_tol_;
+
   MagneticTower(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg,
                 const std::string &block = "problem/cluster/magnetic_tower")
       : alpha_(pin->GetOrAddReal(block, "alpha", 0)),
@@ -140,10 +151,54 @@ class MagneticTower {
         initial_field_(pin->GetOrAddReal(block, "initial_field", 0)),
         fixed_field_rate_(pin->GetOrAddReal(block, "fixed_field_rate", 0)),
         fixed_mass_rate_(pin->GetOrAddReal(block, "fixed_mass_rate", 0)),
-        l_mass_scale_(pin->GetOrAddReal(block, "l_mass_scale", 0)) {
+        l_mass_scale_(pin->GetOrAddReal(block, "l_mass_scale", 0)),
+        roi_radius_(pin->GetOrAddReal(block, "roi_radius", 0)),
+        power_contribs_refresh_interval_(
+            pin->GetOrAddInteger(block, "power_contribs_refresh_interval", 1)),
+        power_contribs_tol_(pin->GetOrAddReal(block, "power_contribs_tol", 1e-3)) {
+    PARTHENON_REQUIRE_THROWS(power_contribs_refresh_interval_ >= 1,
+                             "magnetic_tower/power_contribs_refresh_interval must be "
+                             ">= 1.");
     hydro_pkg->AddParam<>("magnetic_tower", *this);
     hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_linear_contrib", 0.0, true);
     hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_quadratic_contrib", 0.0, true);
+    auto *global_reductions =
+        hydro_pkg->MutableParam<utils::GlobalReductions>("global_reductions");
+    global_reductions->Register("magnetic_tower_linear_contrib", utils::ReductionOp::sum);
+    global_reductions->Register("magnetic_tower_quadratic_contrib",
+                                utils::ReductionOp::sum);
+    if (power_contribs_refresh_interval_ > 1) {
+      // Contributions accumulated by the source term in the final stage of a cycle
+      hydro_pkg->AddParam<bool>("magnetic_tower_accumulate_contribs", false, true);
+      hydro_pkg->AddParam<int>("magnetic_tower_lagged_cycle", -1, true);
+      hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_lagged_linear_contrib", 0.0,
+                                           true);
+      hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_lagged_quadratic_contrib",
+                                           0.0, true);
+      // Set (to 1) by any partition that did not accumulate its contributions
+      hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_lagged_invalid", 0.0, true);
+      // Accumulated over the partitions of the rank only (see PrepareStage)
+      global_reductions->Register("magnetic_tower_lagged_linear_contrib",
+                                  utils::ReductionOp::sum, false);
+      global_reductions->Register("magnetic_tower_lagged_quadratic_contrib",
+                                  utils::ReductionOp::sum, false);
+      global_reductions->Register("magnetic_tower_lagged_invalid",
+                                  utils::ReductionOp::max, false);
+      // Current interval (adapted between 1 and power_contribs_refresh_interval_)
+      hydro_pkg->AddParam<int>("magnetic_tower_refresh_interval",
+                               power_contribs_refresh_interval_, true);
+      hydro_pkg->AddParam<int>("magnetic_tower_cycles_since_refresh", 0, true);
+      // Lagged contributions compared to the exact ones when refreshing
+      hydro_pkg->AddParam<bool>("magnetic_tower_compare_contribs", false, true);
+      hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_compared_linear_contrib", 0.0,
+                                           true);
+      hydro_pkg->AddParam<parthenon::Real>("magnetic_tower_compared_quadratic_contrib",
+                                           0.0, true);
+      global_reductions->Register("magnetic_tower_compared_linear_contrib",
+                                  utils::ReductionOp::sum);
+      global_reductions->Register("magnetic_tower_compared_quadratic_contrib",
+                                  utils::ReductionOp::sum);
+    }
   }
 
   // Add initial magnetic field to provided potential with a single meshblock
@@ -179,6 +234,11 @@ class MagneticTower {
                            parthenon::MeshData<parthenon::Real> *md,
                            const parthenon::SimTime &tm) const;
 
+  // Number of blocks (and their indices) of the partition intersecting the sphere with
+  // roi_radius_ (all blocks if disabled)
+  int GetROIBlocks(parthenon::MeshData<parthenon::Real> *md,
+                   parthenon::ParArray1D<int> &roi_blocks) const;
+
   friend parthenon::TaskStatus
   MagneticTowerResetPowerContribs(parthenon::StateDescriptor *hydro_pkg);
 
@@ -187,11 +247,22 @@ class MagneticTower {
                                    const parthenon::SimTime &tm);
 };
 
+// To be called when the tasks of a stage are created (with power scaling). Returns
+// whether the power contributions need to be reduced exactly in this cycle (stage 1).
+// Otherwise (stage 1), the contributions accumulated in the final stage of the previous
+// cycle are used. Prepares the accumulation in the final stage.
+bool MagneticTowerPrepareStage(parthenon::StateDescriptor *hydro_pkg,
+                               parthenon::Mesh *pmesh, const int stage, const int nstages,
+                               const parthenon::SimTime &tm);
 parthenon::TaskStatus
 MagneticTowerResetPowerContribs(parthenon::StateDescriptor *hydro_pkg);
 parthenon::TaskStatus
 MagneticTowerReducePowerContribs(parthenon::MeshData<parthenon::Real> *md,
                                  const parthenon::SimTime &tm);
+// Adapts the refresh interval based on the difference between the lagged and the exact
+// (global) contributions. To be called after the global reductions finished.
+parthenon::TaskStatus
+MagneticTowerCheckLaggedPowerContribs(parthenon::StateDescriptor *hydro_pkg);
 
 } // namespace cluster
 
@@ -0,0 +1,69 @@
+//========================================================================================
+//// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+///// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+///// Licensed under the 3-clause BSD License, see LICENSE file for details
+/////========================================================================================
+//! \file region_of_interest.cpp
+//  \brief Lists of blocks intersecting the (small) regions of the cluster source terms
+
+// C++ headers
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// AthenaPK headers
+#include "../../utils/block_culling.hpp"
+#include "region_of_interest.hpp"
+
+namespace cluster {
+using parthenon::Real;
+
+Real BlockDistanceToOrigin2(const parthenon::RegionSize &bs, const bool with_ghosts) {
+  return utils::BlockDistanceToPoint2(bs, {0.0, 0.0, 0.0}, with_ghosts);
+}
+
+std::vector<Real> PartitionSignature(parthenon::MeshData<Real> *md) {
+  std::vector<Real> signature;
+  signature.reserve(6 * md->NumBlocks());
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    const auto &bs = md->GetBlockData(b)->GetBlockPointer()->block_size;
+    for (const auto x : {bs.x1min, bs.x1max, bs.x2min, bs.x2max, bs.x3min, bs.x3max}) {
+      signature.push_back(x);
+    }
+  }
+  return signature;
+}
+
+int RegionOfInterest::BlocksInSphere(parthenon::MeshData<Real> *md,
+                                     const std::string &feature, const Real radius,
+                                     const bool with_ghosts,
+                                     parthenon::ParArray1D<int> &block_idx) {
+  const int nblocks = md->NumBlocks();
+  auto signature = PartitionSignature(md);
+
+  std::lock_guard<std::mutex> lock(*mutex_);
+  auto &list = lists_[std::make_pair(md, feature)];
+  if (list.signature != signature || list.radius != radius || list.num_blocks < 0) {
+    std::vector<int> idx;
+    for (int b = 0; b < nblocks; b++) {
+      auto pmb = md->GetBlockData(b)->GetBlockPointer();
+      if (BlockDistanceToOrigin2(pmb->block_size, with_ghosts) < SQR(radius)) {
+        idx.push_back(b);
+      }
+    }
+    list.signature = std::move(signature);
+    list.radius = radius;
+    list.num_blocks = static_cast<int>(idx.size());
+    list.block_idx = parthenon::ParArray1D<int>(feature + "_roi_blocks", list.num_blocks);
+    auto block_idx_host = list.block_idx.GetHostMirror();
+    for (int n = 0; n < list.num_blocks; n++) {
+      block_idx_host(n) = idx[n];
+    }
+    list.block_idx.DeepCopy(block_idx_host);
+  }
+  block_idx = list.block_idx;
+  return list.num_blocks;
+}
+
+} // namespace cluster
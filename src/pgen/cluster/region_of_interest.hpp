@@ -0,0 +1,68 @@
+#ifndef CLUSTER_REGION_OF_INTEREST_HPP_
+#define CLUSTER_REGION_OF_INTEREST_HPP_
+//========================================================================================
+//// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+///// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+///// Licensed under the 3-clause BSD License, see LICENSE file for details
+/////========================================================================================
+//! \file region_of_interest.hpp
+//  \brief Lists of blocks intersecting the (small) regions of the cluster source terms
+
+// C++ headers
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// parthenon headers
+#include <basic_types.hpp>
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+
+namespace cluster {
+
+// Squared distance of the point of the block (optionally including the ghost zones)
+// closest to the origin
+parthenon::Real BlockDistanceToOrigin2(const parthenon::RegionSize &bs,
+                                       const bool with_ghosts);
+
+// Extents of all blocks of a partition, which change whenever the blocks of the
+// partition changed (e.g., after remeshing or load balancing). Contrary to the gids,
+// the extents uniquely identify the blocks.
+std::vector<parthenon::Real>
+PartitionSignature(parthenon::MeshData<parthenon::Real> *md);
+
+// Source terms of the cluster problem generator typically only act on a few blocks close
+// to the center (e.g., the accretion region or the AGN feedback region). The indices
+// (within a MeshData partition) of the blocks intersecting a sphere around the origin
+// are cached for each partition and feature. A list is rebuilt whenever the blocks of the
+// partition changed (e.g., after remeshing or load balancing) or the radius changed.
+// Kernels then only loop over the listed blocks (or return early for empty lists).
+// The cache is shared by the tasks of all partitions and thus guarded by a mutex (for
+// host-threaded task execution).
+class RegionOfInterest {
+ public:
+  // Returns the number of blocks intersecting the sphere and sets `block_idx` to the
+  // device array containing the indices of these blocks.
+  int BlocksInSphere(parthenon::MeshData<parthenon::Real> *md, const std::string &feature,
+                     const parthenon::Real radius, const bool with_ghosts,
+                     parthenon::ParArray1D<int> &block_idx);
+
+ private:
+  struct BlockList {
+    std::vector<parthenon::Real> signature; // of the partition when the list was built
+    parthenon::Real radius;
+    int num_blocks = -1; // negative if not built yet
+    parthenon::ParArray1D<int> block_idx;
+  };
+  std::map<std::pair<parthenon::MeshData<parthenon::Real> *, std::string>, BlockList>
+      lists_;
+  // Shared so that the cache remains copyable (as param)
+  std::shared_ptr<std::mutex> mutex_ = std::make_shared<std::mutex>();
+};
+
+} // namespace cluster
+
+#endif // CLUSTER_REGION_OF_INTEREST_HPP_
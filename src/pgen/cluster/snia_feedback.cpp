@@ -7,6 +7,9 @@
 //  \brief  Class for injecting SNIA feedback following BCG density
 
 #include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
 
 // Parthenon headers
 #include <coordinates/uniform_cartesian.hpp>
@@ -21,13 +24,44 @@
 #include "../../eos/adiabatic_hydro.hpp"
 #include "../../main.hpp"
 #include "../../units.hpp"
+#include "../../utils/partition_data.hpp"
 #include "cluster_gravity.hpp"
 #include "cluster_utils.hpp"
+#include "region_of_interest.hpp"
 #include "snia_feedback.hpp"
 
 namespace cluster {
 using namespace parthenon;
 
+// Constant volumetric heating on the listed blocks. Not in an anonymous namespace as the
+// enclosing function of an extended (device) lambda must not have internal linkage.
+template <typename Src, typename EOS>
+void ApplySNIAFeedback(MeshData<Real> *md, const ParArray1D<int> &roi_blocks,
+                       const int num_roi_blocks, const Src snia_src, const EOS &eos) {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  const auto nhydro = hydro_pkg->Param<int>("nhydro");
+  const auto nscalars = hydro_pkg->Param<int>("nscalars");
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "SNIAFeedback::FeedbackSrcTerm", parthenon::DevExecSpace(), 0,
+      num_roi_blocks - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &n, const int &k, const int &j, const int &i) {
+        const int b = roi_blocks(n);
+        auto &cons = cons_pack(b);
+        auto &prim = prim_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
+
+        snia_src(b, cons, prim, coords, k, j, i);
+
+        eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
+      });
+}
+
 SNIAFeedback::SNIAFeedback(parthenon::ParameterInput *pin,
                            parthenon::StateDescriptor *hydro_pkg)
     : power_per_bcg_mass_(
@@ -35,7 +69,11 @@ SNIAFeedback::SNIAFeedback(parthenon::ParameterInput *pin,
       mass_rate_per_bcg_mass_(pin->GetOrAddReal("problem/cluster/snia_feedback",
                                                 "mass_rate_per_bcg_mass", 0.0)),
       bcg_gravity_(pin), disabled_(pin->GetOrAddBoolean("problem/cluster/snia_feedback",
-                                                        "disabled", false)) {
+                                                        "disabled", false)),
+      roi_radius_(
+          pin->GetOrAddReal("problem/cluster/snia_feedback", "roi_radius", 0.0)),
+      cached_density_(pin->GetOrAddBoolean("problem/cluster/snia_feedback",
+                                           "cached_density", false)) {
 
   // Initialize the gravity from the cluster
   // Turn off the NFW and SMBH to get just the BCG gravity
@@ -44,9 +82,50 @@ SNIAFeedback::SNIAFeedback(parthenon::ParameterInput *pin,
 
   PARTHENON_REQUIRE(disabled_ || bcg_gravity_.which_bcg_g_ != BCG::NONE,
                     "BCG must be defined for SNIA Feedback to be enabled");
+  if (cached_density_) {
+    hydro_pkg->AddField("snia_bcg_density",
+                        Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy}));
+    hydro_pkg->AddParam<>("snia_partition_signatures",
+                          utils::PartitionData<std::vector<Real>>(), true);
+  }
   hydro_pkg->AddParam<SNIAFeedback>("snia_feedback", *this);
 }
 
+void SNIAFeedback::UpdateDensityCache(parthenon::MeshData<parthenon::Real> *md) const {
+  auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
+  // Per partition so that concurrently executed source term tasks do not share state
+  auto &cached_signature =
+      hydro_pkg
+          ->MutableParam<utils::PartitionData<std::vector<Real>>>(
+              "snia_partition_signatures")
+          ->Get(md);
+  auto signature = PartitionSignature(md);
+  if (cached_signature == signature) {
+    return;
+  }
+  cached_signature = std::move(signature);
+
+  const auto &density_pack =
+      md->PackVariables(std::vector<std::string>{"snia_bcg_density"});
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  const ClusterGravity bcg_gravity = bcg_gravity_;
+  const Real roi_radius2 = SQR(ROIRadius());
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, "SNIAFeedback::UpdateDensityCache", parthenon::DevExecSpace(),
+      0, density_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
+        const auto &coords = density_pack.GetCoords(b);
+        const Real r2 =
+            SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k));
+        density_pack(b, 0, k, j, i) =
+            (r2 < roi_radius2) ? bcg_gravity.rho_from_r(sqrt(r2)) : 0.0;
+      });
+}
+
 void SNIAFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                                    const parthenon::Real beta_dt,
                                    const parthenon::SimTime &tm) const {
@@ -70,52 +149,22 @@ void SNIAFeedback::FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
 
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
 
-  if ((power_per_bcg_mass_ == 0 && mass_rate_per_bcg_mass_ == 0) || disabled_) {
+  if (!IsActive()) {
     // No AGN feedback, return
     return;
   }
 
-  // Grab some necessary variables
-  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
-  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
-  const auto nhydro = hydro_pkg->Param<int>("nhydro");
-  const auto nscalars = hydro_pkg->Param<int>("nscalars");
-
-  const Real energy_per_bcg_mass = power_per_bcg_mass_ * beta_dt;
-  const Real mass_per_bcg_mass = mass_rate_per_bcg_mass_ * beta_dt;
+  // Only loop over the blocks within the region of interest
+  parthenon::ParArray1D<int> roi_blocks;
+  const int num_roi_blocks =
+      hydro_pkg->MutableParam<RegionOfInterest>("cluster_roi")
+          ->BlocksInSphere(md, "snia_feedback", ROIRadius(), false, roi_blocks);
 
-  const ClusterGravity bcg_gravity = bcg_gravity_;
-
-  ////////////////////////////////////////////////////////////////////////////////
-
-  // Constant volumetric heating
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "SNIAFeedback::FeedbackSrcTerm", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int &b, const int &k, const int &j, const int &i) {
-        auto &cons = cons_pack(b);
-        auto &prim = prim_pack(b);
-        const auto &coords = cons_pack.GetCoords(b);
-
-        const Real x = coords.Xc<1>(i);
-        const Real y = coords.Xc<2>(j);
-        const Real z = coords.Xc<3>(k);
-
-        const Real r = sqrt(x * x + y * y + z * z);
-
-        const Real bcg_density = bcg_gravity.rho_from_r(r);
-
-        const Real snia_energy_density = energy_per_bcg_mass * bcg_density;
-        const Real snia_mass_density = mass_per_bcg_mass * bcg_density;
-
-        cons(IEN, k, j, i) += snia_energy_density;
-        AddDensityToConsAtFixedVel(snia_mass_density, cons, prim, k, j, i);
-
-        eos.ConsToPrim(cons, prim, nhydro, nscalars, k, j, i);
-      });
+  if (cached_density_) {
+    ApplySNIAFeedback(md, roi_blocks, num_roi_blocks, GetCachedSrc(md, beta_dt), eos);
+  } else {
+    ApplySNIAFeedback(md, roi_blocks, num_roi_blocks, GetSrc(beta_dt), eos);
+  }
 }
 
 } // namespace cluster
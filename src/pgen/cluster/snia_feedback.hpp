@@ -8,6 +8,12 @@
 //! \file snia_feedback.hpp
 //  \brief  Class for injecting SNIA feedback following BCG density
 
+// C++ headers
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 // parthenon headers
 #include <basic_types.hpp>
 #include <mesh/domain.hpp>
@@ -15,10 +21,67 @@
 #include <parameter_input.hpp>
 #include <parthenon/package.hpp>
 
+#include "cluster_gravity.hpp"
+#include "cluster_utils.hpp"
 #include "jet_coords.hpp"
 
 namespace cluster {
 
+// Per cell SNIA feedback (heating and mass injection following the BCG density)
+struct SNIAFeedbackSrc {
+  ClusterGravity bcg_gravity;
+  parthenon::Real energy_per_bcg_mass, mass_per_bcg_mass;
+  // Feedback is neglected beyond this (squared) radius
+  parthenon::Real roi_radius2;
+  bool active;
+
+  template <typename CV, typename Coords>
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, CV &cons, CV &prim,
+                                         const Coords &coords, const int k, const int j,
+                                         const int i) const {
+    if (!active) {
+      return;
+    }
+    const parthenon::Real x = coords.template Xc<1>(i);
+    const parthenon::Real y = coords.template Xc<2>(j);
+    const parthenon::Real z = coords.template Xc<3>(k);
+
+    const parthenon::Real r2 = x * x + y * y + z * z;
+    if (r2 >= roi_radius2) {
+      return;
+    }
+
+    const parthenon::Real bcg_density = bcg_gravity.rho_from_r(sqrt(r2));
+
+    const parthenon::Real snia_energy_density = energy_per_bcg_mass * bcg_density;
+    const parthenon::Real snia_mass_density = mass_per_bcg_mass * bcg_density;
+
+    cons(IEN, k, j, i) += snia_energy_density;
+    AddDensityToConsAtFixedVel(snia_mass_density, cons, prim, k, j, i);
+  }
+};
+
+// Same as above but using the BCG density stored in the "snia_bcg_density" field (which
+// is zero beyond the region of interest)
+template <typename DPack>
+struct CachedSNIAFeedbackSrc {
+  DPack density_pack;
+  parthenon::Real energy_per_bcg_mass, mass_per_bcg_mass;
+  bool active;
+
+  template <typename CV, typename Coords>
+  KOKKOS_INLINE_FUNCTION void operator()(const int b, CV &cons, CV &prim,
+                                         const Coords &coords, const int k, const int j,
+                                         const int i) const {
+    if (!active) {
+      return;
+    }
+    const parthenon::Real bcg_density = density_pack(b, 0, k, j, i);
+    cons(IEN, k, j, i) += energy_per_bcg_mass * bcg_density;
+    AddDensityToConsAtFixedVel(mass_per_bcg_mass * bcg_density, cons, prim, k, j, i);
+  }
+};
+
 /************************************************************
  *  AGNFeedback
  ************************************************************/
@@ -33,11 +96,47 @@ class SNIAFeedback {
 
   const bool disabled_;
 
+  // Radius beyond which the feedback is neglected (<= 0 to apply it everywhere)
+  parthenon::Real roi_radius_;
+  // Store the (static) BCG density in a field that is only updated after remeshing
+  bool cached_density_;
+
   SNIAFeedback(parthenon::ParameterInput *pin, parthenon::StateDescriptor *hydro_pkg);
 
   void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
                        const parthenon::Real beta_dt, const parthenon::SimTime &tm) const;
 
+  bool IsActive() const {
+    return !((power_per_bcg_mass_ == 0 && mass_rate_per_bcg_mass_ == 0) || disabled_);
+  }
+
+  parthenon::Real ROIRadius() const {
+    return (roi_radius_ > 0) ? roi_radius_
+                             : std::numeric_limits<parthenon::Real>::infinity();
+  }
+
+  // Per cell source term functor (e.g., for fused source term kernels)
+  SNIAFeedbackSrc GetSrc(const parthenon::Real beta_dt) const {
+    return SNIAFeedbackSrc{bcg_gravity_, power_per_bcg_mass_ * beta_dt,
+                           mass_rate_per_bcg_mass_ * beta_dt, SQR(ROIRadius()),
+                           IsActive()};
+  }
+
+  // (Re)fill the "snia_bcg_density" field if the blocks of the partition changed
+  void UpdateDensityCache(parthenon::MeshData<parthenon::Real> *md) const;
+
+  // Per cell source term functor using the cached BCG density (requires
+  // `cached_density_`)
+  auto GetCachedSrc(parthenon::MeshData<parthenon::Real> *md,
+                    const parthenon::Real beta_dt) const {
+    UpdateDensityCache(md);
+    const auto density_pack =
+        md->PackVariables(std::vector<std::string>{"snia_bcg_density"});
+    return CachedSNIAFeedbackSrc<std::decay_t<decltype(density_pack)>>{
+        density_pack, power_per_bcg_mass_ * beta_dt, mass_rate_per_bcg_mass_ * beta_dt,
+        IsActive()};
+  }
+
   // Apply the feedback from SNIAe tied to the BCG density
   template <typename EOS>
   void FeedbackSrcTerm(parthenon::MeshData<parthenon::Real> *md,
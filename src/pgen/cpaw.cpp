@@ -23,6 +23,7 @@
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <vector>
 
 // Parthenon headers
 #include "mesh/mesh.hpp"
@@ -31,6 +32,8 @@
 
 // Athena headers
 #include "../main.hpp"
+#include "../utils/error_norms.hpp"
+#include "../utils/vector_potential.hpp"
 
 namespace cpaw {
 using namespace parthenon::driver::prelude;
@@ -41,10 +44,23 @@ Real ang_2, ang_3; // Rotation angles about the y and z' axis
 Real fac, sin_a2, cos_a2, sin_a3, cos_a3;
 Real lambda, k_par; // Wavelength, 2*PI/wavelength
 
-// functions to compute vector potential to initialize the solution
-Real A1(const Real x1, const Real x2, const Real x3);
-Real A2(const Real x1, const Real x2, const Real x3);
-Real A3(const Real x1, const Real x2, const Real x3);
+// Vector potential to initialize the solution, using a gauge such that Ax = 0, and Ay,
+// Az are functions of x and y alone (in the rotated frame of the wave).
+struct VectorPotential {
+  Real fac, b_par, b_perp, k_par, sin_a2, cos_a2, sin_a3, cos_a3;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const Real x1, const Real x2, const Real x3,
+                                         Real a[3]) const {
+    Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
+    Real y = -x1 * sin_a3 + x2 * cos_a3;
+    Real Ay = fac * (b_perp / k_par) * std::sin(k_par * (x));
+    Real Az = (b_perp / k_par) * std::cos(k_par * (x)) + b_par * y;
+
+    a[0] = -Ay * sin_a3 - Az * sin_a2 * cos_a3;
+    a[1] = Ay * cos_a3 - Az * sin_a2 * sin_a3;
+    a[2] = Az * cos_a2;
+  }
+};
 
 //========================================================================================
 //! \fn void Mesh::InitUserMeshData(Mesh *mesh, ParameterInput *pin)
@@ -124,55 +140,48 @@ void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm)
 
   constexpr int NGLMMHD = 8; // excluding psi
 
-  // Initialize errors to zero
-  Real err[NGLMMHD];
-  for (int i = 0; i < NGLMMHD; ++i)
-    err[i] = 0.0;
-
-  for (auto &pmb : mesh->block_list) {
-    //  Compute errors
-    IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-    IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-    IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-    auto &rc = pmb->meshblock_data.Get(); // get base container
-    auto u = rc->Get("cons").data.GetHostMirrorAndCopy();
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
-          Real x =
-              cos_a2 * (pmb->coords.Xc<1>(i) * cos_a3 + pmb->coords.Xc<2>(j) * sin_a3) +
-              pmb->coords.Xc<3>(k) * sin_a2;
-          Real sn = std::sin(k_par * x);
-          Real cs = fac * std::cos(k_par * x);
-
-          err[IDN] += std::abs(den - u(IDN, k, j, i));
-
-          Real mx = den * v_par;
-          Real my = -fac * den * v_perp * sn;
-          Real mz = -fac * den * v_perp * cs;
-          Real m1 = mx * cos_a2 * cos_a3 - my * sin_a3 - mz * sin_a2 * cos_a3;
-          Real m2 = mx * cos_a2 * sin_a3 + my * cos_a3 - mz * sin_a2 * sin_a3;
-          Real m3 = mx * sin_a2 + mz * cos_a2;
-          err[IM1] += std::abs(m1 - u(IM1, k, j, i));
-          err[IM2] += std::abs(m2 - u(IM2, k, j, i));
-          err[IM3] += std::abs(m3 - u(IM3, k, j, i));
-
-          Real bx = b_par;
-          Real by = b_perp * sn;
-          Real bz = b_perp * cs;
-          Real b1 = bx * cos_a2 * cos_a3 - by * sin_a3 - bz * sin_a2 * cos_a3;
-          Real b2 = bx * cos_a2 * sin_a3 + by * cos_a3 - bz * sin_a2 * sin_a3;
-          Real b3 = bx * sin_a2 + bz * cos_a2;
-          err[IB1] += std::abs(b1 - u(IB1, k, j, i));
-          err[IB2] += std::abs(b2 - u(IB2, k, j, i));
-          err[IB3] += std::abs(b3 - u(IB3, k, j, i));
-
-          Real e0 = pres / gm1 + 0.5 * (m1 * m1 + m2 * m2 + m3 * m3) / den +
+  // Copy the parameters of the analytic solution so that they're captured by value
+  const Real den_ = den, pres_ = pres, gm1_ = gm1, b_par_ = b_par, b_perp_ = b_perp;
+  const Real v_perp_ = v_perp, v_par_ = v_par, fac_ = fac, k_par_ = k_par;
+  const Real sin_a2_ = sin_a2, cos_a2_ = cos_a2, sin_a3_ = sin_a3, cos_a3_ = cos_a3;
+
+  // Errors are not weighted by the cell volume (but normalized by the number of cells)
+  const auto norms = utils::ReduceErrorNorms<NGLMMHD>(
+      mesh,
+      KOKKOS_LAMBDA(const Real x1, const Real x2, const Real x3, Real *cons) {
+        const Real x = cos_a2_ * (x1 * cos_a3_ + x2 * sin_a3_) + x3 * sin_a2_;
+        const Real sn = std::sin(k_par_ * x);
+        const Real cs = fac_ * std::cos(k_par_ * x);
+
+        cons[IDN] = den_;
+
+        const Real mx = den_ * v_par_;
+        const Real my = -fac_ * den_ * v_perp_ * sn;
+        const Real mz = -fac_ * den_ * v_perp_ * cs;
+        const Real m1 = mx * cos_a2_ * cos_a3_ - my * sin_a3_ - mz * sin_a2_ * cos_a3_;
+        const Real m2 = mx * cos_a2_ * sin_a3_ + my * cos_a3_ - mz * sin_a2_ * sin_a3_;
+        const Real m3 = mx * sin_a2_ + mz * cos_a2_;
+        cons[IM1] = m1;
+        cons[IM2] = m2;
+        cons[IM3] = m3;
+
+        const Real bx = b_par_;
+        const Real by = b_perp_ * sn;
+        const Real bz = b_perp_ * cs;
+        const Real b1 = bx * cos_a2_ * cos_a3_ - by * sin_a3_ - bz * sin_a2_ * cos_a3_;
+        const Real b2 = bx * cos_a2_ * sin_a3_ + by * cos_a3_ - bz * sin_a2_ * sin_a3_;
+        const Real b3 = bx * sin_a2_ + bz * cos_a2_;
+        cons[IB1] = b1;
+        cons[IB2] = b2;
+        cons[IB3] = b3;
+
+        cons[IEN] = pres_ / gm1_ + 0.5 * (m1 * m1 + m2 * m2 + m3 * m3) / den_ +
                     0.5 * (b1 * b1 + b2 * b2 + b3 * b3);
-          err[IEN] += std::abs(e0 - u(IEN, k, j, i));
-        }
-      }
-    }
+      },
+      false);
+  Real err[NGLMMHD];
+  for (int i = 0; i < NGLMMHD; ++i) {
+    err[i] = norms.l1[i];
   }
 
   // normalize errors by number of cells, compute RMS
@@ -185,6 +194,9 @@ void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm)
     rms_err += SQR(err[i]);
   rms_err = std::sqrt(rms_err);
 
+  // only the root process outputs the data
+  if (parthenon::Globals::my_rank != 0) return;
+
   // open output file and write out errors
   std::string fname;
   fname.assign("cpaw-errors.dat");
@@ -223,122 +235,58 @@ void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm)
 }
 
 //========================================================================================
-//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //! \brief circularly polarized Alfven wave problem generator for 1D/2D/3D problems.
 //========================================================================================
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  // nxN != ncellsN, in general. Allocate to extend through ghost zones, regardless # dim
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-  // Initialize the magnetic fields.
-
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> a1(
-      "a1", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> a2(
-      "a2", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> a3(
-      "a3", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-
-  auto &coords = pmb->coords;
-
-  // Initialize components of the vector potential
-  for (int k = kb.s - 1; k <= kb.e + 1; k++) {
-    for (int j = jb.s - 1; j <= jb.e + 1; j++) {
-      for (int i = ib.s - 1; i <= ib.e + 1; i++) {
-        a1(k, j, i) = A1(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k));
-        a2(k, j, i) = A2(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k));
-        a3(k, j, i) = A3(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k));
-      }
-    }
-  }
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+  // Copy the parameters so that they're captured by value
+  const Real den_ = den, pres_ = pres, gm1_ = gm1, v_perp_ = v_perp, v_par_ = v_par;
+  const Real fac_ = fac, k_par_ = k_par;
+  const Real sin_a2_ = sin_a2, cos_a2_ = cos_a2, sin_a3_ = sin_a3, cos_a3_ = cos_a3;
+  // Initialize the magnetic fields from the vector potential.
+  const VectorPotential potential{fac,    b_par,  b_perp, k_par,
+                                  sin_a2, cos_a2, sin_a3, cos_a3};
 
   // Now initialize rest of the cell centered quantities
   // initialize conserved variables
-  auto &rc = pmb->meshblock_data.Get();
-  auto &u_dev = rc->Get("cons").data;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
-        Real x = cos_a2 * (coords.Xc<1>(i) * cos_a3 + coords.Xc<2>(j) * sin_a3) +
-                 coords.Xc<3>(k) * sin_a2;
-        Real sn = std::sin(k_par * x);
-        Real cs = fac * std::cos(k_par * x);
-
-        u(IDN, k, j, i) = den;
-
-        Real mx = den * v_par;
-        Real my = -fac * den * v_perp * sn;
-        Real mz = -fac * den * v_perp * cs;
-
-        u(IM1, k, j, i) = mx * cos_a2 * cos_a3 - my * sin_a3 - mz * sin_a2 * cos_a3;
-        u(IM2, k, j, i) = mx * cos_a2 * sin_a3 + my * cos_a3 - mz * sin_a2 * sin_a3;
-        u(IM3, k, j, i) = mx * sin_a2 + mz * cos_a2;
-
-        u(IB1, k, j, i) = (a3(k, j + 1, i) - a3(k, j - 1, i)) / coords.Dxc<2>(j) / 2.0 -
-                          (a2(k + 1, j, i) - a2(k - 1, j, i)) / coords.Dxc<3>(k) / 2.0;
-        u(IB2, k, j, i) = (a1(k + 1, j, i) - a1(k - 1, j, i)) / coords.Dxc<3>(k) / 2.0 -
-                          (a3(k, j, i + 1) - a3(k, j, i - 1)) / coords.Dxc<1>(i) / 2.0;
-        u(IB3, k, j, i) = (a2(k, j, i + 1) - a2(k, j, i - 1)) / coords.Dxc<1>(i) / 2.0 -
-                          (a1(k, j + 1, i) - a1(k, j - 1, i)) / coords.Dxc<2>(j) / 2.0;
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  pmb->par_for(
+      "ProblemGenerator: CPAW", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+      ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
+        Real x = cos_a2_ * (coords.Xc<1>(i) * cos_a3_ + coords.Xc<2>(j) * sin_a3_) +
+                 coords.Xc<3>(k) * sin_a2_;
+        Real sn = std::sin(k_par_ * x);
+        Real cs = fac_ * std::cos(k_par_ * x);
+
+        u(IDN, k, j, i) = den_;
+
+        Real mx = den_ * v_par_;
+        Real my = -fac_ * den_ * v_perp_ * sn;
+        Real mz = -fac_ * den_ * v_perp_ * cs;
+
+        u(IM1, k, j, i) = mx * cos_a2_ * cos_a3_ - my * sin_a3_ - mz * sin_a2_ * cos_a3_;
+        u(IM2, k, j, i) = mx * cos_a2_ * sin_a3_ + my * cos_a3_ - mz * sin_a2_ * sin_a3_;
+        u(IM3, k, j, i) = mx * sin_a2_ + mz * cos_a2_;
+
+        Real bfield[3];
+        utils::CurlOfVectorPotential(coords, k, j, i, potential, bfield);
+        u(IB1, k, j, i) = bfield[0];
+        u(IB2, k, j, i) = bfield[1];
+        u(IB3, k, j, i) = bfield[2];
 
         u(IEN, k, j, i) =
-            pres / gm1 +
+            pres_ / gm1_ +
             0.5 * (SQR(u(IB1, k, j, i)) + SQR(u(IB2, k, j, i)) + SQR(u(IB3, k, j, i))) +
-            (0.5 / den) *
+            (0.5 / den_) *
                 (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i)) + SQR(u(IM3, k, j, i)));
-      }
-    }
-  }
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn Real A1(const Real x1,const Real x2,const Real x3)
-//! \brief A1: 1-component of vector potential, using a gauge such that Ax = 0, and Ay,
-//! Az are functions of x and y alone.
-
-Real A1(const Real x1, const Real x2, const Real x3) {
-  Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
-  Real y = -x1 * sin_a3 + x2 * cos_a3;
-  Real Ay = fac * (b_perp / k_par) * std::sin(k_par * (x));
-  Real Az = (b_perp / k_par) * std::cos(k_par * (x)) + b_par * y;
-
-  return -Ay * sin_a3 - Az * sin_a2 * cos_a3;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn Real A2(const Real x1,const Real x2,const Real x3)
-//! \brief A2: 2-component of vector potential
-
-Real A2(const Real x1, const Real x2, const Real x3) {
-  Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
-  Real y = -x1 * sin_a3 + x2 * cos_a3;
-  Real Ay = fac * (b_perp / k_par) * std::sin(k_par * (x));
-  Real Az = (b_perp / k_par) * std::cos(k_par * (x)) + b_par * y;
-
-  return Ay * cos_a3 - Az * sin_a2 * sin_a3;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn Real A3(const Real x1,const Real x2,const Real x3)
-//! \brief A3: 3-component of vector potential
-
-Real A3(const Real x1, const Real x2, const Real x3) {
-  Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
-  Real y = -x1 * sin_a3 + x2 * cos_a3;
-  Real Az = (b_perp / k_par) * std::cos(k_par * (x)) + b_par * y;
-
-  return Az * cos_a2;
+      });
 }
 } // namespace cpaw
@@ -3,9 +3,13 @@
 // Copyright (c) 2021, Athena Parthenon Collaboration. All rights reserved.
 // Licensed under the 3-Clause License (the "LICENSE")
 
+// C++ headers
+#include <cmath>
+#include <string>
+#include <vector>
+
 // Parthenon headers
 #include "mesh/mesh.hpp"
-#include <cmath>
 #include <parthenon/driver.hpp>
 #include <parthenon/package.hpp>
 
@@ -15,13 +19,13 @@
 namespace diffusion {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
-  auto &mbd = pmb->meshblock_data.Get();
-  auto &u = mbd->Get("cons").data;
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
 
   const auto Bx = pin->GetOrAddReal("problem/diffusion", "Bx", 0.0);
   const auto By = pin->GetOrAddReal("problem/diffusion", "By", 0.0);
@@ -29,11 +33,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
   const auto iprob = pin->GetInteger("problem/diffusion", "iprob");
   const auto sigma = pin->GetOrAddReal("problem/diffusion", "sigma", 0.1);
 
-  auto &coords = pmb->coords;
-
   pmb->par_for(
-      "ProblemGenerator: Diffusion Step", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int k, const int j, const int i) {
+      "ProblemGenerator: Diffusion Step", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e,
+      ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
         u(IDN, k, j, i) = 1.0;
 
         u(IM1, k, j, i) = 0.0;
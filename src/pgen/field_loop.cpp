@@ -38,6 +38,7 @@
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <vector>
 
 // Parthenon headers
 #include "mesh/mesh.hpp"
@@ -46,6 +47,7 @@
 
 // Athena headers
 #include "../main.hpp"
+#include "../utils/vector_potential.hpp"
 #include "outputs/outputs.hpp"
 
 namespace field_loop {
@@ -101,28 +103,82 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
   pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
 }
 
+// Vector potential of the field loop for the given test case (iprob)
+struct FieldLoopPotential {
+  int iprob;
+  Real amp, rad, cos_a2, sin_a2, lambda;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const Real x1, const Real x2, const Real x3,
+                                         Real a[3]) const {
+    a[0] = 0.0;
+    a[1] = 0.0;
+    a[2] = 0.0;
+    // (iprob=1): field loop in x1-x2 plane (cylinder in 3D) */
+    if (iprob == 1) {
+      if ((SQR(x1) + SQR(x2)) < rad * rad) {
+        a[2] = amp * (rad - std::sqrt(SQR(x1) + SQR(x2)));
+      }
+    }
+
+    // (iprob=2): field loop in x2-x3 plane (cylinder in 3D)
+    if (iprob == 2) {
+      if ((SQR(x2) + SQR(x3)) < rad * rad) {
+        a[0] = amp * (rad - std::sqrt(SQR(x2) + SQR(x3)));
+      }
+    }
+
+    // (iprob=3): field loop in x3-x1 plane (cylinder in 3D)
+    if (iprob == 3) {
+      if ((SQR(x1) + SQR(x3)) < rad * rad) {
+        a[1] = amp * (rad - std::sqrt(SQR(x1) + SQR(x3)));
+      }
+    }
+
+    // (iprob=4): rotated cylindrical field loop in 3D.  Similar to iprob=1 with a
+    // rotation about the x2-axis.  Define coordinate systems (x1,x2,x3) and (x,y,z)
+    // with the following transformation rules:
+    //    x =  x1*std::cos(ang_2) + x3*std::sin(ang_2)
+    //    y =  x2
+    //    z = -x1*std::sin(ang_2) + x3*std::cos(ang_2)
+    // This inverts to:
+    //    x1  = x*std::cos(ang_2) - z*std::sin(ang_2)
+    //    x2  = y
+    //    x3  = x*std::sin(ang_2) + z*std::cos(ang_2)
+
+    if (iprob == 4) {
+      Real x = x1 * cos_a2 + x3 * sin_a2;
+      Real y = x2;
+      // shift x back to the domain -0.5*lambda <= x <= 0.5*lambda
+      while (x > 0.5 * lambda)
+        x -= lambda;
+      while (x < -0.5 * lambda)
+        x += lambda;
+      if ((x * x + y * y) < rad * rad) {
+        a[0] = amp * (rad - std::sqrt(x * x + y * y)) * (-sin_a2);
+        a[2] = amp * (rad - std::sqrt(x * x + y * y)) * (cos_a2);
+      }
+    }
+
+    // (iprob=5): spherical field loop in rotated plane
+    if (iprob == 5) {
+      if ((SQR(x1) + SQR(x2) + SQR(x3)) < rad * rad) {
+        a[1] = amp * (rad - std::sqrt(SQR(x1) + SQR(x2) + SQR(x3)));
+        a[2] = amp * (rad - std::sqrt(SQR(x1) + SQR(x2) + SQR(x3)));
+      }
+    }
+  }
+};
+
 //========================================================================================
-//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //! \brief field loop advection problem generator for 2D/3D problems.
 //========================================================================================
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> ax(
-      "ax", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> ay(
-      "ay", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> az(
-      "az", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   Real gm1 = pin->GetReal("hydro", "gamma") - 1.0;
 
@@ -135,13 +191,12 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
   int iprob = pin->GetInteger("problem/field_loop", "iprob");
   Real ang_2, cos_a2(0.0), sin_a2(0.0), lambda(0.0);
 
-  Real x1size = pmb->pmy_mesh->mesh_size.x1max - pmb->pmy_mesh->mesh_size.x1min;
-  Real x2size = pmb->pmy_mesh->mesh_size.x2max - pmb->pmy_mesh->mesh_size.x2min;
+  Real x1size = pmesh->mesh_size.x1max - pmesh->mesh_size.x1min;
+  Real x2size = pmesh->mesh_size.x2max - pmesh->mesh_size.x2min;
 
-  const bool two_d = pmb->pmy_mesh->ndim < 3;
+  const bool two_d = pmesh->ndim < 3;
   // for 2D sim set x3size to zero so that v_z is 0 below
-  Real x3size =
-      two_d ? 0 : pmb->pmy_mesh->mesh_size.x3max - pmb->pmy_mesh->mesh_size.x3min;
+  Real x3size = two_d ? 0 : pmesh->mesh_size.x3max - pmesh->mesh_size.x3min;
 
   // For (iprob=4) -- rotated cylinder in 3D -- set up rotation angle and wavelength
   if (iprob == 4) {
@@ -166,131 +221,17 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
     }
   }
 
-  // Use vector potential to initialize field loop
-  auto &coords = pmb->coords;
-
-  // manually defining loop bounds here to make vector potential work
-  int kl, ku;
-  if (two_d) {
-    kl = 0;
-    ku = 0;
-  } else {
-    kl = kb.s - 1;
-    ku = kb.e + 1;
-  }
-  for (int k = kl; k <= ku; k++) {
-    for (int j = jb.s - 1; j <= jb.e + 1; j++) {
-      for (int i = ib.s - 1; i <= ib.e + 1; i++) {
-        // (iprob=1): field loop in x1-x2 plane (cylinder in 3D) */
-        if (iprob == 1) {
-          ax(k, j, i) = 0.0;
-          ay(k, j, i) = 0.0;
-          if ((SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j))) < rad * rad) {
-            az(k, j, i) =
-                amp * (rad - std::sqrt(SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j))));
-          } else {
-            az(k, j, i) = 0.0;
-          }
-        }
-
-        // (iprob=2): field loop in x2-x3 plane (cylinder in 3D)
-        if (iprob == 2) {
-          if ((SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k))) < rad * rad) {
-            ax(k, j, i) =
-                amp * (rad - std::sqrt(SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k))));
-          } else {
-            ax(k, j, i) = 0.0;
-          }
-          ay(k, j, i) = 0.0;
-          az(k, j, i) = 0.0;
-        }
-
-        // (iprob=3): field loop in x3-x1 plane (cylinder in 3D)
-        if (iprob == 3) {
-          if ((SQR(coords.Xc<1>(i)) + SQR(coords.Xc<3>(k))) < rad * rad) {
-            ay(k, j, i) =
-                amp * (rad - std::sqrt(SQR(coords.Xc<1>(i)) + SQR(coords.Xc<3>(k))));
-          } else {
-            ay(k, j, i) = 0.0;
-          }
-          ax(k, j, i) = 0.0;
-          az(k, j, i) = 0.0;
-        }
-
-        // (iprob=4): rotated cylindrical field loop in 3D.  Similar to iprob=1 with a
-        // rotation about the x2-axis.  Define coordinate systems (x1,x2,x3) and (x,y,z)
-        // with the following transformation rules:
-        //    x =  x1*std::cos(ang_2) + x3*std::sin(ang_2)
-        //    y =  x2
-        //    z = -x1*std::sin(ang_2) + x3*std::cos(ang_2)
-        // This inverts to:
-        //    x1  = x*std::cos(ang_2) - z*std::sin(ang_2)
-        //    x2  = y
-        //    x3  = x*std::sin(ang_2) + z*std::cos(ang_2)
-
-        if (iprob == 4) {
-          Real x = coords.Xc<1>(i) * cos_a2 + coords.Xc<3>(k) * sin_a2;
-          Real y = coords.Xc<2>(j);
-          // shift x back to the domain -0.5*lambda <= x <= 0.5*lambda
-          while (x > 0.5 * lambda)
-            x -= lambda;
-          while (x < -0.5 * lambda)
-            x += lambda;
-          if ((x * x + y * y) < rad * rad) {
-            ax(k, j, i) = amp * (rad - std::sqrt(x * x + y * y)) * (-sin_a2);
-          } else {
-            ax(k, j, i) = 0.0;
-          }
-          ay(k, j, i) = 0.0;
-
-          x = coords.Xc<1>(i) * cos_a2 + coords.Xc<3>(k) * sin_a2;
-          y = coords.Xc<2>(j);
-          // shift x back to the domain -0.5*lambda <= x <= 0.5*lambda
-          while (x > 0.5 * lambda)
-            x -= lambda;
-          while (x < -0.5 * lambda)
-            x += lambda;
-          if ((x * x + y * y) < rad * rad) {
-            az(k, j, i) = amp * (rad - std::sqrt(x * x + y * y)) * (cos_a2);
-          } else {
-            az(k, j, i) = 0.0;
-          }
-        }
-
-        // (iprob=5): spherical field loop in rotated plane
-        if (iprob == 5) {
-          ax(k, j, i) = 0.0;
-          if ((SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k))) <
-              rad * rad) {
-            ay(k, j, i) =
-                amp * (rad - std::sqrt(SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) +
-                                       SQR(coords.Xc<3>(k))));
-          } else {
-            ay(k, j, i) = 0.0;
-          }
-          if ((SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k))) <
-              rad * rad) {
-            az(k, j, i) =
-                amp * (rad - std::sqrt(SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) +
-                                       SQR(coords.Xc<3>(k))));
-          } else {
-            az(k, j, i) = 0.0;
-          }
-        }
-      }
-    }
-  }
+  // Use vector potential to initialize field loop (without derivatives along x3 in 2D)
+  const FieldLoopPotential potential{iprob, amp, rad, cos_a2, sin_a2, lambda};
 
   // Initialize density and momenta.  If drat != 1, then density and temperature will be
   // different inside loop than background values
-
-  auto &mbd = pmb->meshblock_data.Get();
-  auto &u_dev = mbd->Get("cons").data;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  pmb->par_for(
+      "ProblemGenerator: Field Loop", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e,
+      ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
         u(IDN, k, j, i) = 1.0;
         if ((SQR(coords.Xc<1>(i)) + SQR(coords.Xc<2>(j)) + SQR(coords.Xc<3>(k))) <
             rad * rad) {
@@ -299,27 +240,19 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
         u(IM1, k, j, i) = u(IDN, k, j, i) * vflow * x1size;
         u(IM2, k, j, i) = u(IDN, k, j, i) * vflow * x2size;
         u(IM3, k, j, i) = u(IDN, k, j, i) * vflow * x3size;
-        Real aydz =
-            two_d ? 0.0 : (ay(k + 1, j, i) - ay(k - 1, j, i)) / coords.Dxc<3>(k) / 2.0;
-        Real axdz =
-            two_d ? 0.0 : (ax(k + 1, j, i) - ax(k - 1, j, i)) / coords.Dxc<3>(k) / 2.0;
-        u(IB1, k, j, i) =
-            (az(k, j + 1, i) - az(k, j - 1, i)) / coords.Dxc<2>(j) / 2.0 - aydz;
-        u(IB2, k, j, i) =
-            axdz - (az(k, j, i + 1) - az(k, j, i - 1)) / coords.Dxc<1>(i) / 2.0;
-        u(IB3, k, j, i) = (ay(k, j, i + 1) - ay(k, j, i - 1)) / coords.Dxc<1>(i) / 2.0 -
-                          (ax(k, j + 1, i) - ax(k, j - 1, i)) / coords.Dxc<2>(j) / 2.0;
+
+        Real bfield[3];
+        utils::CurlOfVectorPotential(coords, k, j, i, potential, bfield, !two_d);
+        u(IB1, k, j, i) = bfield[0];
+        u(IB2, k, j, i) = bfield[1];
+        u(IB3, k, j, i) = bfield[2];
 
         u(IEN, k, j, i) =
             1.0 / gm1 +
             0.5 * (SQR(u(IB1, k, j, i)) + SQR(u(IB2, k, j, i)) + SQR(u(IB3, k, j, i))) +
             0.5 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i)) + SQR(u(IM3, k, j, i))) /
                 u(IDN, k, j, i);
-      }
-    }
-  }
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
+      });
 }
 
 } // namespace field_loop
@@ -23,12 +23,14 @@
 #include <algorithm> // min, max
 #include <cmath>     // log
 #include <cstring>   // strcmp()
+#include <random>
+#include <string>
+#include <vector>
 
 // Parthenon headers
 #include "mesh/mesh.hpp"
 #include <parthenon/driver.hpp>
 #include <parthenon/package.hpp>
-#include <random>
 
 // AthenaPK headers
 #include "../main.hpp"
@@ -37,27 +39,22 @@ namespace kh {
 using namespace parthenon::driver::prelude;
 
 //----------------------------------------------------------------------------------------
-//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //  \brief Problem Generator for the Kelvin-Helmholtz test
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
   auto vflow = pin->GetReal("problem/kh", "vflow");
   auto iprob = pin->GetInteger("problem/kh", "iprob");
-  auto ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  auto jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  auto kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
   auto gam = pin->GetReal("hydro", "gamma");
   auto gm1 = (gam - 1.0);
 
   // initialize conserved variables
-  auto &rc = pmb->meshblock_data.Get();
-  auto &u_dev = rc->Get("cons").data;
-  auto &coords = pmb->coords;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-
-  std::mt19937 gen(pmb->gid); // Standard mersenne_twister_engine seeded with gid
-  std::uniform_real_distribution<Real> ran(-0.5, 0.5);
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  const int num_blocks = md->NumBlocks();
 
   //--- iprob=1.  Uniform stream with density ratio "drat" located in region -1/4<y<1/4
   // moving at (-vflow) seperated by two slip-surfaces from background medium with d=1
@@ -67,24 +64,37 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
     // Read problem parameters
     Real drat = pin->GetReal("problem/kh", "drat");
     Real amp = pin->GetReal("problem/kh", "amp");
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
-          u(IDN, k, j, i) = 1.0;
-          u(IM1, k, j, i) = vflow + amp * ran(gen);
-          u(IM2, k, j, i) = amp * ran(gen);
-          u(IM3, k, j, i) = 0.0;
-          if (std::abs(coords.Xc<2>(j)) < 0.25) {
-            u(IDN, k, j, i) = drat;
-            u(IM1, k, j, i) = -drat * (vflow + amp * ran(gen));
-            u(IM2, k, j, i) = drat * amp * ran(gen);
+    // The random perturbations are drawn on the host (in the order of the cells of each
+    // block) so that they are independent of the partitioning.
+    for (int b = 0; b < num_blocks; b++) {
+      auto pmb_b = md->GetBlockData(b)->GetBlockPointer();
+      auto &u_dev = md->GetBlockData(b)->Get("cons").data;
+      auto &coords = pmb_b->coords;
+      auto u = u_dev.GetHostMirrorAndCopy();
+
+      std::mt19937 gen(pmb_b->gid); // Standard mersenne_twister_engine seeded with gid
+      std::uniform_real_distribution<Real> ran(-0.5, 0.5);
+      for (int k = kb.s; k <= kb.e; k++) {
+        for (int j = jb.s; j <= jb.e; j++) {
+          for (int i = ib.s; i <= ib.e; i++) {
+            u(IDN, k, j, i) = 1.0;
+            u(IM1, k, j, i) = vflow + amp * ran(gen);
+            u(IM2, k, j, i) = amp * ran(gen);
+            u(IM3, k, j, i) = 0.0;
+            if (std::abs(coords.Xc<2>(j)) < 0.25) {
+              u(IDN, k, j, i) = drat;
+              u(IM1, k, j, i) = -drat * (vflow + amp * ran(gen));
+              u(IM2, k, j, i) = drat * amp * ran(gen);
+            }
+            // Pressure scaled to give a sound speed of 1 with gamma=1.4
+            u(IEN, k, j, i) =
+                2.5 / gm1 +
+                0.5 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i))) / u(IDN, k, j, i);
           }
-          // Pressure scaled to give a sound speed of 1 with gamma=1.4
-          u(IEN, k, j, i) =
-              2.5 / gm1 +
-              0.5 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i))) / u(IDN, k, j, i);
         }
       }
+      // copy initialized vars to device
+      u_dev.DeepCopy(u);
     }
   }
 
@@ -97,9 +107,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
     Real amp = pin->GetReal("problem/kh", "amp");
     Real a = 0.02;
     Real sigma = 0.2;
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
+    pmb->par_for(
+        "ProblemGenerator: KH iprob=2", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e,
+        ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          auto &u = cons(b);
+          const auto &coords = cons.GetCoords(b);
           u(IDN, k, j, i) = 1.0;
           u(IM1, k, j, i) = vflow * std::tanh((coords.Xc<2>(j)) / a);
           u(IM2, k, j, i) = amp * std::cos(2.0 * M_PI * coords.Xc<1>(i)) *
@@ -108,9 +120,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
           u(IEN, k, j, i) =
               1.0 / gm1 +
               0.5 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i))) / u(IDN, k, j, i);
-        }
-      }
-    }
+        });
   }
 
   //--- iprob=3.  Test in SR paper (Beckwith & Stone, ApJS 193, 6, 2011).  Gives two
@@ -122,9 +132,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
     Real amp = pin->GetReal("problem/kh", "amp");
     Real a = 0.01;
     Real sigma = 0.1;
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
+    pmb->par_for(
+        "ProblemGenerator: KH iprob=3", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e,
+        ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          auto &u = cons(b);
+          const auto &coords = cons.GetCoords(b);
           u(IDN, k, j, i) =
               0.505 + 0.495 * std::tanh((std::abs(coords.Xc<2>(j)) - 0.5) / a);
           u(IM1, k, j, i) = vflow * std::tanh((std::abs(coords.Xc<2>(j)) - 0.5) / a);
@@ -139,9 +151,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
           u(IEN, k, j, i) =
               1.0 / gm1 +
               0.5 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i))) / u(IDN, k, j, i);
-        }
-      }
-    }
+        });
   }
 
   //--- iprob=4.  "Lecoanet" test, resolved shear layers with tanh() profiles for velocity
@@ -164,9 +174,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
     Real z1 = -0.5; // z1' = z1 - 1.0
     Real z2 = 0.5;  // z2' = z2 - 1.0
 
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
+    pmb->par_for(
+        "ProblemGenerator: KH iprob=4", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e,
+        ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          auto &u = cons(b);
+          const auto &coords = cons.GetCoords(b);
           // Lecoanet (2015) equation 8a)
           Real dens = 1.0 + 0.5 * drho_rho0 *
                                 (std::tanh((coords.Xc<2>(j) - z1) / a) -
@@ -233,11 +245,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
               P0 / gm1 +
               0.5 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i)) + SQR(u(IM3, k, j, i))) /
                   u(IDN, k, j, i);
-        }
-      }
-    }
-    // copy initialized vars to device
-    u_dev.DeepCopy(u);
+        });
   }
 
   //--- iprob=5. Uniform stream with density ratio "drat" located in region -1/4<y<1/4
@@ -250,9 +258,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
     Real sigma = pin->GetReal("problem/kh", "sigma");
     Real drat = pin->GetReal("problem/kh", "drat");
     Real amp = pin->GetReal("problem/kh", "amp");
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
+    pmb->par_for(
+        "ProblemGenerator: KH iprob=5", 0, num_blocks - 1, kb.s, kb.e, jb.s, jb.e,
+        ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          auto &u = cons(b);
+          const auto &coords = cons.GetCoords(b);
           Real w = (std::tanh((std::abs(coords.Xc<2>(j)) - 0.25) / a) + 1.0) * 0.5;
           u(IDN, k, j, i) = w + (1.0 - w) * drat;
           u(IM1, k, j, i) = w * vflow - (1.0 - w) * vflow * drat;
@@ -264,9 +274,7 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
           u(IEN, k, j, i) =
               2.5 / gm1 +
               0.25 * (SQR(u(IM1, k, j, i)) + SQR(u(IM2, k, j, i))) / u(IDN, k, j, i);
-        }
-      }
-    }
+        });
   }
 }
 
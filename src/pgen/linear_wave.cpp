@@ -21,6 +21,7 @@
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <vector>
 
 // Parthenon headers
 #include "mesh/mesh.hpp"
@@ -29,6 +30,7 @@
 
 // Athena headers
 #include "../main.hpp"
+#include "../utils/error_norms.hpp"
 
 namespace linear_wave {
 using namespace parthenon::driver::prelude;
@@ -182,100 +184,35 @@ void InitUserMeshData(Mesh *mesh, ParameterInput *pin) {
 void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm) {
   if (!pin->GetOrAddBoolean("problem/linear_wave", "compute_error", false)) return;
 
-  // Initialize errors to zero
-  Real l1_err[NHYDRO + NFIELD]{}, max_err[NHYDRO + NFIELD]{};
-
-  for (auto &pmb : mesh->block_list) {
-    IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-    IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-    IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-    // Even for MHD, there are only cell-centered mesh variables
-    int ncells4 = NHYDRO + NFIELD;
-    // Save analytic solution of conserved variables in 4D scratch array on host
-    Kokkos::View<Real ****, parthenon::LayoutWrapper, parthenon::HostMemSpace> cons_(
-        "cons scratch", ncells4, pmb->cellbounds.ncellsk(IndexDomain::entire),
-        pmb->cellbounds.ncellsj(IndexDomain::entire),
-        pmb->cellbounds.ncellsi(IndexDomain::entire));
-
-    //  Compute errors at cell centers
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
-          Real x =
-              cos_a2 * (pmb->coords.Xc<1>(i) * cos_a3 + pmb->coords.Xc<2>(j) * sin_a3) +
-              pmb->coords.Xc<3>(k) * sin_a2;
-          Real sn = std::sin(k_par * x);
-
-          Real d1 = d0 + amp * sn * rem[0][wave_flag];
-          Real mx = d0 * vflow + amp * sn * rem[1][wave_flag];
-          Real my = amp * sn * rem[2][wave_flag];
-          Real mz = amp * sn * rem[3][wave_flag];
-          Real m1 = mx * cos_a2 * cos_a3 - my * sin_a3 - mz * sin_a2 * cos_a3;
-          Real m2 = mx * cos_a2 * sin_a3 + my * cos_a3 - mz * sin_a2 * sin_a3;
-          Real m3 = mx * sin_a2 + mz * cos_a2;
-
-          // Store analytic solution at cell-centers
-          cons_(IDN, k, j, i) = d1;
-          cons_(IM1, k, j, i) = m1;
-          cons_(IM2, k, j, i) = m2;
-          cons_(IM3, k, j, i) = m3;
-
-          Real e0 = p0 / gm1 + 0.5 * d0 * u0 * u0 + amp * sn * rem[4][wave_flag];
-          cons_(IEN, k, j, i) = e0;
-        }
-      }
-    }
-
-    auto &rc = pmb->meshblock_data.Get(); // get base container
-    auto u = rc->Get("cons").data.GetHostMirrorAndCopy();
-    for (int k = kb.s; k <= kb.e; ++k) {
-      for (int j = jb.s; j <= jb.e; ++j) {
-        for (int i = ib.s; i <= ib.e; ++i) {
-          // Load cell-averaged <U>, either midpoint approx. or fourth-order approx
-          Real d1 = cons_(IDN, k, j, i);
-          Real m1 = cons_(IM1, k, j, i);
-          Real m2 = cons_(IM2, k, j, i);
-          Real m3 = cons_(IM3, k, j, i);
-          // Weight l1 error by cell volume
-          Real vol = pmb->coords.CellVolume(k, j, i);
-
-          l1_err[IDN] += std::abs(d1 - u(IDN, k, j, i)) * vol;
-          max_err[IDN] =
-              std::max(static_cast<Real>(std::abs(d1 - u(IDN, k, j, i))), max_err[IDN]);
-          l1_err[IM1] += std::abs(m1 - u(IM1, k, j, i)) * vol;
-          l1_err[IM2] += std::abs(m2 - u(IM2, k, j, i)) * vol;
-          l1_err[IM3] += std::abs(m3 - u(IM3, k, j, i)) * vol;
-          max_err[IM1] =
-              std::max(static_cast<Real>(std::abs(m1 - u(IM1, k, j, i))), max_err[IM1]);
-          max_err[IM2] =
-              std::max(static_cast<Real>(std::abs(m2 - u(IM2, k, j, i))), max_err[IM2]);
-          max_err[IM3] =
-              std::max(static_cast<Real>(std::abs(m3 - u(IM3, k, j, i))), max_err[IM3]);
-
-          Real e0 = cons_(IEN, k, j, i);
-          l1_err[IEN] += std::abs(e0 - u(IEN, k, j, i)) * vol;
-          max_err[IEN] =
-              std::max(static_cast<Real>(std::abs(e0 - u(IEN, k, j, i))), max_err[IEN]);
-        }
-      }
-    }
+  // Copy the parameters of the analytic solution so that they're captured by value
+  const Real d0_ = d0, p0_ = p0, u0_ = u0, vflow_ = vflow, amp_ = amp, gm1_ = gm1;
+  const Real k_par_ = k_par, sin_a2_ = sin_a2, cos_a2_ = cos_a2, sin_a3_ = sin_a3,
+             cos_a3_ = cos_a3;
+  const Real rem0 = rem[0][wave_flag], rem1 = rem[1][wave_flag], rem2 = rem[2][wave_flag],
+             rem3 = rem[3][wave_flag], rem4 = rem[4][wave_flag];
+
+  // Even for MHD, there are only cell-centered mesh variables
+  const auto norms = utils::ReduceErrorNorms<NHYDRO + NFIELD>(
+      mesh, KOKKOS_LAMBDA(const Real x1, const Real x2, const Real x3, Real *cons) {
+        const Real x = cos_a2_ * (x1 * cos_a3_ + x2 * sin_a3_) + x3 * sin_a2_;
+        const Real sn = std::sin(k_par_ * x);
+
+        const Real mx = d0_ * vflow_ + amp_ * sn * rem1;
+        const Real my = amp_ * sn * rem2;
+        const Real mz = amp_ * sn * rem3;
+        cons[IDN] = d0_ + amp_ * sn * rem0;
+        cons[IM1] = mx * cos_a2_ * cos_a3_ - my * sin_a3_ - mz * sin_a2_ * cos_a3_;
+        cons[IM2] = mx * cos_a2_ * sin_a3_ + my * cos_a3_ - mz * sin_a2_ * sin_a3_;
+        cons[IM3] = mx * sin_a2_ + mz * cos_a2_;
+        cons[IEN] = p0_ / gm1_ + 0.5 * d0_ * u0_ * u0_ + amp_ * sn * rem4;
+      });
+  Real l1_err[NHYDRO + NFIELD], max_err[NHYDRO + NFIELD];
+  for (int n = 0; n < NHYDRO + NFIELD; n++) {
+    l1_err[n] = norms.l1[n];
+    max_err[n] = norms.max[n];
   }
   Real rms_err = 0.0, max_max_over_l1 = 0.0;
 
-#ifdef MPI_PARALLEL
-  if (parthenon::Globals::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, &l1_err, (NHYDRO + NFIELD), MPI_PARTHENON_REAL, MPI_SUM, 0,
-               MPI_COMM_WORLD);
-    MPI_Reduce(MPI_IN_PLACE, &max_err, (NHYDRO + NFIELD), MPI_PARTHENON_REAL, MPI_MAX, 0,
-               MPI_COMM_WORLD);
-  } else {
-    MPI_Reduce(&l1_err, &l1_err, (NHYDRO + NFIELD), MPI_PARTHENON_REAL, MPI_SUM, 0,
-               MPI_COMM_WORLD);
-    MPI_Reduce(&max_err, &max_err, (NHYDRO + NFIELD), MPI_PARTHENON_REAL, MPI_MAX, 0,
-               MPI_COMM_WORLD);
-  }
-#endif
-
   // only the root process outputs the data
   if (parthenon::Globals::my_rank == 0) {
     // normalize errors by number of cells
@@ -334,44 +271,46 @@ void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm)
 }
 
 //========================================================================================
-//! \fn void ProblemGenerator(ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //  \brief Linear wave problem generator for 1D/2D/3D problems.
 //========================================================================================
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-  // Initialize the magnetic fields.  Note wavevector, eigenvectors, and other variables
-  // are set in InitUserMeshData
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  // Note wavevector, eigenvectors, and other variables are set in InitUserMeshData
+
+  // Copy the parameters so that they're captured by value
+  const Real d0_ = d0, p0_ = p0, u0_ = u0, vflow_ = vflow, amp_ = amp, gm1_ = gm1;
+  const Real k_par_ = k_par, sin_a2_ = sin_a2, cos_a2_ = cos_a2, sin_a3_ = sin_a3,
+             cos_a3_ = cos_a3;
+  const Real rem0 = rem[0][wave_flag], rem1 = rem[1][wave_flag];
+  const Real rem2 = rem[2][wave_flag], rem3 = rem[3][wave_flag];
+  const Real rem4 = rem[4][wave_flag];
 
   // initialize conserved variables
-  auto &rc = pmb->meshblock_data.Get();
-  auto &u_dev = rc->Get("cons").data;
-  auto &coords = pmb->coords;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
-        Real x = cos_a2 * (coords.Xc<1>(i) * cos_a3 + coords.Xc<2>(j) * sin_a3) +
-                 coords.Xc<3>(k) * sin_a2;
-        Real sn = std::sin(k_par * x);
-        u(IDN, k, j, i) = d0 + amp * sn * rem[0][wave_flag];
-        Real mx = d0 * vflow + amp * sn * rem[1][wave_flag];
-        Real my = amp * sn * rem[2][wave_flag];
-        Real mz = amp * sn * rem[3][wave_flag];
-
-        u(IM1, k, j, i) = mx * cos_a2 * cos_a3 - my * sin_a3 - mz * sin_a2 * cos_a3;
-        u(IM2, k, j, i) = mx * cos_a2 * sin_a3 + my * cos_a3 - mz * sin_a2 * sin_a3;
-        u(IM3, k, j, i) = mx * sin_a2 + mz * cos_a2;
-
-        u(IEN, k, j, i) = p0 / gm1 + 0.5 * d0 * u0 * u0 + amp * sn * rem[4][wave_flag];
-      }
-    }
-  }
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  pmb->par_for(
+      "ProblemGenerator: Linear Wave", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e,
+      ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
+        Real x = cos_a2_ * (coords.Xc<1>(i) * cos_a3_ + coords.Xc<2>(j) * sin_a3_) +
+                 coords.Xc<3>(k) * sin_a2_;
+        Real sn = std::sin(k_par_ * x);
+        u(IDN, k, j, i) = d0_ + amp_ * sn * rem0;
+        Real mx = d0_ * vflow_ + amp_ * sn * rem1;
+        Real my = amp_ * sn * rem2;
+        Real mz = amp_ * sn * rem3;
+
+        u(IM1, k, j, i) = mx * cos_a2_ * cos_a3_ - my * sin_a3_ - mz * sin_a2_ * cos_a3_;
+        u(IM2, k, j, i) = mx * cos_a2_ * sin_a3_ + my * cos_a3_ - mz * sin_a2_ * sin_a3_;
+        u(IM3, k, j, i) = mx * sin_a2_ + mz * cos_a2_;
+
+        u(IEN, k, j, i) = p0_ / gm1_ + 0.5 * d0_ * u0_ * u0_ + amp_ * sn * rem4;
+      });
 }
 
 //----------------------------------------------------------------------------------------
@@ -21,6 +21,7 @@
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <vector>
 
 // Parthenon headers
 #include "mesh/mesh.hpp"
@@ -29,13 +30,15 @@
 
 // Athena headers
 #include "../main.hpp"
+#include "../utils/error_norms.hpp"
+#include "../utils/vector_potential.hpp"
 
 namespace linear_wave_mhd {
 using namespace parthenon::driver::prelude;
 
 constexpr int NMHDWAVE = 7;
 // Parameters which define initial solution -- made global so that they can be shared
-// with functions A1,2,3 which compute vector potentials
+// with the VectorPotential and the analytic solution
 Real d0, p0, u0, bx0, by0, bz0, dby, dbz;
 int wave_flag;
 Real ang_2, ang_3;           // Rotation angles about the y and z' axis
@@ -45,10 +48,23 @@ Real amp, lambda, k_par; // amplitude, Wavelength, 2*PI/wavelength
 Real gam, gm1, iso_cs, vflow;
 Real ev[NMHDWAVE], rem[NMHDWAVE][NMHDWAVE], lem[NMHDWAVE][NMHDWAVE];
 
-// functions to compute vector potential to initialize the solution
-Real A1(const Real x1, const Real x2, const Real x3);
-Real A2(const Real x1, const Real x2, const Real x3);
-Real A3(const Real x1, const Real x2, const Real x3);
+// Vector potential to initialize the solution, using a gauge such that Ax = 0, and Ay,
+// Az are functions of x and y alone (in the rotated frame of the wave).
+struct VectorPotential {
+  Real bx0, by0, bz0, dby, dbz, k_par, sin_a2, cos_a2, sin_a3, cos_a3;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const Real x1, const Real x2, const Real x3,
+                                         Real a[3]) const {
+    Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
+    Real y = -x1 * sin_a3 + x2 * cos_a3;
+    Real Ay = bz0 * x - (dbz / k_par) * std::cos(k_par * (x));
+    Real Az = -by0 * x + (dby / k_par) * std::cos(k_par * (x)) + bx0 * y;
+
+    a[0] = -Ay * sin_a3 - Az * sin_a2 * cos_a3;
+    a[1] = Ay * cos_a3 - Az * sin_a2 * sin_a3;
+    a[2] = Az * cos_a2;
+  }
+};
 
 // function to compute eigenvectors of linear waves
 void Eigensystem(const Real d, const Real v1, const Real v2, const Real v3, const Real h,
@@ -178,124 +194,45 @@ void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm)
 
   constexpr int NGLMMHD = 8; // excluding psi
 
-  // Initialize errors to zero
-  Real l1_err[NGLMMHD]{}, max_err[NGLMMHD]{};
-
-  for (auto &pmb : mesh->block_list) {
-    IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-    IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-    IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-    // Even for MHD, there are only cell-centered mesh variables
-    int ncells4 = NGLMMHD;
-    // Save analytic solution of conserved variables in 4D scratch array on host
-    Kokkos::View<Real ****, parthenon::LayoutWrapper, parthenon::HostMemSpace> cons_(
-        "cons scratch", ncells4, pmb->cellbounds.ncellsk(IndexDomain::entire),
-        pmb->cellbounds.ncellsj(IndexDomain::entire),
-        pmb->cellbounds.ncellsi(IndexDomain::entire));
-
-    //  Compute errors at cell centers
-    for (int k = kb.s; k <= kb.e; k++) {
-      for (int j = jb.s; j <= jb.e; j++) {
-        for (int i = ib.s; i <= ib.e; i++) {
-          Real x =
-              cos_a2 * (pmb->coords.Xc<1>(i) * cos_a3 + pmb->coords.Xc<2>(j) * sin_a3) +
-              pmb->coords.Xc<3>(k) * sin_a2;
-          Real sn = std::sin(k_par * x);
-
-          Real d1 = d0 + amp * sn * rem[0][wave_flag];
-          Real mx = d0 * vflow + amp * sn * rem[1][wave_flag];
-          Real my = amp * sn * rem[2][wave_flag];
-          Real mz = amp * sn * rem[3][wave_flag];
-          Real m1 = mx * cos_a2 * cos_a3 - my * sin_a3 - mz * sin_a2 * cos_a3;
-          Real m2 = mx * cos_a2 * sin_a3 + my * cos_a3 - mz * sin_a2 * sin_a3;
-          Real m3 = mx * sin_a2 + mz * cos_a2;
-
-          // Store analytic solution at cell-centers
-          cons_(IDN, k, j, i) = d1;
-          cons_(IM1, k, j, i) = m1;
-          cons_(IM2, k, j, i) = m2;
-          cons_(IM3, k, j, i) = m3;
-
-          Real e0 = p0 / gm1 + 0.5 * d0 * u0 * u0 + amp * sn * rem[4][wave_flag];
-          e0 += 0.5 * (bx0 * bx0 + by0 * by0 + bz0 * bz0);
-          Real bx = bx0;
-          Real by = by0 + amp * sn * rem[5][wave_flag];
-          Real bz = bz0 + amp * sn * rem[6][wave_flag];
-          Real b1 = bx * cos_a2 * cos_a3 - by * sin_a3 - bz * sin_a2 * cos_a3;
-          Real b2 = bx * cos_a2 * sin_a3 + by * cos_a3 - bz * sin_a2 * sin_a3;
-          Real b3 = bx * sin_a2 + bz * cos_a2;
-          cons_(IB1, k, j, i) = b1;
-          cons_(IB2, k, j, i) = b2;
-          cons_(IB3, k, j, i) = b3;
-          cons_(IEN, k, j, i) = e0;
-        }
-      }
-    }
-
-    auto &rc = pmb->meshblock_data.Get(); // get base container
-    auto u = rc->Get("cons").data.GetHostMirrorAndCopy();
-    for (int k = kb.s; k <= kb.e; ++k) {
-      for (int j = jb.s; j <= jb.e; ++j) {
-        for (int i = ib.s; i <= ib.e; ++i) {
-          // Load cell-averaged <U>, either midpoint approx. or fourth-order approx
-          Real d1 = cons_(IDN, k, j, i);
-          Real m1 = cons_(IM1, k, j, i);
-          Real m2 = cons_(IM2, k, j, i);
-          Real m3 = cons_(IM3, k, j, i);
-          // Weight l1 error by cell volume
-          Real vol = pmb->coords.CellVolume(k, j, i);
-
-          l1_err[IDN] += std::abs(d1 - u(IDN, k, j, i)) * vol;
-          max_err[IDN] =
-              std::max(static_cast<Real>(std::abs(d1 - u(IDN, k, j, i))), max_err[IDN]);
-          l1_err[IM1] += std::abs(m1 - u(IM1, k, j, i)) * vol;
-          l1_err[IM2] += std::abs(m2 - u(IM2, k, j, i)) * vol;
-          l1_err[IM3] += std::abs(m3 - u(IM3, k, j, i)) * vol;
-          max_err[IM1] =
-              std::max(static_cast<Real>(std::abs(m1 - u(IM1, k, j, i))), max_err[IM1]);
-          max_err[IM2] =
-              std::max(static_cast<Real>(std::abs(m2 - u(IM2, k, j, i))), max_err[IM2]);
-          max_err[IM3] =
-              std::max(static_cast<Real>(std::abs(m3 - u(IM3, k, j, i))), max_err[IM3]);
-
-          Real e0 = cons_(IEN, k, j, i);
-          l1_err[IEN] += std::abs(e0 - u(IEN, k, j, i)) * vol;
-          max_err[IEN] =
-              std::max(static_cast<Real>(std::abs(e0 - u(IEN, k, j, i))), max_err[IEN]);
-
-          Real b1 = cons_(IB1, k, j, i);
-          Real b2 = cons_(IB2, k, j, i);
-          Real b3 = cons_(IB3, k, j, i);
-          Real db1 = std::abs(b1 - u(IB1, k, j, i));
-          Real db2 = std::abs(b2 - u(IB2, k, j, i));
-          Real db3 = std::abs(b3 - u(IB3, k, j, i));
-
-          l1_err[IB1] += db1 * vol;
-          l1_err[IB2] += db2 * vol;
-          l1_err[IB3] += db3 * vol;
-          max_err[IB1] = std::max(db1, max_err[IB1]);
-          max_err[IB2] = std::max(db2, max_err[IB2]);
-          max_err[IB3] = std::max(db3, max_err[IB3]);
-        }
-      }
-    }
+  // Copy the parameters of the analytic solution so that they're captured by value
+  const Real d0_ = d0, p0_ = p0, u0_ = u0, vflow_ = vflow, amp_ = amp, gm1_ = gm1;
+  const Real bx0_ = bx0, by0_ = by0, bz0_ = bz0;
+  const Real k_par_ = k_par, sin_a2_ = sin_a2, cos_a2_ = cos_a2, sin_a3_ = sin_a3,
+             cos_a3_ = cos_a3;
+  const Real rem0 = rem[0][wave_flag], rem1 = rem[1][wave_flag], rem2 = rem[2][wave_flag],
+             rem3 = rem[3][wave_flag], rem4 = rem[4][wave_flag], rem5 = rem[5][wave_flag],
+             rem6 = rem[6][wave_flag];
+
+  // Even for MHD, there are only cell-centered mesh variables
+  const auto norms = utils::ReduceErrorNorms<NGLMMHD>(
+      mesh, KOKKOS_LAMBDA(const Real x1, const Real x2, const Real x3, Real *cons) {
+        const Real x = cos_a2_ * (x1 * cos_a3_ + x2 * sin_a3_) + x3 * sin_a2_;
+        const Real sn = std::sin(k_par_ * x);
+
+        const Real mx = d0_ * vflow_ + amp_ * sn * rem1;
+        const Real my = amp_ * sn * rem2;
+        const Real mz = amp_ * sn * rem3;
+        cons[IDN] = d0_ + amp_ * sn * rem0;
+        cons[IM1] = mx * cos_a2_ * cos_a3_ - my * sin_a3_ - mz * sin_a2_ * cos_a3_;
+        cons[IM2] = mx * cos_a2_ * sin_a3_ + my * cos_a3_ - mz * sin_a2_ * sin_a3_;
+        cons[IM3] = mx * sin_a2_ + mz * cos_a2_;
+
+        const Real bx = bx0_;
+        const Real by = by0_ + amp_ * sn * rem5;
+        const Real bz = bz0_ + amp_ * sn * rem6;
+        cons[IB1] = bx * cos_a2_ * cos_a3_ - by * sin_a3_ - bz * sin_a2_ * cos_a3_;
+        cons[IB2] = bx * cos_a2_ * sin_a3_ + by * cos_a3_ - bz * sin_a2_ * sin_a3_;
+        cons[IB3] = bx * sin_a2_ + bz * cos_a2_;
+        cons[IEN] = p0_ / gm1_ + 0.5 * d0_ * u0_ * u0_ + amp_ * sn * rem4 +
+                    0.5 * (bx0_ * bx0_ + by0_ * by0_ + bz0_ * bz0_);
+      });
+  Real l1_err[NGLMMHD], max_err[NGLMMHD];
+  for (int n = 0; n < NGLMMHD; n++) {
+    l1_err[n] = norms.l1[n];
+    max_err[n] = norms.max[n];
   }
   Real rms_err = 0.0, max_max_over_l1 = 0.0;
 
-#ifdef MPI_PARALLEL
-  if (parthenon::Globals::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, &l1_err, (NGLMMHD), MPI_PARTHENON_REAL, MPI_SUM, 0,
-               MPI_COMM_WORLD);
-    MPI_Reduce(MPI_IN_PLACE, &max_err, (NGLMMHD), MPI_PARTHENON_REAL, MPI_MAX, 0,
-               MPI_COMM_WORLD);
-  } else {
-    MPI_Reduce(&l1_err, &l1_err, (NGLMMHD), MPI_PARTHENON_REAL, MPI_SUM, 0,
-               MPI_COMM_WORLD);
-    MPI_Reduce(&max_err, &max_err, (NGLMMHD), MPI_PARTHENON_REAL, MPI_MAX, 0,
-               MPI_COMM_WORLD);
-  }
-#endif
-
   // only the root process outputs the data
   if (parthenon::Globals::my_rank == 0) {
     // normalize errors by number of cells
@@ -362,120 +299,63 @@ void UserWorkAfterLoop(Mesh *mesh, ParameterInput *pin, parthenon::SimTime &tm)
 }
 
 //========================================================================================
-//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //  \brief Linear wave problem generator for 1D/2D/3D problems.
 //========================================================================================
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
   // Initialize the magnetic fields.  Note wavevector, eigenvectors, and other variables
   // are set in InitUserMeshData
 
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> a1(
-      "a1", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> a2(
-      "a2", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-  Kokkos::View<Real ***, parthenon::LayoutWrapper, parthenon::HostMemSpace> a3(
-      "a3", pmb->cellbounds.ncellsk(IndexDomain::entire),
-      pmb->cellbounds.ncellsj(IndexDomain::entire),
-      pmb->cellbounds.ncellsi(IndexDomain::entire));
-
   // wave amplitudes
   dby = amp * rem[NMHDWAVE - 2][wave_flag];
   dbz = amp * rem[NMHDWAVE - 1][wave_flag];
 
-  auto &coords = pmb->coords;
+  const VectorPotential potential{bx0,    by0,    bz0,    dby,    dbz,
+                                  k_par,  sin_a2, cos_a2, sin_a3, cos_a3};
 
-  // Initialize components of the vector potential
-  for (int k = kb.s - 1; k <= kb.e + 1; k++) {
-    for (int j = jb.s - 1; j <= jb.e + 1; j++) {
-      for (int i = ib.s - 1; i <= ib.e + 1; i++) {
-        a1(k, j, i) = A1(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k));
-        a2(k, j, i) = A2(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k));
-        a3(k, j, i) = A3(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k));
-      }
-    }
-  }
+  // Copy the parameters so that they're captured by value
+  const Real d0_ = d0, p0_ = p0, u0_ = u0, vflow_ = vflow, amp_ = amp, gm1_ = gm1;
+  const Real bx0_ = bx0, by0_ = by0, bz0_ = bz0;
+  const Real k_par_ = k_par, sin_a2_ = sin_a2, cos_a2_ = cos_a2, sin_a3_ = sin_a3,
+             cos_a3_ = cos_a3;
+  const Real rem0 = rem[0][wave_flag], rem1 = rem[1][wave_flag];
+  const Real rem2 = rem[2][wave_flag], rem3 = rem[3][wave_flag];
+  const Real rem4 = rem[4][wave_flag];
 
   // initialize conserved variables
-  auto &rc = pmb->meshblock_data.Get();
-  auto &u_dev = rc->Get("cons").data;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
-        Real x = cos_a2 * (coords.Xc<1>(i) * cos_a3 + coords.Xc<2>(j) * sin_a3) +
-                 coords.Xc<3>(k) * sin_a2;
-        Real sn = std::sin(k_par * x);
-        u(IDN, k, j, i) = d0 + amp * sn * rem[0][wave_flag];
-        Real mx = d0 * vflow + amp * sn * rem[1][wave_flag];
-        Real my = amp * sn * rem[2][wave_flag];
-        Real mz = amp * sn * rem[3][wave_flag];
-
-        u(IM1, k, j, i) = mx * cos_a2 * cos_a3 - my * sin_a3 - mz * sin_a2 * cos_a3;
-        u(IM2, k, j, i) = mx * cos_a2 * sin_a3 + my * cos_a3 - mz * sin_a2 * sin_a3;
-        u(IM3, k, j, i) = mx * sin_a2 + mz * cos_a2;
-
-        u(IB1, k, j, i) = (a3(k, j + 1, i) - a3(k, j - 1, i)) / coords.Dxc<2>(j) / 2.0 -
-                          (a2(k + 1, j, i) - a2(k - 1, j, i)) / coords.Dxc<3>(k) / 2.0;
-        u(IB2, k, j, i) = (a1(k + 1, j, i) - a1(k - 1, j, i)) / coords.Dxc<3>(k) / 2.0 -
-                          (a3(k, j, i + 1) - a3(k, j, i - 1)) / coords.Dxc<1>(i) / 2.0;
-        u(IB3, k, j, i) = (a2(k, j, i + 1) - a2(k, j, i - 1)) / coords.Dxc<1>(i) / 2.0 -
-                          (a1(k, j + 1, i) - a1(k, j - 1, i)) / coords.Dxc<2>(j) / 2.0;
-
-        u(IEN, k, j, i) = p0 / gm1 + 0.5 * d0 * u0 * u0 + amp * sn * rem[4][wave_flag];
-        u(IEN, k, j, i) += 0.5 * (bx0 * bx0 + by0 * by0 + bz0 * bz0);
-      }
-    }
-  }
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn Real A1(const Real x1,const Real x2,const Real x3)
-//  \brief A1: 1-component of vector potential, using a gauge such that Ax = 0, and Ay,
-//  Az are functions of x and y alone.
-
-Real A1(const Real x1, const Real x2, const Real x3) {
-  Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
-  Real y = -x1 * sin_a3 + x2 * cos_a3;
-  Real Ay = bz0 * x - (dbz / k_par) * std::cos(k_par * (x));
-  Real Az = -by0 * x + (dby / k_par) * std::cos(k_par * (x)) + bx0 * y;
-
-  return -Ay * sin_a3 - Az * sin_a2 * cos_a3;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn Real A2(const Real x1,const Real x2,const Real x3)
-//  \brief A2: 2-component of vector potential
-
-Real A2(const Real x1, const Real x2, const Real x3) {
-  Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
-  Real y = -x1 * sin_a3 + x2 * cos_a3;
-  Real Ay = bz0 * x - (dbz / k_par) * std::cos(k_par * (x));
-  Real Az = -by0 * x + (dby / k_par) * std::cos(k_par * (x)) + bx0 * y;
-
-  return Ay * cos_a3 - Az * sin_a2 * sin_a3;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn Real A3(const Real x1,const Real x2,const Real x3)
-//  \brief A3: 3-component of vector potential
-
-Real A3(const Real x1, const Real x2, const Real x3) {
-  Real x = x1 * cos_a2 * cos_a3 + x2 * cos_a2 * sin_a3 + x3 * sin_a2;
-  Real y = -x1 * sin_a3 + x2 * cos_a3;
-  Real Az = -by0 * x + (dby / k_par) * std::cos(k_par * (x)) + bx0 * y;
-
-  return Az * cos_a2;
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  pmb->par_for(
+      "ProblemGenerator: Linear Wave MHD", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s,
+      jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
+        Real x = cos_a2_ * (coords.Xc<1>(i) * cos_a3_ + coords.Xc<2>(j) * sin_a3_) +
+                 coords.Xc<3>(k) * sin_a2_;
+        Real sn = std::sin(k_par_ * x);
+        u(IDN, k, j, i) = d0_ + amp_ * sn * rem0;
+        Real mx = d0_ * vflow_ + amp_ * sn * rem1;
+        Real my = amp_ * sn * rem2;
+        Real mz = amp_ * sn * rem3;
+
+        u(IM1, k, j, i) = mx * cos_a2_ * cos_a3_ - my * sin_a3_ - mz * sin_a2_ * cos_a3_;
+        u(IM2, k, j, i) = mx * cos_a2_ * sin_a3_ + my * cos_a3_ - mz * sin_a2_ * sin_a3_;
+        u(IM3, k, j, i) = mx * sin_a2_ + mz * cos_a2_;
+
+        Real bfield[3];
+        utils::CurlOfVectorPotential(coords, k, j, i, potential, bfield);
+        u(IB1, k, j, i) = bfield[0];
+        u(IB2, k, j, i) = bfield[1];
+        u(IB3, k, j, i) = bfield[2];
+
+        u(IEN, k, j, i) = p0_ / gm1_ + 0.5 * d0_ * u0_ * u0_ + amp_ * sn * rem4;
+        u(IEN, k, j, i) += 0.5 * (bx0_ * bx0_ + by0_ * by0_ + bz0_ * bz0_);
+      });
 }
 
 //----------------------------------------------------------------------------------------
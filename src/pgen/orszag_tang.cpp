@@ -11,6 +11,10 @@
 //! https://www.astro.princeton.edu/~jstone/Athena/tests/orszag-tang/pagesource.html
 //========================================================================================
 
+// C++ headers
+#include <string>
+#include <vector>
+
 // Parthenon headers
 #include "mesh/mesh.hpp"
 #include <parthenon/driver.hpp>
@@ -22,13 +26,13 @@
 namespace orszag_tang {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
-  auto &mbd = pmb->meshblock_data.Get();
-  auto &u = mbd->Get("cons").data;
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
 
   Real gm1 = pin->GetReal("hydro", "gamma") - 1.0;
   Real B0 = 1.0 / std::sqrt(4.0 * M_PI);
@@ -36,11 +40,11 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
   Real v0 = 1.0;
   Real p0 = 5.0 / (12.0 * M_PI);
 
-  auto &coords = pmb->coords;
-
   pmb->par_for(
-      "ProblemGenerator: Orszag-Tang", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int k, const int j, const int i) {
+      "ProblemGenerator: Orszag-Tang", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e,
+      ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
+        const auto &coords = cons.GetCoords(b);
         u(IDN, k, j, i) = d0;
         // Note the different signs in this pgen compared to the the eqn mentioned in the
         // original paper (and other codes).
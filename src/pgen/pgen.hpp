@@ -13,7 +13,7 @@ namespace linear_wave {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void UserWorkAfterLoop(Mesh *mesh, parthenon::ParameterInput *pin,
                        parthenon::SimTime &tm);
 } // namespace linear_wave
@@ -22,7 +22,7 @@ namespace linear_wave_mhd {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void UserWorkAfterLoop(Mesh *mesh, parthenon::ParameterInput *pin,
                        parthenon::SimTime &tm);
 } // namespace linear_wave_mhd
@@ -31,7 +31,7 @@ namespace cpaw {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void UserWorkAfterLoop(Mesh *mesh, parthenon::ParameterInput *pin,
                        parthenon::SimTime &tm);
 } // namespace cpaw
@@ -40,16 +40,19 @@ namespace cloud {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void InflowWindX2(std::shared_ptr<MeshBlockData<Real>> &mbd, bool coarse);
-parthenon::AmrTag ProblemCheckRefinementBlock(MeshBlockData<Real> *mbd);
+void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg);
+void TrackCloud(Mesh *pmesh, ParameterInput *pin, const parthenon::SimTime &tm);
+void ProblemCheckRefinementMesh(MeshData<Real> *md,
+                                parthenon::ParArray1D<parthenon::AmrTag> &amr_tags);
 } // namespace cloud
 
 namespace blast {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void UserWorkAfterLoop(Mesh *mesh, parthenon::ParameterInput *pin,
                        parthenon::SimTime &tm);
 } // namespace blast
@@ -58,37 +61,37 @@ namespace advection {
 using namespace parthenon::driver::prelude;
 
 void InitUserMeshData(Mesh *mesh, ParameterInput *pin);
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 } // namespace advection
 
 namespace orszag_tang {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 } // namespace orszag_tang
 
 namespace diffusion {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 } // namespace diffusion
 
 namespace field_loop {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg);
 } // namespace field_loop
 
 namespace kh {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 } // namespace kh
 namespace rand_blast {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg);
 void RandomBlasts(MeshData<Real> *md, const parthenon::SimTime &tm, const Real);
 } // namespace rand_blast
@@ -102,12 +105,15 @@ void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin);
 void ClusterSrcTerm(MeshData<Real> *md, const parthenon::SimTime &tm, const Real beta_dt);
 parthenon::Real ClusterEstimateTimestep(MeshData<Real> *md);
+parthenon::Real ClusterBlockCost(MeshBlock *pmb);
+void ClusterPostStepDiagnostics(Mesh *pmesh, ParameterInput *pin,
+                                const parthenon::SimTime &tm);
 } // namespace cluster
 
 namespace sod {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md);
 } // namespace sod
 
 namespace turbulence {
@@ -117,6 +123,7 @@ void ProblemGenerator(Mesh *pm, parthenon::ParameterInput *pin, MeshData<Real> *
 void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg);
 void Driving(MeshData<Real> *md, const parthenon::SimTime &tm, const Real dt);
 void SetPhases(MeshBlock *pmb, ParameterInput *pin);
+void PostStepDiagnostics(Mesh *pmesh, ParameterInput *pin, const parthenon::SimTime &tm);
 void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin);
 void Cleanup();
 } // namespace turbulence
@@ -23,6 +23,7 @@
 #include <sstream>   // stringstream
 #include <stdexcept> // runtime_error
 #include <string>    // c_str()
+#include <vector>
 
 // Parthenon headers
 #include "basic_types.hpp"
@@ -34,6 +35,7 @@
 #include "../eos/adiabatic_glmmhd.hpp"
 #include "../hydro/hydro.hpp"
 #include "../main.hpp"
+#include "../utils/block_culling.hpp"
 
 namespace rand_blast {
 using namespace parthenon::driver::prelude;
@@ -75,17 +77,15 @@ void RandomBlasts(MeshData<Real> *md, const parthenon::SimTime &tm, const Real)
     return;
   }
   auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
-  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
-  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   auto hydro_pkg = md->GetBlockData(0)->GetBlockPointer()->packages.Get("Hydro");
   const auto &eos = hydro_pkg->Param<AdiabaticGLMMHDEOS>("eos");
   const auto gm1 = eos.GetGamma() - 1.0;
-  auto blasts = blasts_; // make sure blasts is captured
-  parthenon::par_for(
-      DEFAULT_LOOP_PATTERN, "RandomBlastSource", parthenon::DevExecSpace(), 0,
-      cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+  const auto blast = blasts_[blast_i];
+  const Real blast_radius = 0.005;
+  // Only launch over the (few) blocks that intersect the blast
+  utils::ParForBlocksInSphere(
+      "RandomBlastSource", md, blast, blast_radius, IndexDomain::interior,
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
         auto &cons = cons_pack(b);
         const auto &coords = cons_pack.GetCoords(b);
@@ -93,10 +93,10 @@ void RandomBlasts(MeshData<Real> *md, const parthenon::SimTime &tm, const Real)
         Real x = coords.Xc<1>(i);
         Real y = coords.Xc<2>(j);
         Real z = coords.Xc<3>(k);
-        Real dist = std::sqrt(SQR(x - blasts[blast_i][0]) + SQR(y - blasts[blast_i][1]) +
-                              SQR(z - blasts[blast_i][2]));
+        Real dist =
+            std::sqrt(SQR(x - blast[0]) + SQR(y - blast[1]) + SQR(z - blast[2]));
 
-        if (dist < 0.005) {
+        if (dist < blast_radius) {
           cons(IEN, k, j, i) = 13649.6 / gm1 +
                                0.5 * (SQR(cons(IB1, k, j, i)) + SQR(cons(IB2, k, j, i)) +
                                       SQR(cons(IB3, k, j, i))) +
@@ -112,15 +112,15 @@ void ProblemInitPackageData(ParameterInput *pin, StateDescriptor *pkg) {
 }
 
 //========================================================================================
-//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \fn void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md)
 //! \brief Initialize uniform background for random blasts
 //========================================================================================
 
-void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
-  // nxN != ncellsN, in general. Allocate to extend through ghost zones, regardless # dim
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+void ProblemGenerator(Mesh *pmesh, ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   Real gamma = pin->GetOrAddReal("hydro", "gamma", 5 / 3);
   Real gm1 = gamma - 1.0;
@@ -130,21 +130,15 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
 
   // Now initialize rest of the cell centered quantities
   // initialize conserved variables
-  auto &rc = pmb->meshblock_data.Get();
-  auto &u_dev = rc->Get("cons").data;
-  // initializing on host
-  auto u = u_dev.GetHostMirrorAndCopy();
-  for (int k = kb.s; k <= kb.e; k++) {
-    for (int j = jb.s; j <= jb.e; j++) {
-      for (int i = ib.s; i <= ib.e; i++) {
+  const auto &cons = md->PackVariables(std::vector<std::string>{"cons"});
+  pmb->par_for(
+      "ProblemGenerator: Rand Blast", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e,
+      ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &u = cons(b);
         u(IDN, k, j, i) = rho0;
         u(IB1, k, j, i) = Bx0;
         u(IEN, k, j, i) = p0 / gm1 + 0.5 * SQR(Bx0);
-      }
-    }
-  }
-  // copy initialized vars to device
-  u_dev.DeepCopy(u);
+      });
 }
 
 } // namespace rand_blast
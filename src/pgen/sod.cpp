@@ -3,6 +3,10 @@
 // Copyright (c) 2020-2021, Athena Parthenon Collaboration. All rights reserved.
 // Licensed under the 3-Clause License (the "LICENSE")
 
+// C++ headers
+#include <string>
+#include <vector>
+
 // Parthenon headers
 #include "mesh/mesh.hpp"
 #include <parthenon/driver.hpp>
@@ -14,11 +18,11 @@
 namespace sod {
 using namespace parthenon::driver::prelude;
 
-void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin) {
-  auto hydro_pkg = pmb->packages.Get("Hydro");
-  auto ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  auto jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  auto kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+void ProblemGenerator(Mesh *pmesh, parthenon::ParameterInput *pin, MeshData<Real> *md) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
 
   Real rho_l = pin->GetOrAddReal("problem/sod", "rho_l", 1.0);
   Real pres_l = pin->GetOrAddReal("problem/sod", "pres_l", 1.0);
@@ -27,17 +31,26 @@ void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin) {
   Real pres_r = pin->GetOrAddReal("problem/sod", "pres_r", 0.1);
   Real u_r = pin->GetOrAddReal("problem/sod", "u_r", 0.0);
   Real x_discont = pin->GetOrAddReal("problem/sod", "x_discont", 0.5);
+  // Magnetic field (e.g., for the Brio & Wu shock tube) with constant normal component
+  Real bx = pin->GetOrAddReal("problem/sod", "bx", 0.0);
+  Real by_l = pin->GetOrAddReal("problem/sod", "by_l", 0.0);
+  Real by_r = pin->GetOrAddReal("problem/sod", "by_r", 0.0);
 
   Real gamma = pin->GetReal("hydro", "gamma");
 
+  const bool mhd_enabled =
+      pmb->packages.Get("Hydro")->Param<Fluid>("fluid") == Fluid::glmmhd;
+  PARTHENON_REQUIRE_THROWS(mhd_enabled || (bx == 0.0 && by_l == 0.0 && by_r == 0.0),
+                           "Magnetic fields in problem/sod require hydro/fluid = glmmhd.");
+
   // initialize conserved variables
-  auto &mbd = pmb->meshblock_data.Get();
-  auto &cons = mbd->Get("cons").data;
-  auto &coords = pmb->coords;
+  const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
 
   pmb->par_for(
-      "Init sod", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int k, const int j, const int i) {
+      "Init sod", 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        auto &cons = cons_pack(b);
+        const auto &coords = cons_pack.GetCoords(b);
         if (coords.Xc<1>(i) < x_discont) {
           cons(IDN, k, j, i) = rho_l;
           cons(IM1, k, j, i) = rho_l * u_l;
@@ -47,6 +60,12 @@ void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin) {
           cons(IM1, k, j, i) = rho_r * u_r;
           cons(IEN, k, j, i) = 0.5 * rho_r * u_r * u_r + pres_r / (gamma - 1.0);
         }
+        if (mhd_enabled) {
+          const Real by = coords.Xc<1>(i) < x_discont ? by_l : by_r;
+          cons(IB1, k, j, i) = bx;
+          cons(IB2, k, j, i) = by;
+          cons(IEN, k, j, i) += 0.5 * (bx * bx + by * by);
+        }
       });
 }
 } // namespace sod
@@ -28,6 +28,7 @@
 #include "../main.hpp"
 #include "../units.hpp"
 #include "../utils/few_modes_ft.hpp"
+#include "../utils/power_spectra.hpp"
 
 namespace turbulence {
 using namespace parthenon::package::prelude;
@@ -35,6 +36,37 @@ using parthenon::DevMemSpace;
 using parthenon::ParArray2D;
 using utils::few_modes_ft::Complex;
 using utils::few_modes_ft::FewModesFT;
+using utils::power_spectra::PowerSpectra;
+
+// Moments reduced in Perturb(): volume, mass, mass weighted acceleration (3), volume
+// weighted acceleration (3), and the squared acceleration.
+constexpr int num_perturb_sums = 9;
+struct PerturbSums {
+  Real vals[num_perturb_sums];
+  KOKKOS_INLINE_FUNCTION PerturbSums() {
+    for (int n = 0; n < num_perturb_sums; n++) {
+      vals[n] = 0.0;
+    }
+  }
+  KOKKOS_INLINE_FUNCTION PerturbSums &operator+=(const PerturbSums &rhs) {
+    for (int n = 0; n < num_perturb_sums; n++) {
+      vals[n] += rhs.vals[n];
+    }
+    return *this;
+  }
+};
+} // namespace turbulence
+
+namespace Kokkos {
+template <>
+struct reduction_identity<turbulence::PerturbSums> {
+  KOKKOS_FORCEINLINE_FUNCTION static turbulence::PerturbSums sum() {
+    return turbulence::PerturbSums();
+  }
+};
+} // namespace Kokkos
+
+namespace turbulence {
 
 // TODO(?) until we are able to process multiple variables in a single hst function call
 // we'll use this enum to identify the various vars.
@@ -160,6 +192,10 @@ void ProblemInitPackageData(ParameterInput *pin, parthenon::StateDescriptor *pkg
   // object must be mutable to update the internal state of the RNG
   pkg->AddParam<>("turbulence/few_modes_ft", few_modes_ft, true);
 
+  // In-situ energy spectra (mutable to keep track of the next analysis time)
+  pkg->AddParam<>("turbulence/power_spectra",
+                  PowerSpectra(pin, pkg, "problem/turbulence/spectra"), true);
+
   // Check if this is is a restart and restore previous state
   if (pin->DoesParameterExist("problem/turbulence", "accel_hat_0_0_r")) {
     // Need to extract mutable object from Params here as the original few_modes_ft above
@@ -362,51 +398,54 @@ void Perturb(MeshData<Real> *md, const Real dt) {
   auto cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
   auto acc_pack = md->PackVariables(std::vector<std::string>{"acc"});
 
-  Kokkos::Array<Real, 4> sums{{0.0, 0.0, 0.0, 0.0}};
+  // All moments required to remove the mean momentum and to normalize the acceleration
+  // field are reduced at once using
+  // int (a_n - mu_n)^2 dV = int a_n^2 dV - 2 mu_n int a_n dV + mu_n^2 V
+  // with mu_n = int rho a_n dV / int rho dV so that a single collective is required.
+  PerturbSums sums;
   Kokkos::parallel_reduce(
-      "forcing: calc mean momenum",
+      "forcing: calc moments",
       Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
           {0, kb.s, jb.s, ib.s}, {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
           {1, 1, 1, ib.e + 1 - ib.s}),
-      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmass_sum,
-                    Real &lim1_sum, Real &lim2_sum, Real &lim3_sum) {
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                    PerturbSums &lsums) {
         const auto &coords = cons_pack.GetCoords(b);
-        auto den = cons_pack(b, IDN, k, j, i);
-        lmass_sum += den * coords.CellVolume(k, j, i);
-        lim1_sum += den * acc_pack(b, 0, k, j, i) * coords.CellVolume(k, j, i);
-        lim2_sum += den * acc_pack(b, 1, k, j, i) * coords.CellVolume(k, j, i);
-        lim3_sum += den * acc_pack(b, 2, k, j, i) * coords.CellVolume(k, j, i);
+        const auto vol = coords.CellVolume(k, j, i);
+        const auto den = cons_pack(b, IDN, k, j, i);
+        lsums.vals[0] += vol;
+        lsums.vals[1] += den * vol;
+        for (int n = 0; n < 3; n++) {
+          const auto acc = acc_pack(b, n, k, j, i);
+          lsums.vals[2 + n] += den * acc * vol;
+          lsums.vals[5 + n] += acc * vol;
+          lsums.vals[8] += SQR(acc) * vol;
+        }
       },
-      sums[0], sums[1], sums[2], sums[3]);
+      Kokkos::Sum<PerturbSums>(sums));
 
 #ifdef MPI_PARALLEL
-  // Sum the perturbations over all processors
-  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 4, MPI_PARTHENON_REAL,
-                                    MPI_SUM, MPI_COMM_WORLD));
+  // Sum the moments over all processors
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.vals, num_perturb_sums,
+                                    MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
 #endif // MPI_PARALLEL
 
-  pmb->par_reduce(
-      "forcing: remove mean momentum and calc norm", 0, acc_pack.GetDim(5) - 1, 0, 2,
-      kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-      KOKKOS_LAMBDA(const int b, const int n, const int k, const int j, const int i,
-                    Real &lampl_sum) {
-        const auto &coords = acc_pack.GetCoords(b);
-        acc_pack(b, n, k, j, i) -= sums[n + 1] / sums[0];
-        lampl_sum += SQR(acc_pack(b, n, k, j, i)) * coords.CellVolume(k, j, i);
-      },
-      sums[0]);
-
-#ifdef MPI_PARALLEL
-  // Sum the perturbations over all processors
-  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, sums.data(), 1, MPI_PARTHENON_REAL,
-                                    MPI_SUM, MPI_COMM_WORLD));
-#endif // MPI_PARALLEL
+  const auto vol_sum = sums.vals[0];
+  const auto mass_sum = sums.vals[1];
+  const Real mean_acc_0 = sums.vals[2] / mass_sum;
+  const Real mean_acc_1 = sums.vals[3] / mass_sum;
+  const Real mean_acc_2 = sums.vals[4] / mass_sum;
+  Real ampl_sum = sums.vals[8];
+  for (int n = 0; n < 3; n++) {
+    const auto mean_acc = sums.vals[2 + n] / mass_sum;
+    ampl_sum += -2.0 * mean_acc * sums.vals[5 + n] + SQR(mean_acc) * vol_sum;
+  }
 
   const auto Lx = pmb->pmy_mesh->mesh_size.x1max - pmb->pmy_mesh->mesh_size.x1min;
   const auto Ly = pmb->pmy_mesh->mesh_size.x2max - pmb->pmy_mesh->mesh_size.x2min;
   const auto Lz = pmb->pmy_mesh->mesh_size.x3max - pmb->pmy_mesh->mesh_size.x3min;
   const auto accel_rms = hydro_pkg->Param<Real>("turbulence/accel_rms");
-  auto norm = accel_rms / std::sqrt(sums[0] / (Lx * Ly * Lz));
+  auto norm = accel_rms / std::sqrt(ampl_sum / (Lx * Ly * Lz));
 
   pmb->par_for(
       "apply momemtum perturb", 0, cons_pack.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
@@ -418,10 +457,11 @@ void Perturb(MeshData<Real> *md, const Real dt) {
         auto &acc_1 = acc(1, k, j, i);
         auto &acc_2 = acc(2, k, j, i);
 
-        // normalizing accel field here so that the actual values are used in the output
-        acc_0 *= norm;
-        acc_1 *= norm;
-        acc_2 *= norm;
+        // removing the mean momentum and normalizing accel field here so that the actual
+        // values are used in the output
+        acc_0 = (acc_0 - mean_acc_0) * norm;
+        acc_1 = (acc_1 - mean_acc_1) * norm;
+        acc_2 = (acc_2 - mean_acc_2) * norm;
 
         Real qa = dt * cons(IDN, k, j, i);
         cons(IEN, k, j, i) +=
@@ -447,6 +487,16 @@ void Driving(MeshData<Real> *md, const parthenon::SimTime &tm, const Real dt) {
   Perturb(md, dt);
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void PostStepDiagnostics()
+//  \brief Write the in-situ energy spectra (if due)
+
+void PostStepDiagnostics(Mesh *pmesh, ParameterInput *pin, const parthenon::SimTime &tm) {
+  auto hydro_pkg = pmesh->packages.Get("Hydro");
+  hydro_pkg->MutableParam<PowerSpectra>("turbulence/power_spectra")
+      ->ComputeIfDue(pmesh, pin, tm);
+}
+
 void UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin) {
   auto hydro_pkg = pmb->packages.Get("Hydro");
 
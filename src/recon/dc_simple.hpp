@@ -22,11 +22,11 @@ using parthenon::ScratchPad2D;
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
-template <Reconstruction recon, int XNDIR>
+template <Reconstruction recon, int XNDIR, typename T>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::dc, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
-            ScratchPad2D<Real> &qr) {
+            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<T> &ql,
+            ScratchPad2D<T> &qr) {
   const auto nvar = q.GetDim(4);
   for (auto n = 0; n < nvar; ++n) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
@@ -46,4 +46,19 @@ Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const
   }
 }
 
+//! \fn Reconstruct<Reconstruction::dc, int DIR>()
+//  \brief Pointwise donor cell reconstruction of variable n (used in tight flux kernel)
+//  Returns the L/R states at the interface between cell i-1 and i in X1DIR (j-1 and j in
+//  X2DIR, and k-1 and k in X3DIR).
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::dc, void>::type
+Reconstruct(const int n, const int k, const int j, const int i,
+            const parthenon::VariablePack<Real> &q, Real &ql, Real &qr) {
+  constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+  constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+  constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+  ql = q(n, k - dk, j - dj, i - di);
+  qr = q(n, k, j, i);
+}
+
 #endif // RECONSTRUCT_DC_SIMPLE_HPP_
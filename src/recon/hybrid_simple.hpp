@@ -0,0 +1,149 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+#ifndef RECONSTRUCT_HYBRID_SIMPLE_HPP_
+#define RECONSTRUCT_HYBRID_SIMPLE_HPP_
+//! \file hybrid_simple.hpp
+//  \brief Hybrid reconstruction using PLM in smooth/uniform cells and a high order method
+//  (PPM or WENOZ) elsewhere.
+//
+// The method is selected per cell (identical for all variables of a cell) by a cheap
+// indicator: the high order method is used if the relative variation of the density or
+// pressure across the cell, |q_{i+1} - q_{i-1}| / q_i, exceeds a threshold.
+// PLM and both high order methods are conservative so that interfaces between cells
+// using different methods require no special treatment.
+// The reconstruction does not count the cells using each method. This is done by a
+// separate (optional) kernel, see CountHybridReconstructionCells.
+
+// C++ headers
+#include <cmath>
+
+#include <parthenon/parthenon.hpp>
+
+#include "../main.hpp"
+#include "plm_simple.hpp"
+#include "ppm_simple.hpp"
+#include "wenoz_simple.hpp"
+
+// Threshold of the indicator of the hybrid reconstruction
+struct HybridReconstruction {
+  Real threshold;
+};
+
+// Methods of the two cells adjacent to the interface between cell i-1 and i used by the
+// pointwise reconstruction (see MakeHybridInterface())
+struct HybridInterface {
+  bool high_order_im1;
+  bool high_order_i;
+};
+
+constexpr bool IsHybridReconstruction(const Reconstruction recon) {
+  return recon == Reconstruction::hybrid_ppm || recon == Reconstruction::hybrid_wenoz;
+}
+
+// High order method used by a hybrid reconstruction
+constexpr Reconstruction HybridHighOrderReconstruction(const Reconstruction recon) {
+  return recon == Reconstruction::hybrid_wenoz ? Reconstruction::wenoz
+                                               : Reconstruction::ppm;
+}
+
+// Whether cell (k, j, i) requires the high order method for the reconstruction in XNDIR
+template <int XNDIR, typename Pack>
+KOKKOS_INLINE_FUNCTION bool HybridRequiresHighOrder(const int k, const int j,
+                                                    const int i, const Pack &q,
+                                                    const Real threshold) {
+  constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+  constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+  constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+  const Real drho = q(IDN, k + dk, j + dj, i + di) - q(IDN, k - dk, j - dj, i - di);
+  const Real dp = q(IPR, k + dk, j + dj, i + di) - q(IPR, k - dk, j - dj, i - di);
+  return std::abs(drho) > threshold * q(IDN, k, j, i) ||
+         std::abs(dp) > threshold * q(IPR, k, j, i);
+}
+
+// Reconstructs variable n of cell (k, j, i) with PLM or the high order method.
+// ql_ip1 and qr_i are the states at the upper and lower face of the cell.
+template <Reconstruction recon, int XNDIR, typename Pack, typename T>
+KOKKOS_INLINE_FUNCTION void
+ReconstructHybridCell(const int n, const int k, const int j, const int i, const Pack &q,
+                      const bool high_order, T &ql_ip1, T &qr_i) {
+  constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+  constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+  constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+  if (!high_order) {
+    PLM(q(n, k - dk, j - dj, i - di), q(n, k, j, i), q(n, k + dk, j + dj, i + di), ql_ip1,
+        qr_i);
+  } else if constexpr (HybridHighOrderReconstruction(recon) == Reconstruction::wenoz) {
+    WENOZ(q(n, k - 2 * dk, j - 2 * dj, i - 2 * di), q(n, k - dk, j - dj, i - di),
+          q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+          q(n, k + 2 * dk, j + 2 * dj, i + 2 * di), ql_ip1, qr_i);
+  } else {
+    PPM(q(n, k - 2 * dk, j - 2 * dj, i - 2 * di), q(n, k - dk, j - dj, i - di),
+        q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+        q(n, k + 2 * dk, j + 2 * dj, i + 2 * di), ql_ip1, qr_i);
+  }
+}
+
+//! \fn ReconstructHybrid<Reconstruction recon, int DIR>()
+//  \brief Same interface (and loop limits) as ReconstructAllVars(). All variables of a
+//  cell are reconstructed in a single inner iteration so that the indicator is only
+//  evaluated once per cell.
+template <Reconstruction recon, int XNDIR, typename Pack, typename T>
+KOKKOS_INLINE_FUNCTION void
+ReconstructHybrid(parthenon::team_mbr_t const &member, const int k, const int j,
+                  const int il, const int iu, const Pack &q, ScratchPad2D<T> &ql,
+                  ScratchPad2D<T> &qr, const HybridReconstruction &hybrid) {
+  // in x1dir ql is ql_ip1, otherwise the offset has been set outside in the cached
+  // stencil (see Reconstruct())
+  constexpr int dl = XNDIR == parthenon::X1DIR ? 1 : 0;
+  const auto nvar = q.GetDim(4);
+  parthenon::par_for_inner(member, il, iu, [&](const int i) {
+    const bool high_order = HybridRequiresHighOrder<XNDIR>(k, j, i, q, hybrid.threshold);
+    for (auto n = 0; n < nvar; ++n) {
+      ReconstructHybridCell<recon, XNDIR>(n, k, j, i, q, high_order, ql(n, i + dl),
+                                          qr(n, i));
+    }
+  });
+}
+
+// Evaluates the indicator of both cells adjacent to the interface between cell i-1 and
+// i in X1DIR (j-1 and j in X2DIR, and k-1 and k in X3DIR) once for all variables.
+// Returns PLM for both cells for all other reconstructions (where it is unused).
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION HybridInterface
+MakeHybridInterface(const int k, const int j, const int i,
+                    const parthenon::VariablePack<Real> &q,
+                    const HybridReconstruction &hybrid) {
+  if constexpr (IsHybridReconstruction(recon)) {
+    constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+    constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+    constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+    return {HybridRequiresHighOrder<XNDIR>(k - dk, j - dj, i - di, q, hybrid.threshold),
+            HybridRequiresHighOrder<XNDIR>(k, j, i, q, hybrid.threshold)};
+  } else {
+    return {false, false};
+  }
+}
+
+//! \fn ReconstructHybrid<Reconstruction recon, int DIR>()
+//  \brief Pointwise hybrid reconstruction of variable n (used in the tight flux kernel)
+//  Returns the L/R states at the interface between cell i-1 and i in X1DIR (j-1 and j in
+//  X2DIR, and k-1 and k in X3DIR) using the methods of both cells given by `iface`.
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION void
+ReconstructHybrid(const int n, const int k, const int j, const int i,
+                  const parthenon::VariablePack<Real> &q, Real &ql, Real &qr,
+                  const HybridInterface &iface) {
+  constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+  constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+  constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+  Real unused;
+  // ql is the ql_ip1 of cell i-1 and qr is the qr_i of cell i
+  ReconstructHybridCell<recon, XNDIR>(n, k - dk, j - dj, i - di, q, iface.high_order_im1,
+                                      ql, unused);
+  ReconstructHybridCell<recon, XNDIR>(n, k, j, i, q, iface.high_order_i, unused, qr);
+}
+
+#endif // RECONSTRUCT_HYBRID_SIMPLE_HPP_
@@ -59,9 +59,10 @@ KOKKOS_INLINE_FUNCTION Real limo3_limiter(const Real dvp, const Real dvm, const
 //  \brief Reconstructs linear slope in cell i to compute ql(i+1) and qr(i). Works for
 //  reconstruction in any dimension by passing in the appropriate q_im1, q_i, and q_ip1.
 
+template <typename T>
 KOKKOS_INLINE_FUNCTION
-void LimO3(const Real &q_im1, const Real &q_i, const Real &q_ip1, Real &ql_ip1,
-           Real &qr_i, const Real &dx, const bool ensure_positivity) {
+void LimO3(const Real &q_im1, const Real &q_i, const Real &q_ip1, T &ql_ip1, T &qr_i,
+           const Real &dx, const bool ensure_positivity) {
 
   const Real dqp = q_ip1 - q_i;
   const Real dqm = q_i - q_im1;
@@ -86,11 +87,11 @@ void LimO3(const Real &q_im1, const Real &q_i, const Real &q_ip1, Real &ql_ip1,
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
-template <Reconstruction recon, int XNDIR>
+template <Reconstruction recon, int XNDIR, typename T>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::limo3, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
-            ScratchPad2D<Real> &qr) {
+            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<T> &ql,
+            ScratchPad2D<T> &qr) {
   const auto nvar = q.GetDim(4);
   for (auto n = 0; n < nvar; ++n) {
     // Note, this may be unsafe as we implicitly assume how this function is called with
@@ -117,4 +118,28 @@ Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const
   }
 }
 
+//! \fn Reconstruct<Reconstruction::limo3, int DIR>()
+//  \brief Pointwise LimO3 reconstruction of variable n (used in the tight flux kernel)
+//  Returns the L/R states at the interface between cell i-1 and i in X1DIR (j-1 and j in
+//  X2DIR, and k-1 and k in X3DIR).
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::limo3, void>::type
+Reconstruct(const int n, const int k, const int j, const int i,
+            const parthenon::VariablePack<Real> &q, Real &ql, Real &qr) {
+  constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+  constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+  constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+  Real unused;
+  // Note, this may be unsafe as we implicitly assume how this function is called with
+  // respect to the entries in the single state vector containing all components
+  const bool ensure_positivity = (n == IDN || n == IPR);
+  const auto dx_im1 = q.GetCoords().Dxc<XNDIR>(k - dk, j - dj, i - di);
+  const auto dx = q.GetCoords().Dxc<XNDIR>(k, j, i);
+  // ql is the ql_ip1 of cell i-1 and qr is the qr_i of cell i
+  LimO3(q(n, k - 2 * dk, j - 2 * dj, i - 2 * di), q(n, k - dk, j - dj, i - di),
+        q(n, k, j, i), ql, unused, dx_im1, ensure_positivity);
+  LimO3(q(n, k - dk, j - dj, i - di), q(n, k, j, i), q(n, k + dk, j + dj, i + di), unused,
+        qr, dx, ensure_positivity);
+}
+
 #endif // RECONSTRUCT_LIMO3_SIMPLE_HPP_
@@ -35,9 +35,10 @@ using parthenon::ScratchPad2D;
 //  \brief Reconstructs parabolic slope in cell i to compute ql(i+1) and qr(i). Works for
 //  reconstruction in any dimension by passing in the appropriate q_im2,...,q _ip2.
 
+template <typename T>
 KOKKOS_INLINE_FUNCTION
 void PPM(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_ip1,
-         const Real &q_ip2, Real &ql_ip1, Real &qr_i) {
+         const Real &q_ip2, T &ql_ip1, T &qr_i) {
 
   // CS08 constant used in second derivative limiter, >1 , independent of h
   const Real C2 = 1.25;
@@ -170,11 +171,11 @@ void PPM(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_ip
 //  have been cached for the appropriate k, j (and plus 1) values. Thus, in x1dir ql needs
 //  to be offset by i+1 but for the other direction the offset has been set outside in the
 //  cached stencil.
-template <Reconstruction recon, int XNDIR>
+template <Reconstruction recon, int XNDIR, typename T>
 KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::ppm, void>::type
 Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
-            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<Real> &ql,
-            ScratchPad2D<Real> &qr) {
+            const int iu, const parthenon::VariablePack<Real> &q, ScratchPad2D<T> &ql,
+            ScratchPad2D<T> &qr) {
   const auto nvar = q.GetDim(4);
   for (auto n = 0; n < nvar; ++n) {
     parthenon::par_for_inner(member, il, iu, [&](const int i) {
@@ -197,4 +198,25 @@ Reconstruct(parthenon::team_mbr_t const &member, const int k, const int j, const
   }
 }
 
+//! \fn Reconstruct<Reconstruction::ppm, int DIR>()
+//  \brief Pointwise PPM reconstruction of variable n (used in the tight flux kernel)
+//  Returns the L/R states at the interface between cell i-1 and i in X1DIR (j-1 and j in
+//  X2DIR, and k-1 and k in X3DIR).
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION typename std::enable_if<recon == Reconstruction::ppm, void>::type
+Reconstruct(const int n, const int k, const int j, const int i,
+            const parthenon::VariablePack<Real> &q, Real &ql, Real &qr) {
+  constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+  constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+  constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+  Real unused;
+  // ql is the ql_ip1 of cell i-1 and qr is the qr_i of cell i
+  PPM(q(n, k - 3 * dk, j - 3 * dj, i - 3 * di), q(n, k - 2 * dk, j - 2 * dj, i - 2 * di),
+      q(n, k - dk, j - dj, i - di), q(n, k, j, i), q(n, k + dk, j + dj, i + di), ql,
+      unused);
+  PPM(q(n, k - 2 * dk, j - 2 * dj, i - 2 * di), q(n, k - dk, j - dj, i - di),
+      q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+      q(n, k + 2 * dk, j + 2 * dj, i + 2 * di), unused, qr);
+}
+
 #endif // RECONSTRUCT_PPM_SIMPLE_HPP_
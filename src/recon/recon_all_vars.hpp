@@ -0,0 +1,198 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "LICENSE").
+//========================================================================================
+#ifndef RECONSTRUCT_RECON_ALL_VARS_HPP_
+#define RECONSTRUCT_RECON_ALL_VARS_HPP_
+//! \file recon_all_vars.hpp
+//  \brief Reconstruction of all variables of a cell in a single inner iteration
+//
+// The Reconstruct() wrappers of the individual methods loop over the variables on the
+// outside and launch one inner loop (over i) per variable. Here, a single inner loop
+// over i reconstructs all variables of a cell (variables innermost) so that quantities
+// shared by all variables (e.g., the mesh spacing of WENO3 and LimO3) are only computed
+// once per cell and the stencils of all variables are loaded within the same iteration.
+// The states are identical to the ones of the Reconstruct() wrappers.
+
+#include <parthenon/parthenon.hpp>
+
+#include "../main.hpp"
+#include "dc_simple.hpp"
+#include "hybrid_simple.hpp"
+#include "limo3_simple.hpp"
+#include "plm_simple.hpp"
+#include "ppm_simple.hpp"
+#include "weno3_simple.hpp"
+#include "wenoz_simple.hpp"
+
+//! \fn ReconstructAllVars<Reconstruction recon, int DIR>()
+//  \brief Same interface (and loop limits) as the Reconstruct() wrappers
+//  In X1DIR call over [is-1,ie+1] to get BOTH L/R states over [is,ie]
+//  In X2DIR call over [js-1,je+1] to get BOTH L/R states over [js,je]
+//  In X3DIR call over [ks-1,ke+1] to get BOTH L/R states over [ks,ke]
+//  The input q is either a VariablePack or a PencilWindow (see below).
+//  The hybrid reconstructions always reconstruct all variables of a cell at once (see
+//  ReconstructHybrid()).
+template <Reconstruction recon, int XNDIR, typename Pack, typename T>
+KOKKOS_INLINE_FUNCTION void
+ReconstructAllVars(parthenon::team_mbr_t const &member, const int k, const int j,
+                   const int il, const int iu, const Pack &q, ScratchPad2D<T> &ql,
+                   ScratchPad2D<T> &qr, const HybridReconstruction &hybrid) {
+  if constexpr (IsHybridReconstruction(recon)) {
+    ReconstructHybrid<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, hybrid);
+    return;
+  }
+  constexpr int di = XNDIR == parthenon::X1DIR ? 1 : 0;
+  constexpr int dj = XNDIR == parthenon::X2DIR ? 1 : 0;
+  constexpr int dk = XNDIR == parthenon::X3DIR ? 1 : 0;
+  // in x1dir ql is ql_ip1, otherwise the offset has been set outside in the cached
+  // stencil (see Reconstruct())
+  constexpr int dl = di;
+  const auto nvar = q.GetDim(4);
+  parthenon::par_for_inner(member, il, iu, [&](const int i) {
+    // mesh spacing shared by all variables
+    Real dx = 0.0;
+    if constexpr (recon == Reconstruction::weno3 || recon == Reconstruction::limo3) {
+      dx = q.GetCoords().template Dxc<XNDIR>(k, j, i);
+    }
+    const Real dx2 = dx * dx;
+    for (auto n = 0; n < nvar; ++n) {
+      if constexpr (recon == Reconstruction::dc) {
+        ql(n, i + dl) = qr(n, i) = q(n, k, j, i);
+      } else if constexpr (recon == Reconstruction::plm) {
+        PLM(q(n, k - dk, j - dj, i - di), q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+            ql(n, i + dl), qr(n, i));
+      } else if constexpr (recon == Reconstruction::ppm) {
+        PPM(q(n, k - 2 * dk, j - 2 * dj, i - 2 * di), q(n, k - dk, j - dj, i - di),
+            q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+            q(n, k + 2 * dk, j + 2 * dj, i + 2 * di), ql(n, i + dl), qr(n, i));
+      } else if constexpr (recon == Reconstruction::weno3) {
+        WENO3(q(n, k - dk, j - dj, i - di), q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+              ql(n, i + dl), qr(n, i), dx2);
+      } else if constexpr (recon == Reconstruction::limo3) {
+        // Note, this may be unsafe as we implicitly assume how this function is called
+        // with respect to the entries in the single state vector containing all
+        // components
+        const bool ensure_positivity = (n == IDN || n == IPR);
+        LimO3(q(n, k - dk, j - dj, i - di), q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+              ql(n, i + dl), qr(n, i), dx, ensure_positivity);
+      } else if constexpr (recon == Reconstruction::wenoz) {
+        WENOZ(q(n, k - 2 * dk, j - 2 * dj, i - 2 * di), q(n, k - dk, j - dj, i - di),
+              q(n, k, j, i), q(n, k + dk, j + dj, i + di),
+              q(n, k + 2 * dk, j + 2 * dj, i + 2 * di), ql(n, i + dl), qr(n, i));
+      } else {
+        PARTHENON_FAIL("Unknown reconstruction method.")
+      }
+    }
+  });
+}
+
+// Number of neighboring cells (on each side) in the stencil of a reconstruction method
+constexpr int ReconstructionStencilHalfWidth(const Reconstruction recon) {
+  if (recon == Reconstruction::dc) {
+    return 0;
+  }
+  if (recon == Reconstruction::ppm || recon == Reconstruction::wenoz ||
+      IsHybridReconstruction(recon)) {
+    return 2;
+  }
+  return 1;
+}
+
+//! \struct PencilWindow
+//  \brief Rolling window of input pencils (all variables) cached in scratch memory
+//  Used for the reconstruction in the x2 (x3) direction where the team sweeps over j (k)
+//  so that each pencil is only loaded once from device memory instead of once per
+//  stencil it is part of. Pencil l (j in X2DIR and k in X3DIR) is stored in slot
+//  (l - start) % width so that loading pencil l overwrites pencil l - width.
+//  Provides the (n, k, j, i) access of the cached pencils as well as the dimensions and
+//  coordinates of the underlying VariablePack.
+template <int XNDIR>
+struct PencilWindow {
+  static_assert(XNDIR == parthenon::X2DIR || XNDIR == parthenon::X3DIR,
+                "Pencil windows are only used for transverse sweeps.");
+  using ScratchPad3D = parthenon::ScratchPad3D<Real>;
+
+  KOKKOS_INLINE_FUNCTION
+  PencilWindow(const parthenon::team_mbr_t::scratch_memory_space &scratch_space,
+               const parthenon::VariablePack<Real> &q, const int start, const int width,
+               const int nx1)
+      : q_(q), start_(start), width_(width),
+        data_(scratch_space, width, q.GetDim(4), nx1) {}
+
+  static size_t shmem_size(const int width, const int nvar, const int nx1) {
+    return ScratchPad3D::shmem_size(width, nvar, nx1);
+  }
+
+  // Loads pencil k, j (for i in [il, iu]) into the window. Requires a barrier before
+  // (if the overwritten pencil is still used) and after (before the pencil is used).
+  KOKKOS_INLINE_FUNCTION
+  void Load(parthenon::team_mbr_t const &member, const int k, const int j, const int il,
+            const int iu) const {
+    const int slot = Slot(XNDIR == parthenon::X2DIR ? j : k);
+    const int nvar = q_.GetDim(4);
+    parthenon::par_for_inner(member, il, iu, [&](const int i) {
+      for (auto n = 0; n < nvar; ++n) {
+        data_(slot, n, i) = q_(n, k, j, i);
+      }
+    });
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  Real &operator()(const int n, const int k, const int j, const int i) const {
+    return data_(Slot(XNDIR == parthenon::X2DIR ? j : k), n, i);
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  auto GetDim(const int i) const { return q_.GetDim(i); }
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  decltype(auto) GetCoords() const { return q_.GetCoords(); }
+
+ private:
+  KOKKOS_FORCEINLINE_FUNCTION
+  int Slot(const int l) const { return (l - start_) % width_; }
+
+  const parthenon::VariablePack<Real> &q_;
+  int start_, width_;
+  ScratchPad3D data_;
+};
+
+//! \fn ReconstructPencil<Reconstruction recon, int DIR>()
+//  \brief Reconstructs a pencil either per variable (Reconstruct()) or with all
+//  variables in a single inner loop (ReconstructAllVars()), see
+//  `hydro/reconstruct_all_vars`.
+template <Reconstruction recon, int XNDIR, typename T>
+KOKKOS_INLINE_FUNCTION void
+ReconstructPencil(parthenon::team_mbr_t const &member, const bool all_vars, const int k,
+                  const int j, const int il, const int iu,
+                  const parthenon::VariablePack<Real> &q, ScratchPad2D<T> &ql,
+                  ScratchPad2D<T> &qr, const HybridReconstruction &hybrid) {
+  if constexpr (IsHybridReconstruction(recon)) {
+    ReconstructHybrid<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, hybrid);
+  } else if (all_vars) {
+    ReconstructAllVars<recon, XNDIR>(member, k, j, il, iu, q, ql, qr, hybrid);
+  } else {
+    Reconstruct<recon, XNDIR>(member, k, j, il, iu, q, ql, qr);
+  }
+}
+
+//! \fn ReconstructInterface<Reconstruction recon, int DIR>()
+//  \brief Pointwise reconstruction of variable n at the interface between cell i-1 and i
+//  (used in the tight flux kernel), see the pointwise Reconstruct() wrappers.
+//  `iface` contains the methods of the hybrid reconstructions (see
+//  MakeHybridInterface()), which are shared by all variables of the interface.
+template <Reconstruction recon, int XNDIR>
+KOKKOS_INLINE_FUNCTION void
+ReconstructInterface(const int n, const int k, const int j, const int i,
+                     const parthenon::VariablePack<Real> &q, Real &ql, Real &qr,
+                     const HybridInterface &iface) {
+  if constexpr (IsHybridReconstruction(recon)) {
+    ReconstructHybrid<recon, XNDIR>(n, k, j, i, q, ql, qr, iface);
+  } else {
+    Reconstruct<recon, XNDIR>(n, k, j, i, q, ql, qr);
+  }
+}
+
+#endif // RECONSTRUCT_RECON_ALL_VARS_HPP_
@@ -4,6 +4,10 @@
 // reserved. Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+// C++ headers
+#include <string>
+#include <vector>
+
 // AthenaPK headers
 #include "../main.hpp"
 #include "refinement.hpp"
@@ -12,83 +16,73 @@ namespace refinement {
 namespace gradient {
 
 using parthenon::IndexDomain;
-using parthenon::IndexRange;
 
 // refinement condition: check the maximum pressure gradient
-AmrTag PressureGradient(MeshBlockData<Real> *rc) {
-  auto pmb = rc->GetBlockPointer();
-  auto w = rc->Get("prim").data;
+void PressureGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto ndim = pmb->pmy_mesh->ndim;
+  if (ndim < 2) {
+    // no refinement criterion in 1D, i.e., keep the current refinement level
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "check refine: pressure gradient 1D",
+        parthenon::DevExecSpace(), 0, md->NumBlocks() - 1, KOKKOS_LAMBDA(const int b) {
+          if (amr_tags(b) < AmrTag::same) amr_tags(b) = AmrTag::same;
+        });
+    return;
+  }
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
 
-  const auto threshold =
-      pmb->packages.Get("Hydro")->Param<Real>("refinement/threshold_pressure_gradient");
+  auto hydro_pkg = pmb->packages.Get("Hydro");
+  const auto threshold = hydro_pkg->Param<Real>("refinement/threshold_pressure_gradient");
+  const auto threshold_deref =
+      hydro_pkg->Param<Real>("refinement/threshold_pressure_gradient_deref");
 
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-
-  Real maxeps = 0.0;
-  if (pmb->pmy_mesh->ndim == 3) {
-
-    pmb->par_reduce(
-        "check refine: pressure gradient", kb.s - 1, kb.e + 1, jb.s - 1, jb.e + 1,
-        ib.s - 1, ib.e + 1,
-        KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lmaxeps) {
-          Real eps = std::sqrt(SQR(0.5 * (w(IPR, k, j, i + 1) - w(IPR, k, j, i - 1))) +
-                               SQR(0.5 * (w(IPR, k, j + 1, i) - w(IPR, k, j - 1, i))) +
-                               SQR(0.5 * (w(IPR, k + 1, j, i) - w(IPR, k - 1, j, i)))) /
-                     w(IPR, k, j, i);
-          lmaxeps = std::max(lmaxeps, eps);
-        },
-        Kokkos::Max<Real>(maxeps));
-  } else if (pmb->pmy_mesh->ndim == 2) {
-    int k = kb.s;
-    pmb->par_reduce(
-        "check refine: pressure gradient", jb.s - 1, jb.e + 1, ib.s - 1, ib.e + 1,
-        KOKKOS_LAMBDA(const int j, const int i, Real &lmaxeps) {
-          Real eps = std::sqrt(SQR(0.5 * (w(IPR, k, j, i + 1) - w(IPR, k, j, i - 1))) +
-                               SQR(0.5 * (w(IPR, k, j + 1, i) - w(IPR, k, j - 1, i)))) /
-                     w(IPR, k, j, i);
-          lmaxeps = std::max(lmaxeps, eps);
-        },
-        Kokkos::Max<Real>(maxeps));
-  } else {
-    return AmrTag::same;
+  if (ndim == 3) {
+    kb = IndexRange{kb.s - 1, kb.e + 1};
   }
 
-  if (maxeps > threshold) return AmrTag::refine;
-  if (maxeps < 0.25 * threshold) return AmrTag::derefine;
-  return AmrTag::same;
+  TagMaxCriterion(
+      md, amr_tags, "check refine: pressure gradient", kb, IndexRange{jb.s - 1, jb.e + 1},
+      IndexRange{ib.s - 1, ib.e + 1}, threshold, threshold_deref,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &w = prim_pack(b);
+        Real eps_sqr = SQR(0.5 * (w(IPR, k, j, i + 1) - w(IPR, k, j, i - 1))) +
+                       SQR(0.5 * (w(IPR, k, j + 1, i) - w(IPR, k, j - 1, i)));
+        if (ndim == 3) {
+          eps_sqr += SQR(0.5 * (w(IPR, k + 1, j, i) - w(IPR, k - 1, j, i)));
+        }
+        return std::sqrt(eps_sqr) / w(IPR, k, j, i);
+      });
 }
 
 // refinement condition: check the maximum 2D velocity gradient
-AmrTag VelocityGradient(MeshBlockData<Real> *rc) {
-  auto pmb = rc->GetBlockPointer();
-  auto w = rc->Get("prim").data;
+void VelocityGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
 
+  auto hydro_pkg = pmb->packages.Get("Hydro");
   const auto threshold =
-      pmb->packages.Get("Hydro")->Param<Real>("refinement/threshold_xyvelocity_gradient");
+      hydro_pkg->Param<Real>("refinement/threshold_xyvelocity_gradient");
+  const auto threshold_deref =
+      hydro_pkg->Param<Real>("refinement/threshold_xyvelocity_gradient_deref");
 
   IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  Real vgmax = 0.0;
-
-  pmb->par_reduce(
-      "check refine: velocity gradient", kb.s, kb.e, jb.s - 1, jb.e + 1, ib.s - 1,
-      ib.e + 1,
-      KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lvgmax) {
+  TagMaxCriterion(
+      md, amr_tags, "check refine: velocity gradient", kb, IndexRange{jb.s - 1, jb.e + 1},
+      IndexRange{ib.s - 1, ib.e + 1}, threshold, threshold_deref,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+        const auto &w = prim_pack(b);
         Real vgy = std::abs(w(IV2, k, j, i + 1) - w(IV2, k, j, i - 1)) * 0.5;
         Real vgx = std::abs(w(IV1, k, j + 1, i) - w(IV1, k, j - 1, i)) * 0.5;
-        Real vg = std::sqrt(vgx * vgx + vgy * vgy);
-        if (vg > lvgmax) lvgmax = vg;
-      },
-      Kokkos::Max<Real>(vgmax));
-
-  if (vgmax > threshold) return AmrTag::refine;
-  if (vgmax < 0.5 * threshold) return AmrTag::derefine;
-  return AmrTag::same;
+        return std::sqrt(vgx * vgx + vgy * vgy);
+      });
 }
 
 } // namespace gradient
-} // namespace refinement
\ No newline at end of file
+} // namespace refinement
@@ -4,6 +4,10 @@
 // reserved. Licensed under the BSD 3-Clause License (the "LICENSE").
 //========================================================================================
 
+// C++ headers
+#include <string>
+#include <vector>
+
 // AthenaPK headers
 #include "../main.hpp"
 #include "refinement.hpp"
@@ -12,12 +16,11 @@ namespace refinement {
 namespace other {
 
 using parthenon::IndexDomain;
-using parthenon::IndexRange;
 
 // refinement condition: check max density
-parthenon::AmrTag MaxDensity(MeshBlockData<Real> *rc) {
-  auto pmb = rc->GetBlockPointer();
-  auto w = rc->Get("prim").data;
+void MaxDensity(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags) {
+  auto pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
   const auto deref_below =
       pmb->packages.Get("Hydro")->Param<Real>("refinement/maxdensity_deref_below");
   const auto refine_above =
@@ -27,18 +30,12 @@ parthenon::AmrTag MaxDensity(MeshBlockData<Real> *rc) {
   IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
   IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
 
-  Real maxrho = 0.0;
-  pmb->par_reduce(
-      "overdens check refinement", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e + 1,
-      KOKKOS_LAMBDA(const int k, const int j, const int i, Real &lmaxrho) {
-        lmaxrho = std::max(lmaxrho, w(IDN, k, j, i));
-      },
-      Kokkos::Max<Real>(maxrho));
-
-  if (maxrho > refine_above) return parthenon::AmrTag::refine;
-  if (maxrho < deref_below) return parthenon::AmrTag::derefine;
-  return parthenon::AmrTag::same;
+  TagMaxCriterion(md, amr_tags, "overdens check refinement", kb, jb,
+                  IndexRange{ib.s, ib.e + 1}, refine_above, deref_below,
+                  KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+                    return prim_pack(b, IDN, k, j, i);
+                  });
 }
 
 } // namespace other
-} // namespace refinement
\ No newline at end of file
+} // namespace refinement
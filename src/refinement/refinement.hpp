@@ -5,21 +5,66 @@
 #ifndef REFINEMENT_HPP_
 #define REFINEMENT_HPP_
 
+// C++ headers
+#include <string>
+
 // Parthenon headers
 #include <parthenon/parthenon.hpp>
 
 namespace refinement {
 
 using parthenon::AmrTag;
+using parthenon::IndexRange;
 using parthenon::MeshBlockData;
+using parthenon::MeshData;
+using parthenon::ParArray1D;
 using parthenon::Real;
 
+// All criteria tag all blocks of a MeshData partition at once (with a single kernel) and
+// combine the tag with the existing tag of a block (i.e., refinement takes precedence).
 namespace gradient {
-AmrTag PressureGradient(MeshBlockData<Real> *rc);
-AmrTag VelocityGradient(MeshBlockData<Real> *rc);
+void PressureGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
+void VelocityGradient(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
 } // namespace gradient
 namespace other {
-parthenon::AmrTag MaxDensity(MeshBlockData<Real> *rc);
+void MaxDensity(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags);
+}
+
+// Calculates the maximum of `func(b, k, j, i)` over the given index ranges separately
+// for each block b of the partition using one team per block. A block is tagged for
+// refinement if the maximum is above `refine_above` and for derefinement if it is below
+// `deref_below`.
+template <typename F>
+void TagMaxCriterion(MeshData<Real> *md, ParArray1D<AmrTag> &amr_tags,
+                     const std::string &name, const IndexRange &kb, const IndexRange &jb,
+                     const IndexRange &ib, const Real refine_above,
+                     const Real deref_below, const F &func) {
+  const int nk = kb.e - kb.s + 1;
+  const int nj = jb.e - jb.s + 1;
+  const int ni = ib.e - ib.s + 1;
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, name, parthenon::DevExecSpace(), 0, 0, 0,
+      md->NumBlocks() - 1, KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b) {
+        Real maxval = 0.0;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange<>(member, nk * nj * ni),
+            [&](const int idx, Real &lmaxval) {
+              const int k = kb.s + idx / (nj * ni);
+              const int j = jb.s + (idx / ni) % nj;
+              const int i = ib.s + idx % ni;
+              lmaxval = Kokkos::fmax(lmaxval, func(b, k, j, i));
+            },
+            Kokkos::Max<Real>(maxval));
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          auto tag = AmrTag::same;
+          if (maxval > refine_above) {
+            tag = AmrTag::refine;
+          } else if (maxval < deref_below) {
+            tag = AmrTag::derefine;
+          }
+          if (tag > amr_tags(b)) amr_tags(b) = tag;
+        });
+      });
 }
 
 } // namespace refinement
@@ -0,0 +1,352 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file async_output.cpp
+//  \brief Snapshots of selected fields that are written by a background thread
+
+// C++ headers
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "async_output.hpp"
+#include "utils/error_checking.hpp"
+
+namespace utils {
+using parthenon::IndexDomain;
+using parthenon::IndexRange;
+
+namespace {
+// Comma separated list (ignoring whitespace and empty entries)
+std::vector<std::string> SplitList(const std::string &list) {
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+} // namespace
+
+AsyncOutput::AsyncOutput(parthenon::ParameterInput *pin) {
+  const std::string block = "async_output";
+  dt_ = pin->GetOrAddReal(block, "dt", -1.0);
+  enabled_ = dt_ > 0.0;
+  // Stored in the input so that the cadence is continued after restarts
+  next_time_ = pin->GetOrAddReal(block, "next_time", 0.0);
+  file_number_ = pin->GetOrAddInteger(block, "file_number", 0);
+  basename_ = pin->GetOrAddString(block, "basename", "snapshot");
+  const auto max_staged_mb = pin->GetOrAddReal(block, "max_staged_mb", 1024.0);
+  max_staged_bytes_ = static_cast<std::size_t>(std::max(max_staged_mb, 0.0) * (1 << 20));
+
+  variables_ = SplitList(pin->GetOrAddString(block, "variables", "prim"));
+  float_variables_ = SplitList(pin->GetOrAddString(block, "float_variables", ""));
+  if (!enabled_) {
+    return;
+  }
+  PARTHENON_REQUIRE_THROWS(!variables_.empty() || !float_variables_.empty(),
+                           "async_output/variables and float_variables are empty.");
+  for (const auto &var : float_variables_) {
+    PARTHENON_REQUIRE_THROWS(
+        std::find(variables_.begin(), variables_.end(), var) == variables_.end(),
+        "Field " + var + " in both async_output/variables and float_variables.");
+  }
+  PARTHENON_REQUIRE_THROWS(max_staged_bytes_ > 0, "async_output/max_staged_mb <= 0.");
+  writer_ = std::thread(&AsyncOutput::WriterLoop, this);
+}
+
+AsyncOutput::~AsyncOutput() {
+  if (writer_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    writer_.join();
+  }
+}
+
+void AsyncOutput::SnapshotIfDue(
+    parthenon::Mesh *pmesh, parthenon::ParameterInput *pin, const parthenon::SimTime &tm,
+    const std::function<void(parthenon::MeshBlock *, parthenon::ParameterInput *)>
+        &user_work_before_output) {
+  if (!enabled_ || tm.time < next_time_) {
+    return;
+  }
+  if (user_work_before_output) {
+    for (auto &pmb : pmesh->block_list) {
+      user_work_before_output(pmb.get(), pin);
+    }
+  }
+
+  const auto num_values = NumValues(pmesh, variables_);
+  const auto num_float_values = NumValues(pmesh, float_variables_);
+
+  const auto start = std::chrono::steady_clock::now();
+  const int n = AcquireSlot(num_values, num_float_values);
+  const std::chrono::duration<Real> wait_time = std::chrono::steady_clock::now() - start;
+  if (parthenon::Globals::my_rank == 0 && wait_time.count() > 1e-3) {
+    std::cout << "Async output: waited " << wait_time.count()
+              << " s (on rank 0) for the writer to free a staging buffer. Consider "
+                 "increasing async_output/max_staged_mb or dt."
+              << std::endl;
+  }
+  // Busy slots are neither moved (in memory) nor modified by the writer
+  auto &slot = slots_[n];
+  slot.num_values = num_values;
+  slot.num_float_values = num_float_values;
+  std::stringstream number;
+  number << std::setw(5) << std::setfill('0') << file_number_;
+  slot.filename = basename_ + "." + number.str() + ".rank" +
+                  std::to_string(parthenon::Globals::my_rank) + ".bin";
+  Stage(pmesh, tm, slot);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(n);
+  }
+  cv_.notify_all();
+
+  file_number_ += 1;
+  // Skip missed output times (e.g., for dt smaller than the timestep)
+  while (next_time_ <= tm.time) {
+    next_time_ += dt_;
+  }
+  pin->SetReal("async_output", "next_time", next_time_);
+  pin->SetInteger("async_output", "file_number", file_number_);
+}
+
+std::size_t AsyncOutput::NumValues(parthenon::Mesh *pmesh,
+                                   const std::vector<std::string> &variables) const {
+  if (variables.empty()) {
+    return 0;
+  }
+  std::size_t num_values = 0;
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto &pack = md->PackVariables(variables);
+    const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+    num_values += static_cast<std::size_t>(pack.GetDim(5)) * pack.GetDim(4) *
+                  (kb.e - kb.s + 1) * (jb.e - jb.s + 1) * (ib.e - ib.s + 1);
+  }
+  return num_values;
+}
+
+int AsyncOutput::AcquireSlot(const std::size_t num_values,
+                             const std::size_t num_float_values) {
+  const auto bytes = num_values * sizeof(Real) + num_float_values * sizeof(float);
+  PARTHENON_REQUIRE_THROWS(bytes <= max_staged_bytes_,
+                           "A single async output snapshot exceeds "
+                           "async_output/max_staged_mb.");
+  const auto allocate = [&](Slot &slot) {
+    // Release first so that the old and new buffers are not allocated at the same time
+    slot.buffer = StagingBuffer<Real>();
+    slot.buffer_float = StagingBuffer<float>();
+    slot.buffer = StagingBuffer<Real>(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "async output staging"),
+        num_values);
+    slot.buffer_float = StagingBuffer<float>(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "async output staging float"),
+        num_float_values);
+  };
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    std::size_t total = 0;
+    for (const auto &slot : slots_) {
+      total += slot.Bytes();
+    }
+    for (int n = 0; n < static_cast<int>(slots_.size()); n++) {
+      auto &slot = slots_[n];
+      if (slot.busy) {
+        continue;
+      }
+      if (slot.buffer.extent(0) >= num_values &&
+          slot.buffer_float.extent(0) >= num_float_values) {
+        slot.busy = true;
+        return n;
+      }
+      // Grow a free slot (if within the budget)
+      if (total - slot.Bytes() + bytes <= max_staged_bytes_) {
+        allocate(slot);
+        slot.busy = true;
+        return n;
+      }
+    }
+    if (total + bytes <= max_staged_bytes_) {
+      slots_.emplace_back();
+      allocate(slots_.back());
+      slots_.back().busy = true;
+      return static_cast<int>(slots_.size()) - 1;
+    }
+    // Back-pressure: wait for the writer to free a buffer
+    cv_.wait(lock);
+  }
+}
+
+void AsyncOutput::Stage(parthenon::Mesh *pmesh, const parthenon::SimTime &tm,
+                        Slot &slot) {
+  std::stringstream header;
+  header << std::setprecision(17);
+  header << "# AthenaPK snapshot\n";
+  header << "time " << tm.time << "\n";
+  header << "cycle " << tm.ncycle << "\n";
+  header << "rank " << parthenon::Globals::my_rank << " " << parthenon::Globals::nranks
+         << "\n";
+  header << "real_bytes " << sizeof(Real) << "\n";
+
+  auto &md = pmesh->mesh_data.GetOrAdd("base", 0);
+  for (const auto &[label, variables] :
+       {std::make_pair("variables", &variables_),
+        std::make_pair("float_variables", &float_variables_)}) {
+    header << label;
+    for (const auto &var : *variables) {
+      header << " " << var << ":"
+             << md->PackVariables(std::vector<std::string>{var}).GetDim(4);
+    }
+    header << "\n";
+  }
+  const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+  const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+  const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+  header << "nx " << ib.e - ib.s + 1 << " " << jb.e - jb.s + 1 << " " << kb.e - kb.s + 1
+         << "\n";
+
+  header << "num_blocks " << pmesh->block_list.size() << "\n";
+  // Same order as the blocks of the partitions
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &mdp = pmesh->mesh_data.GetOrAdd("base", p);
+    for (int b = 0; b < mdp->NumBlocks(); b++) {
+      auto pmb = mdp->GetBlockData(b)->GetBlockPointer();
+      const auto &bs = pmb->block_size;
+      header << "block " << pmb->gid << " " << pmb->loc.level << " " << bs.x1min << " "
+             << bs.x1max << " " << bs.x2min << " " << bs.x2max << " " << bs.x3min << " "
+             << bs.x3max << "\n";
+    }
+  }
+  header << "data\n";
+  slot.header = header.str();
+
+  StageFields(pmesh, variables_, gather_, slot.buffer);
+  StageFields(pmesh, float_variables_, gather_float_, slot.buffer_float);
+}
+
+template <typename T>
+void AsyncOutput::StageFields(parthenon::Mesh *pmesh,
+                              const std::vector<std::string> &variables,
+                              parthenon::ParArray1D<T> &gather_buffer,
+                              StagingBuffer<T> &buffer) {
+  if (variables.empty()) {
+    return;
+  }
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  std::size_t offset = 0;
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto &pack = md->PackVariables(variables);
+    const auto ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    const auto jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    const auto kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+    const int nb = pack.GetDim(5);
+    const int nv = pack.GetDim(4);
+    const int nk = kb.e - kb.s + 1;
+    const int nj = jb.e - jb.s + 1;
+    const int ni = ib.e - ib.s + 1;
+    const std::size_t n = static_cast<std::size_t>(nb) * nv * nk * nj * ni;
+    if (gather_buffer.extent(0) < n) {
+      gather_buffer = parthenon::ParArray1D<T>("async output gather", n);
+    }
+    auto gather = gather_buffer;
+    // Layout of each block: [variable][k][j][i]
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, "AsyncOutput::Gather", parthenon::DevExecSpace(), 0,
+        nb - 1, 0, nv - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int v, const int k, const int j, const int i) {
+          gather(i - ib.s + ni * (j - jb.s + nj * (k - kb.s + nk * (v + nv * b)))) =
+              static_cast<T>(pack(b, v, k, j, i));
+        });
+    Kokkos::deep_copy(Kokkos::subview(buffer, std::make_pair(offset, offset + n)),
+                      Kokkos::subview(gather, std::make_pair(std::size_t(0), n)));
+    offset += n;
+  }
+}
+
+void AsyncOutput::WriterLoop() {
+  while (true) {
+    std::string filename, header;
+    const Real *data = nullptr;
+    const float *data_float = nullptr;
+    std::size_t num_values = 0, num_float_values = 0;
+    int n = -1;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      n = queue_.front();
+      queue_.pop_front();
+      // Copied as slots_ may be reallocated while the file is written
+      const auto &slot = slots_[n];
+      filename = slot.filename;
+      header = slot.header;
+      data = slot.buffer.data();
+      num_values = slot.num_values;
+      data_float = slot.buffer_float.data();
+      num_float_values = slot.num_float_values;
+    }
+    std::ofstream os(filename, std::ios::binary);
+    os.write(header.data(), header.size());
+    os.write(reinterpret_cast<const char *>(data), num_values * sizeof(Real));
+    os.write(reinterpret_cast<const char *>(data_float),
+             num_float_values * sizeof(float));
+    if (!os) {
+      std::cerr << "Async output: failed to write " << filename << std::endl;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      slots_[n].busy = false;
+    }
+    cv_.notify_all();
+  }
+}
+
+void AsyncOutput::Finalize() {
+  if (!writer_.joinable()) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&]() {
+      return queue_.empty() && std::none_of(slots_.begin(), slots_.end(),
+                                            [](const Slot &s) { return s.busy; });
+    });
+    stop_ = true;
+  }
+  cv_.notify_all();
+  writer_.join();
+  slots_.clear();
+  gather_ = parthenon::ParArray1D<Real>();
+  gather_float_ = parthenon::ParArray1D<float>();
+}
+
+} // namespace utils
@@ -0,0 +1,117 @@
+#ifndef UTILS_ASYNC_OUTPUT_HPP_
+#define UTILS_ASYNC_OUTPUT_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file async_output.hpp
+//  \brief Snapshots of selected fields that are written by a background thread
+
+// C++ headers
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Parthenon headers
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+
+namespace utils {
+using parthenon::Real;
+
+// If enabled (async_output/dt > 0), the interior cells of the selected fields (in full
+// precision or, e.g., for derived fields only used for plotting, converted to float) are
+// copied to (pinned) host staging buffers every `dt` in simulation time and written
+// (one raw binary file per rank and snapshot, see docs/input.md for the format) by a
+// background thread while the time integration continues.
+// The total size of the staging buffers is limited by `max_staged_mb`. If the writer
+// falls behind and no buffer is available, the next snapshot waits for the writer
+// (back-pressure) and the time spent waiting is reported.
+// Only the device to host copy blocks the time integration. The writer thread does not
+// use Kokkos or MPI.
+class AsyncOutput {
+ public:
+  explicit AsyncOutput(parthenon::ParameterInput *pin);
+  ~AsyncOutput();
+  AsyncOutput(const AsyncOutput &) = delete;
+  AsyncOutput &operator=(const AsyncOutput &) = delete;
+
+  bool IsEnabled() const { return enabled_; }
+
+  // Stages a snapshot of the current state if due. To be called at the beginning of a
+  // cycle (when the primitive variables are up to date). The (optional)
+  // `user_work_before_output` is called for all blocks before the fields are copied,
+  // e.g., to fill derived fields.
+  void SnapshotIfDue(
+      parthenon::Mesh *pmesh, parthenon::ParameterInput *pin,
+      const parthenon::SimTime &tm,
+      const std::function<void(parthenon::MeshBlock *, parthenon::ParameterInput *)>
+          &user_work_before_output);
+
+  // Waits for all pending writes and releases the staging buffers (must be called
+  // before Kokkos is finalized).
+  void Finalize();
+
+ private:
+#if defined(KOKKOS_ENABLE_CUDA)
+  using StagingSpace = Kokkos::CudaHostPinnedSpace;
+#else
+  using StagingSpace = Kokkos::HostSpace;
+#endif
+  template <typename T>
+  using StagingBuffer = Kokkos::View<T *, StagingSpace>;
+  struct Slot {
+    // Fields in full precision and fields converted to float
+    StagingBuffer<Real> buffer;
+    StagingBuffer<float> buffer_float;
+    std::size_t num_values = 0, num_float_values = 0;
+    std::string filename, header;
+    bool busy = false;
+
+    std::size_t Bytes() const {
+      return buffer.extent(0) * sizeof(Real) + buffer_float.extent(0) * sizeof(float);
+    }
+  };
+
+  // Number of values of the interior cells of all local blocks of the given fields
+  std::size_t NumValues(parthenon::Mesh *pmesh,
+                        const std::vector<std::string> &variables) const;
+  // Returns the index of a free slot with at least the given number of values
+  // (allocating or growing slots within the budget), waiting for the writer if required.
+  int AcquireSlot(std::size_t num_values, std::size_t num_float_values);
+  void Stage(parthenon::Mesh *pmesh, const parthenon::SimTime &tm, Slot &slot);
+  // Copies the interior cells of the given fields of all local blocks to `buffer`
+  template <typename T>
+  void StageFields(parthenon::Mesh *pmesh, const std::vector<std::string> &variables,
+                   parthenon::ParArray1D<T> &gather_buffer, StagingBuffer<T> &buffer);
+  void WriterLoop();
+
+  bool enabled_;
+  Real dt_, next_time_;
+  int file_number_;
+  std::string basename_;
+  std::vector<std::string> variables_, float_variables_;
+  std::size_t max_staged_bytes_;
+
+  // Device buffers (reused) to gather the interior cells of a partition
+  parthenon::ParArray1D<Real> gather_;
+  parthenon::ParArray1D<float> gather_float_;
+
+  std::vector<Slot> slots_;
+  std::deque<int> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  std::thread writer_;
+};
+
+} // namespace utils
+
+#endif // UTILS_ASYNC_OUTPUT_HPP_
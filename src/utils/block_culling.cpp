@@ -0,0 +1,60 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file block_culling.cpp
+//  \brief Kernels restricted to the blocks intersecting a (small) sphere
+
+// C++ headers
+#include <array>
+#include <tuple>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+
+// AthenaPK headers
+#include "block_culling.hpp"
+
+namespace utils {
+
+Real BlockDistanceToPoint2(const parthenon::RegionSize &bs,
+                           const std::array<Real, 3> &center, const bool with_ghosts) {
+  const int ng = with_ghosts ? parthenon::Globals::nghost : 0;
+  Real dist2 = 0.0;
+  for (const auto &[xmin, xmax, nx, xc] :
+       {std::make_tuple(bs.x1min, bs.x1max, bs.nx1, center[0]),
+        std::make_tuple(bs.x2min, bs.x2max, bs.nx2, center[1]),
+        std::make_tuple(bs.x3min, bs.x3max, bs.nx3, center[2])}) {
+    // ghost zones only exist in active dimensions
+    const Real ghost_extent = (nx > 1) ? ng * (xmax - xmin) / nx : 0.0;
+    const Real lo = xmin - ghost_extent;
+    const Real hi = xmax + ghost_extent;
+    const Real d = (lo > xc) ? lo - xc : ((hi < xc) ? xc - hi : 0.0);
+    dist2 += d * d;
+  }
+  return dist2;
+}
+
+int BlocksInSphere(parthenon::MeshData<Real> *md, const std::array<Real, 3> &center,
+                   const Real radius, const bool with_ghosts,
+                   parthenon::ParArray1D<int> &block_idx) {
+  std::vector<int> idx;
+  for (int b = 0; b < md->NumBlocks(); b++) {
+    auto pmb = md->GetBlockData(b)->GetBlockPointer();
+    if (BlockDistanceToPoint2(pmb->block_size, center, with_ghosts) < SQR(radius)) {
+      idx.push_back(b);
+    }
+  }
+  const int num_blocks = static_cast<int>(idx.size());
+  block_idx = parthenon::ParArray1D<int>("blocks_in_sphere", num_blocks);
+  auto block_idx_host = block_idx.GetHostMirror();
+  for (int n = 0; n < num_blocks; n++) {
+    block_idx_host(n) = idx[n];
+  }
+  block_idx.DeepCopy(block_idx_host);
+  return num_blocks;
+}
+
+} // namespace utils
@@ -0,0 +1,67 @@
+#ifndef UTILS_BLOCK_CULLING_HPP_
+#define UTILS_BLOCK_CULLING_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file block_culling.hpp
+//  \brief Kernels restricted to the blocks intersecting a (small) sphere
+
+// C++ headers
+#include <array>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <basic_types.hpp>
+#include <interface/mesh_data.hpp>
+#include <kokkos_abstraction.hpp>
+#include <mesh/domain.hpp>
+#include <mesh/mesh.hpp>
+
+namespace utils {
+using parthenon::Real;
+
+// Squared distance of the point of the block (optionally including the ghost zones)
+// closest to `center`
+Real BlockDistanceToPoint2(const parthenon::RegionSize &bs,
+                           const std::array<Real, 3> &center, const bool with_ghosts);
+
+// Returns the number of blocks of the partition intersecting the sphere and sets
+// `block_idx` to the device array containing the indices of these blocks. The list is
+// built on the host on every call so that this is intended for spheres that move (e.g.,
+// point sources). See cluster::RegionOfInterest for a cached version for fixed spheres.
+int BlocksInSphere(parthenon::MeshData<Real> *md, const std::array<Real, 3> &center,
+                   const Real radius, const bool with_ghosts,
+                   parthenon::ParArray1D<int> &block_idx);
+
+// Calls function(b, k, j, i) for all cells (of `domain`) of the blocks of the partition
+// that intersect the sphere, e.g., for localized source terms acting on only a few
+// blocks. No kernel is launched if no block intersects the sphere.
+template <typename Function>
+void ParForBlocksInSphere(const std::string &name, parthenon::MeshData<Real> *md,
+                          const std::array<Real, 3> &center, const Real radius,
+                          const parthenon::IndexDomain domain, const Function &function) {
+  parthenon::ParArray1D<int> block_idx;
+  const int num_blocks =
+      BlocksInSphere(md, center, radius, domain != parthenon::IndexDomain::interior,
+                     block_idx);
+  if (num_blocks == 0) {
+    return;
+  }
+  parthenon::IndexRange ib = md->GetBlockData(0)->GetBoundsI(domain);
+  parthenon::IndexRange jb = md->GetBlockData(0)->GetBoundsJ(domain);
+  parthenon::IndexRange kb = md->GetBlockData(0)->GetBoundsK(domain);
+
+  parthenon::par_for(
+      DEFAULT_LOOP_PATTERN, name, parthenon::DevExecSpace(), 0, num_blocks - 1, kb.s,
+      kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int n, const int k, const int j, const int i) {
+        function(block_idx(n), k, j, i);
+      });
+}
+
+} // namespace utils
+
+#endif // UTILS_BLOCK_CULLING_HPP_
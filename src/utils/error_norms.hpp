@@ -0,0 +1,114 @@
+#ifndef UTILS_ERROR_NORMS_HPP_
+#define UTILS_ERROR_NORMS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file error_norms.hpp
+//  \brief Device reduction of the errors of the conserved variables to analytic solutions
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "global_reductions.hpp"
+
+namespace utils {
+using parthenon::Real;
+
+// L1 (weighted sum) and max norms of the error of the first N conserved variables.
+// Note that the join (+=) sums the L1 norms but takes the maximum of the max norms so
+// that both are reduced in a single kernel with a Kokkos::Sum reducer.
+template <int N>
+struct ErrorNorms {
+  Real l1[N];
+  Real max[N];
+  KOKKOS_INLINE_FUNCTION ErrorNorms() {
+    for (int n = 0; n < N; n++) {
+      l1[n] = 0.0;
+      max[n] = 0.0;
+    }
+  }
+  KOKKOS_INLINE_FUNCTION ErrorNorms &operator+=(const ErrorNorms &rhs) {
+    for (int n = 0; n < N; n++) {
+      l1[n] += rhs.l1[n];
+      max[n] = max[n] > rhs.max[n] ? max[n] : rhs.max[n];
+    }
+    return *this;
+  }
+};
+} // namespace utils
+
+namespace Kokkos {
+template <int N>
+struct reduction_identity<utils::ErrorNorms<N>> {
+  KOKKOS_FORCEINLINE_FUNCTION static utils::ErrorNorms<N> sum() {
+    return utils::ErrorNorms<N>();
+  }
+};
+} // namespace Kokkos
+
+namespace utils {
+
+// Global (over all blocks and ranks) error norms of the first N conserved variables of
+// the interior cells. `analytic(x1, x2, x3, sol)` is a device function (e.g., a
+// KOKKOS_LAMBDA capturing all parameters by value) that stores the analytic solution at
+// the cell center in sol[0, N). The L1 norm is weighted by the cell volume if
+// `volume_weighted` and otherwise is the plain sum of the errors. Collective.
+template <int N, typename Analytic>
+ErrorNorms<N> ReduceErrorNorms(parthenon::Mesh *pmesh, const Analytic &analytic,
+                               const bool volume_weighted = true) {
+  using parthenon::IndexDomain;
+  using parthenon::IndexRange;
+  ErrorNorms<N> norms;
+
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto &cons_pack = md->PackVariables(std::vector<std::string>{"cons"});
+    IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+
+    ErrorNorms<N> md_norms;
+    Kokkos::parallel_reduce(
+        "ReduceErrorNorms",
+        Kokkos::MDRangePolicy<Kokkos::Rank<4>>(
+            parthenon::DevExecSpace(), {0, kb.s, jb.s, ib.s},
+            {cons_pack.GetDim(5), kb.e + 1, jb.e + 1, ib.e + 1},
+            {1, 1, 1, ib.e + 1 - ib.s}),
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                      ErrorNorms<N> &lnorms) {
+          const auto &coords = cons_pack.GetCoords(b);
+          const Real weight = volume_weighted ? coords.CellVolume(k, j, i) : 1.0;
+          Real sol[N];
+          analytic(coords.Xc<1>(i), coords.Xc<2>(j), coords.Xc<3>(k), sol);
+          for (int n = 0; n < N; n++) {
+            const Real err = std::abs(sol[n] - cons_pack(b, n, k, j, i));
+            lnorms.l1[n] += err * weight;
+            lnorms.max[n] = lnorms.max[n] > err ? lnorms.max[n] : err;
+          }
+        },
+        Kokkos::Sum<ErrorNorms<N>>(md_norms));
+    norms += md_norms;
+  }
+
+  // Single collective for both norms
+  std::vector<Real> l1(norms.l1, norms.l1 + N), mins, max(norms.max, norms.max + N);
+  AllReduceCombined(l1, mins, max);
+  std::copy(l1.begin(), l1.end(), norms.l1);
+  std::copy(max.begin(), max.end(), norms.max);
+  return norms;
+}
+
+} // namespace utils
+
+#endif // UTILS_ERROR_NORMS_HPP_
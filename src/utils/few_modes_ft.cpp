@@ -29,6 +29,31 @@ using Complex = Kokkos::complex<parthenon::Real>;
 using parthenon::IndexRange;
 using parthenon::Metadata;
 
+namespace {
+// Counter based Philox4x32-10 generator (Salmon et al. 2011). Only uses integer
+// arithmetic so that results are bitwise identical on all devices.
+KOKKOS_INLINE_FUNCTION void Philox4x32(uint32_t ctr[4], uint32_t key0, uint32_t key1) {
+  for (int round = 0; round < 10; round++) {
+    const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * ctr[0];
+    const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * ctr[2];
+    const uint32_t c0 = static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key0;
+    const uint32_t c2 = static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key1;
+    ctr[0] = c0;
+    ctr[1] = static_cast<uint32_t>(p1);
+    ctr[2] = c2;
+    ctr[3] = static_cast<uint32_t>(p0);
+    key0 += 0x9E3779B9u;
+    key1 += 0xBB67AE85u;
+  }
+}
+
+// Uniform random number in [-1, 1) from 53 random bits
+KOKKOS_INLINE_FUNCTION Real ToUniform(const uint32_t hi, const uint32_t lo) {
+  const uint64_t bits = (static_cast<uint64_t>(hi) << 21) ^ (lo >> 11);
+  return 2.0 * static_cast<Real>(bits) * (1.0 / 9007199254740992.0) - 1.0;
+}
+} // namespace
+
 FewModesFT::FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg,
                        std::string prefix, int num_modes, ParArray2D<Real> k_vec,
                        Real k_peak, Real sol_weight, Real t_corr, uint32_t rseed,
@@ -55,6 +80,24 @@ FewModesFT::FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescripto
     PARTHENON_REQUIRE(std::abs(k_vec_host(2, i)) <= gnx3 / 2, "k_vec x3 mode too large");
   }
 
+  // The mode set is fixed so the (last) earlier mode with negated ky and kz that is
+  // used to enforce the symmetry of the complex to real transform for kx == 0 modes is
+  // precomputed (-1 if there is none).
+  conj_partner_ = parthenon::ParArray1D<int>(prefix + "_conj_partner", num_modes);
+  auto conj_partner_host = conj_partner_.GetHostMirror();
+  for (int m = 0; m < num_modes; m++) {
+    conj_partner_host(m) = -1;
+    if (k_vec_host(0, m) == 0.) {
+      for (int m2 = 0; m2 < m; m2++) {
+        if (k_vec_host(1, m) == -k_vec_host(1, m2) &&
+            k_vec_host(2, m) == -k_vec_host(2, m2)) {
+          conj_partner_host(m) = m2;
+        }
+      }
+    }
+  }
+  conj_partner_.DeepCopy(conj_partner_host);
+
   const auto nx1 = pin->GetInteger("parthenon/meshblock", "nx1");
   const auto nx2 = pin->GetInteger("parthenon/meshblock", "nx2");
   const auto nx3 = pin->GetInteger("parthenon/meshblock", "nx3");
@@ -85,6 +128,16 @@ FewModesFT::FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescripto
 
   rng_.seed(rseed);
   dist_ = std::uniform_real_distribution<>(-1.0, 1.0);
+
+  // Counter based random numbers generated on the device (without synchronization with
+  // the host) keyed by the seed, the number of calls to Generate(), and the mode.
+  device_rng_ = pin->GetOrAddBoolean("few_modes_ft", "device_rng", false);
+  rseed_ = rseed;
+  rng_counter_ = 0;
+
+  // Team based inverse transform (see Generate()), which results in identical fields up
+  // to roundoff.
+  team_inverse_ft_ = pin->GetOrAddBoolean("few_modes_ft", "team_inverse_ft", false);
 }
 
 void FewModesFT::SetPhases(MeshBlock *pmb, ParameterInput *pin) {
@@ -203,21 +256,44 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   Complex I(0.0, 1.0);
   auto &random_num = random_num_;
 
-  // get a set of random numbers from the CPU so that they are deterministic
-  // when run on GPUs
-  Real v1, v2, v_sqr;
-  for (int n = 0; n < 3; n++)
-    for (int m = 0; m < num_modes; m++) {
-      do {
-        v1 = dist_(rng_);
-        v2 = dist_(rng_);
-        v_sqr = v1 * v1 + v2 * v2;
-      } while (v_sqr >= 1.0 || v_sqr == 0.0);
-
-      random_num_host_(n, m, 0) = v1;
-      random_num_host_(n, m, 1) = v2;
-    }
-  Kokkos::deep_copy(random_num, random_num_host_);
+  if (device_rng_) {
+    const auto key0 = rseed_;
+    const uint64_t counter = rng_counter_++;
+    pmb->par_for(
+        "FMFT: random numbers", 0, 2, 0, num_modes - 1,
+        KOKKOS_LAMBDA(const int n, const int m) {
+          // Same rejection sampling as on the host (with the attempt as counter)
+          Real v1, v2, v_sqr;
+          uint32_t attempt = 0;
+          do {
+            uint32_t ctr[4] = {attempt++, static_cast<uint32_t>(n * num_modes + m),
+                               static_cast<uint32_t>(counter),
+                               static_cast<uint32_t>(counter >> 32)};
+            Philox4x32(ctr, key0, 0x5EED5EEDu);
+            v1 = ToUniform(ctr[0], ctr[1]);
+            v2 = ToUniform(ctr[2], ctr[3]);
+            v_sqr = v1 * v1 + v2 * v2;
+          } while (v_sqr >= 1.0 || v_sqr == 0.0);
+          random_num(n, m, 0) = v1;
+          random_num(n, m, 1) = v2;
+        });
+  } else {
+    // get a set of random numbers from the CPU so that they are deterministic
+    // when run on GPUs
+    Real v1, v2, v_sqr;
+    for (int n = 0; n < 3; n++)
+      for (int m = 0; m < num_modes; m++) {
+        do {
+          v1 = dist_(rng_);
+          v2 = dist_(rng_);
+          v_sqr = v1 * v1 + v2 * v2;
+        } while (v_sqr >= 1.0 || v_sqr == 0.0);
+
+        random_num_host_(n, m, 0) = v1;
+        random_num_host_(n, m, 1) = v2;
+      }
+    Kokkos::deep_copy(random_num, random_num_host_);
+  }
 
   // make local ref to capure in lambda
   auto &k_vec = k_vec_;
@@ -250,15 +326,14 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
       });
 
   // enforce symmetry of complex to real transform
+  auto &conj_partner = conj_partner_;
   pmb->par_for(
       "forcing: enforce symmetry", 0, 2, 0, num_modes - 1,
       KOKKOS_LAMBDA(const int n, const int m) {
-        if (k_vec(0, m) == 0.) {
-          for (int m2 = 0; m2 < m; m2++) {
-            if (k_vec(1, m) == -k_vec(1, m2) && k_vec(2, m) == -k_vec(2, m2))
-              var_hat_new(n, m) =
-                  Complex(var_hat_new(n, m2).real(), -var_hat_new(n, m2).imag());
-          }
+        const auto m2 = conj_partner(m);
+        if (m2 >= 0) {
+          var_hat_new(n, m) =
+              Complex(var_hat_new(n, m2).real(), -var_hat_new(n, m2).imag());
         }
       });
 
@@ -327,6 +402,57 @@ void FewModesFT::Generate(MeshData<Real> *md, const Real dt,
   auto phases_k = md->PackVariables(std::vector<std::string>{prefix_ + "_phases_k"});
 
   // implictly assuming cubic box of size L=1
+  if (team_inverse_ft_) {
+    // Each team works on an i-pencil. The spectrum and the j- and k-phase products
+    // (which are identical for all cells in the pencil) are staged in scratch memory
+    // and all three components are calculated together.
+    constexpr int nscratch = 8; // (phase_j * phase_k, var_hat(0..2)) x (real, imag)
+    const int scratch_level = 0;
+    const size_t scratch_size_in_bytes =
+        parthenon::ScratchPad1D<Real>::shmem_size(nscratch * num_modes);
+    parthenon::par_for_outer(
+        DEFAULT_OUTER_LOOP_PATTERN, "FMFT: Inverse FT (team)", parthenon::DevExecSpace(),
+        scratch_size_in_bytes, scratch_level, 0, md->NumBlocks() - 1, kb.s, kb.e, jb.s,
+        jb.e,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int k,
+                      const int j) {
+          parthenon::ScratchPad1D<Real> scr(member.team_scratch(scratch_level),
+                                            nscratch * num_modes);
+          parthenon::par_for_inner(member, 0, num_modes - 1, [&](const int m) {
+            const Complex phase_j(phases_j(b, 0, j - jb.s, m, 0),
+                                  phases_j(b, 0, j - jb.s, m, 1));
+            const Complex phase_k(phases_k(b, 0, k - kb.s, m, 0),
+                                  phases_k(b, 0, k - kb.s, m, 1));
+            const Complex phase_jk = phase_j * phase_k;
+            scr(nscratch * m) = phase_jk.real();
+            scr(nscratch * m + 1) = phase_jk.imag();
+            for (int n = 0; n < 3; n++) {
+              scr(nscratch * m + 2 + 2 * n) = var_hat(n, m).real();
+              scr(nscratch * m + 3 + 2 * n) = var_hat(n, m).imag();
+            }
+          });
+          member.team_barrier();
+
+          parthenon::par_for_inner(member, ib.s, ib.e, [&](const int i) {
+            Real var[3] = {0.0, 0.0, 0.0};
+            for (int m = 0; m < num_modes; m++) {
+              const Complex phase_i(phases_i(b, 0, i - ib.s, m, 0),
+                                    phases_i(b, 0, i - ib.s, m, 1));
+              const Complex phase =
+                  phase_i * Complex(scr(nscratch * m), scr(nscratch * m + 1));
+              for (int n = 0; n < 3; n++) {
+                var[n] += 2. * (scr(nscratch * m + 2 + 2 * n) * phase.real() -
+                                scr(nscratch * m + 3 + 2 * n) * phase.imag());
+              }
+            }
+            for (int n = 0; n < 3; n++) {
+              var_pack(b, n, k, j, i) = var[n];
+            }
+          });
+        });
+    return;
+  }
+
   parthenon::par_for(
       DEFAULT_LOOP_PATTERN, "FMFT: Inverse FT", parthenon::DevExecSpace(), 0,
       md->NumBlocks() - 1, 0, 2, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
@@ -32,6 +32,7 @@ class FewModesFT {
   std::string prefix_;
   ParArray2D<Complex> var_hat_, var_hat_new_;
   ParArray2D<Real> k_vec_;
+  parthenon::ParArray1D<int> conj_partner_; // partner mode for symmetry enforcement
   Real k_peak_; // peak of the power spectrum
   Kokkos::View<Real ***, Kokkos::LayoutRight, parthenon::DevMemSpace> random_num_;
   Kokkos::View<Real ***, Kokkos::LayoutRight, parthenon::HostMemSpace> random_num_host_;
@@ -41,6 +42,10 @@ class FewModesFT {
                      // disable projection
   Real t_corr_;      // correlation time for evolution of Ornstein-Uhlenbeck process
   bool fill_ghosts_; // if the inverse transform should also fill ghost zones
+  bool team_inverse_ft_; // if the (cache blocked) team based inverse transform is used
+  bool device_rng_;      // if random numbers are generated on the device (counter based)
+  uint32_t rseed_;       // seed and number of calls to Generate for device_rng_
+  uint64_t rng_counter_;
 
  public:
   FewModesFT(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg,
@@ -51,11 +56,22 @@ class FewModesFT {
   int GetNumModes() { return num_modes_; }
   void SetPhases(MeshBlock *pmb, ParameterInput *pin);
   void Generate(MeshData<Real> *md, const Real dt, const std::string &var_name);
-  void RestoreRNG(std::istringstream &iss) { iss >> rng_; }
+  // The state of the device RNG is given by the seed and counter
+  void RestoreRNG(std::istringstream &iss) {
+    if (device_rng_) {
+      iss >> rseed_ >> rng_counter_;
+    } else {
+      iss >> rng_;
+    }
+  }
   void RestoreDist(std::istringstream &iss) { iss >> dist_; }
   std::string GetRNGState() {
     std::ostringstream oss;
-    oss << rng_;
+    if (device_rng_) {
+      oss << rseed_ << " " << rng_counter_;
+    } else {
+      oss << rng_;
+    }
     return oss.str();
   }
   std::string GetDistState() {
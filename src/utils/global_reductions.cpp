@@ -0,0 +1,279 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file global_reductions.cpp
+//  \brief Registry to reduce scalar contributions of multiple features at once
+
+// C++ headers
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "global_reductions.hpp"
+#include "utils/error_checking.hpp"
+
+namespace utils {
+
+namespace {
+#ifdef MPI_PARALLEL
+// Combined reduction of all params. Layout of the buffer is
+// [num_sum, num_min, num_max, sum params..., min params..., max params...]
+// where the counts are identical on all ranks. The entire buffer is a single element of
+// a contiguous datatype so that MPI does not split it into segments.
+void CombinedReduction(void *invec, void *inoutvec, int * /*len*/,
+                       MPI_Datatype * /*datatype*/) {
+  const auto *in = static_cast<Real *>(invec);
+  auto *inout = static_cast<Real *>(inoutvec);
+  const int num_sum = static_cast<int>(inout[0]);
+  const int num_min = static_cast<int>(inout[1]);
+  const int num_max = static_cast<int>(inout[2]);
+  int n = 3;
+  for (int i = 0; i < num_sum; i++, n++) {
+    inout[n] += in[n];
+  }
+  for (int i = 0; i < num_min; i++, n++) {
+    inout[n] = std::min(inout[n], in[n]);
+  }
+  for (int i = 0; i < num_max; i++, n++) {
+    inout[n] = std::max(inout[n], in[n]);
+  }
+}
+
+MPI_Op GetCombinedReductionOp() {
+  static MPI_Op op = [] {
+    MPI_Op new_op;
+    PARTHENON_MPI_CHECK(MPI_Op_create(&CombinedReduction, 1, &new_op));
+    return new_op;
+  }();
+  return op;
+}
+#endif // MPI_PARALLEL
+
+Real Identity(const ReductionOp op) {
+  switch (op) {
+  case ReductionOp::sum:
+    return 0.0;
+  case ReductionOp::min:
+    return std::numeric_limits<Real>::max();
+  case ReductionOp::max:
+    return std::numeric_limits<Real>::lowest();
+  }
+  return 0.0;
+}
+
+Real Combine(const ReductionOp op, const Real a, const Real b) {
+  switch (op) {
+  case ReductionOp::sum:
+    return a + b;
+  case ReductionOp::min:
+    return std::min(a, b);
+  case ReductionOp::max:
+    return std::max(a, b);
+  }
+  return a;
+}
+} // namespace
+
+void GlobalReductions::Register(const std::string &param_name, const ReductionOp op,
+                                const bool global) {
+  PARTHENON_REQUIRE_THROWS(accumulator_ids_.count(param_name) == 0,
+                           "Param '" + param_name +
+                               "' is already registered for a global reduction.");
+  if (global) {
+    params_[static_cast<int>(op)].push_back(param_name);
+  }
+  accumulator_ids_[param_name] = static_cast<int>(accumulator_params_.size());
+  accumulator_params_.push_back(param_name);
+  accumulator_ops_.push_back(op);
+  accumulators_.resize(accumulators_.size() + partition_slots_.size() + 1, Identity(op));
+}
+
+bool GlobalReductions::Empty() const {
+  return std::all_of(params_.begin(), params_.end(), [&](const auto &params) {
+    return std::all_of(params.begin(), params.end(), [&](const std::string &param) {
+      return inactive_.count(param) > 0;
+    });
+  });
+}
+
+void GlobalReductions::SetActive(const std::string &param_name, const bool active) {
+  PARTHENON_REQUIRE(!in_flight_, "Cannot change a global reduction in flight.");
+  if (active) {
+    inactive_.erase(param_name);
+  } else {
+    inactive_.insert(param_name);
+  }
+}
+
+void GlobalReductions::PrepareContributions(StateDescriptor *pkg,
+                                            parthenon::Mesh *pmesh) {
+  MergeContributions(pkg);
+  partition_slots_.clear();
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int i = 0; i < num_partitions; i++) {
+    partition_slots_[pmesh->mesh_data.GetOrAdd("base", i).get()] = i;
+  }
+  const auto num_slots = partition_slots_.size() + 1;
+  accumulators_.resize(accumulator_params_.size() * num_slots);
+  for (int p = 0; p < accumulator_params_.size(); p++) {
+    std::fill_n(accumulators_.begin() + p * num_slots, num_slots,
+                Identity(accumulator_ops_[p]));
+  }
+}
+
+void GlobalReductions::Contribute(const std::string &param_name,
+                                  const MeshData<Real> *md, const Real value) {
+  // Only reads of the maps so that concurrent contributions are safe
+  const auto id = accumulator_ids_.find(param_name);
+  PARTHENON_REQUIRE(id != accumulator_ids_.end(),
+                    "Param '" + param_name + "' is not registered for a reduction.");
+  const int p = id->second;
+  const int num_slots = static_cast<int>(partition_slots_.size()) + 1;
+  const auto slot = partition_slots_.find(md);
+  if (slot != partition_slots_.end()) {
+    auto &acc = accumulators_[p * num_slots + slot->second];
+    acc = Combine(accumulator_ops_[p], acc, value);
+  } else {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    auto &acc = accumulators_[p * num_slots + num_slots - 1];
+    acc = Combine(accumulator_ops_[p], acc, value);
+  }
+}
+
+void GlobalReductions::MergeContributions(StateDescriptor *pkg) {
+  const int num_slots = static_cast<int>(partition_slots_.size()) + 1;
+  for (int p = 0; p < accumulator_params_.size(); p++) {
+    const auto op = accumulator_ops_[p];
+    const Real identity = Identity(op);
+    auto acc = accumulators_.begin() + p * num_slots;
+    if (std::all_of(acc, acc + num_slots, [&](const Real v) { return v == identity; })) {
+      continue;
+    }
+    Real value = pkg->Param<Real>(accumulator_params_[p]);
+    for (int s = 0; s < num_slots; s++) {
+      value = Combine(op, value, acc[s]);
+    }
+    pkg->UpdateParam(accumulator_params_[p], value);
+    std::fill_n(acc, num_slots, identity);
+  }
+}
+
+void GlobalReductions::ResetParams(StateDescriptor *pkg, const Real value) {
+  const int num_slots = static_cast<int>(partition_slots_.size()) + 1;
+  for (int p = 0; p < accumulator_params_.size(); p++) {
+    std::fill_n(accumulators_.begin() + p * num_slots, num_slots,
+                Identity(accumulator_ops_[p]));
+    pkg->UpdateParam(accumulator_params_[p], value);
+  }
+}
+
+void GlobalReductions::Start(StateDescriptor *pkg) {
+  PARTHENON_REQUIRE(!in_flight_, "Global reduction started twice.");
+  MergeContributions(pkg);
+#ifdef MPI_PARALLEL
+  if (Empty()) {
+    return;
+  }
+  buffer_.clear();
+  for (const auto &params : params_) {
+    buffer_.push_back(static_cast<Real>(
+        std::count_if(params.begin(), params.end(), [&](const std::string &param) {
+          return inactive_.count(param) == 0;
+        })));
+  }
+  for (const auto &params : params_) {
+    for (const auto &param : params) {
+      if (inactive_.count(param) == 0) {
+        buffer_.push_back(pkg->Param<Real>(param));
+      }
+    }
+  }
+  PARTHENON_MPI_CHECK(
+      MPI_Type_contiguous(static_cast<int>(buffer_.size()), MPI_PARTHENON_REAL, &type_));
+  PARTHENON_MPI_CHECK(MPI_Type_commit(&type_));
+  PARTHENON_MPI_CHECK(MPI_Iallreduce(MPI_IN_PLACE, buffer_.data(), 1, type_,
+                                     GetCombinedReductionOp(), MPI_COMM_WORLD,
+                                     &request_));
+  in_flight_ = true;
+#endif // MPI_PARALLEL
+}
+
+void GlobalReductions::Finish(StateDescriptor *pkg) {
+  if (!in_flight_) {
+    return;
+  }
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Wait(&request_, MPI_STATUS_IGNORE));
+  PARTHENON_MPI_CHECK(MPI_Type_free(&type_));
+  int n = num_reduction_ops;
+  for (const auto &params : params_) {
+    for (const auto &param : params) {
+      if (inactive_.count(param) == 0) {
+        pkg->UpdateParam(param, buffer_[n++]);
+      }
+    }
+  }
+#endif // MPI_PARALLEL
+  in_flight_ = false;
+}
+
+void AllReduceCombined(std::vector<Real> &sums, std::vector<Real> &mins,
+                       std::vector<Real> &maxs) {
+#ifdef MPI_PARALLEL
+  std::vector<Real> buffer{static_cast<Real>(sums.size()), static_cast<Real>(mins.size()),
+                           static_cast<Real>(maxs.size())};
+  for (const auto *vals : {&sums, &mins, &maxs}) {
+    buffer.insert(buffer.end(), vals->begin(), vals->end());
+  }
+  MPI_Datatype type;
+  PARTHENON_MPI_CHECK(
+      MPI_Type_contiguous(static_cast<int>(buffer.size()), MPI_PARTHENON_REAL, &type));
+  PARTHENON_MPI_CHECK(MPI_Type_commit(&type));
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, buffer.data(), 1, type,
+                                    GetCombinedReductionOp(), MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Type_free(&type));
+  auto it = buffer.begin() + num_reduction_ops;
+  for (auto *vals : {&sums, &mins, &maxs}) {
+    std::copy(it, it + vals->size(), vals->begin());
+    it += vals->size();
+  }
+#endif // MPI_PARALLEL
+}
+
+parthenon::HistoryOutputVar AccumulatedParamHstVar(parthenon::UserHistoryOperation op,
+                                                   const std::string &pkg_name,
+                                                   const std::string &registry,
+                                                   const std::string &param_name) {
+  return parthenon::HistoryOutputVar(
+      op,
+      [pkg_name, registry, param_name](MeshData<Real> *md) -> Real {
+        auto pmb = md->GetBlockData(0)->GetBlockPointer();
+        if (pmb->pmy_mesh->mesh_data.GetOrAdd("base", 0).get() != md) {
+          return 0.0;
+        }
+        auto pkg = pmb->packages.Get(pkg_name);
+        pkg->MutableParam<GlobalReductions>(registry)->MergeContributions(pkg.get());
+        return pkg->Param<Real>(param_name);
+      },
+      param_name);
+}
+
+TaskStatus StartGlobalReductions(StateDescriptor *pkg) {
+  pkg->MutableParam<GlobalReductions>("global_reductions")->Start(pkg);
+  return TaskStatus::complete;
+}
+
+TaskStatus FinishGlobalReductions(StateDescriptor *pkg) {
+  pkg->MutableParam<GlobalReductions>("global_reductions")->Finish(pkg);
+  return TaskStatus::complete;
+}
+
+} // namespace utils
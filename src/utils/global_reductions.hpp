@@ -0,0 +1,126 @@
+#ifndef UTILS_GLOBAL_REDUCTIONS_HPP_
+#define UTILS_GLOBAL_REDUCTIONS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file global_reductions.hpp
+//  \brief Registry to reduce scalar contributions of multiple features at once
+
+// C++ headers
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+
+namespace utils {
+using parthenon::MeshData;
+using parthenon::Real;
+using parthenon::StateDescriptor;
+using parthenon::TaskStatus;
+
+// Order of the ops is used as index so needs to be contiguous
+enum class ReductionOp { sum, min, max };
+constexpr int num_reduction_ops = 3;
+
+// Features register (mutable) Real params of the Hydro package that contain the rank
+// local contribution to a global reduction. After all rank local contributions have been
+// calculated, all registered params are reduced using a single non-blocking MPI call so
+// that the communication overlaps with other tasks until the result is required.
+// Without MPI, the rank local contributions already are the global results.
+//
+// Tasks of different task lists may be executed concurrently by multiple host threads so
+// that tasks must not update the params directly. Instead, each partition ("base"
+// MeshData) contributes to its own accumulator (Contribute()), which requires neither
+// locks nor atomics. The accumulators are merged into the params at region boundaries,
+// i.e., when the reduction is started and when the task collection of the next stage is
+// created. Merging in partition order keeps the sums independent of the execution order.
+class GlobalReductions {
+ public:
+  // Params that are not `global` are only accumulated over the partitions of a rank
+  // (e.g., rank local timestep constraints) but not reduced over all ranks.
+  void Register(const std::string &param_name, const ReductionOp op,
+                const bool global = true);
+  bool Empty() const;
+  // Inactive params are excluded from the reduction (and keep their value), e.g., for
+  // features that do not update their contributions every cycle. Must be identical on
+  // all ranks.
+  void SetActive(const std::string &param_name, const bool active);
+
+  // Merges pending contributions into the params and (re)assigns one accumulator to each
+  // partition of the mesh (which change with remeshing and load balancing). Must be
+  // called while no tasks are executed, e.g., when the task collection is created.
+  void PrepareContributions(StateDescriptor *pkg, parthenon::Mesh *pmesh);
+  // Thread-safe contribution of a task of the task list of partition `md` to the (rank
+  // local) value of the param, which is combined with the value using the op of the
+  // param. Contributions of other MeshData (e.g., outside the task lists) are serialized.
+  void Contribute(const std::string &param_name, const MeshData<Real> *md,
+                  const Real value);
+  // Combines all pending contributions with the params and resets the accumulators
+  void MergeContributions(StateDescriptor *pkg);
+  // Discards all pending contributions and sets all registered params to `value`, e.g.,
+  // to reset counters. Must be called while no tasks are executed.
+  void ResetParams(StateDescriptor *pkg, const Real value);
+
+  // Post the reduction of all registered params (after merging the contributions)
+  void Start(StateDescriptor *pkg);
+  // Wait for the reduction to finish and update the params with the global results.
+  // Noop if no reduction is in flight.
+  void Finish(StateDescriptor *pkg);
+
+ private:
+  // Registered params for each op
+  std::array<std::vector<std::string>, num_reduction_ops> params_;
+  std::set<std::string> inactive_;
+  // Reduction buffer, which contains the number of params for each op followed by the
+  // params ordered by op.
+  std::vector<Real> buffer_;
+  bool in_flight_ = false;
+
+  // Accumulators of all registered params (global and local). The accumulators of param
+  // p are stored contiguously at [p * num_slots, (p + 1) * num_slots) with one slot per
+  // partition followed by a slot (guarded by the mutex) for all other contributions.
+  std::map<std::string, int> accumulator_ids_;
+  std::vector<std::string> accumulator_params_;
+  std::vector<ReductionOp> accumulator_ops_;
+  std::map<const MeshData<Real> *, int> partition_slots_;
+  std::vector<Real> accumulators_;
+  // Shared so that the registry remains copyable (as param)
+  std::shared_ptr<std::mutex> mutex_ = std::make_shared<std::mutex>();
+#ifdef MPI_PARALLEL
+  MPI_Request request_ = MPI_REQUEST_NULL;
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+#endif
+};
+
+// Blocking reduction of the given values over all ranks (in place) using a single
+// collective, e.g., for diagnostics outside of the task lists. The sizes of the vectors
+// must be identical on all ranks.
+void AllReduceCombined(std::vector<Real> &sums, std::vector<Real> &mins,
+                       std::vector<Real> &maxs);
+
+// History output of the (rank local) value of a param accumulated by the registry stored
+// in the `registry` param of package `pkg_name`. Pending contributions are merged first
+// and only the first partition of each rank reports the value so that the result (sum
+// or max over all partitions and ranks) does not depend on the number of partitions.
+// Reading does not modify the value, so the param can be read by multiple outputs.
+parthenon::HistoryOutputVar AccumulatedParamHstVar(parthenon::UserHistoryOperation op,
+                                                   const std::string &pkg_name,
+                                                   const std::string &registry,
+                                                   const std::string &param_name);
+
+// Task wrappers for the registry stored in the "global_reductions" param of the package
+TaskStatus StartGlobalReductions(StateDescriptor *pkg);
+TaskStatus FinishGlobalReductions(StateDescriptor *pkg);
+
+} // namespace utils
+
+#endif // UTILS_GLOBAL_REDUCTIONS_HPP_
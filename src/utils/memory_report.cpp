@@ -0,0 +1,231 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file memory_report.cpp
+//  \brief Accounting of the device memory used by the fields of all registers
+
+// C++ headers
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(KOKKOS_ENABLE_CUDA) && !defined(KOKKOS_ENABLE_HIP)
+#include <sys/resource.h>
+#endif
+
+// Parthenon headers
+#include <globals.hpp>
+#include <outputs/outputs.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "../hydro/hydro.hpp"
+#include "memory_report.hpp"
+#include "utils/error_checking.hpp"
+
+#if defined(KOKKOS_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#endif
+
+namespace utils {
+using parthenon::Real;
+
+namespace {
+// Bytes of all fields on this rank per register and per field
+struct MemoryAccount {
+  std::map<std::string, std::int64_t> per_register;
+  std::map<std::string, std::int64_t> per_field;
+  // values, fluxes and coarse buffers of a single block (of the base register)
+  std::map<std::string, std::int64_t> per_field_block;
+  std::int64_t total = 0;
+};
+
+MemoryAccount AccountFields(parthenon::Mesh *pmesh) {
+  MemoryAccount account;
+  for (const auto &pmb : pmesh->block_list) {
+    const bool first_block = pmb == pmesh->block_list.front();
+    for (const auto &[reg, data] : pmb->meshblock_data.Stages()) {
+      const bool base = reg == "base";
+      auto &reg_bytes = account.per_register[reg];
+      for (const auto &var : data->GetVariableVector()) {
+        // Variables with a single copy are shared by all registers
+        if (!base && var->IsSet(parthenon::Metadata::OneCopy)) {
+          continue;
+        }
+        const auto bytes = VariableBytes(*var);
+        reg_bytes += bytes;
+        account.per_field[var->label()] += bytes;
+        if (first_block && base) {
+          account.per_field_block[var->label()] = bytes;
+        }
+        account.total += bytes;
+      }
+    }
+  }
+  return account;
+}
+
+// Memory currently in use on the device (or the high-water mark of the resident host
+// memory of the process when running on the host)
+std::int64_t DeviceBytesInUse() {
+#if defined(KOKKOS_ENABLE_CUDA)
+  std::size_t free, total;
+  cudaMemGetInfo(&free, &total);
+  return static_cast<std::int64_t>(total - free);
+#elif defined(KOKKOS_ENABLE_HIP)
+  std::size_t free, total;
+  PARTHENON_REQUIRE_THROWS(hipMemGetInfo(&free, &total) == hipSuccess,
+                           "Failed to get the HIP device memory info.");
+  return static_cast<std::int64_t>(total - free);
+#else
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<std::int64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+// Maximum over all ranks (in place)
+void ReduceMax(std::vector<std::int64_t> &vals) {
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, vals.data(),
+                                    static_cast<int>(vals.size()), MPI_INT64_T, MPI_MAX,
+                                    MPI_COMM_WORLD));
+#endif
+}
+
+std::string FormatBytes(const std::int64_t bytes) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(2) << static_cast<Real>(bytes) / (1 << 20)
+     << " MiB";
+  return os.str();
+}
+} // namespace
+
+std::int64_t VariableBytes(const parthenon::Variable<Real> &var) {
+  std::int64_t size = var.data.size() + var.coarse_s.size();
+  if (var.IsSet(parthenon::Metadata::WithFluxes)) {
+    for (int d = 1; d <= 3; d++) {
+      size += var.flux[d].size();
+    }
+  }
+  return size * static_cast<std::int64_t>(sizeof(Real));
+}
+
+void InitMemoryReport(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg) {
+  const auto memory_report = pin->GetOrAddBoolean("hydro", "memory_report", false);
+  pkg->AddParam<>("memory_report", memory_report);
+  if (!memory_report) {
+    return;
+  }
+  // Global block counts of the mesh at the last report and high-water marks (maximum
+  // over all ranks)
+  pkg->AddParam<>("memory_report_mesh", std::vector<std::int64_t>{-1, -1, -1}, true);
+  pkg->AddParam<std::int64_t>("memory_report_fields_high_water", 0, true);
+  pkg->AddParam<std::int64_t>("memory_report_device_high_water", 0, true);
+
+  if (!pin->GetOrAddBoolean("hydro", "memory_report_hst", false)) {
+    return;
+  }
+  auto hst_vars = pkg->Param<parthenon::HstVar_list>(parthenon::hist_param_key);
+  hst_vars.emplace_back(parthenon::HistoryOutputVar(
+      parthenon::UserHistoryOperation::max,
+      [](parthenon::MeshData<Real> *md) {
+        auto pmesh = md->GetBlockData(0)->GetBlockPointer()->pmy_mesh;
+        return static_cast<Real>(AccountFields(pmesh).total);
+      },
+      "mem_fields_bytes"));
+  hst_vars.emplace_back(parthenon::HistoryOutputVar(
+      parthenon::UserHistoryOperation::max,
+      [](parthenon::MeshData<Real> *md) { return static_cast<Real>(DeviceBytesInUse()); },
+      "mem_device_bytes"));
+  pkg->UpdateParam(parthenon::hist_param_key, hst_vars);
+}
+
+void ReportMemory(parthenon::Mesh *pmesh, parthenon::StateDescriptor *pkg) {
+  if (!pkg->Param<bool>("memory_report")) {
+    return;
+  }
+  // Global quantities so that all ranks agree on whether to report
+  const std::vector<std::int64_t> mesh{pmesh->nbtotal, pmesh->nbnew, pmesh->nbdel};
+  if (mesh == pkg->Param<std::vector<std::int64_t>>("memory_report_mesh")) {
+    return;
+  }
+  pkg->UpdateParam("memory_report_mesh", mesh);
+
+  const auto account = AccountFields(pmesh);
+  // All ranks hold the same fields and registers (and thus the same map keys)
+  std::vector<std::int64_t> vals;
+  for (const auto &[reg, bytes] : account.per_register) {
+    vals.push_back(bytes);
+  }
+  for (const auto &[field, bytes] : account.per_field) {
+    vals.push_back(bytes);
+  }
+  const auto num_blocks = static_cast<std::int64_t>(pmesh->block_list.size());
+  vals.push_back(account.total);
+  vals.push_back(DeviceBytesInUse());
+  vals.push_back(num_blocks);
+  std::vector<std::int64_t> num_keys{static_cast<std::int64_t>(vals.size()),
+                                     -static_cast<std::int64_t>(vals.size())};
+  ReduceMax(num_keys);
+  PARTHENON_REQUIRE_THROWS(num_keys[0] == -num_keys[1],
+                           "Memory report requires the same fields on all ranks.");
+  ReduceMax(vals);
+
+  const auto num_vals = vals.size();
+  const auto total = vals[num_vals - 3];
+  const auto device = vals[num_vals - 2];
+  const auto max_num_blocks = vals[num_vals - 1];
+  const auto fields_high_water =
+      std::max(total, pkg->Param<std::int64_t>("memory_report_fields_high_water"));
+  const auto device_high_water =
+      std::max(device, pkg->Param<std::int64_t>("memory_report_device_high_water"));
+  pkg->UpdateParam("memory_report_fields_high_water", fields_high_water);
+  pkg->UpdateParam("memory_report_device_high_water", device_high_water);
+
+  if (parthenon::Globals::my_rank != 0) {
+    return;
+  }
+  const auto &block_size = pmesh->block_list.front()->block_size;
+  const int nx1 = block_size.nx1 + 2 * parthenon::Globals::nghost;
+  std::cout << "Memory report for " << pmesh->nbtotal << " block(s) (at most "
+            << max_num_blocks << " per rank, all values are the maximum over ranks):"
+            << std::endl;
+  std::size_t n = 0;
+  std::cout << "  Registers:" << std::endl;
+  for (const auto &[reg, bytes] : account.per_register) {
+    std::cout << "    " << std::left << std::setw(36) << reg << std::right
+              << std::setw(16) << FormatBytes(vals[n++]) << std::endl;
+  }
+  std::cout << "  Fields (all registers, per block of the base register):" << std::endl;
+  for (const auto &[field, bytes] : account.per_field) {
+    const auto it = account.per_field_block.find(field);
+    const auto block_bytes = it != account.per_field_block.end() ? it->second : 0;
+    std::cout << "    " << std::left << std::setw(36) << field << std::right
+              << std::setw(16) << FormatBytes(vals[n++]) << std::setw(16)
+              << FormatBytes(block_bytes) << std::endl;
+  }
+  std::cout << "  Total fields: " << FormatBytes(total)
+            << " (high-water mark: " << FormatBytes(fields_high_water) << ")"
+            << std::endl;
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP)
+  std::cout << "  Device memory in use: " << FormatBytes(device)
+#else
+  std::cout << "  Resident host memory (process high-water mark): " << FormatBytes(device)
+#endif
+            << " (high-water mark: " << FormatBytes(device_high_water) << ")"
+            << std::endl;
+  std::cout << "  Flux kernel scratch memory per team: "
+            << Hydro::FluxScratchBytesPerTeam(pkg, nx1) << " bytes (level "
+            << pkg->Param<int>("scratch_level") << ")" << std::endl;
+}
+
+} // namespace utils
@@ -0,0 +1,40 @@
+#ifndef UTILS_MEMORY_REPORT_HPP_
+#define UTILS_MEMORY_REPORT_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file memory_report.hpp
+//  \brief Accounting of the device memory used by the fields of all registers
+
+// C++ headers
+#include <cstdint>
+
+// Parthenon headers
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+
+namespace utils {
+
+// If enabled (hydro/memory_report), the device memory of the fields (values, fluxes and
+// coarse buffers) of all packages is accounted per field and per register and reported
+// on rank 0 (maximum over all ranks) at startup and after every change of the mesh
+// (remeshing or load balancing). The report also contains the scratch memory per
+// team requested by the flux kernel and the high-water mark of the accounted memory
+// (and of the memory in use on the device if available).
+// Optionally (hydro/memory_report_hst), the accounted and the device memory (maximum
+// over all ranks) are additionally added as history columns.
+void InitMemoryReport(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg);
+
+// Prints the report if the mesh changed since the last call. Collective.
+void ReportMemory(parthenon::Mesh *pmesh, parthenon::StateDescriptor *pkg);
+
+// Device memory allocated by a variable, i.e., its values, fluxes, and coarse buffer
+// (used for the prolongation and restriction on multilevel meshes).
+std::int64_t VariableBytes(const parthenon::Variable<parthenon::Real> &var);
+
+} // namespace utils
+
+#endif // UTILS_MEMORY_REPORT_HPP_
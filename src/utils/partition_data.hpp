@@ -0,0 +1,58 @@
+#ifndef UTILS_PARTITION_DATA_HPP_
+#define UTILS_PARTITION_DATA_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file partition_data.hpp
+//  \brief Per partition instances of (host) state, e.g., device work lists
+
+// C++ headers
+#include <map>
+#include <vector>
+
+// Parthenon headers
+#include <mesh/mesh.hpp>
+#include <parthenon/package.hpp>
+
+namespace utils {
+using parthenon::MeshData;
+using parthenon::Real;
+
+// One instance of T for each partition ("base" MeshData) of the rank so that tasks of
+// different task lists, which may be executed concurrently by multiple host threads,
+// do not share state (see the global reductions for scalar contributions).
+// Instances are kept when the partitions change so that allocations are reused.
+template <typename T>
+class PartitionData {
+ public:
+  // (Re)assigns one instance to each partition of the mesh. Must be called while no
+  // tasks are executed, e.g., when the task collection is created.
+  void Prepare(parthenon::Mesh *pmesh) {
+    slots_.clear();
+    const int num_partitions = pmesh->DefaultNumPartitions();
+    for (int i = 0; i < num_partitions; i++) {
+      slots_[pmesh->mesh_data.GetOrAdd("base", i).get()] = i;
+    }
+    if (static_cast<int>(data_.size()) < num_partitions + 1) {
+      data_.resize(num_partitions + 1);
+    }
+  }
+
+  // Instance of partition `md`. All other MeshData (e.g., outside the task lists, where
+  // tasks are not executed concurrently) share the last instance.
+  T &Get(const MeshData<Real> *md) {
+    // Only reads of the map so that concurrent calls for different partitions are safe
+    const auto slot = slots_.find(md);
+    return slot != slots_.end() ? data_[slot->second] : data_.back();
+  }
+
+ private:
+  std::map<const MeshData<Real> *, int> slots_;
+  std::vector<T> data_ = std::vector<T>(1);
+};
+
+} // namespace utils
+
+#endif // UTILS_PARTITION_DATA_HPP_
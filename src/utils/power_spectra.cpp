@@ -0,0 +1,220 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file power_spectra.cpp
+//  \brief In-situ kinetic and magnetic energy spectra from an explicit (direct) FT
+
+// C++ headers
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include "basic_types.hpp"
+#include "globals.hpp"
+#include "kokkos_abstraction.hpp"
+#include "mesh/domain.hpp"
+
+// AthenaPK headers
+#include "../main.hpp"
+#include "power_spectra.hpp"
+#include "utils/error_checking.hpp"
+
+namespace utils::power_spectra {
+using Complex = Kokkos::complex<Real>;
+using parthenon::IndexDomain;
+using parthenon::IndexRange;
+
+PowerSpectra::PowerSpectra(parthenon::ParameterInput *pin,
+                           parthenon::StateDescriptor *pkg, const std::string &block)
+    : block_(block) {
+  dt_ = pin->GetOrAddReal(block, "dt", -1.0);
+  enabled_ = dt_ > 0.0;
+  // Stored in the input so that the cadence is continued after restarts
+  next_time_ = pin->GetOrAddReal(block, "next_time", 0.0);
+  file_number_ = pin->GetOrAddInteger(block, "file_number", 0);
+  basename_ = pin->GetOrAddString(block, "basename", "spectra");
+  k_max_ = pin->GetOrAddInteger(block, "k_max", 8);
+  with_mag_ = pkg->Param<Fluid>("fluid") == Fluid::glmmhd;
+
+  num_modes_ = 0;
+  if (!enabled_) {
+    return;
+  }
+
+  const auto Lx1 = pin->GetReal("parthenon/mesh", "x1max") -
+                   pin->GetReal("parthenon/mesh", "x1min");
+  const auto Lx2 = pin->GetReal("parthenon/mesh", "x2max") -
+                   pin->GetReal("parthenon/mesh", "x2min");
+  const auto Lx3 = pin->GetReal("parthenon/mesh", "x3max") -
+                   pin->GetReal("parthenon/mesh", "x3min");
+  PARTHENON_REQUIRE_THROWS((Lx1 == Lx2) && (Lx2 == Lx3),
+                           "Power spectra require a cubic box.");
+  const auto gnx1 = pin->GetInteger("parthenon/mesh", "nx1");
+  PARTHENON_REQUIRE_THROWS(k_max_ > 0 && k_max_ <= gnx1 / 2,
+                           "Power spectra k_max must be between 1 and nx1/2.");
+
+  // Half space of wave vectors (the other half are the complex conjugates)
+  std::vector<int> k_list;
+  for (int kx = 0; kx <= k_max_; kx++) {
+    for (int ky = -k_max_; ky <= k_max_; ky++) {
+      for (int kz = -k_max_; kz <= k_max_; kz++) {
+        const bool upper_half = kx > 0 || (kx == 0 && (ky > 0 || (ky == 0 && kz > 0)));
+        if (upper_half && std::sqrt(SQR(kx) + SQR(ky) + SQR(kz)) <= k_max_ + 0.5) {
+          k_list.insert(k_list.end(), {kx, ky, kz});
+        }
+      }
+    }
+  }
+  num_modes_ = static_cast<int>(k_list.size()) / 3;
+
+  k_vec_ = ParArray2D<Real>("power_spectra_k_vec", 3, num_modes_);
+  auto k_vec_host = k_vec_.GetHostMirror();
+  for (int m = 0; m < num_modes_; m++) {
+    for (int n = 0; n < 3; n++) {
+      k_vec_host(n, m) = k_list[3 * m + n];
+    }
+  }
+  k_vec_.DeepCopy(k_vec_host);
+}
+
+void PowerSpectra::ComputeIfDue(parthenon::Mesh *pmesh, parthenon::ParameterInput *pin,
+                                const parthenon::SimTime &tm) {
+  if (!enabled_ || tm.time < next_time_) {
+    return;
+  }
+  Compute(pmesh, tm);
+
+  file_number_ += 1;
+  while (next_time_ <= tm.time) {
+    next_time_ += dt_;
+  }
+  pin->SetReal(block_, "next_time", next_time_);
+  pin->SetInteger(block_, "file_number", file_number_);
+}
+
+void PowerSpectra::Compute(parthenon::Mesh *pmesh, const parthenon::SimTime &tm) const {
+  const auto x1min = pmesh->mesh_size.x1min;
+  const auto x2min = pmesh->mesh_size.x2min;
+  const auto x3min = pmesh->mesh_size.x3min;
+  const auto L = pmesh->mesh_size.x1max - pmesh->mesh_size.x1min;
+  const Real w0 = 2.0 * M_PI / L;
+
+  const int num_modes = num_modes_;
+  const bool with_mag = with_mag_;
+  // sqrt(rho) v and (for MHD) B
+  const int num_comp = with_mag ? 6 : 3;
+  auto k_vec = k_vec_;
+  // Real and imaginary part of the projection of all components onto all modes so that
+  // all partitions are reduced with a single collective
+  ParArray2D<Real> coeffs("power_spectra_coeffs", num_modes, 2 * num_comp);
+
+  const int num_partitions = pmesh->DefaultNumPartitions();
+  for (int p = 0; p < num_partitions; p++) {
+    auto &md = pmesh->mesh_data.GetOrAdd("base", p);
+    const auto &prim_pack = md->PackVariables(std::vector<std::string>{"prim"});
+    IndexRange ib = md->GetBlockData(0)->GetBoundsI(IndexDomain::interior);
+    IndexRange jb = md->GetBlockData(0)->GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = md->GetBlockData(0)->GetBoundsK(IndexDomain::interior);
+    const int ni = ib.e + 1 - ib.s;
+    const int nj = jb.e + 1 - jb.s;
+    const int ncells = ni * nj * (kb.e + 1 - kb.s);
+
+    // Each team projects one component of one block onto one mode
+    parthenon::par_for_outer(
+        DEFAULT_OUTER_LOOP_PATTERN, "PowerSpectra::Compute", parthenon::DevExecSpace(),
+        0, 0, 0, prim_pack.GetDim(5) - 1, 0, num_modes - 1, 0, num_comp - 1,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int b, const int m,
+                      const int n) {
+          const auto &prim = prim_pack(b);
+          const auto &coords = prim_pack.GetCoords(b);
+          const Real kx = w0 * k_vec(0, m);
+          const Real ky = w0 * k_vec(1, m);
+          const Real kz = w0 * k_vec(2, m);
+
+          Complex sum(0.0, 0.0);
+          Kokkos::parallel_reduce(
+              Kokkos::TeamThreadRange(member, ncells),
+              [&](const int idx, Complex &lsum) {
+                const int i = ib.s + idx % ni;
+                const int j = jb.s + (idx / ni) % nj;
+                const int k = kb.s + idx / (ni * nj);
+                const Real f = n < 3
+                                   ? std::sqrt(prim(IDN, k, j, i)) * prim(IV1 + n, k, j, i)
+                                   : prim(IB1 + n - 3, k, j, i);
+                const Real phase = -(kx * (coords.Xc<1>(i) - x1min) +
+                                     ky * (coords.Xc<2>(j) - x2min) +
+                                     kz * (coords.Xc<3>(k) - x3min));
+                lsum += f * coords.CellVolume(k, j, i) *
+                        Complex(std::cos(phase), std::sin(phase));
+              },
+              sum);
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            Kokkos::atomic_add(&coeffs(m, 2 * n), sum.real());
+            Kokkos::atomic_add(&coeffs(m, 2 * n + 1), sum.imag());
+          });
+        });
+  }
+
+  auto coeffs_host = coeffs.GetHostMirrorAndCopy();
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, coeffs_host.data(),
+                                    static_cast<int>(coeffs_host.size()),
+                                    MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
+#endif
+  if (parthenon::Globals::my_rank != 0) {
+    return;
+  }
+  auto k_vec_host = k_vec_.GetHostMirrorAndCopy();
+
+  // Shell sums normalized so that sum_k E(k) = 1/V int 0.5 f^2 dV (excluding the mean),
+  // i.e., 2 (for the conjugate modes) x 0.5 x |f_hat|^2 with f_hat = 1/V int f e^-ikx dV
+  const Real inv_vol = 1.0 / (L * L * L);
+  std::vector<int> shell_num_modes(k_max_ + 1, 0);
+  std::vector<Real> e_kin(k_max_ + 1, 0.0);
+  std::vector<Real> e_kin_comp(k_max_ + 1, 0.0);
+  std::vector<Real> e_mag(k_max_ + 1, 0.0);
+  for (int m = 0; m < num_modes; m++) {
+    const Real k_mag =
+        std::sqrt(SQR(k_vec_host(0, m)) + SQR(k_vec_host(1, m)) + SQR(k_vec_host(2, m)));
+    const int shell = static_cast<int>(std::lround(k_mag));
+    Complex k_dot_w(0.0, 0.0);
+    for (int n = 0; n < 3; n++) {
+      const Complex w(coeffs_host(m, 2 * n), coeffs_host(m, 2 * n + 1));
+      k_dot_w += k_vec_host(n, m) / k_mag * w * inv_vol;
+      e_kin[shell] += Kokkos::abs(w * inv_vol) * Kokkos::abs(w * inv_vol);
+      if (with_mag) {
+        const Complex bf(coeffs_host(m, 2 * n + 6), coeffs_host(m, 2 * n + 7));
+        e_mag[shell] += Kokkos::abs(bf * inv_vol) * Kokkos::abs(bf * inv_vol);
+      }
+    }
+    e_kin_comp[shell] += Kokkos::abs(k_dot_w) * Kokkos::abs(k_dot_w);
+    shell_num_modes[shell] += 2;
+  }
+
+  std::stringstream number;
+  number << std::setw(5) << std::setfill('0') << file_number_;
+  std::ofstream os(basename_ + "." + number.str() + ".dat");
+  os << std::scientific << std::setprecision(8);
+  os << "# time = " << tm.time << " cycle = " << tm.ncycle << std::endl;
+  os << "# [1]=k [2]=num_modes [3]=E_kin [4]=E_kin_solenoidal [5]=E_kin_compressive";
+  if (with_mag) {
+    os << " [6]=E_mag";
+  }
+  os << std::endl;
+  for (int shell = 1; shell <= k_max_; shell++) {
+    os << shell << " " << shell_num_modes[shell] << " " << e_kin[shell] << " "
+       << e_kin[shell] - e_kin_comp[shell] << " " << e_kin_comp[shell];
+    if (with_mag) {
+      os << " " << e_mag[shell];
+    }
+    os << std::endl;
+  }
+}
+
+} // namespace utils::power_spectra
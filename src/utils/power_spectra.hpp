@@ -0,0 +1,54 @@
+#ifndef UTILS_POWER_SPECTRA_HPP_
+#define UTILS_POWER_SPECTRA_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file power_spectra.hpp
+//  \brief In-situ kinetic and magnetic energy spectra from an explicit (direct) FT
+
+// C++ headers
+#include <string>
+
+// Parthenon headers
+#include <basic_types.hpp>
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+
+namespace utils::power_spectra {
+using parthenon::ParArray2D;
+using parthenon::Real;
+
+// Projects sqrt(rho) v (and B for MHD) onto all integer wave vectors (in units of 2 pi /
+// L) with |k| <= k_max of a periodic, cubic box and writes the shell averaged (k - 1/2 <
+// |k| <= k + 1/2) kinetic (total, solenoidal, and compressive) and magnetic energy
+// spectra. Only one half space of wave vectors is projected as the fields are real.
+// The cost scales with the number of modes times the number of cells so that this is
+// intended for moderate k_max.
+class PowerSpectra {
+ public:
+  PowerSpectra(parthenon::ParameterInput *pin, parthenon::StateDescriptor *pkg,
+               const std::string &block);
+
+  // Computes and writes the spectra if the next analysis time is reached
+  void ComputeIfDue(parthenon::Mesh *pmesh, parthenon::ParameterInput *pin,
+                    const parthenon::SimTime &tm);
+
+ private:
+  void Compute(parthenon::Mesh *pmesh, const parthenon::SimTime &tm) const;
+
+  std::string block_;
+  bool enabled_, with_mag_;
+  Real dt_, next_time_;
+  int file_number_;
+  std::string basename_;
+
+  int k_max_, num_modes_;
+  ParArray2D<Real> k_vec_;
+};
+
+} // namespace utils::power_spectra
+
+#endif // UTILS_POWER_SPECTRA_HPP_
@@ -0,0 +1,192 @@
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file task_timers.cpp
+//  \brief Named profiling regions and optional timers for the tasks of the driver
+
+// C++ headers
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Parthenon headers
+#include <globals.hpp>
+#include <parthenon/package.hpp>
+
+// AthenaPK headers
+#include "task_timers.hpp"
+#include "utils/error_checking.hpp"
+
+namespace utils {
+
+TaskTimers::TaskTimers(parthenon::ParameterInput *pin) {
+  enabled_ = pin->GetOrAddBoolean("hydro", "task_timers", false);
+  fence_ = pin->GetOrAddBoolean("hydro", "task_timers_fence", true);
+  cycle_interval_ = pin->GetOrAddInteger("hydro", "task_timers_cycle_interval", 0);
+  json_filename_ = pin->GetOrAddString("hydro", "task_timers_json", "");
+}
+
+int TaskTimers::Register(const std::string &name) {
+  const auto it = ids_.find(name);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  const int id = static_cast<int>(names_.size());
+  ids_[name] = id;
+  names_.push_back(name);
+  interval_times_.push_back(0.0);
+  total_times_.push_back(0.0);
+  interval_calls_.push_back(0);
+  total_calls_.push_back(0);
+  return id;
+}
+
+TaskTimers::Clock::time_point TaskTimers::Start() const {
+  if (!enabled_) {
+    return {};
+  }
+  if (fence_) {
+    Kokkos::fence();
+  }
+  return Clock::now();
+}
+
+void TaskTimers::Stop(const int id, const Clock::time_point &start) {
+  if (!enabled_) {
+    return;
+  }
+  if (fence_) {
+    Kokkos::fence();
+  }
+  const std::chrono::duration<Real> time = Clock::now() - start;
+  std::lock_guard<std::mutex> lock(*mutex_);
+  interval_times_[id] += time.count();
+  interval_calls_[id] += 1;
+}
+
+void TaskTimers::BeginCycle(parthenon::Mesh *pmesh, const int ncycle) {
+  if (!enabled_) {
+    return;
+  }
+  // Times of the previous interval are complete
+  if (cycle_interval_ > 0 && interval_num_cycles_ >= cycle_interval_) {
+    PrintTable("Task timers of the last " + std::to_string(interval_num_cycles_) +
+                   " cycle(s) before cycle " + std::to_string(ncycle),
+               interval_times_, interval_calls_, interval_zone_cycles_, "");
+  }
+  if (interval_num_cycles_ >= cycle_interval_) {
+    for (int id = 0; id < static_cast<int>(names_.size()); id++) {
+      total_times_[id] += interval_times_[id];
+      total_calls_[id] += interval_calls_[id];
+      interval_times_[id] = 0.0;
+      interval_calls_[id] = 0;
+    }
+    total_zone_cycles_ += interval_zone_cycles_;
+    interval_zone_cycles_ = 0;
+    interval_num_cycles_ = 0;
+  }
+
+  const auto &block_size = pmesh->block_list.front()->block_size;
+  interval_zone_cycles_ += static_cast<std::int64_t>(pmesh->block_list.size()) *
+                           block_size.nx1 * block_size.nx2 * block_size.nx3;
+  interval_num_cycles_ += 1;
+}
+
+void TaskTimers::Report() {
+  if (!enabled_) {
+    return;
+  }
+  auto times = total_times_;
+  auto calls = total_calls_;
+  for (int id = 0; id < static_cast<int>(names_.size()); id++) {
+    times[id] += interval_times_[id];
+    calls[id] += interval_calls_[id];
+  }
+  PrintTable("Task timers of the entire run", times, calls,
+             total_zone_cycles_ + interval_zone_cycles_, json_filename_);
+}
+
+void TaskTimers::PrintTable(const std::string &title, const std::vector<Real> &times,
+                            const std::vector<std::int64_t> &calls,
+                            const std::int64_t zone_cycles,
+                            const std::string &json_filename) const {
+  // Tasks are registered in the order they are added so that all ranks share the same
+  // registry as long as all ranks use the same task graph.
+  const int num_tasks = static_cast<int>(names_.size());
+  std::vector<Real> t_min(times), t_max(times), t_avg(times);
+  Real zones = static_cast<Real>(zone_cycles);
+#ifdef MPI_PARALLEL
+  int num_tasks_min = num_tasks, num_tasks_max = num_tasks;
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &num_tasks_min, 1, MPI_INT, MPI_MIN,
+                                    MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &num_tasks_max, 1, MPI_INT, MPI_MAX,
+                                    MPI_COMM_WORLD));
+  PARTHENON_REQUIRE_THROWS(num_tasks_min == num_tasks_max,
+                           "Task timers require the same tasks on all ranks.");
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, t_min.data(), num_tasks,
+                                    MPI_PARTHENON_REAL, MPI_MIN, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, t_max.data(), num_tasks,
+                                    MPI_PARTHENON_REAL, MPI_MAX, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, t_avg.data(), num_tasks,
+                                    MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD));
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &zones, 1, MPI_PARTHENON_REAL,
+                                    MPI_SUM, MPI_COMM_WORLD));
+#endif
+  if (parthenon::Globals::my_rank != 0) {
+    return;
+  }
+  Real t_sum = 0.0;
+  for (int id = 0; id < num_tasks; id++) {
+    t_avg[id] /= static_cast<Real>(parthenon::Globals::nranks);
+    t_sum += t_avg[id];
+  }
+  // Sorted by decreasing average time
+  std::vector<int> order(num_tasks);
+  for (int id = 0; id < num_tasks; id++) {
+    order[id] = id;
+  }
+  std::sort(order.begin(), order.end(),
+            [&](const int a, const int b) { return t_avg[a] > t_avg[b]; });
+
+  // The slowest rank determines the zone-cycles per second
+  std::cout << title << " (times in s, min/avg/max over ranks):" << std::endl;
+  std::cout << std::left << std::setw(40) << "  task" << std::right << std::setw(10)
+            << "calls" << std::setw(12) << "min" << std::setw(12) << "avg"
+            << std::setw(12) << "max" << std::setw(8) << "frac" << std::setw(14)
+            << "zone-cyc/s" << std::endl;
+  for (const auto id : order) {
+    std::cout << "  " << std::left << std::setw(38) << names_[id] << std::right
+              << std::setw(10) << calls[id] << std::scientific << std::setprecision(3)
+              << std::setw(12) << t_min[id] << std::setw(12) << t_avg[id]
+              << std::setw(12) << t_max[id] << std::fixed << std::setprecision(3)
+              << std::setw(8) << (t_sum > 0.0 ? t_avg[id] / t_sum : 0.0)
+              << std::scientific << std::setw(14)
+              << (t_max[id] > 0.0 ? zones / t_max[id] : 0.0) << std::endl;
+    std::cout << std::defaultfloat;
+  }
+
+  if (json_filename.empty()) {
+    return;
+  }
+  std::ofstream os(json_filename);
+  os << std::scientific << std::setprecision(8);
+  os << "{\n  \"zone_cycles\": " << zones << ",\n  \"num_ranks\": "
+     << parthenon::Globals::nranks << ",\n  \"tasks\": [\n";
+  for (int n = 0; n < num_tasks; n++) {
+    const auto id = order[n];
+    os << "    {\"name\": \"" << names_[id] << "\", \"calls\": " << calls[id]
+       << ", \"time_min\": " << t_min[id] << ", \"time_avg\": " << t_avg[id]
+       << ", \"time_max\": " << t_max[id] << ", \"zone_cycles_per_second\": "
+       << (t_max[id] > 0.0 ? zones / t_max[id] : 0.0) << "}"
+       << (n + 1 < num_tasks ? "," : "") << "\n";
+  }
+  os << "  ]\n}" << std::endl;
+}
+
+} // namespace utils
@@ -0,0 +1,101 @@
+#ifndef UTILS_TASK_TIMERS_HPP_
+#define UTILS_TASK_TIMERS_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file task_timers.hpp
+//  \brief Named profiling regions and optional timers for the tasks of the driver
+
+// C++ headers
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parthenon headers
+#include <mesh/mesh.hpp>
+#include <parameter_input.hpp>
+#include <parthenon/package.hpp>
+#include <tasks/tasks.hpp>
+
+namespace utils {
+using parthenon::Real;
+using parthenon::TaskID;
+using parthenon::TaskList;
+using parthenon::TaskStatus;
+
+// All tasks added via AddTask() are wrapped in a named Kokkos profiling region (so that
+// they show up in Kokkos tools without further instrumentation). If enabled (see
+// hydro/task_timers), the time spent in each named task is additionally accumulated and
+// reported (min/avg/max over all ranks and zone-cycles per second) every
+// `task_timers_cycle_interval` cycles and at the end of the run.
+// Kernels are launched asynchronously, i.e., by default the device is fenced before and
+// after each timed task so that the time of the kernels is attributed to the task
+// launching them (at the cost of preventing overlap between tasks).
+// The accumulation is guarded by a mutex as tasks of different task lists may be
+// executed concurrently by multiple host threads (in which case the times of concurrent
+// tasks overlap).
+class TaskTimers {
+ public:
+  explicit TaskTimers(parthenon::ParameterInput *pin);
+
+  bool IsEnabled() const { return enabled_; }
+
+  // Same interface as TaskList::AddTask with an additional name of the task
+  template <typename F, typename... Args>
+  TaskID AddTask(TaskList &tl, const TaskID &dep, const std::string &name, F &&func,
+                 Args &&...args) {
+    const int id = Register(name);
+    auto *timers = this;
+    return tl.AddTask(dep, [=, func = std::forward<F>(func)]() mutable -> TaskStatus {
+      Kokkos::Profiling::pushRegion(timers->names_[id]);
+      const auto start = timers->Start();
+      const TaskStatus status = func(args...);
+      timers->Stop(id, start);
+      Kokkos::Profiling::popRegion();
+      return status;
+    });
+  }
+
+  // To be called at the beginning of each cycle (accounts the zones of the cycle and
+  // reports the last interval if due)
+  void BeginCycle(parthenon::Mesh *pmesh, int ncycle);
+  // End of run report (and JSON output if enabled)
+  void Report();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  int Register(const std::string &name);
+  Clock::time_point Start() const;
+  void Stop(int id, const Clock::time_point &start);
+  // Prints (rank 0) the table of the given times accumulated over the given
+  // (rank local) number of zone-cycles. Collective.
+  void PrintTable(const std::string &title, const std::vector<Real> &times,
+                  const std::vector<std::int64_t> &calls, std::int64_t zone_cycles,
+                  const std::string &json_filename) const;
+
+  bool enabled_, fence_;
+  int cycle_interval_;
+  std::string json_filename_;
+
+  std::map<std::string, int> ids_;
+  std::vector<std::string> names_;
+  // Accumulated over the current interval and the entire run
+  std::vector<Real> interval_times_, total_times_;
+  std::vector<std::int64_t> interval_calls_, total_calls_;
+  std::int64_t interval_zone_cycles_ = 0, total_zone_cycles_ = 0;
+  int interval_num_cycles_ = 0;
+  // Shared so that the timers remain copyable (as param)
+  std::shared_ptr<std::mutex> mutex_ = std::make_shared<std::mutex>();
+};
+
+} // namespace utils
+
+#endif // UTILS_TASK_TIMERS_HPP_
@@ -0,0 +1,57 @@
+#ifndef UTILS_VECTOR_POTENTIAL_HPP_
+#define UTILS_VECTOR_POTENTIAL_HPP_
+//========================================================================================
+// AthenaPK - a performance portable block structured AMR astrophysical MHD code.
+// Copyright (c) 2024, Athena-Parthenon Collaboration. All rights reserved.
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file vector_potential.hpp
+//  \brief Cell centered magnetic fields from analytic vector potentials
+
+// Parthenon headers
+#include <parthenon/package.hpp>
+
+namespace utils {
+using parthenon::Real;
+
+// Stores the curl of the vector potential `potential(x1, x2, x3, a)` (a device function
+// storing the three components in a[3]) at the center of cell (k, j, i) in b[3].
+// Identical to the second order central differences of the potential evaluated at the
+// neighboring cell centers (as used by the problem generators) but does not require
+// storing the potential. This allows initializing fields of entire MeshData objects in
+// the same kernel as the other variables. The derivatives along x3 can be disabled,
+// e.g., for 2D problems with potentials that depend on x3.
+template <typename Coords, typename Potential>
+KOKKOS_INLINE_FUNCTION void CurlOfVectorPotential(const Coords &coords, const int k,
+                                                  const int j, const int i,
+                                                  const Potential &potential, Real b[3],
+                                                  const bool x3_derivatives = true) {
+  const Real x1 = coords.template Xc<1>(i);
+  const Real x2 = coords.template Xc<2>(j);
+  const Real x3 = coords.template Xc<3>(k);
+  const Real dx1 = coords.template Dxc<1>(i);
+  const Real dx2 = coords.template Dxc<2>(j);
+  const Real dx3 = coords.template Dxc<3>(k);
+
+  Real a_p[3], a_m[3];
+  potential(x1 + dx1, x2, x3, a_p);
+  potential(x1 - dx1, x2, x3, a_m);
+  b[1] = -(a_p[2] - a_m[2]) / dx1 / 2.0;
+  b[2] = (a_p[1] - a_m[1]) / dx1 / 2.0;
+
+  potential(x1, x2 + dx2, x3, a_p);
+  potential(x1, x2 - dx2, x3, a_m);
+  b[0] = (a_p[2] - a_m[2]) / dx2 / 2.0;
+  b[2] -= (a_p[0] - a_m[0]) / dx2 / 2.0;
+
+  if (x3_derivatives) {
+    potential(x1, x2, x3 + dx3, a_p);
+    potential(x1, x2, x3 - dx3, a_m);
+    b[0] -= (a_p[1] - a_m[1]) / dx3 / 2.0;
+    b[1] += (a_p[0] - a_m[0]) / dx3 / 2.0;
+  }
+}
+
+} // namespace utils
+
+#endif // UTILS_VECTOR_POTENTIAL_HPP_
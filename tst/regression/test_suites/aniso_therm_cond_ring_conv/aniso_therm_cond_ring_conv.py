@@ -31,6 +31,14 @@ from scipy.optimize import curve_fit
 sys.dont_write_bytecode = True
 
 res_cfgs = [32, 64, 128, 256]
+# The same resolutions are run with the (unsplit) explicit integrator first and then
+# with RKL2 super-time-stepping (limited to 5 times the explicit diffusive timestep as
+# pure diffusion problems have no other timestep constraint).
+diffint_cfgs = ["unsplit", "rkl2"]
+rkl2_max_dt_ratio = 5.0
+# maximum L1 difference between the RKL2 and explicit solutions relative to the L1
+# error of the explicit solution
+rkl2_max_rel_diff = 0.25
 
 
 class TestCase(utils.test_case.TestCaseAbs):
@@ -38,7 +46,8 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         assert parameters.num_ranks <= 4, "Use <= 4 ranks for diffusion test."
 
-        res = res_cfgs[step - 1]
+        res = res_cfgs[(step - 1) % len(res_cfgs)]
+        diffint = diffint_cfgs[(step - 1) // len(res_cfgs)]
 
         nx1 = res
         nx2 = res
@@ -55,8 +64,13 @@ class TestCase(utils.test_case.TestCaseAbs):
             "problem/diffusion/iprob=20",
             "parthenon/time/tlim=200.0",
             "parthenon/output0/dt=200.0",
-            f"parthenon/output0/id={res}",
+            f"parthenon/output0/id={diffint}_{res}",
+            f"diffusion/integrator={diffint}",
         ]
+        if diffint == "rkl2":
+            parameters.driver_cmd_line_args.append(
+                f"diffusion/rkl2_max_dt_ratio={rkl2_max_dt_ratio}"
+            )
 
         return parameters
 
@@ -74,12 +88,18 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         test_success = True
 
-        errs = []
-        for res in res_cfgs:
-            data_filename = f"{parameters.output_path}/parthenon.{res}.final.phdf"
+        def load_temperature(diffint, res):
+            data_filename = (
+                f"{parameters.output_path}/parthenon.{diffint}_{res}.final.phdf"
+            )
             data_file = phdf.phdf(data_filename)
             prim = data_file.Get("prim")
             T = prim[4]  # because of gamma = 2.0 and rho = 1 -> p = e = T
+            return data_file, T
+
+        errs = []
+        for res in res_cfgs:
+            data_file, T = load_temperature("unsplit", res)
             zz, yy, xx = data_file.GetVolumeLocations()
             r = np.sqrt(xx**2 + yy**2)
 
@@ -99,6 +119,19 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         errs = np.array(errs)
 
+        # RKL2 super-time-stepping should agree with the explicit integration to well
+        # within the discretization error
+        for i, res in enumerate(res_cfgs):
+            _, T_explicit = load_temperature("unsplit", res)
+            _, T_rkl2 = load_temperature("rkl2", res)
+            rel_diff = np.mean(np.abs(T_rkl2 - T_explicit)) / errs[i, 0]
+            print(f"RKL2 vs. explicit at {res}^2: relative L1 difference {rel_diff:.3e}")
+            if rel_diff > rkl2_max_rel_diff:
+                print(
+                    f"!!!\nRKL2 solution at {res}^2 differs from the explicit one.\n!!!"
+                )
+                test_success = False
+
         # poor man's test
         if errs[-1, 1] > 0.0264:
             print("!!!\nL2 error at 256^3 larger than expected.\n!!!")
@@ -0,0 +1,124 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import glob
+import numpy as np
+import os
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Blast wave (with mesh refinement) with asynchronous snapshots and (HDF5) outputs at
+# the same cadence. The snapshots are taken at the beginning of the first cycle at or
+# after the output time, i.e., of the same state as the HDF5 output written at the end
+# of the previous cycle, and have to be identical to it (or, for the fields converted to
+# float, agree within the round-off of the conversion).
+output_dt = 0.004
+tlim = 0.01
+basename = "snapshot"
+variables = ["prim"]
+float_variables = ["cons"]
+# Maximum relative difference of the fields converted to float (unit round-off of float,
+# plus the smallest normal float for values that underflow)
+float_rtol = 2.0**-24
+# Minimum number of snapshots (initial state and during the run)
+min_num_snapshots = 2
+
+
+def compare(snap, output):
+    """Returns whether the snapshot agrees with the HDF5 output (of the same time)"""
+    print(f"Comparing snapshot at cycle {snap['cycle']} (time {snap['time']})")
+    # The block bounds of phdf are rounded
+    if len(snap["gid"]) != output.NumBlocks or not np.allclose(
+        snap["bounds"], np.array(output.BlockBounds), rtol=0.0, atol=1e-6
+    ):
+        print("ERROR: Blocks of the snapshot differ from the HDF5 output.")
+        return False
+    success = True
+    for var in variables:
+        values = snap["fields"][var]
+        ref = output.Get(var, flatten=False).reshape(values.shape)
+        if not np.array_equal(values, ref):
+            print(f"ERROR: {var} of the snapshot differs from the HDF5 output.")
+            success = False
+    for var in float_variables:
+        values = snap["fields"][var]
+        ref = output.Get(var, flatten=False).reshape(values.shape)
+        if values.dtype != np.float32 or not np.all(
+            np.abs(values - ref)
+            <= float_rtol * np.abs(ref) + np.finfo(np.float32).tiny
+        ):
+            print(f"ERROR: {var} (float) of the snapshot differs from the HDF5 output.")
+            success = False
+    return success
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        parameters.driver_cmd_line_args = [
+            "parthenon/job/problem_id=async",
+            "parthenon/mesh/numlevel=2",
+            f"parthenon/time/tlim={tlim}",
+            f"parthenon/output0/dt={output_dt}",
+            f"parthenon/output0/variables={','.join(variables + float_variables)}",
+            f"async_output/dt={output_dt}",
+            f"async_output/basename={basename}",
+            f"async_output/variables={','.join(variables)}",
+            f"async_output/float_variables={','.join(float_variables)}",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        sys.path.insert(
+            1,
+            os.path.join(os.path.dirname(os.path.abspath(__file__)), *[".."] * 4)
+            + "/scripts/python",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+        import async_snapshot
+
+        outputs = [
+            phdf.phdf(filename)
+            for filename in sorted(
+                glob.glob(f"{parameters.output_path}/async.out0.*.phdf")
+            )
+        ]
+
+        test_success = True
+        file_number = 0
+        while glob.glob(
+            f"{parameters.output_path}/{basename}.{file_number:05d}.rank*.bin"
+        ):
+            snap = async_snapshot.read_snapshot(
+                f"{parameters.output_path}/{basename}", file_number
+            )
+            matches = [output for output in outputs if output.Time == snap["time"]]
+            if not matches:
+                print(f"ERROR: No HDF5 output at the time of snapshot {file_number}.")
+                test_success = False
+            else:
+                test_success &= compare(snap, matches[0])
+            file_number += 1
+
+        print(f"Compared {file_number} snapshots")
+        if file_number < min_num_snapshots:
+            print(f"ERROR: Expected at least {min_num_snapshots} snapshots.")
+            test_success = False
+
+        return test_success
@@ -82,8 +82,29 @@ class TestCase(utils.test_case.TestCaseAbs):
         # plus 1 for Townsend exact integrator
         self.n_steps = len(self.integrators_and_max_iters) + len(self.integrators) + 1
 
-        self.norm_tol = 1e-3
         self.machine_epsilon = 1e-14
+
+        # Additional adaptive runs of the subcycling integrators with different code
+        # paths that are compared to the adaptive runs above (with the default
+        # parameters). Cells requiring more than `compaction_iter` subcycles are
+        # compacted into a work list, which does not change the results. The fast
+        # cooling table only differs in roundoff of the cooling rates.
+        self.path_args = {
+            "no_compaction": ["cooling/compaction_iter=0"],
+            "early_compaction": ["cooling/compaction_iter=1"],
+            "fast_table": ["cooling/fast_table=true"],
+        }
+        self.path_tol = {
+            "no_compaction": self.machine_epsilon,
+            "early_compaction": self.machine_epsilon,
+            "fast_table": 1e-10,
+        }
+        self.integrators_and_paths = list(
+            itertools.product(self.integrators, self.path_args.keys())
+        )
+        self.n_total_steps = self.n_steps + len(self.integrators_and_paths)
+
+        self.norm_tol = 1e-3
         self.integrator_tol = {"rk12": 1e-4, "rk45": 1e-10, "townsend": 1e-14}
         self.integrator_order = {"rk12": 2, "rk45": 5}
 
@@ -137,7 +158,7 @@ class TestCase(utils.test_case.TestCaseAbs):
             d_e_tol = self.machine_epsilon
             # Use a reasonable cooling cfl
             cooling_cfl = self.cooling_cfl_convergence_test
-        else:
+        elif step == self.n_steps:
             integrator = "townsend"
             # Parameter unused (still, Townsend is an exact, single step integrator)
             max_iter = 1
@@ -145,6 +166,12 @@ class TestCase(utils.test_case.TestCaseAbs):
             d_e_tol = self.machine_epsilon
             # Use a reasonable cooling cfl (unused)
             cooling_cfl = self.cooling_cfl_convergence_test
+        else:
+            # Test alternative code paths with the same setup as the adaptive tests
+            integrator, path = self.integrators_and_paths[step - self.n_steps - 1]
+            max_iter = max(self.max_iters)
+            d_e_tol = self.machine_epsilon
+            cooling_cfl = self.cooling_cfl_convergence_test
 
         # Create the tabular cooling file (in log cgs)
         table_filename = "exponential.cooling"
@@ -178,6 +205,8 @@ class TestCase(utils.test_case.TestCaseAbs):
             f"cooling/max_iter={max_iter}",
             f"cooling/d_e_tol={d_e_tol}",
         ]
+        if step > self.n_steps:
+            parameters.driver_cmd_line_args += self.path_args[path]
 
         return parameters
 
@@ -294,7 +323,7 @@ class TestCase(utils.test_case.TestCaseAbs):
             return np.max((non_zero_linf, zero_linf))
 
         # Verify the initial state
-        for step in range(1, self.n_steps + 1):
+        for step in range(1, self.n_total_steps + 1):
             data_filename = (
                 f"{parameters.output_path}/parthenon.tabular_cooling_{step}.00000.phdf"
             )
@@ -341,8 +370,9 @@ class TestCase(utils.test_case.TestCaseAbs):
         # Read and check the final state of all sims
         conv_final_internal_es = {}  # internal_e for convergence study
         adapt_final_internal_es = {}  # internal_e for the adaptive tests
+        path_final_internal_es = {}  # internal_e for the alternative code paths
 
-        for step in range(1, self.n_steps + 1):
+        for step in range(1, self.n_total_steps + 1):
             data_filename = (
                 f"{parameters.output_path}/parthenon.tabular_cooling_{step}.final.phdf"
             )
@@ -393,9 +423,13 @@ class TestCase(utils.test_case.TestCaseAbs):
                 adapt_step = step - len(self.integrators_and_max_iters)
                 integrator = self.integrators[adapt_step - 1]
                 adapt_final_internal_es[integrator] = internal_e
-            else:
+            elif step == self.n_steps:
                 integrator = "townsend"
                 adapt_final_internal_es[integrator] = internal_e
+            else:
+                path_final_internal_es[
+                    self.integrators_and_paths[step - self.n_steps - 1]
+                ] = internal_e
 
         for integrator in self.integrators:
             final_internal_es = unyt.unyt_array(
@@ -480,6 +514,20 @@ class TestCase(utils.test_case.TestCaseAbs):
                 print(f"    {adapt_err} >= {self.integrator_tol[integrator]}")
                 analyze_status = False
 
+        for integrator, path in self.integrators_and_paths:
+            # Check that the alternative code paths agree with the default one
+            path_err = np.abs(
+                (
+                    path_final_internal_es[(integrator, path)]
+                    - adapt_final_internal_es[integrator]
+                )
+                / adapt_final_internal_es[integrator]
+            )
+            if path_err > self.path_tol[path]:
+                print(f"ERROR: {integrator} with {path} differs from the default")
+                print(f"    {path_err} > {self.path_tol[path]}")
+                analyze_status = False
+
         ax.set_xscale("log")
         ax.set_yscale("log")
 
@@ -42,7 +42,17 @@ method_cfgs = [
     {"integrator": "rk3", "recon": "weno3"},
     {"integrator": "rk3", "recon": "limo3"},
     {"integrator": "rk3", "recon": "wenoz"},
+    # Mixed precision runs (reconstructed states stored in single precision).
+    # These are only run if AthenaPK_ENABLE_MIXED_PRECISION=ON and must remain at the
+    # end of the list as the quick tests below use fixed indices.
+    {"integrator": "vl2", "recon": "plm", "mixed_precision": True},
+    {"integrator": "rk3", "recon": "ppm", "mixed_precision": True},
 ]
+# index of the full precision reference run for each mixed precision run
+mixed_precision_refs = {10: 2, 11: 6}
+# maximum ratio of mixed to full precision L1 error at the lowest resolution where
+# the truncation error is expected to dominate over round-off
+mixed_precision_max_ratio = 2.0
 
 
 class TestCase(utils.test_case.TestCaseAbs):
@@ -94,6 +104,8 @@ class TestCase(utils.test_case.TestCaseAbs):
         while mb_nx1 > 128:
             mb_nx1 //= 2
 
+        mixed_precision = method_cfg.get("mixed_precision", False)
+
         parameters.driver_cmd_line_args = [
             "parthenon/mesh/nx1=%d" % (2 * res),
             "parthenon/meshblock/nx1=%d" % mb_nx1,
@@ -106,6 +118,7 @@ class TestCase(utils.test_case.TestCaseAbs):
             "parthenon/time/integrator=%s" % integrator,
             "hydro/reconstruction=%s" % recon,
             "hydro/riemann=%s" % riemann,
+            "hydro/mixed_precision=%s" % ("true" if mixed_precision else "false"),
         ]
 
         return parameters
@@ -141,6 +154,9 @@ class TestCase(utils.test_case.TestCaseAbs):
         analyze_status = True
         n_res = len(lin_res)
         n_meth = len(method_cfgs)
+        # mixed precision runs are skipped if not compiled in
+        if len(lines) == n_res * (n_meth - len(mixed_precision_refs)) + 1:
+            n_meth -= len(mixed_precision_refs)
 
         if len(lines) != n_res * n_meth + 1:
             print(
@@ -163,8 +179,30 @@ class TestCase(utils.test_case.TestCaseAbs):
         if data[10, 4] > 1.547584e-08:
             analyze_status = False
 
-        markers = "ov^<>sp*hXD"
-        for i, cfg in enumerate(method_cfgs):
+        # Quantify accuracy cost of storing reconstructed states in single precision
+        for i_mixed, i_ref in mixed_precision_refs.items():
+            if i_mixed >= n_meth:
+                continue
+            err_mixed = data[i_mixed * n_res : (i_mixed + 1) * n_res, 4]
+            err_ref = data[i_ref * n_res : (i_ref + 1) * n_res, 4]
+            ratios = err_mixed / err_ref
+            cfg = method_cfgs[i_mixed]
+            print(
+                f'Mixed precision {cfg["integrator"].upper()} {cfg["recon"].upper()} '
+                f"L1 error ratio to full precision for res {lin_res}: {ratios}"
+            )
+            if not np.all(np.isfinite(err_mixed)):
+                print("Mixed precision errors are not finite.")
+                analyze_status = False
+            if ratios[0] > mixed_precision_max_ratio:
+                print(
+                    f"Mixed precision error ratio {ratios[0]} at lowest resolution "
+                    f"exceeds {mixed_precision_max_ratio}."
+                )
+                analyze_status = False
+
+        markers = "ov^<>sp*hXDd+"
+        for i, cfg in enumerate(method_cfgs[:n_meth]):
             plt.plot(
                 data[i * n_res : (i + 1) * n_res, 0],
                 data[i * n_res : (i + 1) * n_res, 4],
@@ -173,6 +211,7 @@ class TestCase(utils.test_case.TestCaseAbs):
                     (
                         f'{cfg["integrator"].upper()} {cfg["recon"].upper()} '
                         f'{"hlle" if "riemann" not in cfg.keys() else cfg["riemann"]}'
+                        f'{" mixed" if cfg.get("mixed_precision", False) else ""}'
                     )
                 ),
             )
@@ -0,0 +1,171 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import os
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# All flux kernels are expected to result in identical fluxes. This is checked for all
+# reconstructions (and both fluids) by comparing the results of the other kernels
+# (including the tight_boundary kernel used with overlap_flux_correction) to the ones of
+# the (reference) scratch kernel for
+# - the 3D linear wave convergence runs (L1 errors), and
+# - a 3D blast wave with mesh refinement (final states).
+flux_kernels = ["scratch", "fused", "tight"]
+lin_res = [16, 32]
+linwave_methods = [
+    {"integrator": "rk1", "recon": "dc"},
+    {"integrator": "vl2", "recon": "plm"},
+    {"integrator": "rk3", "recon": "ppm"},
+    {"integrator": "rk2", "recon": "weno3"},
+    {"integrator": "rk3", "recon": "limo3"},
+    {"integrator": "rk3", "recon": "wenoz"},
+    {"integrator": "vl2", "recon": "plm", "fluid": "glmmhd", "riemann": "hlld"},
+]
+blast_recons = ["dc", "plm", "ppm", "weno3", "limo3", "wenoz"]
+# Flux kernel and additional arguments of the blast wave runs (the first is the
+# reference)
+blast_cfgs = [
+    {"name": "scratch", "args": ["hydro/flux_kernel=scratch"]},
+    {"name": "fused", "args": ["hydro/flux_kernel=fused"]},
+    {"name": "tight", "args": ["hydro/flux_kernel=tight"]},
+    # Fluxes on the block faces calculated first by the tight_boundary kernel
+    {
+        "name": "tight_overlap",
+        "args": ["hydro/flux_kernel=tight", "hydro/overlap_flux_correction=true"],
+    },
+    {
+        "name": "scratch_overlap",
+        "args": ["hydro/flux_kernel=scratch", "hydro/overlap_flux_correction=true"],
+    },
+]
+
+linwave_runs = [
+    (method, kernel, res)
+    for method in linwave_methods
+    for kernel in flux_kernels
+    for res in lin_res
+]
+blast_runs = [(recon, cfg) for recon in blast_recons for cfg in blast_cfgs]
+
+# Maximum relative difference to the scratch kernel (identical up to round-off)
+max_rel_diff = 1e-10
+
+
+def get_method_name(method):
+    return f"{method.get('fluid', 'euler')}_{method['recon']}"
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        # The blast wave input is located next to the default (linear wave) input file
+        if not hasattr(self, "inputs_dir"):
+            self.inputs_dir = os.path.dirname(parameters.driver_input_path)
+
+        if step <= len(linwave_runs):
+            method, kernel, res = linwave_runs[step - 1]
+            parameters.driver_input_path = os.path.join(
+                self.inputs_dir, "linear_wave3d.in"
+            )
+            parameters.driver_cmd_line_args = [
+                f"parthenon/job/problem_id=linwave_{get_method_name(method)}_{kernel}",
+                f"parthenon/mesh/nx1={2 * res}",
+                f"parthenon/meshblock/nx1={res}",
+                f"parthenon/mesh/nx2={res}",
+                f"parthenon/meshblock/nx2={res // 2}",
+                f"parthenon/mesh/nx3={res}",
+                f"parthenon/meshblock/nx3={res // 2}",
+                "parthenon/mesh/nghost=3",
+                f"parthenon/time/integrator={method['integrator']}",
+                f"hydro/fluid={method.get('fluid', 'euler')}",
+                f"hydro/reconstruction={method['recon']}",
+                f"hydro/riemann={method.get('riemann', 'hlle')}",
+                f"hydro/flux_kernel={kernel}",
+            ]
+        else:
+            recon, cfg = blast_runs[step - 1 - len(linwave_runs)]
+            parameters.driver_input_path = os.path.join(
+                self.inputs_dir, "blast_3d_amr.in"
+            )
+            parameters.driver_cmd_line_args = [
+                f"parthenon/job/problem_id=blast_{recon}_{cfg['name']}",
+                "parthenon/mesh/numlevel=2",
+                "parthenon/mesh/nghost=3",
+                "parthenon/time/integrator=rk2",
+                "parthenon/time/tlim=0.02",
+                "parthenon/output0/dt=0.02",
+                "parthenon/output0/id=cons",
+                "problem/blast/pressure_ratio=100.0",
+                f"hydro/reconstruction={recon}",
+            ] + cfg["args"]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+
+        # Linear waves: one line per run (in the order of the runs)
+        errs = np.atleast_2d(
+            np.genfromtxt(os.path.join(parameters.output_path, "linearwave-errors.dat"))
+        )
+        if errs.shape[0] != len(linwave_runs):
+            print(f"ERROR: Expected {len(linwave_runs)} linear wave errors.")
+            return False
+        errs = errs[:, 4].reshape(len(linwave_methods), len(flux_kernels), len(lin_res))
+        for i, method in enumerate(linwave_methods):
+            name = get_method_name(method)
+            err_ref = errs[i, 0]
+            if not err_ref[-1] < err_ref[0]:
+                print(f"ERROR: {name} with scratch kernel does not converge: {err_ref}")
+                test_success = False
+            for j, kernel in enumerate(flux_kernels[1:], start=1):
+                rel_diff = np.abs(errs[i, j] - err_ref) / err_ref
+                print(f"linwave {name} {kernel}: rel. error difference {rel_diff}")
+                if not np.all(rel_diff <= max_rel_diff):
+                    print(f"ERROR: {kernel} kernel differs from scratch for {name}.")
+                    test_success = False
+
+        # Blast wave: comparison of the final states
+        for recon in blast_recons:
+            ref_cfg = blast_cfgs[0]
+            data_ref = phdf.phdf(
+                f"{parameters.output_path}/blast_{recon}_{ref_cfg['name']}"
+                ".cons.final.phdf"
+            )
+            cons_ref = data_ref.Get("cons", flatten=False)
+            for cfg in blast_cfgs[1:]:
+                data = phdf.phdf(
+                    f"{parameters.output_path}/blast_{recon}_{cfg['name']}"
+                    ".cons.final.phdf"
+                )
+                cons = data.Get("cons", flatten=False)
+                if cons.shape != cons_ref.shape:
+                    print(f"ERROR: Mesh of {cfg['name']} differs for {recon} blast.")
+                    test_success = False
+                    continue
+                rel_diff = np.max(np.abs(cons - cons_ref)) / np.max(np.abs(cons_ref))
+                print(f"blast {recon} {cfg['name']}: max. rel. difference {rel_diff}")
+                if not rel_diff <= max_rel_diff:
+                    print(f"ERROR: {cfg['name']} differs from scratch for {recon}.")
+                    test_success = False
+
+        return test_success
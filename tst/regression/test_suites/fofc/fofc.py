@@ -0,0 +1,136 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import os
+import re
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Strong 3D blast wave (with mesh refinement) that requires the first order flux
+# correction. The first run (correction in all stages rechecking all cells in every
+# attempt) is the reference for the other configurations of the correction.
+fofc_cfgs = [
+    {
+        "name": "all_full_recheck",
+        "args": [
+            "hydro/first_order_flux_correct_stages=all",
+            "hydro/first_order_flux_correct_work_list=false",
+        ],
+    },
+    # Only the cells corrected in the previous attempt (and their neighbors) are
+    # rechecked, which yields identical results
+    {"name": "all", "args": ["hydro/first_order_flux_correct_stages=all"]},
+    # Correction only in the final stage (with the first order fluxes calculated from
+    # the initial state of the cycle). As the intermediate state is not corrected, the
+    # results only agree approximately with the reference.
+    {
+        "name": "final_full_recheck",
+        "args": [
+            "hydro/first_order_flux_correct_stages=final",
+            "hydro/first_order_flux_correct_work_list=false",
+        ],
+        "max_rel_diff": 1e-2,
+    },
+    # Identical to the previous run (but with the work list)
+    {
+        "name": "final",
+        "args": ["hydro/first_order_flux_correct_stages=final"],
+        "ref": 2,
+    },
+]
+
+tlim = 0.01
+
+# Default maximum L1 difference in density (relative to the mean density) to the
+# reference (run "ref", or the first run if not set). For identical results, the total
+# number of corrected cells also has to agree.
+default_max_rel_diff = 1e-12
+
+
+def read_hst(filename):
+    """Returns the history data and a dict of the column indices of all variables"""
+    with open(filename, "r") as f:
+        header = [line for line in f if line.startswith("#") and "[1]=" in line][-1]
+    columns = {
+        name: int(idx) - 1 for idx, name in re.findall(r"\[(\d+)\]=(\S+)", header)
+    }
+    return np.atleast_2d(np.genfromtxt(filename)), columns
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        cfg = fofc_cfgs[step - 1]
+        parameters.driver_cmd_line_args = [
+            f"parthenon/job/problem_id=fofc_{cfg['name']}",
+            "parthenon/mesh/nghost=3",
+            "parthenon/mesh/numlevel=2",
+            "parthenon/time/integrator=vl2",
+            f"parthenon/time/tlim={tlim}",
+            f"parthenon/output0/dt={tlim}",
+            "parthenon/output0/id=cons",
+            "parthenon/output1/file_type=hst",
+            "parthenon/output1/dt=-1.0",
+            "parthenon/output1/ncycle=1",
+            "hydro/reconstruction=ppm",
+            "hydro/riemann=hllc",
+            "hydro/first_order_flux_correct=true",
+        ] + cfg["args"]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+
+        rhos = []
+        num_corrected = []
+        for cfg in fofc_cfgs:
+            outname = f"{parameters.output_path}/fofc_{cfg['name']}"
+            data_file = phdf.phdf(f"{outname}.cons.final.phdf")
+            rhos.append(data_file.Get("cons", flatten=False)[:, 0])
+            hst, columns = read_hst(f"{outname}.hst")
+            num_corrected.append(np.sum(hst[:, columns["fofc_num_corrected"]]))
+            print(f"{cfg['name']}: {num_corrected[-1]} corrected cells in total")
+            if not num_corrected[-1] > 0:
+                print(f"ERROR: No cell corrected with {cfg['name']}.")
+                test_success = False
+            if not np.all(np.isfinite(rhos[-1])) or np.min(rhos[-1]) <= 0.0:
+                print(f"ERROR: Invalid density with {cfg['name']}.")
+                test_success = False
+
+        for n, cfg in enumerate(fofc_cfgs[1:], start=1):
+            ref = cfg.get("ref", 0)
+            ref_name = fofc_cfgs[ref]["name"]
+            if rhos[n].shape != rhos[ref].shape:
+                print(f"ERROR: Mesh of {cfg['name']} differs from {ref_name}.")
+                test_success = False
+                continue
+            rel_diff = np.mean(np.abs(rhos[n] - rhos[ref])) / np.mean(rhos[ref])
+            max_rel_diff = cfg.get("max_rel_diff", default_max_rel_diff)
+            print(f"{cfg['name']}: relative L1 difference in density {rel_diff}")
+            if not rel_diff <= max_rel_diff:
+                print(f"ERROR: {cfg['name']} differs from {ref_name}.")
+                test_success = False
+            if "max_rel_diff" not in cfg and num_corrected[n] != num_corrected[ref]:
+                print(f"ERROR: {cfg['name']} corrected other cells than {ref_name}.")
+                test_success = False
+
+        return test_success
@@ -0,0 +1,121 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import os
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Pairs of runs with the hlld (reference) and the hlld_branchless Riemann solver, which
+# are expected to agree up to round-off:
+# - 3D MHD linear waves (fast, Alfven, slow, and entropy wave), and
+# - the Brio & Wu shock tube (sod problem generator with magnetic fields), which covers
+#   the intermediate states and the degenerate cases of both solvers.
+riemann_solvers = ["hlld", "hlld_branchless"]
+linwave_flags = [0, 1, 2, 3]
+problem_cfgs = [
+    {
+        "name": f"linwave{wave_flag}",
+        "input": "linear_wave3d.in",
+        "args": [
+            f"problem/linear_wave/wave_flag={wave_flag}",
+            "parthenon/mesh/nx1=32",
+            "parthenon/meshblock/nx1=16",
+            "parthenon/mesh/nx2=16",
+            "parthenon/meshblock/nx2=16",
+            "parthenon/mesh/nx3=16",
+            "parthenon/meshblock/nx3=16",
+        ],
+    }
+    for wave_flag in linwave_flags
+] + [
+    {
+        "name": "brio_wu",
+        "input": "sod.in",
+        "args": [
+            "hydro/gamma=2.0",
+            "problem/sod/bx=0.75",
+            "problem/sod/by_l=1.0",
+            "problem/sod/by_r=-1.0",
+            "parthenon/mesh/nx1=512",
+            "parthenon/time/tlim=0.1",
+            "parthenon/output0/dt=0.1",
+        ],
+    },
+]
+
+all_cfgs = [
+    (problem, riemann) for problem in problem_cfgs for riemann in riemann_solvers
+]
+
+# Maximum relative differences between both solvers (of the linear wave L1 errors and
+# the L1 norm of the density of the shock tube)
+max_rel_diff = 1e-6
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        problem, riemann = all_cfgs[step - 1]
+        # All input files are located next to the default (linear wave) input file
+        if not hasattr(self, "inputs_dir"):
+            self.inputs_dir = os.path.dirname(parameters.driver_input_path)
+        parameters.driver_input_path = os.path.join(self.inputs_dir, problem["input"])
+
+        parameters.driver_cmd_line_args = [
+            f"parthenon/job/problem_id={problem['name']}_{riemann}",
+            "hydro/fluid=glmmhd",
+            f"hydro/riemann={riemann}",
+        ] + problem["args"]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+
+        # Linear waves: the errors of all linear wave runs are appended to a single file
+        errs = np.atleast_2d(
+            np.genfromtxt(os.path.join(parameters.output_path, "linearwave-errors.dat"))
+        )
+        if errs.shape[0] != len(linwave_flags) * len(riemann_solvers):
+            print("ERROR: Unexpected number of linear wave errors.")
+            return False
+        for i, wave_flag in enumerate(linwave_flags):
+            err_ref, err = errs[2 * i, 4], errs[2 * i + 1, 4]
+            rel_diff = abs(err - err_ref) / err_ref
+            print(f"Wave {wave_flag}: L1 error {err_ref} (hlld), {err} (branchless)")
+            if not rel_diff <= max_rel_diff:
+                print(f"ERROR: hlld_branchless differs for wave {wave_flag}.")
+                test_success = False
+
+        # Shock tube: comparison of the final states
+        rhos = []
+        for riemann in riemann_solvers:
+            data_file = phdf.phdf(
+                f"{parameters.output_path}/brio_wu_{riemann}.prim.final.phdf"
+            )
+            rhos.append(data_file.Get("prim")[0].ravel())
+        rel_diff = np.sum(np.abs(rhos[1] - rhos[0])) / np.sum(rhos[0])
+        print(f"Brio & Wu: relative L1 difference in density {rel_diff}")
+        if not rel_diff <= max_rel_diff:
+            print("ERROR: hlld_branchless differs for the Brio & Wu shock tube.")
+            test_success = False
+
+        return test_success
@@ -0,0 +1,115 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import os
+import re
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Linear wave convergence of the hybrid reconstructions and their high order methods.
+# The threshold of the indicator is lowered below the relative variation of the (small
+# amplitude) waves so that the hybrid reconstructions are expected to (almost only) use
+# the high order method and, thus, to keep its accuracy.
+lin_res = [16, 32, 64]
+method_cfgs = [
+    {"recon": "ppm", "hybrid": False},
+    {"recon": "ppm", "hybrid": True},
+    {"recon": "wenoz", "hybrid": False},
+    {"recon": "wenoz", "hybrid": True},
+]
+hybrid_recon_threshold = 1e-10
+# Maximum ratio of the L1 errors of the hybrid and the high order reconstruction
+max_err_ratio = 1.2
+# Minimum fraction of cell reconstructions using the high order method
+min_high_order_frac = 0.95
+
+
+def get_recon(cfg):
+    return f"hybrid_{cfg['recon']}" if cfg["hybrid"] else cfg["recon"]
+
+
+def read_hst(filename):
+    """Returns the history data and a dict of the column indices of all variables"""
+    with open(filename, "r") as f:
+        header = [line for line in f if line.startswith("#") and "[1]=" in line][-1]
+    columns = {
+        name: int(idx) - 1 for idx, name in re.findall(r"\[(\d+)\]=(\S+)", header)
+    }
+    return np.atleast_2d(np.genfromtxt(filename)), columns
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        assert parameters.num_ranks <= 4, "Use <= 4 ranks for hybrid_recon test."
+
+        res = lin_res[(step - 1) % len(lin_res)]
+        cfg = method_cfgs[(step - 1) // len(lin_res)]
+        mb_nx1 = (2 * res) // parameters.num_ranks
+
+        parameters.driver_cmd_line_args = [
+            f"parthenon/job/problem_id={get_recon(cfg)}_{res}",
+            f"parthenon/mesh/nx1={2 * res}",
+            f"parthenon/meshblock/nx1={mb_nx1}",
+            f"parthenon/mesh/nx2={res}",
+            f"parthenon/meshblock/nx2={res}",
+            f"parthenon/mesh/nx3={res}",
+            f"parthenon/meshblock/nx3={res}",
+            "parthenon/mesh/nghost=3",
+            "parthenon/time/integrator=rk3",
+            f"hydro/reconstruction={get_recon(cfg)}",
+            "hydro/riemann=hlle",
+            f"hydro/hybrid_recon_threshold={hybrid_recon_threshold}",
+            "hydro/hybrid_recon_hst=true",
+            "parthenon/output1/file_type=hst",
+            "parthenon/output1/dt=0.1",
+        ]
+
+        return parameters
+
+    def Analyse(self, parameters):
+        n_res = len(lin_res)
+        data = np.atleast_2d(
+            np.genfromtxt(os.path.join(parameters.output_path, "linearwave-errors.dat"))
+        )
+        if data.shape[0] != n_res * len(method_cfgs):
+            print(
+                f"ERROR: Expected {n_res * len(method_cfgs)} linear wave errors, "
+                f"but got {data.shape[0]}."
+            )
+            return False
+
+        test_success = True
+        for i in range(0, len(method_cfgs), 2):
+            err_ref = data[i * n_res : (i + 1) * n_res, 4]
+            err_hybrid = data[(i + 1) * n_res : (i + 2) * n_res, 4]
+            ratios = err_hybrid / err_ref
+            name = get_recon(method_cfgs[i + 1])
+            print(
+                f"{name}: L1 error ratio to {method_cfgs[i]['recon']} for res "
+                f"{lin_res}: {ratios}"
+            )
+            if not np.all(np.isfinite(ratios)) or np.any(ratios > max_err_ratio):
+                print(f"ERROR: {name} less accurate than its high order method.")
+                test_success = False
+
+            for res in lin_res:
+                hst, columns = read_hst(
+                    os.path.join(parameters.output_path, f"{name}_{res}.hst")
+                )
+                num_plm = hst[-1, columns["recon_plm_cells"]]
+                num_high_order = hst[-1, columns["recon_high_order_cells"]]
+                frac = num_high_order / max(num_plm + num_high_order, 1.0)
+                print(f"{name} res {res}: high order fraction {frac}")
+                if not frac >= min_high_order_frac:
+                    print(f"ERROR: {name} did not use the high order method.")
+                    test_success = False
+
+        return test_success
@@ -0,0 +1,170 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import os
+import re
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Pairs of runs with the accurate (reference) and the hybrid Riemann solver.
+# The smooth linear waves (with the default thresholds) are calculated with the HLLE
+# path only whereas the shock tube and the Orszag-Tang vortex use both paths.
+# For MHD, the plasma beta threshold is lowered as otherwise all interfaces of the
+# (strongly magnetized) problems use HLLD.
+problem_cfgs = [
+    {"name": "linwave_hd", "input": "linear_wave3d.in", "fluid": "euler"},
+    {
+        "name": "linwave_mhd",
+        "input": "linear_wave3d.in",
+        "fluid": "glmmhd",
+        "args": ["hydro/hybrid_beta=0.0"],
+    },
+    {
+        "name": "sod",
+        "input": "sod.in",
+        "fluid": "euler",
+        "args": [
+            "parthenon/time/tlim=0.2",
+            "parthenon/output0/dt=0.2",
+            "parthenon/output1/file_type=hst",
+            "parthenon/output1/dt=0.02",
+        ],
+    },
+    {
+        "name": "orszag_tang",
+        "input": "orszag_tang.in",
+        "fluid": "glmmhd",
+        "args": [
+            "parthenon/mesh/nx1=128",
+            "parthenon/meshblock/nx1=64",
+            "parthenon/mesh/nx2=128",
+            "parthenon/meshblock/nx2=64",
+            "parthenon/time/tlim=0.5",
+            "parthenon/output0/dt=0.5",
+            "parthenon/output1/dt=0.05",
+            "hydro/reconstruction=plm",
+            "hydro/hybrid_beta=1.0",
+        ],
+    },
+]
+
+all_cfgs = [(problem, hybrid) for problem in problem_cfgs for hybrid in [False, True]]
+
+# Maximum ratio of the L1 error of the linear waves with the hybrid and the accurate
+# solver
+max_linwave_err_ratio = 1.5
+# Maximum L1 difference in density (relative to the mean density) between the runs with
+# the hybrid and the accurate solver
+max_rel_diff = {"sod": 1e-2, "orszag_tang": 5e-2}
+
+
+def get_riemann(problem, hybrid):
+    if problem["fluid"] == "euler":
+        return "hybrid_hllc" if hybrid else "hllc"
+    return "hybrid_hlld" if hybrid else "hlld"
+
+
+def get_outname(problem, hybrid):
+    return f"{problem['name']}_{get_riemann(problem, hybrid)}"
+
+
+def read_hst(filename):
+    """Returns the history data and a dict of the column indices of all variables"""
+    with open(filename, "r") as f:
+        header = [line for line in f if line.startswith("#") and "[1]=" in line][-1]
+    columns = {
+        name: int(idx) - 1 for idx, name in re.findall(r"\[(\d+)\]=(\S+)", header)
+    }
+    return np.atleast_2d(np.genfromtxt(filename)), columns
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        problem, hybrid = all_cfgs[step - 1]
+        # All input files are located next to the default (linear wave) input file
+        if not hasattr(self, "inputs_dir"):
+            self.inputs_dir = os.path.dirname(parameters.driver_input_path)
+        parameters.driver_input_path = os.path.join(self.inputs_dir, problem["input"])
+
+        parameters.driver_cmd_line_args = [
+            f"parthenon/job/problem_id={get_outname(problem, hybrid)}",
+            "parthenon/output0/id=prim",
+            "parthenon/output0/variables=prim",
+            f"hydro/fluid={problem['fluid']}",
+            f"hydro/riemann={get_riemann(problem, hybrid)}",
+            "hydro/hybrid_hst=true",
+        ] + problem.get("args", [])
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+
+        # Linear waves: the errors of all linear wave runs are appended to a single file
+        linwave_errs = np.atleast_2d(
+            np.genfromtxt(os.path.join(parameters.output_path, "linearwave-errors.dat"))
+        )
+        linwave_cfgs = [
+            cfg for cfg in all_cfgs if cfg[0]["input"] == "linear_wave3d.in"
+        ]
+        if linwave_errs.shape[0] != len(linwave_cfgs):
+            print(
+                f"ERROR: Expected {len(linwave_cfgs)} linear wave errors, "
+                f"but got {linwave_errs.shape[0]}."
+            )
+            return False
+        for i in range(0, len(linwave_cfgs), 2):
+            name = linwave_cfgs[i][0]["name"]
+            err_ref, err_hybrid = linwave_errs[i, 4], linwave_errs[i + 1, 4]
+            print(f"{name}: L1 error {err_ref} (accurate), {err_hybrid} (hybrid)")
+            if not err_hybrid <= max_linwave_err_ratio * err_ref:
+                print(f"ERROR: Hybrid solver not accurate for {name}.")
+                test_success = False
+
+        # Shock tube and Orszag-Tang: comparison of the final states and both paths used
+        for problem in problem_cfgs:
+            if problem["name"] not in max_rel_diff:
+                continue
+            rhos = []
+            for hybrid in [False, True]:
+                outname = get_outname(problem, hybrid)
+                data_file = phdf.phdf(
+                    f"{parameters.output_path}/{outname}.prim.final.phdf"
+                )
+                rhos.append(data_file.Get("prim")[0].ravel())
+            rel_diff = np.mean(np.abs(rhos[1] - rhos[0])) / np.mean(rhos[0])
+            print(f"{problem['name']}: relative L1 difference in density {rel_diff}")
+            if not np.isfinite(rel_diff) or rel_diff > max_rel_diff[problem["name"]]:
+                print(f"ERROR: Hybrid solver differs for {problem['name']}.")
+                test_success = False
+
+            data, columns = read_hst(
+                f"{parameters.output_path}/{get_outname(problem, True)}.hst"
+            )
+            num_hlle = data[-1, columns["riemann_hlle_interfaces"]]
+            num_accurate = data[-1, columns["riemann_accurate_interfaces"]]
+            print(f"{problem['name']}: {num_hlle} HLLE, {num_accurate} accurate")
+            if num_hlle <= 0 or num_accurate <= 0:
+                print(f"ERROR: Hybrid solver used a single path for {problem['name']}.")
+                test_success = False
+
+        return test_success
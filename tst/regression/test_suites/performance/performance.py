@@ -16,6 +16,7 @@
 # ========================================================================================
 
 # Modules
+import json
 import math
 import numpy as np
 import matplotlib
@@ -29,6 +30,7 @@ import utils.test_case
 """ To prevent littering up imported folders with .pyc files or __pycache_ folder"""
 sys.dont_write_bytecode = True
 
+# Single rank configurations of the linear wave on a uniform grid (comparing methods)
 perf_cfgs = [
     {"mx": 256, "mb": 256, "integrator": "vl2", "recon": "plm"},
     {"mx": 256, "mb": 128, "integrator": "vl2", "recon": "plm"},
@@ -53,40 +55,133 @@ perf_cfgs = [
     {"mx": 256, "mb": 128, "integrator": "rk3", "recon": "wenoz", "fluid": "glmmhd"},
 ]
 
+# Application configurations that are additionally run with multiple ranks (in the
+# order of the rank local steps)
+app_cfgs = [
+    # Strong scaling: fixed mesh independent of the number of ranks
+    {"name": "strong scaling", "mx": 128, "mb": 32},
+    # Weak scaling: fixed number of blocks (8) per rank
+    {"name": "weak scaling", "mx": 64, "mb": 32, "weak": True},
+    {
+        "name": "AMR blast",
+        "input": "blast_3d_amr.in",
+        "args": ["parthenon/time/nlim=20", "parthenon/output0/dt=-1"],
+    },
+    {
+        "name": "cooling cluster",
+        "input": "cluster/cooling.in",
+        "mx": 64,
+        "mb": 32,
+        "args": [
+            "cooling/table_filename=%INPUTS%/cooling_tables/schure.cooling",
+            "parthenon/time/nlim=10",
+            "parthenon/output1/dt=-1",
+            "parthenon/output2/dt=-1",
+        ],
+    },
+    {
+        "name": "anisotropic conduction",
+        "input": "diffusion.in",
+        "args": [
+            "parthenon/mesh/nx3=64",
+            "parthenon/meshblock/nx3=32",
+            "parthenon/time/nlim=10",
+            "parthenon/output0/dt=-1",
+        ],
+    },
+    {
+        "name": "turbulence driving",
+        "input": "turbulence.in",
+        "mx": 64,
+        "mb": 32,
+        "args": [
+            "parthenon/time/nlim=10",
+            "parthenon/output1/dt=-1",
+            "parthenon/output2/dt=-1",
+            "parthenon/output3/dt=-1",
+        ],
+    },
+]
+
 for cfg in perf_cfgs:
     if "fluid" not in cfg.keys():
         cfg["fluid"] = "euler"
+    if "riemann" not in cfg.keys():
+        cfg["riemann"] = "hlle"
+    cfg["name"] = (
+        f'{cfg["integrator"].upper()} {cfg["recon"].upper()} '
+        f'Mesh {cfg["mx"]}^3 MB {cfg["mb"]}^3'
+        f'{" MHD" if cfg["fluid"] == "glmmhd" else ""}'
+        f'{"" if cfg["riemann"] == "hlle" else " " + cfg["riemann"]}'
+    )
+
+
+def get_cfgs(num_ranks):
+    """The method comparison is only run on a single rank"""
+    if num_ranks == 1:
+        return perf_cfgs + app_cfgs
+    return app_cfgs
+
+
+# Optional comparison to a stored baseline, i.e., a JSON file written by a previous
+# run (see `performance_<num_ranks>.json` in the output directory) or a merge of
+# several of these. Configurations that are slower than the baseline by more than the
+# given relative tolerance fail the test.
+baseline_env = "ATHENAPK_PERF_BASELINE"
+tolerance_env = "ATHENAPK_PERF_TOLERANCE"
+default_tolerance = 0.1
 
 
 class TestCase(utils.test_case.TestCaseAbs):
     def Prepare(self, parameters, step):
-        mx = perf_cfgs[step - 1]["mx"]
-        mb = perf_cfgs[step - 1]["mb"]
-        integrator = perf_cfgs[step - 1]["integrator"]
-        recon = perf_cfgs[step - 1]["recon"]
-        fluid = perf_cfgs[step - 1]["fluid"]
-
-        parameters.driver_cmd_line_args = [
-            "problem/linear_wave/compute_error=false",
-            "parthenon/mesh/x1max=1.5",
-            "parthenon/mesh/nx1=%d" % mx,
-            "parthenon/meshblock/nx1=%d" % mb,
-            "parthenon/mesh/nx2=%d" % mx,
-            "parthenon/meshblock/nx2=%d" % mb,
-            "parthenon/mesh/nx3=%d" % mx,
-            "parthenon/meshblock/nx3=%d" % mb,
-            "parthenon/mesh/nghost=%d"
-            % (3 if (recon == "ppm" or recon == "wenoz") else 2),
-            "parthenon/mesh/refinement=none",
-            "parthenon/time/integrator=%s" % integrator,
-            "parthenon/time/nlim=10",
-            "hydro/reconstruction=%s" % recon,
-            "hydro/fluid=%s" % fluid,
-        ]
+        num_ranks = getattr(parameters, "num_ranks", 1)
+        cfg = get_cfgs(num_ranks)[step - 1]
+        # All input files are located next to the default (linear wave) input file
+        inputs_dir = os.path.dirname(parameters.driver_input_path)
+        if not hasattr(self, "default_input_path"):
+            self.default_input_path = parameters.driver_input_path
+
+        if "input" not in cfg.keys():
+            parameters.driver_input_path = self.default_input_path
+            mb = cfg["mb"]
+            mx1 = cfg["mx"] * (num_ranks if cfg.get("weak", False) else 1)
+            recon = cfg.get("recon", "plm")
+            parameters.driver_cmd_line_args = [
+                "problem/linear_wave/compute_error=false",
+                "parthenon/mesh/x1max=%f" % (1.5 * mx1 / cfg["mx"]),
+                "parthenon/mesh/nx1=%d" % mx1,
+                "parthenon/meshblock/nx1=%d" % mb,
+                "parthenon/mesh/nx2=%d" % cfg["mx"],
+                "parthenon/meshblock/nx2=%d" % mb,
+                "parthenon/mesh/nx3=%d" % cfg["mx"],
+                "parthenon/meshblock/nx3=%d" % mb,
+                "parthenon/mesh/nghost=%d"
+                % (3 if (recon == "ppm" or recon == "wenoz") else 2),
+                "parthenon/mesh/refinement=none",
+                "parthenon/time/integrator=%s" % cfg.get("integrator", "vl2"),
+                "parthenon/time/nlim=10",
+                "hydro/reconstruction=%s" % recon,
+                "hydro/fluid=%s" % cfg.get("fluid", "euler"),
+                "hydro/riemann=%s" % cfg.get("riemann", "hlle"),
+            ]
+        else:
+            parameters.driver_input_path = os.path.join(inputs_dir, cfg["input"])
+            parameters.driver_cmd_line_args = []
+            if "mx" in cfg.keys():
+                for dir in ["1", "2", "3"]:
+                    parameters.driver_cmd_line_args += [
+                        "parthenon/mesh/nx%s=%d" % (dir, cfg["mx"]),
+                        "parthenon/meshblock/nx%s=%d" % (dir, cfg["mb"]),
+                    ]
+            parameters.driver_cmd_line_args += [
+                arg.replace("%INPUTS%", inputs_dir) for arg in cfg.get("args", [])
+            ]
 
         return parameters
 
     def Analyse(self, parameters):
+        num_ranks = getattr(parameters, "num_ranks", 1)
+        cfgs = get_cfgs(num_ranks)
 
         perfs = []
         for output in parameters.stdouts:
@@ -95,33 +190,78 @@ class TestCase(utils.test_case.TestCaseAbs):
                 if "zone-cycles/wallsecond" in line:
                     perfs.append(float(line.split(" ")[2]))
 
+        if len(perfs) != len(cfgs):
+            print(f"Expected {len(cfgs)} performance results but found {len(perfs)}.")
+            return False
         perfs = np.array(perfs)
 
+        # Machine readable results
+        results = {
+            "num_ranks": num_ranks,
+            "results": [
+                {
+                    "name": cfg["name"],
+                    "num_ranks": num_ranks,
+                    "zone_cycles_per_second": perfs[i],
+                }
+                for i, cfg in enumerate(cfgs)
+            ],
+        }
+        with open(
+            os.path.join(parameters.output_path, f"performance_{num_ranks}.json"), "w"
+        ) as f:
+            json.dump(results, f, indent=2)
+
         # Plot results
-        fig, p = plt.subplots(2, 1, figsize=(4, 8.0 / 10 * len(perf_cfgs)), sharey=True)
+        fig, p = plt.subplots(2, 1, figsize=(4, 8.0 / 10 * len(cfgs)), sharey=True)
         labels = []
 
-        for i, cfg in enumerate(perf_cfgs):
+        for i, cfg in enumerate(cfgs):
             p[0].plot(perfs[i] / 1e6, i, "o")
             p[1].plot(perfs[i] / perfs[0], i, "o")
-            labels.append(
-                (
-                    f'{cfg["integrator"].upper()} {cfg["recon"].upper()} '
-                    f'Mesh ${cfg["mx"]}^3$ MB ${cfg["mb"]}^3$'
-                    f'{" MHD" if cfg["fluid"] == "glmmhd" else ""}'
-                )
-            )
+            labels.append(cfg["name"])
 
         p[0].set_xlabel("Mzone-cycles/s")
         p[1].set_xlabel("zcs normalized to bottom row")
 
         for i in range(2):
             p[i].grid()
-            p[i].set_yticks(np.arange(len(perf_cfgs)))
+            p[i].set_yticks(np.arange(len(cfgs)))
             p[i].set_yticklabels(labels)
 
         fig.savefig(
-            os.path.join(parameters.output_path, "performance.png"), bbox_inches="tight"
+            os.path.join(parameters.output_path, f"performance_{num_ranks}.png"),
+            bbox_inches="tight",
         )
 
-        return True
+        return self.CompareToBaseline(results["results"])
+
+    def CompareToBaseline(self, results):
+        baseline_path = os.environ.get(baseline_env, "")
+        if baseline_path == "":
+            print(f"No baseline given (via {baseline_env}). Skipping comparison.")
+            return True
+        tolerance = float(os.environ.get(tolerance_env, default_tolerance))
+        with open(baseline_path, "r") as f:
+            baseline = {
+                (r["name"], r["num_ranks"]): r["zone_cycles_per_second"]
+                for r in json.load(f)["results"]
+            }
+
+        success = True
+        print(f"Comparison to baseline {baseline_path} (tolerance {tolerance}):")
+        for r in results:
+            key = (r["name"], r["num_ranks"])
+            if key not in baseline.keys():
+                print(f"  {r['name']} ({r['num_ranks']} rank(s)): no baseline")
+                continue
+            ratio = r["zone_cycles_per_second"] / baseline[key]
+            regression = ratio < 1.0 - tolerance
+            print(
+                f"  {r['name']} ({r['num_ranks']} rank(s)): {ratio:.3f} of baseline"
+                f'{" REGRESSION" if regression else ""}'
+            )
+            if regression:
+                success = False
+
+        return success
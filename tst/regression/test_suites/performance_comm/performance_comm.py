@@ -0,0 +1,98 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import matplotlib
+
+matplotlib.use("agg")
+import matplotlib.pylab as plt
+import sys
+import os
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Benchmark of the ghost zone exchange strategies (Parthenon's default tasks, separate
+# tasks for local and nonlocal neighbors, and a single set of tasks for all neighbors)
+# for different block sizes. The custom strategies are only supported on uniform meshes.
+perf_cfgs = [
+    {"mx": 128, "mb": mb, "exchange": exchange}
+    for mb in [64, 32, 16]
+    for exchange in ["parthenon", "split", "combined"]
+]
+
+# first cycles are considered warmup
+num_warmup_cycles = 2
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        cfg = perf_cfgs[step - 1]
+        mx = cfg["mx"]
+        mb = cfg["mb"]
+
+        parameters.driver_cmd_line_args = [
+            "problem/linear_wave/compute_error=false",
+            "parthenon/mesh/x1max=1.5",
+            "parthenon/mesh/nx1=%d" % mx,
+            "parthenon/meshblock/nx1=%d" % mb,
+            "parthenon/mesh/nx2=%d" % mx,
+            "parthenon/meshblock/nx2=%d" % mb,
+            "parthenon/mesh/nx3=%d" % mx,
+            "parthenon/meshblock/nx3=%d" % mb,
+            "parthenon/time/integrator=vl2",
+            "parthenon/time/nlim=10",
+            "hydro/reconstruction=plm",
+            "hydro/boundary_exchange=%s" % cfg["exchange"],
+            "hydro/time_boundary_exchange=true",
+            "parthenon/mesh/refinement=none",
+        ]
+        return parameters
+
+    def Analyse(self, parameters):
+        exchange_times = []
+        for output in parameters.stdouts:
+            times = []
+            for line in output.decode("utf-8").split("\n"):
+                print(line)
+                if line.startswith("Boundary exchange time in cycle"):
+                    times.append(float(line.split(" ")[-2]))
+            if len(times) <= num_warmup_cycles:
+                print("Not enough timed cycles in output.")
+                return False
+            exchange_times.append(np.mean(times[num_warmup_cycles:]))
+
+        exchange_times = np.array(exchange_times)
+        num_ranks = getattr(parameters, "num_ranks", 1)
+
+        print(f"Ghost zone exchange time per cycle ({num_ranks} rank(s)):")
+        labels = []
+        for i, cfg in enumerate(perf_cfgs):
+            labels.append(
+                (
+                    f'{cfg["exchange"]} Mesh ${cfg["mx"]}^3$ MB ${cfg["mb"]}^3$'
+                )
+            )
+            print(f"  {labels[-1]}: {exchange_times[i]:.4e} s")
+
+        # Plot results
+        fig, p = plt.subplots(1, 1, figsize=(4, 8.0 / 10 * len(perf_cfgs)))
+        for i in range(len(perf_cfgs)):
+            p.plot(exchange_times[i] * 1e3, i, "o")
+
+        p.set_xlabel("exchange time per cycle [ms]")
+        p.grid()
+        p.set_yticks(np.arange(len(perf_cfgs)))
+        p.set_yticklabels(labels)
+
+        fig.savefig(
+            os.path.join(parameters.output_path, f"performance_comm_{num_ranks}.png"),
+            bbox_inches="tight",
+        )
+
+        return True
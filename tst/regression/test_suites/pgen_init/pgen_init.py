@@ -0,0 +1,206 @@
+# ========================================================================================
+# AthenaPK - a performance portable block structured AMR MHD code
+# Copyright (c) 2024, Athena Parthenon Collaboration. All rights reserved.
+# Licensed under the 3-clause BSD License, see LICENSE file for details
+# ========================================================================================
+
+# Modules
+import numpy as np
+import os
+import sys
+import utils.test_case
+
+""" To prevent littering up imported folders with .pyc files or __pycache_ folder"""
+sys.dont_write_bytecode = True
+
+# Initial conditions of the problem generators (that are initialized per MeshData
+# partition) compared to the analytic expressions evaluated at the cell centers.
+# The partitions contain a number of blocks that does not evenly divide the number of
+# blocks (and the meshes of the AMR setups contain multiple levels after the initial
+# refinement) so that wrong block or cell indices within a partition are detected.
+# Problem generators covered by other tests (e.g., the linear waves and field_loop) and
+# random initial conditions (kh with iprob=1 and rand_blast) are not included.
+
+# Maximum difference of each conserved variable (relative to its maximum). Wrong indices
+# result in differences of order unity whereas the cell centers in the output may only
+# be stored in single precision.
+max_rel_diff = 1e-5
+
+
+def orszag_tang(x, y, z, gamma):
+    b0 = 1.0 / np.sqrt(4.0 * np.pi)
+    d0 = 25.0 / (36.0 * np.pi)
+    p0 = 5.0 / (12.0 * np.pi)
+    mx = d0 * np.sin(2.0 * np.pi * y)
+    my = -d0 * np.sin(2.0 * np.pi * x)
+    bx = b0 * np.sin(2.0 * np.pi * y)
+    by = b0 * np.sin(4.0 * np.pi * x)
+    return {
+        "density": np.full_like(x, d0),
+        "momentum_density_1": mx,
+        "momentum_density_2": my,
+        "momentum_density_3": np.zeros_like(x),
+        "total_energy_density": p0 / (gamma - 1.0)
+        + 0.5 * (bx**2 + by**2 + (mx**2 + my**2) / d0),
+        "magnetic_field_1": bx,
+        "magnetic_field_2": by,
+        "magnetic_field_3": np.zeros_like(x),
+    }
+
+
+def kh_iprob2(x, y, z, gamma, vflow=1.0, amp=0.01):
+    mx = vflow * np.tanh(y / 0.02)
+    my = amp * np.cos(2.0 * np.pi * x) * np.exp(-(y**2) / 0.2**2)
+    return {
+        "density": np.ones_like(x),
+        "momentum_density_1": mx,
+        "momentum_density_2": my,
+        "momentum_density_3": np.zeros_like(x),
+        "total_energy_density": 1.0 / (gamma - 1.0) + 0.5 * (mx**2 + my**2),
+    }
+
+
+def kh_iprob3(x, y, z, gamma, vflow=1.0, amp=0.01):
+    dy = np.abs(y) - 0.5
+    rho = 0.505 + 0.495 * np.tanh(dy / 0.01)
+    vx = vflow * np.tanh(dy / 0.01)
+    vy = amp * vflow * np.sin(2.0 * np.pi * x) * np.exp(-(dy**2) / 0.1**2)
+    vy = np.where(y < 0.0, -vy, vy)
+    mx, my = rho * vx, rho * vy
+    return {
+        "density": rho,
+        "momentum_density_1": mx,
+        "momentum_density_2": my,
+        "momentum_density_3": np.zeros_like(x),
+        "total_energy_density": 1.0 / (gamma - 1.0) + 0.5 * (mx**2 + my**2) / rho,
+    }
+
+
+def blast(x, y, z, gamma, rout=0.03125, pa=0.001, prat=1.6e8):
+    # radius_inner = 0, i.e., logarithmic ramp over the entire sphere
+    rad = np.sqrt(x**2 + y**2 + z**2)
+    f = rad / rout
+    pres = np.where(
+        rad < rout, np.exp((1.0 - f) * np.log(prat * pa) + f * np.log(pa)), pa
+    )
+    return {
+        "density": np.ones_like(x),
+        "momentum_density_1": np.zeros_like(x),
+        "momentum_density_2": np.zeros_like(x),
+        "momentum_density_3": np.zeros_like(x),
+        "total_energy_density": pres / (gamma - 1.0),
+    }
+
+
+def advection(x, y, z, gamma, rho_ratio=1.01, rho_radius=0.0625, v=1.0):
+    sigmasq = -(rho_radius**2) / 2.0 / np.log(0.01)
+    rsq = x**2 + y**2 + z**2
+    rho = 1.0 + np.where(
+        rsq < rho_radius**2, rho_ratio * np.exp(-rsq / 2.0 / sigmasq), 0.0
+    )
+    return {
+        "density": rho,
+        "momentum_density_1": rho * v,
+        "momentum_density_2": rho * v,
+        "momentum_density_3": rho * v,
+        "total_energy_density": 1.0 / (gamma - 1.0) + 0.5 * 3.0 * rho * v**2,
+    }
+
+
+problem_cfgs = [
+    {
+        "name": "orszag_tang",
+        "input": "orszag_tang.in",
+        "fun": orszag_tang,
+        "args": [
+            "parthenon/mesh/nx1=64",
+            "parthenon/meshblock/nx1=16",
+            "parthenon/mesh/nx2=64",
+            "parthenon/meshblock/nx2=16",
+        ],
+    },
+    {
+        "name": "kh_iprob2",
+        "input": "kh-shear-lecoanet_2d.in",
+        "fun": kh_iprob2,
+        "args": ["problem/kh/iprob=2"],
+    },
+    {
+        "name": "kh_iprob3",
+        "input": "kh-shear-lecoanet_2d.in",
+        "fun": kh_iprob3,
+        "args": ["problem/kh/iprob=3"],
+    },
+    {
+        "name": "blast",
+        "input": "blast_3d_amr.in",
+        "fun": blast,
+        "args": [],
+    },
+    {
+        "name": "advection",
+        "input": "advection_3d.in",
+        "fun": advection,
+        "args": [],
+    },
+]
+
+common_args = [
+    "parthenon/mesh/pack_size=3",
+    "parthenon/time/nlim=0",
+    "parthenon/output0/file_type=hdf5",
+    "parthenon/output0/dt=1.0",
+    "parthenon/output0/variables=cons",
+    "parthenon/output0/id=cons",
+    "hydro/gamma=1.4",
+]
+
+
+class TestCase(utils.test_case.TestCaseAbs):
+    def Prepare(self, parameters, step):
+        problem = problem_cfgs[step - 1]
+        # All input files are located next to the default (linear wave) input file
+        if not hasattr(self, "inputs_dir"):
+            self.inputs_dir = os.path.dirname(parameters.driver_input_path)
+        parameters.driver_input_path = os.path.join(self.inputs_dir, problem["input"])
+
+        parameters.driver_cmd_line_args = (
+            [f"parthenon/job/problem_id={problem['name']}"]
+            + common_args
+            + problem["args"]
+        )
+
+        return parameters
+
+    def Analyse(self, parameters):
+        sys.path.insert(
+            1,
+            parameters.parthenon_path
+            + "/scripts/python/packages/parthenon_tools/parthenon_tools",
+        )
+        try:
+            import phdf
+        except ModuleNotFoundError:
+            print("Couldn't find module to read Parthenon hdf5 files.")
+            return False
+
+        test_success = True
+        for problem in problem_cfgs:
+            data_file = phdf.phdf(
+                f"{parameters.output_path}/{problem['name']}.cons.00000.phdf"
+            )
+            z, y, x = data_file.GetVolumeLocations(flatten=False)
+            expected = problem["fun"](x, y, z, 1.4)
+            data = data_file.GetComponents(
+                [f"cons_{var}" for var in expected], flatten=False
+            )
+            levels = np.unique(data_file.Levels)
+            print(f"{problem['name']}: {data_file.NumBlocks} blocks on levels {levels}")
+            for var, ref in expected.items():
+                diff = np.max(np.abs(data[f"cons_{var}"] - ref))
+                rel_diff = diff / max(np.max(np.abs(ref)), 1.0)
+                if not rel_diff <= max_rel_diff:
+                    print(f"ERROR: {problem['name']} {var} differs by {rel_diff}.")
+                    test_success = False
+
+        return test_success